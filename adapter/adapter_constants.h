@@ -24,6 +24,9 @@ namespace wrp::cae {
 
 static inline const MapperType kMapperType = MapperType::kBalancedMapper;
 
+/** Max bytes of pages sent to CTE in one PutBlobs/GetBlobs batch */
+static inline const size_t kMaxBlobBatchSize = 16 * 1024 * 1024;
+
 }
 
 #endif  // WRP_CTE_ADAPTER_ADAPTER_CONSTANTS_H_
@@ -17,7 +17,6 @@
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
-#include <regex>
 
 namespace wrp::cae {
 
@@ -119,11 +118,8 @@ bool CaeConfig::LoadFromYaml(const YAML::Node &config) {
       }
     }
 
-    // Sort patterns by length in descending order (most specific first)
-    std::sort(patterns_.begin(), patterns_.end(),
-              [](const PathPattern &a, const PathPattern &b) {
-                return a.pattern.length() > b.pattern.length();
-              });
+    // Sort patterns (most specific first) and compile them once
+    PreparePatterns();
 
     // Load adapter page size
     if (config["adapter_page_size"]) {
@@ -139,6 +135,27 @@ bool CaeConfig::LoadFromYaml(const YAML::Node &config) {
       interception_enabled_ = config["interception_enabled"].as<bool>();
     }
 
+    // Load write-back cache size (optional, defaults to 0 = disabled)
+    if (config["write_back_cache_size"]) {
+      write_back_cache_size_ = config["write_back_cache_size"].as<size_t>();
+    }
+
+    // Load read-ahead settings (optional, read-ahead defaults to disabled)
+    if (config["read_ahead_max_pages"]) {
+      read_ahead_max_pages_ = config["read_ahead_max_pages"].as<size_t>();
+    }
+    if (config["read_ahead_cache_size"]) {
+      read_ahead_cache_size_ = config["read_ahead_cache_size"].as<size_t>();
+    }
+
+    // Load stage-in settings (optional, stage-in defaults to enabled)
+    if (config["stage_in_enabled"]) {
+      stage_in_enabled_ = config["stage_in_enabled"].as<bool>();
+    }
+    if (config["stage_in_score"]) {
+      stage_in_score_ = config["stage_in_score"].as<float>();
+    }
+
     size_t include_count =
         std::count_if(patterns_.begin(), patterns_.end(),
                       [](const PathPattern &p) { return p.include; });
@@ -146,9 +163,12 @@ bool CaeConfig::LoadFromYaml(const YAML::Node &config) {
 
     HILOG(kInfo,
           "CAE config loaded: {} include patterns, {} exclude patterns, "
-          "page size {} bytes, interception {}",
+          "page size {} bytes, interception {}, write-back cache {} bytes, "
+          "read-ahead {} pages, stage-in {}",
           include_count, exclude_count, adapter_page_size_,
-          interception_enabled_ ? "enabled" : "disabled");
+          interception_enabled_ ? "enabled" : "disabled",
+          write_back_cache_size_, read_ahead_max_pages_,
+          stage_in_enabled_ ? "enabled" : "disabled");
     return true;
 
   } catch (const YAML::Exception &e) {
@@ -214,6 +234,17 @@ std::string CaeConfig::ToYamlString() const {
   // Add interception enabled setting
   config["interception_enabled"] = interception_enabled_;
 
+  // Add write-back cache size
+  config["write_back_cache_size"] = write_back_cache_size_;
+
+  // Add read-ahead settings
+  config["read_ahead_max_pages"] = read_ahead_max_pages_;
+  config["read_ahead_cache_size"] = read_ahead_cache_size_;
+
+  // Add stage-in settings
+  config["stage_in_enabled"] = stage_in_enabled_;
+  config["stage_in_score"] = stage_in_score_;
+
   YAML::Emitter emitter;
   emitter << config;
 
@@ -240,16 +271,9 @@ bool CaeConfig::IsPathTracked(const std::string &path) const {
   // Check patterns in order of specificity (already sorted by length
   // descending)
   for (const auto &pattern_entry : patterns_) {
-    try {
-      std::regex pattern_regex(pattern_entry.pattern);
-      if (std::regex_search(path, pattern_regex)) {
-        // First match determines result
-        return pattern_entry.include;
-      }
-    } catch (const std::regex_error &e) {
-      HELOG(kWarning, "Invalid regex pattern '{}': {}", pattern_entry.pattern,
-            e.what());
-      continue;
+    if (pattern_entry.compiled && pattern_entry.compiled->Search(path)) {
+      // First match determines result
+      return pattern_entry.include;
     }
   }
 
@@ -264,11 +288,7 @@ void CaeConfig::AddIncludePattern(const std::string &pattern) {
 
   patterns_.emplace_back(pattern, true);
 
-  // Re-sort by length (descending) to maintain specificity order
-  std::sort(patterns_.begin(), patterns_.end(),
-            [](const PathPattern &a, const PathPattern &b) {
-              return a.pattern.length() > b.pattern.length();
-            });
+  PreparePatterns();
 
   HILOG(kDebug, "Added include pattern: {}", pattern);
 }
@@ -280,15 +300,33 @@ void CaeConfig::AddExcludePattern(const std::string &pattern) {
 
   patterns_.emplace_back(pattern, false);
 
-  // Re-sort by length (descending) to maintain specificity order
-  std::sort(patterns_.begin(), patterns_.end(),
-            [](const PathPattern &a, const PathPattern &b) {
-              return a.pattern.length() > b.pattern.length();
-            });
+  PreparePatterns();
 
   HILOG(kDebug, "Added exclude pattern: {}", pattern);
 }
 
+void CaeConfig::PreparePatterns() {
+  // Sort by length (descending) to maintain specificity order
+  std::stable_sort(patterns_.begin(), patterns_.end(),
+                   [](const PathPattern &a, const PathPattern &b) {
+                     return a.pattern.length() > b.pattern.length();
+                   });
+
+  for (auto &pattern_entry : patterns_) {
+    if (pattern_entry.compiled) {
+      continue;
+    }
+    try {
+      pattern_entry.compiled =
+          std::make_shared<const wrp_cte::core::CompiledPattern>(
+              pattern_entry.pattern);
+    } catch (const std::exception &e) {
+      HELOG(kWarning, "Invalid regex pattern '{}': {}", pattern_entry.pattern,
+            e.what());
+    }
+  }
+}
+
 void CaeConfig::ClearPatterns() {
   patterns_.clear();
   HILOG(kDebug, "Cleared all patterns");
@@ -13,11 +13,12 @@
 #ifndef WRP_CAE_CONFIG_H_
 #define WRP_CAE_CONFIG_H_
 
+#include <memory>
 #include <string>
 #include <vector>
-#include <regex>
 #include <yaml-cpp/yaml.h>
 #include <hermes_shm/util/singleton.h>
+#include "wrp_cte/core/core_pattern.h"
 
 namespace wrp::cae {
 
@@ -28,6 +29,7 @@ namespace wrp::cae {
 struct PathPattern {
   std::string pattern;  // Regex pattern
   bool include;         // true = include, false = exclude
+  std::shared_ptr<const wrp_cte::core::CompiledPattern> compiled;  // null if invalid
 
   PathPattern(const std::string& p, bool inc) : pattern(p), include(inc) {}
 };
@@ -41,9 +43,18 @@ public:
   std::vector<PathPattern> patterns_;     // Include/exclude patterns sorted by specificity
   size_t adapter_page_size_;              // Page size for adapter operations (bytes)
   bool interception_enabled_;             // Global enable/disable for interception
+  size_t write_back_cache_size_;          // Per-file write-back cache limit (bytes, 0 = off)
+  size_t read_ahead_max_pages_;           // Max pages prefetched per stream (0 = off)
+  size_t read_ahead_cache_size_;          // Per-file prefetched page limit (bytes)
+  bool stage_in_enabled_;                 // Populate CTE from the file on read miss
+  float stage_in_score_;                  // Placement score of staged-in pages
 
   // Default constructor
-  CaeConfig() : adapter_page_size_(4096), interception_enabled_(true) {}
+  CaeConfig()
+      : adapter_page_size_(4096), interception_enabled_(true),
+        write_back_cache_size_(0), read_ahead_max_pages_(0),
+        read_ahead_cache_size_(64 * 1024 * 1024), stage_in_enabled_(true),
+        stage_in_score_(1.0f) {}
   
   /**
    * Load configuration from YAML file
@@ -75,7 +86,8 @@ public:
   /**
    * Check if a path should be tracked by adapters using regex matching
    * Patterns are checked in order of specificity (longest first)
-   * First matching pattern determines the result
+   * First matching pattern determines the result. Patterns are compiled when
+   * they are loaded or added, not per call.
    * @param path Path to check
    * @return true if path matches an include pattern, false if excluded or no match
    */
@@ -110,6 +122,66 @@ public:
    */
   void SetAdapterPageSize(size_t page_size) { adapter_page_size_ = page_size; }
 
+  /**
+   * Get the per-file write-back cache limit
+   * @return Max dirty bytes buffered per open file; 0 disables the cache
+   */
+  size_t GetWriteBackCacheSize() const { return write_back_cache_size_; }
+
+  /**
+   * Set the per-file write-back cache limit
+   * @param size Max dirty bytes buffered per open file; 0 disables the cache
+   */
+  void SetWriteBackCacheSize(size_t size) { write_back_cache_size_ = size; }
+
+  /**
+   * Get the max read-ahead depth
+   * @return Max pages prefetched ahead of a detected stream; 0 disables
+   */
+  size_t GetReadAheadMaxPages() const { return read_ahead_max_pages_; }
+
+  /**
+   * Set the max read-ahead depth
+   * @param pages Max pages prefetched ahead of a detected stream; 0 disables
+   */
+  void SetReadAheadMaxPages(size_t pages) { read_ahead_max_pages_ = pages; }
+
+  /**
+   * Get the per-file read-ahead cache limit
+   * @return Max bytes of prefetched pages held per open file
+   */
+  size_t GetReadAheadCacheSize() const { return read_ahead_cache_size_; }
+
+  /**
+   * Set the per-file read-ahead cache limit
+   * @param size Max bytes of prefetched pages held per open file
+   */
+  void SetReadAheadCacheSize(size_t size) { read_ahead_cache_size_ = size; }
+
+  /**
+   * Check if pages missing from CTE are read from the backing file
+   * @return true if read misses stage pages in, false otherwise
+   */
+  bool IsStageInEnabled() const { return stage_in_enabled_; }
+
+  /**
+   * Enable or disable stage-in on read miss
+   * @param enabled Whether read misses stage pages in from the backing file
+   */
+  void SetStageInEnabled(bool enabled) { stage_in_enabled_ = enabled; }
+
+  /**
+   * Get the placement score of staged-in pages
+   * @return Score 0-1 given to pages inserted on read miss or by StageIn
+   */
+  float GetStageInScore() const { return stage_in_score_; }
+
+  /**
+   * Set the placement score of staged-in pages
+   * @param score Score 0-1 given to pages inserted on read miss or by StageIn
+   */
+  void SetStageInScore(float score) { stage_in_score_ = score; }
+
   /**
    * Get list of all patterns
    * @return Vector of path patterns
@@ -139,6 +211,12 @@ private:
    * @return true if loaded successfully, false otherwise
    */
   bool LoadFromYaml(const YAML::Node& config);
+
+  /**
+   * Sort patterns by specificity and compile those not compiled yet;
+   * invalid patterns are logged and never match
+   */
+  void PreparePatterns();
 };
 
 // Global pointer-based singleton with lazy initialization
@@ -21,10 +21,12 @@
 // #include <mpi.h>
 
 #include <filesystem>
+#include <functional>
 #include <future>
 #include <set>
 #include <string>
 
+#include "adapter/adapter_constants.h"
 #include "adapter/adapter_types.h"
 #include "adapter/cae_config.h"
 #include "adapter/mapper/mapper_factory.h"
@@ -95,11 +97,47 @@ public:
       // Initialize CTE core client and get or create tag
       // Use singleton client that should be configured globally
 
+      // A truncated file keeps none of its old pages; otherwise write-back
+      // would restore them
+      if (stat.hflags_.Any(WRP_CTE_FS_TRUNC) &&
+          stat.adapter_mode_ != AdapterMode::kBypass) {
+        WRP_CTE_CLIENT->DelTag(hipc::MemContext(), stat.path_);
+      }
+
       // Create Tag object for this file - Tag constructor handles
       // GetOrCreateTag
       wrp_cte::core::Tag file_tag(stat.path_);
       stat.tag_id_ = file_tag.GetTagId();
 
+      // Buffer small writes on the client if a write-back cache is configured
+      auto *cae_config = WRP_CAE_CONF;
+      if (cae_config && cae_config->GetWriteBackCacheSize() > 0 &&
+          stat.adapter_mode_ != AdapterMode::kBypass) {
+        stat.write_cache_ = std::make_shared<WriteBackCache>(
+            stat.tag_id_, stat.page_size_,
+            cae_config->GetWriteBackCacheSize());
+      }
+      // Prefetch ahead of streaming readers if read-ahead is configured
+      if (cae_config && cae_config->GetReadAheadMaxPages() > 0 &&
+          stat.adapter_mode_ != AdapterMode::kBypass) {
+        stat.read_ahead_ = std::make_shared<ReadAheadCache>(
+            stat.tag_id_, stat.page_size_, cae_config->GetReadAheadMaxPages(),
+            cae_config->GetReadAheadCacheSize());
+      }
+      // Populate CTE from the file when reads find pages missing
+      if (cae_config && cae_config->IsStageInEnabled() &&
+          stat.adapter_mode_ != AdapterMode::kBypass) {
+        stat.stage_in_ = std::make_shared<StageInQueue>(
+            stat.tag_id_, cae_config->GetStageInScore());
+      }
+      // Register the file for write-back before the first write, since only
+      // writes to registered files are tracked; pages left dirty by an
+      // earlier session go out now
+      if (WritesBack(stat)) {
+        WRP_CTE_CLIENT->FlushTag(hipc::MemContext(), stat.tag_id_, stat.path_,
+                                 stat.page_size_);
+      }
+
       if (stat.hflags_.Any(WRP_CTE_FS_TRUNC)) {
         // The file was opened with TRUNCATION
         // In CTE, we handle truncation differently - no explicit clear needed
@@ -144,6 +182,78 @@ private:
     return page_size - page_offset;
   }
 
+  /** Whether pages written through CTE are written back to the file */
+  static bool WritesBack(const AdapterStat &stat) {
+    return stat.hflags_.Any(WRP_CTE_FS_WRITE) &&
+           stat.adapter_mode_ != AdapterMode::kBypass &&
+           stat.adapter_mode_ != AdapterMode::kScratch;
+  }
+
+  /** Bytes covered by the leading requests of a batch that succeeded */
+  static size_t
+  CompletedBatchPrefix(const std::vector<wrp_cte::core::BlobIoRequest> &batch) {
+    size_t completed = 0;
+    for (const auto &request : batch) {
+      if (request.return_code_ != 0) {
+        break;
+      }
+      completed += request.size_;
+    }
+    return completed;
+  }
+
+  /**
+   * Serve the requests of a failed GetBlobs batch whose pages are missing
+   * from CTE by reading those pages from the backing file. Each page read is
+   * also staged into CTE asynchronously. Recovered requests are marked
+   * successful.
+   * @param pages Page index of each request
+   * @param data Destination of the batch
+   * @return true if every failed request was recovered
+   */
+  bool StageInMissing(AdapterStat &stat,
+                      std::vector<wrp_cte::core::BlobIoRequest> &batch,
+                      const std::vector<size_t> &pages, char *data) {
+    if (!stat.stage_in_) {
+      return false;
+    }
+    bool recovered = true;
+    size_t data_off = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+      wrp_cte::core::BlobIoRequest &request = batch[i];
+      char *dst = data + data_off;
+      data_off += request.size_;
+      if (request.return_code_ == 0) {
+        continue;
+      }
+      if (request.return_code_ != wrp_cte::core::kBlobNotFound) {
+        recovered = false;
+        continue;
+      }
+
+      // Read the whole page so the staged blob is complete
+      wrp_cte::core::IoBuffer page(stat.page_size_);
+      if (page.IsNull()) {
+        recovered = false;
+        continue;
+      }
+      FsIoOptions opts;
+      opts.backend_off_ = pages[i] * stat.page_size_;
+      opts.backend_size_ = stat.page_size_;
+      IoStatus status;
+      ReadBlob(stat.path_, page.data(), stat.page_size_, opts, status);
+      size_t page_len = status.size_ > stat.page_size_ ? 0 : status.size_;
+      if (page_len < request.offset_ + request.size_) {
+        recovered = false;
+        continue;
+      }
+      memcpy(dst, page.data() + request.offset_, request.size_);
+      request.return_code_ = 0;
+      stat.stage_in_->Insert(pages[i], std::move(page), page_len);
+    }
+    return recovered;
+  }
+
 public:
   /** write */
   size_t Write(File &f, AdapterStat &stat, const void *ptr, size_t off,
@@ -179,15 +289,34 @@ public:
     // CTE doesn't need Context objects
 
     if (is_append) {
-      // TODO: Append operations not yet supported in CTE
-      // Perform append
-      HILOG(kWarning, "Append operations not yet supported in CTE, treating as "
-                      "regular write");
-      // Fallback to regular write at end of file
-      off = stat.file_size_;
+      return Append(stat, ptr, total_size, io_status, opts);
+    }
+
+    // Prefetched copies of the written range are stale
+    if (stat.read_ahead_) {
+      stat.read_ahead_->Invalidate(off, total_size);
     }
 
-    // Use page-based CTE PutBlob operations with Tag API
+    // Small writes are absorbed by the write-back cache
+    if (stat.write_cache_ && stat.write_cache_->Accepts(total_size)) {
+      stat.write_cache_->Write(off, static_cast<const char *>(ptr),
+                               total_size);
+      if (opts.DoSeek()) {
+        stat.st_ptr_ = off + total_size;
+      }
+      stat.UpdateTime();
+      io_status.size_ = total_size;
+      UpdateIoStatus(opts, io_status);
+      return total_size;
+    }
+
+    // Buffered data for this range must land before it is overwritten
+    if (stat.write_cache_) {
+      stat.write_cache_->FlushRange(off, total_size);
+    }
+
+    // Use page-based CTE PutBlobs operations with Tag API; pages are sent in
+    // batches so one task carries many pages
     {
       size_t bytes_written = 0;
       size_t current_offset = off;
@@ -197,34 +326,41 @@ public:
       wrp_cte::core::Tag file_tag(stat.tag_id_);
 
       while (bytes_written < total_size) {
-        // Calculate current page index and offset within page
-        size_t page_index = CalculatePageIndex(current_offset, stat.page_size_);
-        size_t page_offset =
-            CalculatePageOffset(current_offset, stat.page_size_);
-        size_t remaining_page_space =
-            CalculateRemainingPageSpace(current_offset, stat.page_size_);
-
-        // Calculate how much to write in this page
-        size_t bytes_to_write =
-            std::min(remaining_page_space, total_size - bytes_written);
-
-        // Generate blob name using stringified page index
-        std::string blob_name = std::to_string(page_index);
+        std::vector<wrp_cte::core::BlobIoRequest> batch;
+        size_t batch_start = bytes_written;
+        size_t batch_size = 0;
+        while (bytes_written < total_size && batch_size < kMaxBlobBatchSize) {
+          // Calculate current page index and offset within page
+          size_t page_index =
+              CalculatePageIndex(current_offset, stat.page_size_);
+          size_t page_offset =
+              CalculatePageOffset(current_offset, stat.page_size_);
+          size_t remaining_page_space =
+              CalculateRemainingPageSpace(current_offset, stat.page_size_);
+
+          // Calculate how much to write in this page
+          size_t bytes_to_write =
+              std::min(remaining_page_space, total_size - bytes_written);
+
+          // Generate blob name using stringified page index
+          batch.emplace_back(std::to_string(page_index), page_offset,
+                             bytes_to_write);
+
+          // Update counters for next iteration
+          batch_size += bytes_to_write;
+          bytes_written += bytes_to_write;
+          current_offset += bytes_to_write;
+        }
 
-        // Use Tag API PutBlob with raw char* (handles SHM allocation internally)
+        // Use Tag API PutBlobs with raw char* (one SHM buffer per batch)
         try {
-          file_tag.PutBlob(blob_name, data_ptr + bytes_written, bytes_to_write,
-                           page_offset);
+          file_tag.PutBlobs(batch, data_ptr + batch_start);
         } catch (const std::exception &e) {
-          HILOG(kError, "Tag PutBlob failed for page {}: {}", page_index,
+          HILOG(kError, "Tag PutBlobs failed for {} pages: {}", batch.size(),
                 e.what());
           io_status.success_ = false;
-          return bytes_written;
+          return batch_start + CompletedBatchPrefix(batch);
         }
-
-        // Update counters for next iteration
-        bytes_written += bytes_to_write;
-        current_offset += bytes_to_write;
       }
 
       if (opts.DoSeek()) {
@@ -235,7 +371,59 @@ public:
     io_status.size_ = total_size;
     UpdateIoStatus(opts, io_status);
 
-    HILOG(kDebug, "The size of file after write: {}", GetSize(f, stat));
+    HILOG(kDebug, "Wrote {} bytes at offset {} of {}", total_size, off,
+          filename);
+    return total_size;
+  }
+
+  /**
+   * Append to the end of the file. The runtime reserves the range and writes
+   * it, so appends of many processes to one file never overlap. The known
+   * file size is passed as a floor, since pages of an existing file that were
+   * never staged in are not part of the tag's size.
+   */
+  size_t Append(AdapterStat &stat, const void *ptr, size_t total_size,
+                IoStatus &io_status, FsIoOptions opts = FsIoOptions()) {
+    if (total_size == 0) {
+      io_status.size_ = 0;
+      UpdateIoStatus(opts, io_status);
+      return 0;
+    }
+    // Buffered writes of this file must be in CTE before the end is taken
+    if (stat.write_cache_ && !stat.write_cache_->Flush()) {
+      io_status.success_ = false;
+      return 0;
+    }
+
+    wrp_cte::core::IoBuffer buffer(total_size);
+    if (buffer.IsNull()) {
+      HELOG(kError, "No shared memory to append {} bytes to {}", total_size,
+            stat.path_);
+      io_status.success_ = false;
+      return 0;
+    }
+    memcpy(buffer.data(), ptr, total_size);
+    chi::u64 off = 0;
+    if (!WRP_CTE_CLIENT->AppendToTag(hipc::MemContext(), stat.tag_id_,
+                                     buffer.shm(), total_size,
+                                     stat.page_size_, off, 1.0f,
+                                     stat.file_size_)) {
+      HELOG(kError, "Append of {} bytes to {} failed", total_size,
+            stat.path_);
+      io_status.success_ = false;
+      return 0;
+    }
+
+    if (stat.read_ahead_) {
+      stat.read_ahead_->Invalidate(off, total_size);
+    }
+    stat.file_size_ = std::max<size_t>(stat.file_size_, off + total_size);
+    stat.UpdateTime();
+    io_status.size_ = total_size;
+    UpdateIoStatus(opts, io_status);
+
+    HILOG(kDebug, "Appended {} bytes at offset {} of {}", total_size, off,
+          stat.path_);
     return total_size;
   }
 
@@ -301,7 +489,14 @@ public:
             "Async read operations not yet fully supported, using sync read");
     }
 
-    // Use page-based CTE GetBlob operations with Tag API
+    // Buffered writes to this range must be visible to the read
+    if (stat.write_cache_) {
+      stat.write_cache_->FlushRange(off, total_size);
+    }
+
+    // Use page-based CTE GetBlobs operations with Tag API; pages are read in
+    // batches so one task carries many pages. Pages prefetched by read-ahead
+    // are copied out directly and split the batches around them.
     size_t bytes_read = 0;
     size_t current_offset = off;
     char *data_ptr = static_cast<char *>(ptr);
@@ -309,6 +504,25 @@ public:
     // Create Tag object from stored TagId
     wrp_cte::core::Tag file_tag(stat.tag_id_);
 
+    // Report the access first so prefetches overlap this read
+    if (stat.read_ahead_) {
+      std::function<bool(size_t)> skip;
+      if (stat.write_cache_) {
+        // Pages with buffered writes would be prefetched stale
+        WriteBackCache *write_cache = stat.write_cache_.get();
+        skip = [write_cache](size_t page_index) {
+          return write_cache->IsDirty(page_index);
+        };
+      }
+      stat.read_ahead_->OnAccess(
+          CalculatePageIndex(off, stat.page_size_),
+          CalculatePageIndex(off + total_size - 1, stat.page_size_), skip);
+    }
+
+    std::vector<wrp_cte::core::BlobIoRequest> batch;
+    std::vector<size_t> batch_pages;
+    size_t batch_start = 0;
+    size_t batch_size = 0;
     while (bytes_read < total_size) {
       // Calculate current page index and offset within page
       size_t page_index = CalculatePageIndex(current_offset, stat.page_size_);
@@ -320,23 +534,46 @@ public:
       size_t bytes_to_read =
           std::min(remaining_page_space, total_size - bytes_read);
 
-      // Generate blob name using stringified page index
-      std::string blob_name = std::to_string(page_index);
-
-      // Use Tag API GetBlob with raw char* (handles SHM allocation internally)
-      try {
-        file_tag.GetBlob(blob_name, data_ptr + bytes_read, bytes_to_read,
-                         page_offset);
-      } catch (const std::exception &e) {
-        HILOG(kError, "Tag GetBlob failed for page {}: {}", page_index,
-              e.what());
-        io_status.success_ = false;
-        return bytes_read;
+      bool prefetched =
+          stat.read_ahead_ &&
+          stat.read_ahead_->Read(page_index, page_offset, bytes_to_read,
+                                 data_ptr + bytes_read);
+      if (!prefetched) {
+        if (batch.empty()) {
+          batch_start = bytes_read;
+        }
+        // Generate blob name using stringified page index
+        batch.emplace_back(std::to_string(page_index), page_offset,
+                           bytes_to_read);
+        batch_pages.push_back(page_index);
+        batch_size += bytes_to_read;
       }
 
       // Update counters for next iteration
       bytes_read += bytes_to_read;
       current_offset += bytes_to_read;
+
+      // Send the batch when it is full, interrupted, or complete
+      if (!batch.empty() &&
+          (prefetched || batch_size >= kMaxBlobBatchSize ||
+           bytes_read == total_size)) {
+        // Use Tag API GetBlobs with raw char* (one SHM buffer per batch)
+        try {
+          file_tag.GetBlobs(batch, data_ptr + batch_start);
+        } catch (const std::exception &e) {
+          // Pages missing from CTE are read through from the backing file
+          if (!StageInMissing(stat, batch, batch_pages,
+                              data_ptr + batch_start)) {
+            HILOG(kError, "Tag GetBlobs failed for {} pages: {}",
+                  batch.size(), e.what());
+            io_status.success_ = false;
+            return batch_start + CompletedBatchPrefix(batch);
+          }
+        }
+        batch.clear();
+        batch_pages.clear();
+        batch_size = 0;
+      }
     }
 
     size_t data_offset = bytes_read; // Total bytes read
@@ -456,6 +693,10 @@ public:
   size_t GetSize(File &f, AdapterStat &stat) {
     (void)f;
     if (stat.adapter_mode_ != AdapterMode::kBypass) {
+      // Buffered writes may extend the file
+      if (stat.write_cache_) {
+        stat.write_cache_->Flush();
+      }
       // For CTE, query the actual tag size from CTE runtime
       auto *cte_client = WRP_CTE_CLIENT;
       size_t cte_tag_size =
@@ -488,22 +729,68 @@ public:
   /** sync */
   int Sync(File &f, AdapterStat &stat) {
     (void)f;
-    (void)stat;
-    // CTE sync operations would be handled by the runtime
-    // For now, no explicit sync needed
-    return 0;
+    // Send buffered writes, then have the runtime write every page changed
+    // since the last flush back to the file and sync it
+    if (stat.write_cache_ && !stat.write_cache_->Flush()) {
+      return -1;
+    }
+    if (!WritesBack(stat)) {
+      return 0;
+    }
+    wrp_cte::core::FlushReport report = WRP_CTE_CLIENT->FlushTag(
+        hipc::MemContext(), stat.tag_id_, stat.path_, stat.page_size_,
+        wrp_cte::core::kFlushDurable);
+    HILOG(kDebug, "Flushed {} pages ({} bytes) of {} at {} MB/s",
+          report.pages_, report.bytes_, stat.path_,
+          report.GetBandwidthMBps());
+    return report.success_ ? 0 : -1;
   }
 
   /** truncate */
   int Truncate(File &f, AdapterStat &stat, size_t new_size) {
-    // hapi::Bucket &bkt = stat.bkt_id_;
-    // TODO(llogan)
-    return 0;
+    if (stat.adapter_mode_ != AdapterMode::kBypass) {
+      // Buffered and staged pages must be in CTE before they can be cut
+      if (stat.write_cache_ && !stat.write_cache_->Flush()) {
+        return -1;
+      }
+      if (stat.stage_in_) {
+        stat.stage_in_->Drain();
+      }
+      if (stat.read_ahead_) {
+        stat.read_ahead_->Truncate(new_size);
+      }
+      // Pages past the new size are deleted and the page it falls inside is
+      // shrunk; growing the file only extends the backing file
+      if (!WRP_CTE_CLIENT->TruncateTag(hipc::MemContext(), stat.tag_id_,
+                                       new_size, stat.page_size_)) {
+        HELOG(kError, "Truncating {} to {} bytes in CTE failed", stat.path_,
+              new_size);
+        return -1;
+      }
+    }
+    int ret = RealTruncate(f, stat, new_size);
+    if (ret == 0) {
+      stat.file_size_ = new_size;
+    }
+    return ret;
   }
 
   /** close */
   int Close(File &f, AdapterStat &stat) {
-    Sync(f, stat);
+    int ret = Sync(f, stat);
+    if (stat.read_ahead_) {
+      ReadAheadStats ra = stat.read_ahead_->GetStats();
+      HILOG(kDebug,
+            "Read-ahead for {}: hits={} misses={} issued={} wasted={} "
+            "window={}",
+            stat.path_, ra.hits_, ra.misses_, ra.issued_, ra.wasted_,
+            ra.window_);
+    }
+    if (stat.stage_in_) {
+      stat.stage_in_->Drain();
+      HILOG(kDebug, "Stage-in for {}: {} pages", stat.path_,
+            stat.stage_in_->GetStagedPages());
+    }
     auto mdm = WRP_CTE_FS_METADATA_MANAGER;
     FilesystemIoClientState fs_ctx(&mdm->fs_mdm_, (void *)&stat);
     HermesClose(f, stat, fs_ctx);
@@ -512,9 +799,8 @@ public:
     if (stat.amode_ & MPI_MODE_DELETE_ON_CLOSE) {
       Remove(stat.path_);
     }
-    // CTE doesn't require explicit flush operations
-    // Runtime handles persistence automatically
-    return 0;
+    // Buffered writes were flushed by Sync; the runtime handles persistence
+    return ret;
   }
 
   /** remove */
@@ -522,6 +808,24 @@ public:
     auto mdm = WRP_CTE_FS_METADATA_MANAGER;
     int ret = RealRemove(pathname);
 
+    // Buffered writes, prefetched pages and stage-in inserts of open handles
+    // are dropped or completed before the tag is deleted
+    std::list<File> *open_files = mdm->Find(pathname);
+    if (open_files != nullptr) {
+      for (const File &f : std::list<File>(*open_files)) {
+        std::shared_ptr<AdapterStat> stat = mdm->Find(f);
+        if (stat && stat->write_cache_) {
+          stat->write_cache_->Discard();
+        }
+        if (stat && stat->read_ahead_) {
+          stat->read_ahead_->Invalidate();
+        }
+        if (stat && stat->stage_in_) {
+          stat->stage_in_->Drain();
+        }
+      }
+    }
+
     // CTE tag cleanup - delete the tag associated with this file using
     // canonical path as tag name
     std::string canon_path = stdfs::absolute(pathname).string();
@@ -762,6 +1066,37 @@ public:
     return Sync(f, *stat);
   }
 
+  /**
+   * Bulk-load [off, off + size) of a file into CTE ahead of its readers.
+   * Pages already in CTE are left untouched.
+   * @param size Bytes to stage; 0 stages to the end of the file
+   * @return Bytes staged in
+   */
+  size_t StageIn(const std::string &path, size_t off = 0, size_t size = 0) {
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    std::string canon_path = stdfs::absolute(path).string();
+    auto *cae_config = WRP_CAE_CONF;
+    float score = cae_config ? cae_config->GetStageInScore() : 1.0f;
+    return WRP_CTE_CLIENT->StageIn(hipc::MemContext(), canon_path,
+                                   mdm->GetAdapterPageSize(canon_path), off,
+                                   size, score);
+  }
+
+  /** read-ahead counters; all zero if read-ahead is disabled */
+  ReadAheadStats GetReadAheadStats(File &f, bool &stat_exists) {
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    auto stat = mdm->Find(f);
+    if (!stat) {
+      stat_exists = false;
+      return ReadAheadStats();
+    }
+    stat_exists = true;
+    if (!stat->read_ahead_) {
+      return ReadAheadStats();
+    }
+    return stat->read_ahead_->GetStats();
+  }
+
   /** truncate */
   int Truncate(File &f, bool &stat_exists, size_t new_size) {
     auto mdm = WRP_CTE_FS_METADATA_MANAGER;
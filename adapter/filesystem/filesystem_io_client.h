@@ -22,6 +22,9 @@
 #include "wrp_cte/core/core_client.h"
 #include "wrp_cte/core/core_tasks.h"
 #include "adapter/adapter_types.h"
+#include "adapter/filesystem/read_ahead_cache.h"
+#include "adapter/filesystem/stage_in_queue.h"
+#include "adapter/filesystem/write_back_cache.h"
 #include "adapter/mapper/balanced_mapper.h"
 #include "hermes_shm/types/bitfield.h"
 #include "hermes_shm/thread/lock.h"
@@ -218,6 +221,12 @@ struct AdapterStat {
   wrp_cte::core::TagId tag_id_; /**< tag associated with the file */
   /** Page size used for file */
   size_t page_size_;
+  /** Write-back cache for small writes; null when disabled */
+  std::shared_ptr<WriteBackCache> write_cache_;
+  /** Read-ahead prefetcher for streaming reads; null when disabled */
+  std::shared_ptr<ReadAheadCache> read_ahead_;
+  /** Inserts of pages staged in on read miss; null when disabled */
+  std::shared_ptr<StageInQueue> stage_in_;
 
   /** Default constructor */
   AdapterStat()
@@ -326,6 +335,10 @@ public:
   /** real close */
   virtual int RealClose(const File &f, AdapterStat &stat) = 0;
 
+  /** real truncate */
+  virtual int RealTruncate(const File &f, const AdapterStat &stat,
+                           size_t new_size) = 0;
+
   /** real remove */
   virtual int RealRemove(const std::string &path) = 0;
 
@@ -0,0 +1,297 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Distributed under BSD 3-Clause license.                                   *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Illinois Institute of Technology.                        *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of Hermes. The full Hermes copyright notice, including  *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the top directory. If you do not  *
+ * have access to the file, you may request a copy from help@hdfgroup.org.   *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef WRP_CTE_ADAPTER_FILESYSTEM_READ_AHEAD_CACHE_H_
+#define WRP_CTE_ADAPTER_FILESYSTEM_READ_AHEAD_CACHE_H_
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "hermes_shm/util/logging.h"
+#include "wrp_cte/core/core_client.h"
+
+namespace wrp::cae {
+
+/** Read-ahead counters of one open file */
+struct ReadAheadStats {
+  size_t hits_ = 0;    /**< Page reads served from prefetched pages */
+  size_t misses_ = 0;  /**< Page reads that went to CTE */
+  size_t issued_ = 0;  /**< Pages prefetched */
+  size_t wasted_ = 0;  /**< Prefetched pages evicted without being read */
+  size_t window_ = 0;  /**< Current prefetch depth in pages */
+};
+
+/**
+ * Client-side read-ahead for one open file
+ *
+ * Every read reports the pages it covers to OnAccess(). Two consecutive
+ * reads that continue where the previous one ended mark a sequential stream;
+ * two equal forward jumps between reads mark a strided stream. While a
+ * stream is detected, the pages the next reads are predicted to touch are
+ * fetched with Tag::AsyncGetBlob into a bounded FIFO of pooled shared memory
+ * pages. The prefetch depth doubles when a streaming read misses and shrinks
+ * when prefetched pages are evicted unread.
+ */
+class ReadAheadCache {
+public:
+  /** Matching reads required before prefetching starts */
+  static constexpr size_t kDetectThreshold = 2;
+
+private:
+  /** A prefetched page; task_ is null once the read has completed */
+  struct Entry {
+    wrp_cte::core::IoBuffer buffer_;
+    size_t size_ = 0;
+    hipc::FullPtr<wrp_cte::core::GetBlobTask> task_;
+    bool valid_ = false;
+    bool used_ = false;
+  };
+
+  wrp_cte::core::TagId tag_id_;
+  size_t page_size_;
+  size_t max_window_;
+  size_t max_pages_;
+  std::unordered_map<size_t, Entry> entries_;
+  std::deque<size_t> order_; /**< Insertion order for eviction */
+
+  // Access pattern state
+  bool has_last_;
+  size_t last_first_;
+  size_t last_last_;
+  size_t stride_;
+  size_t seq_count_;
+  size_t stride_count_;
+  size_t extent_; /**< Known file size in bytes; refreshed from CTE */
+
+  ReadAheadStats stats_;
+  std::mutex lock_;
+
+public:
+  /**
+   * @param tag_id Tag of the file
+   * @param page_size Adapter page size; one blob per page
+   * @param max_window Max pages prefetched ahead of a stream
+   * @param capacity Max bytes of prefetched pages held
+   */
+  ReadAheadCache(const wrp_cte::core::TagId &tag_id, size_t page_size,
+                 size_t max_window, size_t capacity)
+      : tag_id_(tag_id), page_size_(page_size), max_window_(max_window),
+        max_pages_(std::max<size_t>(1, capacity / page_size)),
+        has_last_(false), last_first_(0), last_last_(0), stride_(0),
+        seq_count_(0), stride_count_(0), extent_(0) {
+    stats_.window_ = std::min<size_t>(2, max_window_);
+  }
+
+  ~ReadAheadCache() { Invalidate(); }
+
+  ReadAheadCache(const ReadAheadCache &) = delete;
+  ReadAheadCache &operator=(const ReadAheadCache &) = delete;
+
+  /**
+   * Record a read of pages [first_page, last_page] and prefetch the pages
+   * the stream is predicted to read next
+   * @param skip Optional predicate for pages that must not be prefetched
+   * (e.g. pages with writes not yet in CTE)
+   */
+  void OnAccess(size_t first_page, size_t last_page,
+                const std::function<bool(size_t)> &skip = nullptr) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (has_last_) {
+      if (first_page >= last_first_ && first_page <= last_last_ + 1) {
+        ++seq_count_;
+      } else {
+        seq_count_ = 0;
+      }
+      size_t stride = first_page > last_first_ ? first_page - last_first_ : 0;
+      if (stride != 0 && stride == stride_) {
+        ++stride_count_;
+      } else {
+        stride_ = stride;
+        stride_count_ = 0;
+      }
+    }
+    has_last_ = true;
+    last_first_ = first_page;
+    last_last_ = last_page;
+
+    if (seq_count_ >= kDetectThreshold) {
+      for (size_t i = 1; i <= stats_.window_; ++i) {
+        if (!Prefetch(last_page + i, skip)) {
+          break;
+        }
+      }
+    } else if (stride_count_ >= kDetectThreshold) {
+      size_t span = last_page - first_page + 1;
+      size_t issued = 0;
+      for (size_t k = 1; issued < stats_.window_; ++k) {
+        size_t next_first = first_page + k * stride_;
+        for (size_t i = 0; i < span && issued < stats_.window_; ++i, ++issued) {
+          if (!Prefetch(next_first + i, skip)) {
+            return;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Copy [page_off, page_off + len) of a prefetched page into dst
+   * @return false on a miss; the caller must read the page from CTE
+   */
+  bool Read(size_t page_index, size_t page_off, size_t len, char *dst) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = entries_.find(page_index);
+    if (it == entries_.end() || !Complete(it->second) ||
+        page_off + len > it->second.size_) {
+      ++stats_.misses_;
+      // A streaming read that misses means the window is too shallow
+      if (seq_count_ >= kDetectThreshold ||
+          stride_count_ >= kDetectThreshold) {
+        stats_.window_ = std::min(max_window_, stats_.window_ * 2);
+      }
+      return false;
+    }
+    memcpy(dst, it->second.buffer_.data() + page_off, len);
+    it->second.used_ = true;
+    ++stats_.hits_;
+    return true;
+  }
+
+  /** Drop prefetched pages overlapping [off, off + size) (written) */
+  void Invalidate(size_t off, size_t size) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (size == 0) {
+      return;
+    }
+    // Bytes written may extend the file
+    extent_ = std::max(extent_, off + size);
+    if (entries_.empty()) {
+      return;
+    }
+    size_t first = off / page_size_;
+    size_t last = (off + size - 1) / page_size_;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->first >= first && it->first <= last) {
+        Complete(it->second);
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    order_.erase(std::remove_if(order_.begin(), order_.end(),
+                                [first, last](size_t page_index) {
+                                  return page_index >= first &&
+                                         page_index <= last;
+                                }),
+                 order_.end());
+  }
+
+  /** Drop every prefetched page */
+  void Invalidate() {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (auto &kv : entries_) {
+      Complete(kv.second);
+    }
+    entries_.clear();
+    order_.clear();
+  }
+
+  /** Drop every prefetched page; the file now ends at new_size */
+  void Truncate(size_t new_size) {
+    Invalidate();
+    std::lock_guard<std::mutex> guard(lock_);
+    extent_ = new_size;
+  }
+
+  /** Snapshot of the counters */
+  ReadAheadStats GetStats() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return stats_;
+  }
+
+private:
+  /**
+   * Wait for an entry's read if it is still in flight
+   * @return Whether the entry holds valid data
+   */
+  bool Complete(Entry &entry) {
+    if (!entry.task_.IsNull()) {
+      entry.task_->Wait();
+      entry.valid_ = (entry.task_->return_code_.load() == 0);
+      CHI_IPC->DelTask(entry.task_);
+      entry.task_.SetNull();
+    }
+    return entry.valid_;
+  }
+
+  /** Evict the oldest entry */
+  void EvictOne() {
+    while (!order_.empty()) {
+      size_t page_index = order_.front();
+      order_.pop_front();
+      auto it = entries_.find(page_index);
+      if (it == entries_.end()) {
+        continue;
+      }
+      Complete(it->second);
+      if (!it->second.used_) {
+        ++stats_.wasted_;
+        stats_.window_ = std::max<size_t>(1, stats_.window_ - 1);
+      }
+      entries_.erase(it);
+      return;
+    }
+  }
+
+  /**
+   * Start an asynchronous read of one page
+   * @return false if the page lies beyond the end of the file
+   */
+  bool Prefetch(size_t page_index, const std::function<bool(size_t)> &skip) {
+    if (entries_.count(page_index) || (skip && skip(page_index))) {
+      return true;
+    }
+    size_t page_start = page_index * page_size_;
+    if (page_start >= extent_) {
+      extent_ = WRP_CTE_CLIENT->GetTagSize(hipc::MemContext(), tag_id_);
+      if (page_start >= extent_) {
+        return false;
+      }
+    }
+    while (entries_.size() >= max_pages_ && !order_.empty()) {
+      EvictOne();
+    }
+
+    Entry entry;
+    entry.size_ = std::min(page_size_, extent_ - page_start);
+    entry.buffer_ = wrp_cte::core::IoBuffer(entry.size_);
+    if (entry.buffer_.IsNull()) {
+      return false;
+    }
+    wrp_cte::core::Tag tag(tag_id_);
+    entry.task_ = tag.AsyncGetBlob(std::to_string(page_index),
+                                   entry.buffer_.shm(), entry.size_);
+    entries_.emplace(page_index, std::move(entry));
+    order_.push_back(page_index);
+    ++stats_.issued_;
+    return true;
+  }
+};
+
+} // namespace wrp::cae
+
+#endif // WRP_CTE_ADAPTER_FILESYSTEM_READ_AHEAD_CACHE_H_
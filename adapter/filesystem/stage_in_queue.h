@@ -0,0 +1,122 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Distributed under BSD 3-Clause license.                                   *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Illinois Institute of Technology.                        *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of Hermes. The full Hermes copyright notice, including  *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the top directory. If you do not  *
+ * have access to the file, you may request a copy from help@hdfgroup.org.   *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef WRP_CTE_ADAPTER_FILESYSTEM_STAGE_IN_QUEUE_H_
+#define WRP_CTE_ADAPTER_FILESYSTEM_STAGE_IN_QUEUE_H_
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "hermes_shm/util/logging.h"
+#include "wrp_cte/core/core_client.h"
+
+namespace wrp::cae {
+
+/**
+ * Outstanding stage-in inserts of one open file
+ *
+ * When a read finds a page missing from CTE, the adapter reads the page from
+ * the backing file and hands it to Insert(), which stores it in CTE with an
+ * asynchronous PutBlob flagged kPutBlobIfAbsent: a page written through the
+ * adapter in the meantime is never replaced by the older file contents. The
+ * read does not wait for the insert; inserts are completed when too many are
+ * outstanding and on Drain() (close).
+ */
+class StageInQueue {
+public:
+  /** Outstanding inserts beyond which the oldest are reaped */
+  static constexpr size_t kMaxInFlightInserts = 64;
+
+private:
+  /** An outstanding insert; keeps its buffer alive until the task completes */
+  struct InFlightInsert {
+    size_t page_index_;
+    hipc::FullPtr<wrp_cte::core::PutBlobTask> task_;
+    wrp_cte::core::IoBuffer buffer_;
+  };
+
+  wrp_cte::core::TagId tag_id_;
+  float score_;
+  std::vector<InFlightInsert> in_flight_;
+  size_t staged_pages_; /**< Pages inserted successfully */
+  std::mutex lock_;
+
+public:
+  /**
+   * @param tag_id Tag of the file
+   * @param score Placement score of staged-in pages
+   */
+  StageInQueue(const wrp_cte::core::TagId &tag_id, float score)
+      : tag_id_(tag_id), score_(score), staged_pages_(0) {}
+
+  ~StageInQueue() { Drain(); }
+
+  StageInQueue(const StageInQueue &) = delete;
+  StageInQueue &operator=(const StageInQueue &) = delete;
+
+  /**
+   * Insert a page read from the backing file; takes ownership of the buffer
+   * @param size Bytes of the page held in buffer
+   */
+  void Insert(size_t page_index, wrp_cte::core::IoBuffer &&buffer,
+              size_t size) {
+    std::lock_guard<std::mutex> guard(lock_);
+    InFlightInsert insert;
+    insert.page_index_ = page_index;
+    insert.task_ = WRP_CTE_CLIENT->AsyncPutBlob(
+        hipc::MemContext(), tag_id_, std::to_string(page_index), 0, size,
+        buffer.shm(), score_, wrp_cte::core::kPutBlobIfAbsent);
+    insert.buffer_ = std::move(buffer);
+    in_flight_.emplace_back(std::move(insert));
+
+    if (in_flight_.size() > kMaxInFlightInserts) {
+      size_t count = in_flight_.size() / 2;
+      for (size_t i = 0; i < count; ++i) {
+        Complete(in_flight_[i]);
+      }
+      in_flight_.erase(in_flight_.begin(), in_flight_.begin() + count);
+    }
+  }
+
+  /** Wait for every outstanding insert */
+  void Drain() {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (auto &insert : in_flight_) {
+      Complete(insert);
+    }
+    in_flight_.clear();
+  }
+
+  /** Pages inserted successfully so far */
+  size_t GetStagedPages() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return staged_pages_;
+  }
+
+private:
+  /** Wait for one insert; a failed insert only costs a later miss */
+  void Complete(InFlightInsert &insert) {
+    insert.task_->Wait();
+    if (insert.task_->return_code_.load() == 0) {
+      ++staged_pages_;
+    } else {
+      HILOG(kDebug, "Stage-in of page {} failed with code {}",
+            insert.page_index_, insert.task_->return_code_.load());
+    }
+    CHI_IPC->DelTask(insert.task_);
+  }
+};
+
+} // namespace wrp::cae
+
+#endif // WRP_CTE_ADAPTER_FILESYSTEM_STAGE_IN_QUEUE_H_
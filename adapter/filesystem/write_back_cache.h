@@ -0,0 +1,318 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Distributed under BSD 3-Clause license.                                   *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Illinois Institute of Technology.                        *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of Hermes. The full Hermes copyright notice, including  *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the top directory. If you do not  *
+ * have access to the file, you may request a copy from help@hdfgroup.org.   *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef WRP_CTE_ADAPTER_FILESYSTEM_WRITE_BACK_CACHE_H_
+#define WRP_CTE_ADAPTER_FILESYSTEM_WRITE_BACK_CACHE_H_
+
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hermes_shm/util/logging.h"
+#include "wrp_cte/core/core_client.h"
+
+namespace wrp::cae {
+
+/**
+ * Client-side write-back cache for one open file
+ *
+ * Writes smaller than a page are collected into page-sized shared memory
+ * buffers, remembering which byte ranges of each page are dirty. A page is
+ * sent to CTE with Tag::AsyncPutBlob as soon as it is completely dirty; other
+ * pages are sent on Flush() (fsync/close) or when the dirty bytes exceed the
+ * configured capacity. At most one put per page is in flight, so a later
+ * write to a page is never overtaken by an earlier one.
+ */
+class WriteBackCache {
+public:
+  /** Outstanding puts beyond which the oldest are reaped */
+  static constexpr size_t kMaxInFlightPuts = 64;
+
+private:
+  /** Dirty contents of one page; ranges_ are disjoint, sorted [start, end) */
+  struct DirtyPage {
+    wrp_cte::core::IoBuffer buffer_;
+    std::vector<std::pair<size_t, size_t>> ranges_;
+    size_t dirty_bytes_ = 0;
+  };
+
+  /** An outstanding put; keeps its buffer alive until the task completes */
+  struct InFlightPut {
+    size_t page_index_;
+    hipc::FullPtr<wrp_cte::core::PutBlobTask> task_;
+    wrp_cte::core::IoBuffer buffer_;
+  };
+
+  wrp_cte::core::TagId tag_id_;
+  size_t page_size_;
+  size_t capacity_;
+  std::map<size_t, DirtyPage> pages_;
+  std::vector<InFlightPut> in_flight_;
+  size_t dirty_bytes_;
+  bool failed_; /**< A put failed since the last Flush() */
+  std::mutex lock_;
+
+public:
+  /**
+   * @param tag_id Tag of the file
+   * @param page_size Adapter page size; one blob per page
+   * @param capacity Max dirty bytes held before pages are flushed
+   */
+  WriteBackCache(const wrp_cte::core::TagId &tag_id, size_t page_size,
+                 size_t capacity)
+      : tag_id_(tag_id), page_size_(page_size), capacity_(capacity),
+        dirty_bytes_(0), failed_(false) {}
+
+  /** Outstanding puts are waited for; dirty pages must be flushed first */
+  ~WriteBackCache() {
+    std::lock_guard<std::mutex> guard(lock_);
+    WaitAll();
+  }
+
+  WriteBackCache(const WriteBackCache &) = delete;
+  WriteBackCache &operator=(const WriteBackCache &) = delete;
+
+  /** Whether a write of size bytes should be buffered */
+  bool Accepts(size_t size) const { return size > 0 && size < page_size_; }
+
+  /**
+   * Buffer a write of [off, off + size). Pieces that cannot get a staging
+   * buffer are written through synchronously; their failures are reported by
+   * the next Flush().
+   */
+  void Write(size_t off, const char *data, size_t size) {
+    std::lock_guard<std::mutex> guard(lock_);
+    size_t done = 0;
+    while (done < size) {
+      size_t page_index = (off + done) / page_size_;
+      size_t page_off = (off + done) % page_size_;
+      size_t len = std::min(page_size_ - page_off, size - done);
+
+      auto it = pages_.find(page_index);
+      if (it == pages_.end()) {
+        DirtyPage page;
+        page.buffer_ = wrp_cte::core::IoBuffer(page_size_);
+        if (page.buffer_.IsNull()) {
+          WriteThrough(page_index, page_off, data + done, len);
+          done += len;
+          continue;
+        }
+        it = pages_.emplace(page_index, std::move(page)).first;
+      }
+      DirtyPage &page = it->second;
+      memcpy(page.buffer_.data() + page_off, data + done, len);
+      dirty_bytes_ -= page.dirty_bytes_;
+      MarkDirty(page, page_off, page_off + len);
+      dirty_bytes_ += page.dirty_bytes_;
+
+      // A fully dirty page goes out immediately
+      if (page.dirty_bytes_ == page_size_) {
+        FlushPage(it);
+        ReapInFlight();
+      }
+      done += len;
+    }
+
+    // Memory pressure: flush oldest pages until half the capacity is free
+    if (dirty_bytes_ > capacity_) {
+      while (!pages_.empty() && dirty_bytes_ > capacity_ / 2) {
+        FlushPage(pages_.begin());
+      }
+    }
+  }
+
+  /**
+   * Send every dirty page and wait for all outstanding puts
+   * @return false if any put since the last Flush() failed
+   */
+  bool Flush() {
+    std::lock_guard<std::mutex> guard(lock_);
+    while (!pages_.empty()) {
+      FlushPage(pages_.begin());
+    }
+    WaitAll();
+    bool ok = !failed_;
+    failed_ = false;
+    return ok;
+  }
+
+  /**
+   * Make [off, off + size) visible in CTE before a read or an uncached write
+   * of that range: its dirty pages are sent and outstanding puts waited for.
+   * Failures are reported by the next Flush().
+   */
+  void FlushRange(size_t off, size_t size) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (size == 0 || (pages_.empty() && in_flight_.empty())) {
+      return;
+    }
+    size_t first = off / page_size_;
+    size_t last = (off + size - 1) / page_size_;
+    auto it = pages_.lower_bound(first);
+    while (it != pages_.end() && it->first <= last) {
+      it = FlushPage(it);
+    }
+    WaitAll();
+  }
+
+  /** Drop all dirty data without writing it (the file was removed) */
+  void Discard() {
+    std::lock_guard<std::mutex> guard(lock_);
+    WaitAll();
+    pages_.clear();
+    dirty_bytes_ = 0;
+    failed_ = false;
+  }
+
+  /** Whether a page has buffered or in-flight data not yet in CTE */
+  bool IsDirty(size_t page_index) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (pages_.count(page_index)) {
+      return true;
+    }
+    for (const auto &put : in_flight_) {
+      if (put.page_index_ == page_index) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** Bytes currently buffered and not yet sent */
+  size_t GetDirtyBytes() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return dirty_bytes_;
+  }
+
+private:
+  /** Write one piece synchronously, after any put of its page completes */
+  void WriteThrough(size_t page_index, size_t page_off, const char *data,
+                    size_t len) {
+    WaitPage(page_index);
+    try {
+      wrp_cte::core::Tag tag(tag_id_);
+      tag.PutBlob(std::to_string(page_index), data, len, page_off);
+    } catch (const std::exception &e) {
+      HELOG(kError, "Write-through of page {} failed: {}", page_index,
+            e.what());
+      failed_ = true;
+    }
+  }
+
+  /** Add [start, end) to the page's dirty ranges, merging neighbors */
+  static void MarkDirty(DirtyPage &page, size_t start, size_t end) {
+    auto &ranges = page.ranges_;
+    auto it = ranges.begin();
+    while (it != ranges.end() && it->second < start) {
+      ++it;
+    }
+    auto merge_end = it;
+    while (merge_end != ranges.end() && merge_end->first <= end) {
+      start = std::min(start, merge_end->first);
+      end = std::max(end, merge_end->second);
+      ++merge_end;
+    }
+    it = ranges.erase(it, merge_end);
+    ranges.insert(it, {start, end});
+
+    page.dirty_bytes_ = 0;
+    for (const auto &range : ranges) {
+      page.dirty_bytes_ += range.second - range.first;
+    }
+  }
+
+  /** Wait for the outstanding puts of one page, if any */
+  void WaitPage(size_t page_index) {
+    auto it = in_flight_.begin();
+    while (it != in_flight_.end()) {
+      if (it->page_index_ == page_index) {
+        Complete(*it);
+        it = in_flight_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  /** Complete the oldest half of the puts once too many are outstanding */
+  void ReapInFlight() {
+    if (in_flight_.size() <= kMaxInFlightPuts) {
+      return;
+    }
+    size_t count = in_flight_.size() / 2;
+    for (size_t i = 0; i < count; ++i) {
+      Complete(in_flight_[i]);
+    }
+    in_flight_.erase(in_flight_.begin(), in_flight_.begin() + count);
+  }
+
+  /** Wait for every outstanding put */
+  void WaitAll() {
+    for (auto &put : in_flight_) {
+      Complete(put);
+    }
+    in_flight_.clear();
+  }
+
+  /** Wait for one put and record whether it failed */
+  void Complete(InFlightPut &put) {
+    put.task_->Wait();
+    if (put.task_->return_code_.load() != 0) {
+      HELOG(kError, "Write-back of page {} failed with code {}",
+            put.page_index_, put.task_->return_code_.load());
+      failed_ = true;
+    }
+    CHI_IPC->DelTask(put.task_);
+  }
+
+  /**
+   * Send one dirty page, one put per dirty range. Ranges are sent one after
+   * another: every range but the last is waited for before the next is sent,
+   * and only the last stays in flight, so a page never has more than one put
+   * outstanding. Gaps between ranges are never written, since the buffer holds
+   * no data for them.
+   * @return Iterator past the flushed page
+   */
+  std::map<size_t, DirtyPage>::iterator
+  FlushPage(std::map<size_t, DirtyPage>::iterator it) {
+    size_t page_index = it->first;
+    DirtyPage &page = it->second;
+    WaitPage(page_index);
+
+    wrp_cte::core::Tag tag(tag_id_);
+    std::string blob_name = std::to_string(page_index);
+    size_t num_ranges = page.ranges_.size();
+    for (size_t i = 0; i < num_ranges; ++i) {
+      const auto &range = page.ranges_[i];
+      InFlightPut put;
+      put.page_index_ = page_index;
+      put.task_ = tag.AsyncPutBlob(blob_name, page.buffer_.shm() + range.first,
+                                   range.second - range.first, range.first);
+      if (i + 1 < num_ranges) {
+        Complete(put);
+        continue;
+      }
+      // The last put owns the buffer until it completes
+      put.buffer_ = std::move(page.buffer_);
+      in_flight_.emplace_back(std::move(put));
+    }
+    dirty_bytes_ -= page.dirty_bytes_;
+    return pages_.erase(it);
+  }
+};
+
+} // namespace wrp::cae
+
+#endif // WRP_CTE_ADAPTER_FILESYSTEM_WRITE_BACK_CACHE_H_
@@ -571,6 +571,13 @@ public:
     return real_api_->MPI_File_close(&stat.mpi_fh_);
   }
 
+  /** Truncate \a file FILE f to \a new_size bytes */
+  int RealTruncate(const File &f, const AdapterStat &stat,
+                   size_t new_size) override {
+    (void)f;
+    return MPI_File_set_size(stat.mpi_fh_, static_cast<MPI_Offset>(new_size));
+  }
+
   /**
    * Called before RealClose. Releases information provisioned during
    * the allocation phase.
@@ -175,6 +175,16 @@ public:
     return real_api_->close(stat.fd_);
   }
 
+  /** Truncate \a file FILE f to \a new_size bytes */
+  int RealTruncate(const File &f, const AdapterStat &stat,
+                   size_t new_size) override {
+    (void)f;
+    if (stat.adapter_mode_ == AdapterMode::kScratch && stat.fd_ == -1) {
+      return 0;
+    }
+    return real_api_->ftruncate(stat.fd_, static_cast<off_t>(new_size));
+  }
+
   /**
    * Called before RealClose. Releases information provisioned during
    * the allocation phase.
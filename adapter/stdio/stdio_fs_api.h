@@ -172,6 +172,17 @@ public:
     return real_api_->fclose(stat.fh_);
   }
 
+  /** Truncate \a file FILE f to \a new_size bytes */
+  int RealTruncate(const File &f, const AdapterStat &stat,
+                   size_t new_size) override {
+    (void)f;
+    if (stat.adapter_mode_ == AdapterMode::kScratch && stat.fh_ == nullptr) {
+      return 0;
+    }
+    real_api_->fflush(stat.fh_);
+    return ftruncate(fileno(stat.fh_), static_cast<off_t>(new_size));
+  }
+
   /**
    * Called before RealClose. Releases information provisioned during
    * the allocation phase.
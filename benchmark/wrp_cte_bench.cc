@@ -15,14 +15,17 @@
  *
  * This benchmark measures the performance of Put, Get, and GetTagSize
  * operations in the Content Transfer Engine (CTE) with MPI support for parallel
- * I/O.
+ * I/O. The TagScan case measures listing and deleting a small tag while the
+ * node holds io_count unrelated blobs, to show how tag-level metadata
+ * operations scale with the total blob count. After every case the share of
+ * blocks placed on the writer's own node versus neighbor nodes is reported.
  *
  * Usage:
  *   mpirun -n <num_procs> wrp_cte_bench <test_case> <depth> <io_size>
  * <io_count>
  *
  * Parameters:
- *   test_case: Benchmark to conduct (Put, Get, PutGet)
+ *   test_case: Benchmark to conduct (Put, Get, PutGet, TagScan)
  *   depth: Number of async requests to generate
  *   io_size: Size of I/O operations in bytes (supports k/K, m/M, g/G suffixes)
  *   io_count: Number of I/O operations to generate per node
@@ -173,14 +176,20 @@ public:
       RunGetBenchmark();
     } else if (test_case_ == "PutGet") {
       RunPutGetBenchmark();
+    } else if (test_case_ == "TagScan") {
+      RunTagScanBenchmark();
     } else {
       if (rank_ == 0) {
         std::cerr << "Error: Unknown test case: " << test_case_ << std::endl;
-        std::cerr << "Valid options: Put, Get, PutGet" << std::endl;
+        std::cerr << "Valid options: Put, Get, PutGet, TagScan" << std::endl;
       }
     }
 
     MPI_Barrier(MPI_COMM_WORLD);
+
+    if (rank_ == 0) {
+      PrintPlacement();
+    }
   }
 
 private:
@@ -348,6 +357,107 @@ private:
     PrintResults("PutGet", duration_ms);
   }
 
+  /**
+   * Populate io_count background blobs, then time GetContainedBlobs and DelTag
+   * on a small probe tag. With a per-tag index both should stay flat as
+   * io_count grows.
+   */
+  void RunTagScanBenchmark() {
+    constexpr int kProbeBlobs = 16;
+    constexpr int kProbeIters = 100;
+
+    auto shm_buffer = CHI_IPC->AllocateBuffer(io_size_);
+    std::memset(shm_buffer.ptr_, rank_ & 0xFF, io_size_);
+    hipc::Pointer shm_ptr = shm_buffer.shm_;
+
+    if (rank_ == 0) {
+      std::cout << "Populating " << io_count_
+                << " background blobs per rank..." << std::endl;
+    }
+
+    // Background blobs live in a separate tag and are never listed
+    wrp_cte::core::Tag bg_tag("tagscan_bg_r" + std::to_string(rank_));
+    for (int i = 0; i < io_count_; i += depth_) {
+      int batch_size = std::min(depth_, io_count_ - i);
+      std::vector<hipc::FullPtr<wrp_cte::core::PutBlobTask>> tasks;
+      tasks.reserve(batch_size);
+      for (int j = 0; j < batch_size; ++j) {
+        std::string blob_name = "blob_" + std::to_string(i + j);
+        tasks.push_back(
+            bg_tag.AsyncPutBlob(blob_name, shm_ptr, io_size_, 0, 0.8f));
+      }
+      for (auto &task : tasks) {
+        task->Wait();
+        CHI_IPC->DelTask(task);
+      }
+    }
+
+    std::string probe_name = "tagscan_probe_r" + std::to_string(rank_);
+    wrp_cte::core::Tag probe_tag(probe_name);
+    for (int i = 0; i < kProbeBlobs; ++i) {
+      probe_tag.PutBlob("blob_" + std::to_string(i), shm_ptr, io_size_);
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // Time repeated listings of the probe tag
+    auto start_time = high_resolution_clock::now();
+    size_t listed = 0;
+    for (int i = 0; i < kProbeIters; ++i) {
+      listed = probe_tag.GetContainedBlobs().size();
+    }
+    auto end_time = high_resolution_clock::now();
+    double list_us =
+        duration_cast<microseconds>(end_time - start_time).count() /
+        static_cast<double>(kProbeIters);
+
+    // Time deleting the probe tag
+    start_time = high_resolution_clock::now();
+    WRP_CTE_CLIENT->DelTag(hipc::MemContext(), probe_name);
+    end_time = high_resolution_clock::now();
+    double del_us =
+        static_cast<double>(
+            duration_cast<microseconds>(end_time - start_time).count());
+
+    PrintLatency("GetContainedBlobs", list_us);
+    PrintLatency("DelTag", del_us);
+    if (rank_ == 0) {
+      std::cout << "Probe blobs listed: " << listed << " / " << kProbeBlobs
+                << ", background blobs per rank: " << io_count_ << std::endl;
+    }
+
+    WRP_CTE_CLIENT->DelTag(hipc::MemContext(), bg_tag.GetTagId());
+    CHI_IPC->FreeBuffer(shm_buffer);
+  }
+
+  void PrintLatency(const std::string &operation, double latency_us) {
+    std::vector<double> all_latencies;
+    if (rank_ == 0) {
+      all_latencies.resize(size_);
+    }
+
+    MPI_Gather(&latency_us, 1, MPI_DOUBLE, all_latencies.data(), 1, MPI_DOUBLE,
+               0, MPI_COMM_WORLD);
+
+    if (rank_ == 0) {
+      double min_lat =
+          *std::min_element(all_latencies.begin(), all_latencies.end());
+      double max_lat =
+          *std::max_element(all_latencies.begin(), all_latencies.end());
+      double sum_lat = 0.0;
+      for (auto l : all_latencies) {
+        sum_lat += l;
+      }
+
+      std::cout << std::endl;
+      std::cout << "=== " << operation << " Latency ===" << std::endl;
+      std::cout << "Latency (min): " << min_lat << " us" << std::endl;
+      std::cout << "Latency (max): " << max_lat << " us" << std::endl;
+      std::cout << "Latency (avg): " << sum_lat / size_ << " us" << std::endl;
+      std::cout << "===========================" << std::endl;
+    }
+  }
+
   void PrintResults(const std::string &operation, long long duration_ms) {
     // Gather timing results from all ranks
     std::vector<long long> all_times;
@@ -395,6 +505,36 @@ private:
     }
   }
 
+  /**
+   * Report how many blocks were placed on targets local to the allocating
+   * container versus targets on neighbor nodes, summed over all containers
+   */
+  void PrintPlacement() {
+    wrp_cte::core::RuntimeStatsReport report =
+        WRP_CTE_CLIENT->GetRuntimeStats(hipc::MemContext());
+    chi::u64 local_blocks = 0;
+    chi::u64 remote_blocks = 0;
+    for (const auto &target : report.targets_) {
+      if (target.is_local_) {
+        local_blocks += target.blocks_allocated_;
+      } else {
+        remote_blocks += target.blocks_allocated_;
+      }
+    }
+    chi::u64 total_blocks = local_blocks + remote_blocks;
+    double local_pct =
+        total_blocks == 0
+            ? 0.0
+            : 100.0 * static_cast<double>(local_blocks) / total_blocks;
+
+    std::cout << std::endl;
+    std::cout << "=== Block Placement ===" << std::endl;
+    std::cout << "Local blocks: " << local_blocks << std::endl;
+    std::cout << "Remote blocks: " << remote_blocks << std::endl;
+    std::cout << "Local ratio: " << local_pct << " %" << std::endl;
+    std::cout << "===========================" << std::endl;
+  }
+
   int rank_;
   int size_;
   std::string test_case_;
@@ -416,7 +556,7 @@ int main(int argc, char **argv) {
     if (rank == 0) {
       std::cerr << "Usage: " << argv[0]
                 << " <test_case> <depth> <io_size> <io_count>" << std::endl;
-      std::cerr << "  test_case: Put, Get, or PutGet" << std::endl;
+      std::cerr << "  test_case: Put, Get, PutGet, or TagScan" << std::endl;
       std::cerr << "  depth: Number of async requests (e.g., 4)" << std::endl;
       std::cerr << "  io_size: Size of I/O operations (e.g., 1m, 4k, 1g)"
                 << std::endl;
@@ -0,0 +1,227 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Distributed under BSD 3-Clause license.                                   *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Illinois Institute of Technology.                        *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of Hermes. The full Hermes copyright notice, including  *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the top directory. If you do not  *
+ * have access to the file, you may request a copy from help@hdfgroup.org.   *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**
+ * CTE Data Placement Engine Benchmark
+ *
+ * Compares the placement engines offline, without a runtime: a simulated
+ * four-tier node (RAM, NVMe, SSD, HDD) is filled with a mix of small and
+ * large blobs, each placed with the engine under test and allocated the way
+ * the runtime does (fill the first offered target, spill to the next). For
+ * each engine it reports the mean SelectTargets time, the blobs that could
+ * not be placed, and the fill level of every tier after each quarter of the
+ * workload, which shows whether a fast tier fills up gradually or takes all
+ * traffic until it is exhausted.
+ *
+ * Usage:
+ *   wrp_cte_dpe_bench [num_blobs] [large_fraction]
+ *
+ * Parameters:
+ *   num_blobs: Blobs to place per engine (default: 20000)
+ *   large_fraction: Fraction of blobs that are large, 0-1 (default: 0.1)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <wrp_cte/core/core_dpe.h>
+
+using namespace std::chrono;
+using wrp_cte::core::DataPlacementEngine;
+using wrp_cte::core::DpeConfig;
+using wrp_cte::core::DpeFactory;
+using wrp_cte::core::DpeType;
+using wrp_cte::core::DpeTypeToString;
+using wrp_cte::core::TargetDesc;
+
+namespace {
+
+constexpr chi::u64 kSmallBlob = 64 * 1024;
+constexpr chi::u64 kLargeBlob = 16 * 1024 * 1024;
+constexpr size_t kCheckpoints = 4;
+
+/** One simulated tier */
+struct Tier {
+  const char *name_;
+  float score_;
+  double bandwidth_mbps_;
+  double latency_us_;
+  chi::u64 capacity_divisor_; // Capacity is the workload size divided by this
+};
+
+// Together the tiers hold almost twice the workload, so every engine can
+// place everything and only the distribution differs
+const Tier kTiers[] = {
+    {"ram", 1.0f, 10000.0, 1.0, 8},
+    {"nvme", 0.75f, 3000.0, 20.0, 4},
+    {"ssd", 0.5f, 500.0, 100.0, 2},
+    {"hdd", 0.25f, 150.0, 5000.0, 1},
+};
+constexpr size_t kNumTiers = sizeof(kTiers) / sizeof(kTiers[0]);
+
+/** Build the target list; target i + 1 is tier i */
+std::vector<TargetDesc> MakeTargets(chi::u64 workload_bytes) {
+  std::vector<TargetDesc> targets;
+  for (size_t i = 0; i < kNumTiers; ++i) {
+    TargetDesc desc;
+    desc.target_id_ = chi::PoolId(static_cast<chi::u32>(i + 1), 0);
+    desc.target_score_ = kTiers[i].score_;
+    desc.write_bandwidth_mbps_ = kTiers[i].bandwidth_mbps_;
+    desc.avg_latency_us_ = kTiers[i].latency_us_;
+    desc.total_space_ = workload_bytes / kTiers[i].capacity_divisor_;
+    desc.remaining_space_ = desc.total_space_;
+    desc.is_local_ = true;
+    targets.push_back(desc);
+  }
+  return targets;
+}
+
+/** Blob sizes and scores, identical for every engine */
+struct Workload {
+  std::vector<chi::u64> sizes_;
+  std::vector<float> scores_;
+  chi::u64 total_bytes_ = 0;
+};
+
+Workload MakeWorkload(size_t num_blobs, double large_fraction) {
+  Workload workload;
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> coin(0.0, 1.0);
+  for (size_t i = 0; i < num_blobs; ++i) {
+    chi::u64 size = coin(rng) < large_fraction ? kLargeBlob : kSmallBlob;
+    workload.sizes_.push_back(size);
+    workload.scores_.push_back(static_cast<float>(coin(rng)));
+    workload.total_bytes_ += size;
+  }
+  return workload;
+}
+
+/** Results of one engine */
+struct RunResult {
+  double mean_select_ns_ = 0.0;
+  size_t failed_blobs_ = 0;
+  // Fill fraction of each tier after each quarter of the workload
+  std::vector<std::vector<double>> fill_;
+};
+
+RunResult RunEngine(DpeType type, const Workload &workload) {
+  RunResult result;
+  std::vector<TargetDesc> targets = MakeTargets(workload.total_bytes_);
+  auto dpe = DpeFactory::CreateDpe(type, DpeConfig());
+  std::vector<chi::PoolId> ordered;
+  double select_ns = 0.0;
+  size_t num_blobs = workload.sizes_.size();
+
+  for (size_t i = 0; i < num_blobs; ++i) {
+    chi::u64 remaining = workload.sizes_[i];
+
+    auto start = high_resolution_clock::now();
+    dpe->SelectTargets(targets, workload.scores_[i], remaining, ordered);
+    select_ns += static_cast<double>(
+        duration_cast<nanoseconds>(high_resolution_clock::now() - start)
+            .count());
+
+    // Allocate like AllocateNewData: as much as fits on each target in order
+    for (const chi::PoolId &target_id : ordered) {
+      if (remaining == 0) {
+        break;
+      }
+      TargetDesc &target = targets[target_id.major_ - 1];
+      chi::u64 take = std::min(remaining, target.remaining_space_);
+      target.remaining_space_ -= take;
+      remaining -= take;
+    }
+    if (remaining > 0) {
+      ++result.failed_blobs_;
+    }
+
+    if ((i + 1) % (num_blobs / kCheckpoints) == 0 &&
+        result.fill_.size() < kCheckpoints) {
+      std::vector<double> fill;
+      for (const auto &target : targets) {
+        fill.push_back(1.0 - static_cast<double>(target.remaining_space_) /
+                                 static_cast<double>(target.total_space_));
+      }
+      result.fill_.push_back(fill);
+    }
+  }
+
+  result.mean_select_ns_ = num_blobs > 0 ? select_ns / num_blobs : 0.0;
+  return result;
+}
+
+void PrintResult(DpeType type, const RunResult &result) {
+  std::cout << std::endl;
+  std::cout << "=== " << DpeTypeToString(type) << " ===" << std::endl;
+  std::cout << "SelectTargets (mean): " << std::fixed << std::setprecision(1)
+            << result.mean_select_ns_ << " ns" << std::endl;
+  std::cout << "Blobs not placed: " << result.failed_blobs_ << std::endl;
+  std::cout << "Tier fill (%) after each quarter of the workload:"
+            << std::endl;
+  std::cout << "  " << std::setw(6) << "tier";
+  for (size_t q = 0; q < result.fill_.size(); ++q) {
+    std::cout << std::setw(8) << ((q + 1) * 25) << "%";
+  }
+  std::cout << std::endl;
+  for (size_t t = 0; t < kNumTiers; ++t) {
+    std::cout << "  " << std::setw(6) << kTiers[t].name_;
+    for (const auto &fill : result.fill_) {
+      std::cout << std::setw(9) << std::setprecision(1) << fill[t] * 100.0;
+    }
+    std::cout << std::endl;
+  }
+  std::cout << "===========================" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  size_t num_blobs = 20000;
+  double large_fraction = 0.1;
+  if (argc > 1) {
+    num_blobs = std::strtoull(argv[1], nullptr, 10);
+  }
+  if (argc > 2) {
+    large_fraction = std::strtod(argv[2], nullptr);
+  }
+  if (num_blobs < kCheckpoints || large_fraction < 0.0 ||
+      large_fraction > 1.0) {
+    std::cerr << "Usage: " << argv[0] << " [num_blobs] [large_fraction]"
+              << std::endl;
+    std::cerr << "  num_blobs: Blobs to place per engine (at least "
+              << kCheckpoints << ")" << std::endl;
+    std::cerr << "  large_fraction: Fraction of large blobs (0-1)"
+              << std::endl;
+    return 1;
+  }
+
+  Workload workload = MakeWorkload(num_blobs, large_fraction);
+  std::cout << "=== CTE DPE Benchmark ===" << std::endl;
+  std::cout << "Blobs: " << num_blobs << " (" << large_fraction * 100.0
+            << "% of " << kLargeBlob / (1024 * 1024) << " MB, rest "
+            << kSmallBlob / 1024 << " KB)" << std::endl;
+  std::cout << "Workload: " << workload.total_bytes_ / (1024 * 1024) << " MB"
+            << std::endl;
+  std::cout << "===========================" << std::endl;
+
+  for (DpeType type : {DpeType::kRandom, DpeType::kRoundRobin, DpeType::kMaxBW,
+                       DpeType::kWeighted}) {
+    PrintResult(type, RunEngine(type, workload));
+  }
+  return 0;
+}
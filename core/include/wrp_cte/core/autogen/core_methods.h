@@ -32,6 +32,17 @@ GLOBAL_CONST chi::u32 kGetBlobSize = 23;
 GLOBAL_CONST chi::u32 kGetContainedBlobs = 24;
 GLOBAL_CONST chi::u32 kTagQuery = 30;
 GLOBAL_CONST chi::u32 kBlobQuery = 31;
+GLOBAL_CONST chi::u32 kReorganizeTiers = 32;
+GLOBAL_CONST chi::u32 kEnforceWatermarks = 33;
+GLOBAL_CONST chi::u32 kGetRuntimeStats = 34;
+GLOBAL_CONST chi::u32 kPutBlobs = 35;
+GLOBAL_CONST chi::u32 kGetBlobs = 36;
+GLOBAL_CONST chi::u32 kStageIn = 37;
+GLOBAL_CONST chi::u32 kFlushTag = 38;
+GLOBAL_CONST chi::u32 kTruncateBlob = 39;
+GLOBAL_CONST chi::u32 kTruncateTag = 40;
+GLOBAL_CONST chi::u32 kAppendToTag = 41;
+GLOBAL_CONST chi::u32 kRebalanceBlobs = 42;
 }  // namespace Method
 
 }  // namespace wrp_cte::core
@@ -3,10 +3,18 @@
 
 #include <chimaera/chimaera.h>
 #include <hermes_shm/util/singleton.h>
+#include <wrp_cte/core/core_query.h>
+#include <wrp_cte/core/core_staging.h>
 #include <wrp_cte/core/core_tasks.h>
 
 namespace wrp_cte::core {
 
+/** One BlobQuery match with its metadata */
+struct BlobQueryResult {
+  std::string blob_name_;
+  BlobQueryStat stat_;
+};
+
 class Client : public chi::ContainerClient {
 public:
   Client() = default;
@@ -61,8 +69,10 @@ public:
                           chimaera::bdev::BdevType bdev_type,
                           chi::u64 total_size,
                           const chi::PoolQuery &target_query = chi::PoolQuery::Local(),
-                          const chi::PoolId &bdev_id = chi::PoolId::GetNull()) {
-    auto task = AsyncRegisterTarget(mctx, target_name, bdev_type, total_size, target_query, bdev_id);
+                          const chi::PoolId &bdev_id = chi::PoolId::GetNull(),
+                          chi::u32 target_node = kLocalTargetNode) {
+    auto task = AsyncRegisterTarget(mctx, target_name, bdev_type, total_size,
+                                    target_query, bdev_id, target_node);
     task->Wait();
     chi::u32 result = task->return_code_.load();
     CHI_IPC->DelTask(task);
@@ -77,13 +87,14 @@ public:
                       const std::string &target_name,
                       chimaera::bdev::BdevType bdev_type, chi::u64 total_size,
                       const chi::PoolQuery &target_query = chi::PoolQuery::Local(),
-                      const chi::PoolId &bdev_id = chi::PoolId::GetNull()) {
+                      const chi::PoolId &bdev_id = chi::PoolId::GetNull(),
+                      chi::u32 target_node = kLocalTargetNode) {
     (void)mctx; // Suppress unused parameter warning
     auto *ipc_manager = CHI_IPC;
 
     auto task = ipc_manager->NewTask<RegisterTargetTask>(
         chi::CreateTaskId(), pool_id_, chi::PoolQuery::Dynamic(), target_name,
-        bdev_type, total_size, target_query, bdev_id);
+        bdev_type, total_size, target_query, bdev_id, target_node);
 
     ipc_manager->Enqueue(task);
     return task;
@@ -163,14 +174,17 @@ public:
 
   /**
    * Asynchronous target stats update - returns immediately
+   * @param pool_query Pool query for routing (default: Dynamic, which runs
+   * on the local container)
    */
   hipc::FullPtr<StatTargetsTask>
-  AsyncStatTargets(const hipc::MemContext &mctx) {
+  AsyncStatTargets(const hipc::MemContext &mctx,
+                   const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     (void)mctx; // Suppress unused parameter warning
     auto *ipc_manager = CHI_IPC;
 
     auto task = ipc_manager->NewTask<StatTargetsTask>(
-        chi::CreateTaskId(), pool_id_, chi::PoolQuery::Dynamic());
+        chi::CreateTaskId(), pool_id_, pool_query);
 
     ipc_manager->Enqueue(task);
     return task;
@@ -192,16 +206,18 @@ public:
 
   /**
    * Asynchronous get or create tag - returns immediately
+   * @param pool_query Routing; the default resolves the name on its owner
    */
   hipc::FullPtr<GetOrCreateTagTask<CreateParams>>
   AsyncGetOrCreateTag(const hipc::MemContext &mctx, const std::string &tag_name,
-                      const TagId &tag_id = TagId::GetNull()) {
+                      const TagId &tag_id = TagId::GetNull(),
+                      const chi::PoolQuery &pool_query =
+                          chi::PoolQuery::Dynamic()) {
     (void)mctx; // Suppress unused parameter warning
     auto *ipc_manager = CHI_IPC;
 
     auto task = ipc_manager->NewTask<GetOrCreateTagTask<CreateParams>>(
-        chi::CreateTaskId(), pool_id_, chi::PoolQuery::Dynamic(), tag_name,
-        tag_id);
+        chi::CreateTaskId(), pool_id_, pool_query, tag_name, tag_id);
 
     ipc_manager->Enqueue(task);
     return task;
@@ -230,13 +246,14 @@ public:
   hipc::FullPtr<PutBlobTask>
   AsyncPutBlob(const hipc::MemContext &mctx, const TagId &tag_id,
                const std::string &blob_name, chi::u64 offset, chi::u64 size,
-               hipc::Pointer blob_data, float score, chi::u32 flags) {
+               hipc::Pointer blob_data, float score, chi::u32 flags,
+               const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     (void)mctx; // Suppress unused parameter warning
     auto *ipc_manager = CHI_IPC;
 
     auto task = ipc_manager->NewTask<PutBlobTask>(
-        chi::CreateTaskId(), pool_id_, chi::PoolQuery::Dynamic(), tag_id,
-        blob_name, offset, size, blob_data, score, flags);
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, blob_name, offset,
+        size, blob_data, score, flags);
 
     ipc_manager->Enqueue(task);
     return task;
@@ -262,13 +279,98 @@ public:
   hipc::FullPtr<GetBlobTask>
   AsyncGetBlob(const hipc::MemContext &mctx, const TagId &tag_id,
                const std::string &blob_name, chi::u64 offset, chi::u64 size,
-               chi::u32 flags, hipc::Pointer blob_data) {
+               chi::u32 flags, hipc::Pointer blob_data,
+               const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     (void)mctx; // Suppress unused parameter warning
     auto *ipc_manager = CHI_IPC;
 
     auto task = ipc_manager->NewTask<GetBlobTask>(
-        chi::CreateTaskId(), pool_id_, chi::PoolQuery::Dynamic(), tag_id,
-        blob_name, offset, size, flags, blob_data);
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, blob_name, offset,
+        size, flags, blob_data);
+
+    ipc_manager->Enqueue(task);
+    return task;
+  }
+
+  /**
+   * Synchronous put of many blobs of one tag - waits for completion
+   * @param mctx Memory context
+   * @param tag_id Tag the blobs belong to
+   * @param requests Blobs to store; return_code_ is filled in for each
+   * @param flags Operation flags
+   * @return true if every blob was stored
+   */
+  bool PutBlobs(const hipc::MemContext &mctx, const TagId &tag_id,
+                std::vector<BlobIoRequest> &requests, chi::u32 flags = 0) {
+    auto task = AsyncPutBlobs(mctx, tag_id, requests, flags);
+    task->Wait();
+    for (size_t i = 0; i < requests.size() && i < task->entries_.size(); ++i) {
+      requests[i].return_code_ = task->entries_[i].return_code_;
+    }
+    bool result = (task->return_code_.load() == 0);
+    if (!result) {
+      HELOG(kError, "PutBlobs failed: {} of {} blobs", task->failed_count_,
+            requests.size());
+    }
+    CHI_IPC->DelTask(task);
+    return result;
+  }
+
+  /**
+   * Asynchronous put of many blobs of one tag - returns immediately
+   * Data buffers must stay valid until the task completes
+   * @param pool_query Pool query for routing (default: Dynamic, which sends
+   * the batch to its container or splits it across containers)
+   */
+  hipc::FullPtr<PutBlobsTask>
+  AsyncPutBlobs(const hipc::MemContext &mctx, const TagId &tag_id,
+                const std::vector<BlobIoRequest> &requests, chi::u32 flags = 0,
+                const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
+    (void)mctx; // Suppress unused parameter warning
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<PutBlobsTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, requests, flags);
+
+    ipc_manager->Enqueue(task);
+    return task;
+  }
+
+  /**
+   * Synchronous get of many blobs of one tag - waits for completion
+   * @param mctx Memory context
+   * @param tag_id Tag the blobs belong to
+   * @param requests Blobs to read into their data_ buffers; return_code_ is
+   * filled in for each
+   * @param flags Operation flags
+   * @return true if every blob was read
+   */
+  bool GetBlobs(const hipc::MemContext &mctx, const TagId &tag_id,
+                std::vector<BlobIoRequest> &requests, chi::u32 flags = 0) {
+    auto task = AsyncGetBlobs(mctx, tag_id, requests, flags);
+    task->Wait();
+    for (size_t i = 0; i < requests.size() && i < task->entries_.size(); ++i) {
+      requests[i].return_code_ = task->entries_[i].return_code_;
+    }
+    bool result = (task->return_code_.load() == 0);
+    CHI_IPC->DelTask(task);
+    return result;
+  }
+
+  /**
+   * Asynchronous get of many blobs of one tag - returns immediately
+   * @param pool_query Pool query for routing (default: Dynamic, which sends
+   * the batch to its container or splits it across containers)
+   */
+  hipc::FullPtr<GetBlobsTask>
+  AsyncGetBlobs(const hipc::MemContext &mctx, const TagId &tag_id,
+                const std::vector<BlobIoRequest> &requests, chi::u32 flags = 0,
+                const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
+    (void)mctx; // Suppress unused parameter warning
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<GetBlobsTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, requests, flags);
 
     ipc_manager->Enqueue(task);
     return task;
@@ -318,15 +420,15 @@ public:
   /**
    * Asynchronous delete blob - returns immediately
    */
-  hipc::FullPtr<DelBlobTask> AsyncDelBlob(const hipc::MemContext &mctx,
-                                          const TagId &tag_id,
-                                          const std::string &blob_name) {
+  hipc::FullPtr<DelBlobTask> AsyncDelBlob(
+      const hipc::MemContext &mctx, const TagId &tag_id,
+      const std::string &blob_name,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     (void)mctx; // Suppress unused parameter warning
     auto *ipc_manager = CHI_IPC;
 
-    auto task = ipc_manager->NewTask<DelBlobTask>(chi::CreateTaskId(), pool_id_,
-                                                  chi::PoolQuery::Dynamic(),
-                                                  tag_id, blob_name);
+    auto task = ipc_manager->NewTask<DelBlobTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, blob_name);
 
     ipc_manager->Enqueue(task);
     return task;
@@ -412,11 +514,14 @@ public:
 
   /**
    * Synchronous poll telemetry log - waits for completion
+   * @param minimum_logical_time Cursor: entries logged after it are returned
+   * @param max_entries Max entries to return (0 = ring size)
    */
   std::vector<CteTelemetry>
   PollTelemetryLog(const hipc::MemContext &mctx,
-                   std::uint64_t minimum_logical_time) {
-    auto task = AsyncPollTelemetryLog(mctx, minimum_logical_time);
+                   std::uint64_t minimum_logical_time,
+                   chi::u32 max_entries = 0) {
+    auto task = AsyncPollTelemetryLog(mctx, minimum_logical_time, max_entries);
     task->Wait();
 
     // Convert HSHM vector to standard vector for client use
@@ -435,13 +540,14 @@ public:
    */
   hipc::FullPtr<PollTelemetryLogTask>
   AsyncPollTelemetryLog(const hipc::MemContext &mctx,
-                        std::uint64_t minimum_logical_time) {
+                        std::uint64_t minimum_logical_time,
+                        chi::u32 max_entries = 0) {
     (void)mctx; // Suppress unused parameter warning
     auto *ipc_manager = CHI_IPC;
 
     auto task = ipc_manager->NewTask<PollTelemetryLogTask>(
         chi::CreateTaskId(), pool_id_, chi::PoolQuery::Dynamic(),
-        minimum_logical_time);
+        minimum_logical_time, max_entries);
 
     ipc_manager->Enqueue(task);
     return task;
@@ -524,19 +630,73 @@ public:
 
   /**
    * Asynchronous get contained blobs - returns immediately
+   * @param pool_query Pool query for routing (default: Dynamic, all containers)
+   * @param max_results Max names per container (0 = all)
+   * @param cursor next_cursor_ of the previous page ("" = first page)
    */
   hipc::FullPtr<GetContainedBlobsTask>
-  AsyncGetContainedBlobs(const hipc::MemContext &mctx, const TagId &tag_id) {
+  AsyncGetContainedBlobs(const hipc::MemContext &mctx, const TagId &tag_id,
+                         const chi::PoolQuery &pool_query =
+                             chi::PoolQuery::Dynamic(),
+                         chi::u32 max_results = 0,
+                         const std::string &cursor = "") {
     (void)mctx; // Suppress unused parameter warning
     auto *ipc_manager = CHI_IPC;
 
     auto task = ipc_manager->NewTask<GetContainedBlobsTask>(
-        chi::CreateTaskId(), pool_id_, chi::PoolQuery::Dynamic(), tag_id);
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, max_results, cursor);
 
     ipc_manager->Enqueue(task);
     return task;
   }
 
+  /**
+   * Synchronous get of one page of a tag's blob names from one container
+   * @param pool_query Must route to a single container
+   * @param max_results Max names returned
+   * @param cursor In: "" or the cursor returned by the previous page; out:
+   * where the next page starts ("" = no more names on this container)
+   * @param blob_names Out: the page
+   * @return true on success
+   */
+  bool GetContainedBlobsPage(const hipc::MemContext &mctx, const TagId &tag_id,
+                             const chi::PoolQuery &pool_query,
+                             chi::u32 max_results, std::string &cursor,
+                             std::vector<std::string> &blob_names) {
+    auto task =
+        AsyncGetContainedBlobs(mctx, tag_id, pool_query, max_results, cursor);
+    task->Wait();
+    bool success = (task->return_code_.load() == 0);
+    blob_names.clear();
+    cursor.clear();
+    if (success) {
+      for (const auto &blob_name : task->blob_names_) {
+        blob_names.emplace_back(blob_name.str());
+      }
+      cursor = task->next_cursor_.str();
+    }
+    CHI_IPC->DelTask(task);
+    return success;
+  }
+
+  /**
+   * Lazily iterate over a tag's blob names, one page at a time
+   * @param page_size Max names fetched per request
+   */
+  QueryResultIterator IterateContainedBlobs(
+      const hipc::MemContext &mctx, const TagId &tag_id,
+      chi::u32 page_size = QueryResultIterator::kDefaultPageSize) {
+    Client client = *this;
+    return QueryResultIterator(
+        [client, mctx, tag_id](const chi::PoolQuery &pool_query,
+                               chi::u32 max_results, std::string &cursor,
+                               std::vector<std::string> &names) mutable {
+          return client.GetContainedBlobsPage(mctx, tag_id, pool_query,
+                                              max_results, cursor, names);
+        },
+        page_size);
+  }
+
   /**
    * Synchronous tag query - waits for completion
    * Queries tags by regex pattern
@@ -565,22 +725,71 @@ public:
    * @param mctx Memory context
    * @param tag_regex Tag regex pattern to match
    * @param pool_query Pool query for routing (default: Broadcast)
+   * @param max_results Max names per container (0 = all)
+   * @param cursor next_cursor_ of the previous page ("" = first page)
    * @return Task pointer for async operation
    */
   hipc::FullPtr<TagQueryTask>
   AsyncTagQuery(const hipc::MemContext &mctx,
                 const std::string &tag_regex,
-                const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+                const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast(),
+                chi::u32 max_results = 0, const std::string &cursor = "") {
     (void)mctx; // Suppress unused parameter warning
     auto *ipc_manager = CHI_IPC;
 
     auto task = ipc_manager->NewTask<TagQueryTask>(
-        chi::CreateTaskId(), pool_id_, pool_query, tag_regex);
+        chi::CreateTaskId(), pool_id_, pool_query, tag_regex, max_results,
+        cursor);
 
     ipc_manager->Enqueue(task);
     return task;
   }
 
+  /**
+   * Synchronous tag query for one page of results from one container
+   * @param pool_query Must route to a single container
+   * @param max_results Max names returned
+   * @param cursor In: "" or the cursor returned by the previous page; out:
+   * where the next page starts ("" = no more matches on this container)
+   * @param tag_names Out: the page
+   * @return true on success
+   */
+  bool TagQueryPage(const hipc::MemContext &mctx, const std::string &tag_regex,
+                    const chi::PoolQuery &pool_query, chi::u32 max_results,
+                    std::string &cursor, std::vector<std::string> &tag_names) {
+    auto task = AsyncTagQuery(mctx, tag_regex, pool_query, max_results, cursor);
+    task->Wait();
+    bool success = (task->return_code_.load() == 0);
+    tag_names.clear();
+    cursor.clear();
+    if (success) {
+      for (const auto &tag_name : task->tag_names_) {
+        tag_names.emplace_back(tag_name.str());
+      }
+      cursor = task->next_cursor_.str();
+    }
+    CHI_IPC->DelTask(task);
+    return success;
+  }
+
+  /**
+   * Lazily iterate over the tags matching a pattern, one page at a time
+   * @param page_size Max names fetched per request
+   */
+  QueryResultIterator IterateTagQuery(
+      const hipc::MemContext &mctx, const std::string &tag_regex,
+      chi::u32 page_size = QueryResultIterator::kDefaultPageSize) {
+    Client client = *this;
+    return QueryResultIterator(
+        [client, mctx, tag_regex](const chi::PoolQuery &pool_query,
+                                  chi::u32 max_results, std::string &cursor,
+                                  std::vector<std::string> &names) mutable {
+          return client.TagQueryPage(mctx, tag_regex, pool_query, max_results,
+                                     cursor, names);
+        },
+        page_size);
+  }
+
   /**
    * Synchronous blob query - waits for completion
    * Queries blobs by tag and blob regex patterns
@@ -612,18 +821,505 @@ public:
    * @param tag_regex Tag regex pattern to match
    * @param blob_regex Blob regex pattern to match
    * @param pool_query Pool query for routing (default: Broadcast)
+   * @param max_results Max names per container (0 = all)
+   * @param cursor next_cursor_ of the previous page ("" = first page)
+   * @param predicate Metadata filters applied to name matches
+   * @param with_stats Also return each match's metadata in blob_stats_
    * @return Task pointer for async operation
    */
   hipc::FullPtr<BlobQueryTask>
   AsyncBlobQuery(const hipc::MemContext &mctx,
                  const std::string &tag_regex,
                  const std::string &blob_regex,
-                 const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+                 const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast(),
+                 chi::u32 max_results = 0, const std::string &cursor = "",
+                 const BlobQueryPredicate &predicate = BlobQueryPredicate(),
+                 bool with_stats = false) {
     (void)mctx; // Suppress unused parameter warning
     auto *ipc_manager = CHI_IPC;
 
     auto task = ipc_manager->NewTask<BlobQueryTask>(
-        chi::CreateTaskId(), pool_id_, pool_query, tag_regex, blob_regex);
+        chi::CreateTaskId(), pool_id_, pool_query, tag_regex, blob_regex,
+        max_results, cursor, predicate, with_stats);
+
+    ipc_manager->Enqueue(task);
+    return task;
+  }
+
+  /**
+   * Synchronous blob query for one page of results from one container
+   * @param pool_query Must route to a single container
+   * @param max_results Max names returned
+   * @param cursor In: "" or the cursor returned by the previous page; out:
+   * where the next page starts ("" = no more matches on this container)
+   * @param blob_names Out: the page
+   * @param predicate Metadata filters applied to name matches
+   * @return true on success
+   */
+  bool BlobQueryPage(const hipc::MemContext &mctx, const std::string &tag_regex,
+                     const std::string &blob_regex,
+                     const chi::PoolQuery &pool_query, chi::u32 max_results,
+                     std::string &cursor,
+                     std::vector<std::string> &blob_names,
+                     const BlobQueryPredicate &predicate =
+                         BlobQueryPredicate()) {
+    auto task = AsyncBlobQuery(mctx, tag_regex, blob_regex, pool_query,
+                               max_results, cursor, predicate);
+    task->Wait();
+    bool success = (task->return_code_.load() == 0);
+    blob_names.clear();
+    cursor.clear();
+    if (success) {
+      for (const auto &blob_name : task->blob_names_) {
+        blob_names.emplace_back(blob_name.str());
+      }
+      cursor = task->next_cursor_.str();
+    }
+    CHI_IPC->DelTask(task);
+    return success;
+  }
+
+  /**
+   * Lazily iterate over the blobs matching BlobQuery patterns, one page at
+   * a time; memory stays bounded by page_size names
+   * @param page_size Max names fetched per request
+   * @param predicate Metadata filters applied to name matches
+   */
+  QueryResultIterator IterateBlobQuery(
+      const hipc::MemContext &mctx, const std::string &tag_regex,
+      const std::string &blob_regex,
+      chi::u32 page_size = QueryResultIterator::kDefaultPageSize,
+      const BlobQueryPredicate &predicate = BlobQueryPredicate()) {
+    Client client = *this;
+    return QueryResultIterator(
+        [client, mctx, tag_regex, blob_regex, predicate](
+            const chi::PoolQuery &pool_query, chi::u32 max_results,
+            std::string &cursor, std::vector<std::string> &names) mutable {
+          return client.BlobQueryPage(mctx, tag_regex, blob_regex, pool_query,
+                                      max_results, cursor, names, predicate);
+        },
+        page_size);
+  }
+
+  /**
+   * Synchronous blob query returning each match's size, score, ages and
+   * target, filtered by metadata predicates, in one round trip
+   * @param mctx Memory context
+   * @param tag_regex Tag regex pattern to match
+   * @param blob_regex Blob regex pattern to match
+   * @param predicate Metadata filters applied to name matches
+   * @param pool_query Pool query for routing (default: Broadcast)
+   * @return Matching blobs with their metadata (empty on failure)
+   */
+  std::vector<BlobQueryResult>
+  BlobQueryWithStats(const hipc::MemContext &mctx,
+                     const std::string &tag_regex,
+                     const std::string &blob_regex,
+                     const BlobQueryPredicate &predicate = BlobQueryPredicate(),
+                     const chi::PoolQuery &pool_query =
+                         chi::PoolQuery::Broadcast()) {
+    auto task = AsyncBlobQuery(mctx, tag_regex, blob_regex, pool_query, 0, "",
+                               predicate, true);
+    task->Wait();
+    std::vector<BlobQueryResult> result;
+    if (task->return_code_.load() == 0 &&
+        task->blob_stats_.size() == task->blob_names_.size()) {
+      result.reserve(task->blob_names_.size());
+      for (size_t i = 0; i < task->blob_names_.size(); ++i) {
+        result.push_back(
+            BlobQueryResult{task->blob_names_[i].str(), task->blob_stats_[i]});
+      }
+    }
+    CHI_IPC->DelTask(task);
+    return result;
+  }
+
+  /**
+   * Synchronous tier reorganization - waits for completion
+   * Migrates blobs whose current targets no longer match their scores
+   * @param mctx Memory context
+   * @param max_blobs Max blobs to migrate per container (0 = no limit)
+   * @param pool_query Pool query for routing (default: Broadcast)
+   * @return Number of blobs promoted or demoted (0 on failure)
+   */
+  chi::u32 ReorganizeTiers(const hipc::MemContext &mctx, chi::u32 max_blobs = 0,
+                           const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto task = AsyncReorganizeTiers(mctx, max_blobs, pool_query);
+    task->Wait();
+    chi::u32 result = (task->return_code_.load() == 0)
+                          ? task->blobs_promoted_ + task->blobs_demoted_
+                          : 0;
+    CHI_IPC->DelTask(task);
+    return result;
+  }
+
+  /**
+   * Asynchronous tier reorganization - returns immediately
+   * @param mctx Memory context
+   * @param max_blobs Max blobs to migrate per container (0 = no limit)
+   * @param pool_query Pool query for routing (default: Broadcast)
+   * @return Task pointer for async operation
+   */
+  hipc::FullPtr<ReorganizeTiersTask>
+  AsyncReorganizeTiers(const hipc::MemContext &mctx, chi::u32 max_blobs = 0,
+                       const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    (void)mctx; // Suppress unused parameter warning
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<ReorganizeTiersTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, max_blobs);
+
+    ipc_manager->Enqueue(task);
+    return task;
+  }
+
+  /**
+   * Synchronous watermark enforcement - waits for completion
+   * Demotes cold blobs off targets above their high watermark
+   * @param mctx Memory context
+   * @param max_blobs Max blobs to demote per container (0 = no limit)
+   * @param pool_query Pool query for routing (default: Broadcast)
+   * @return Number of blobs demoted (0 on failure)
+   */
+  chi::u32 EnforceWatermarks(const hipc::MemContext &mctx, chi::u32 max_blobs = 0,
+                             const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto task = AsyncEnforceWatermarks(mctx, max_blobs, pool_query);
+    task->Wait();
+    chi::u32 result =
+        (task->return_code_.load() == 0) ? task->blobs_demoted_ : 0;
+    CHI_IPC->DelTask(task);
+    return result;
+  }
+
+  /**
+   * Asynchronous watermark enforcement - returns immediately
+   * @param mctx Memory context
+   * @param max_blobs Max blobs to demote per container (0 = no limit)
+   * @param pool_query Pool query for routing (default: Broadcast)
+   * @return Task pointer for async operation
+   */
+  hipc::FullPtr<EnforceWatermarksTask>
+  AsyncEnforceWatermarks(const hipc::MemContext &mctx, chi::u32 max_blobs = 0,
+                         const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    (void)mctx; // Suppress unused parameter warning
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<EnforceWatermarksTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, max_blobs);
+
+    ipc_manager->Enqueue(task);
+    return task;
+  }
+
+  /**
+   * Synchronous runtime statistics query - waits for completion
+   * @param mctx Memory context
+   * @param reset Clear the latency histograms after reading them
+   * @param pool_query Pool query for routing (default: Broadcast)
+   * @return Latency summaries per (operation, phase) and per-target I/O
+   * counters (empty on failure)
+   */
+  RuntimeStatsReport GetRuntimeStats(const hipc::MemContext &mctx, bool reset = false,
+                                     const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto task = AsyncGetRuntimeStats(mctx, reset, pool_query);
+    task->Wait();
+
+    // Convert HSHM vectors to standard vectors for client use
+    RuntimeStatsReport report;
+    if (task->return_code_.load() == 0) {
+      report.latencies_.reserve(task->latencies_.size());
+      for (const auto &summary : task->latencies_) {
+        report.latencies_.push_back(summary);
+      }
+      report.targets_.reserve(task->targets_.size());
+      for (const auto &target : task->targets_) {
+        report.targets_.push_back(target);
+      }
+    }
+
+    CHI_IPC->DelTask(task);
+    return report;
+  }
+
+  /**
+   * Asynchronous runtime statistics query - returns immediately
+   * @param mctx Memory context
+   * @param reset Clear the latency histograms after reading them
+   * @param pool_query Pool query for routing (default: Broadcast)
+   * @return Task pointer for async operation
+   */
+  hipc::FullPtr<GetRuntimeStatsTask>
+  AsyncGetRuntimeStats(const hipc::MemContext &mctx, bool reset = false,
+                       const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    (void)mctx; // Suppress unused parameter warning
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<GetRuntimeStatsTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, reset);
+
+    ipc_manager->Enqueue(task);
+    return task;
+  }
+
+  /**
+   * Synchronous stage-in - waits for completion
+   * Reads [offset, offset + size) of a backing file and stores it as the page
+   * blobs of the tag named path, skipping pages already in CTE
+   * @param mctx Memory context
+   * @param path Backing file; also the tag name
+   * @param page_size Page size of the tag's blobs
+   * @param offset First byte to stage (rounded down to a page)
+   * @param size Bytes to stage (0 = to end of file)
+   * @param score Score of the staged blobs
+   * @param pool_query Pool query for routing (default: Local)
+   * @return Bytes staged (0 on failure)
+   */
+  chi::u64 StageIn(const hipc::MemContext &mctx, const std::string &path,
+                   chi::u64 page_size, chi::u64 offset = 0, chi::u64 size = 0,
+                   float score = 1.0f,
+                   const chi::PoolQuery &pool_query = chi::PoolQuery::Local()) {
+    auto task =
+        AsyncStageIn(mctx, path, page_size, offset, size, score, pool_query);
+    task->Wait();
+    chi::u64 result =
+        (task->return_code_.load() == 0) ? task->bytes_staged_ : 0;
+    CHI_IPC->DelTask(task);
+    return result;
+  }
+
+  /**
+   * Asynchronous stage-in - returns immediately
+   * @return Task pointer for async operation
+   */
+  hipc::FullPtr<StageInTask>
+  AsyncStageIn(const hipc::MemContext &mctx, const std::string &path,
+               chi::u64 page_size, chi::u64 offset = 0, chi::u64 size = 0,
+               float score = 1.0f,
+               const chi::PoolQuery &pool_query = chi::PoolQuery::Local()) {
+    (void)mctx; // Suppress unused parameter warning
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<StageInTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, path, offset, size,
+        page_size, score);
+
+    ipc_manager->Enqueue(task);
+    return task;
+  }
+
+  /**
+   * Write the page blobs of a tag written since its last flush back to the
+   * tag's backing file
+   * @param mctx Memory context
+   * @param tag_id Tag to flush (null = every registered tag)
+   * @param path Backing file of the tag
+   * @param page_size Page size; blob i holds bytes [i, i+1) * page_size
+   * @param flags kFlushDurable to sync the file to stable storage
+   * @param pool_query Pool query for routing (default: Broadcast)
+   * @return Pages and bytes written and the time taken
+   */
+  FlushReport
+  FlushTag(const hipc::MemContext &mctx, const TagId &tag_id,
+           const std::string &path, chi::u64 page_size, chi::u32 flags = 0,
+           const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto task =
+        AsyncFlushTag(mctx, tag_id, path, page_size, flags, pool_query);
+    task->Wait();
+    FlushReport report;
+    report.success_ =
+        (task->return_code_.load() == 0 && task->failed_pages_ == 0);
+    report.pages_ = task->pages_flushed_;
+    report.bytes_ = task->bytes_flushed_;
+    report.elapsed_ns_ = task->elapsed_ns_;
+    CHI_IPC->DelTask(task);
+    return report;
+  }
+
+  /**
+   * Asynchronous flush of a tag - returns immediately
+   * @return Task pointer for async operation
+   */
+  hipc::FullPtr<FlushTagTask>
+  AsyncFlushTag(const hipc::MemContext &mctx, const TagId &tag_id,
+                const std::string &path, chi::u64 page_size,
+                chi::u32 flags = 0,
+                const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    (void)mctx; // Suppress unused parameter warning
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<FlushTagTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, path, page_size,
+        flags);
+
+    ipc_manager->Enqueue(task);
+    return task;
+  }
+
+  /**
+   * Synchronous blob truncation - waits for completion
+   * @param new_size Size to shrink the blob to; larger blobs are unchanged
+   * @return true on success (including a blob already small enough)
+   */
+  bool TruncateBlob(const hipc::MemContext &mctx, const TagId &tag_id,
+                    const std::string &blob_name, chi::u64 new_size) {
+    auto task = AsyncTruncateBlob(mctx, tag_id, blob_name, new_size);
+    task->Wait();
+    bool result = (task->return_code_.load() == 0);
+    CHI_IPC->DelTask(task);
+    return result;
+  }
+
+  /**
+   * Asynchronous blob truncation - returns immediately
+   */
+  hipc::FullPtr<TruncateBlobTask>
+  AsyncTruncateBlob(const hipc::MemContext &mctx, const TagId &tag_id,
+                    const std::string &blob_name, chi::u64 new_size) {
+    (void)mctx; // Suppress unused parameter warning
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<TruncateBlobTask>(
+        chi::CreateTaskId(), pool_id_, chi::PoolQuery::Dynamic(), tag_id,
+        blob_name, new_size);
+
+    ipc_manager->Enqueue(task);
+    return task;
+  }
+
+  /**
+   * Truncate the file held in a tag's page blobs
+   * @param mctx Memory context
+   * @param tag_id Tag of the file
+   * @param new_size New file size in bytes
+   * @param page_size Page size; blob i holds bytes [i, i+1) * page_size
+   * @param pool_query Pool query for routing (default: Broadcast)
+   * @return true if every page past the new size was deleted or shrunk
+   */
+  bool TruncateTag(const hipc::MemContext &mctx, const TagId &tag_id,
+                   chi::u64 new_size, chi::u64 page_size,
+                   const chi::PoolQuery &pool_query =
+                       chi::PoolQuery::Broadcast()) {
+    auto task = AsyncTruncateTag(mctx, tag_id, new_size, page_size, pool_query);
+    task->Wait();
+    bool result = (task->return_code_.load() == 0);
+    CHI_IPC->DelTask(task);
+    return result;
+  }
+
+  /**
+   * Asynchronous tag truncation - returns immediately
+   * @return Task pointer for async operation
+   */
+  hipc::FullPtr<TruncateTagTask>
+  AsyncTruncateTag(const hipc::MemContext &mctx, const TagId &tag_id,
+                   chi::u64 new_size, chi::u64 page_size,
+                   const chi::PoolQuery &pool_query =
+                       chi::PoolQuery::Broadcast()) {
+    (void)mctx; // Suppress unused parameter warning
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<TruncateTagTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, new_size,
+        page_size);
+
+    ipc_manager->Enqueue(task);
+    return task;
+  }
+
+  /**
+   * Append data to the end of a file tag
+   * @param mctx Memory context
+   * @param tag_id Tag of the file
+   * @param data Data to append (shared memory pointer)
+   * @param size Bytes to append
+   * @param page_size Page size; blob i holds bytes [i, i+1) * page_size
+   * @param offset Output offset the data was appended at. Set whenever the
+   * range was reserved, even if writing it failed.
+   * @param score Score of the written pages
+   * @param min_offset Lowest offset to append at, e.g. the size of a backing
+   * file whose pages are not all in CTE
+   * @return true if the data was written
+   */
+  bool AppendToTag(const hipc::MemContext &mctx, const TagId &tag_id,
+                   const hipc::Pointer &data, chi::u64 size,
+                   chi::u64 page_size, chi::u64 &offset, float score = 1.0f,
+                   chi::u64 min_offset = 0) {
+    auto task = AsyncAppendToTag(mctx, tag_id, data, size, page_size, score,
+                                 min_offset);
+    task->Wait();
+    offset = task->offset_;
+    bool result = (task->return_code_.load() == 0);
+    CHI_IPC->DelTask(task);
+    return result;
+  }
+
+  /**
+   * Asynchronous append - returns immediately
+   * @return Task pointer for async operation
+   */
+  hipc::FullPtr<AppendToTagTask>
+  AsyncAppendToTag(const hipc::MemContext &mctx, const TagId &tag_id,
+                   const hipc::Pointer &data, chi::u64 size,
+                   chi::u64 page_size, float score = 1.0f,
+                   chi::u64 min_offset = 0) {
+    (void)mctx; // Suppress unused parameter warning
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<AppendToTagTask>(
+        chi::CreateTaskId(), pool_id_, chi::PoolQuery::Dynamic(), tag_id,
+        data, size, page_size, score, min_offset);
+
+    ipc_manager->Enqueue(task);
+    return task;
+  }
+
+  /**
+   * Synchronous rebalance - waits for completion
+   * Moves every blob whose owner on the consistent-hash ring is no longer the
+   * container holding it, e.g. after nodes joined the pool. Containers are
+   * rebalanced concurrently.
+   * @param mctx Memory context
+   * @param max_blobs Max blobs to move per container (0 = no limit)
+   * @return Number of blobs moved
+   */
+  chi::u32 RebalanceBlobs(const hipc::MemContext &mctx,
+                          chi::u32 max_blobs = 0) {
+    chi::u32 num_containers =
+        std::max<chi::u32>(CHI_IPC->GetNumHosts(), 1);
+    std::vector<hipc::FullPtr<RebalanceBlobsTask>> tasks;
+    tasks.reserve(num_containers);
+    for (chi::u32 container = 0; container < num_containers; ++container) {
+      tasks.push_back(AsyncRebalanceBlobs(mctx, container, max_blobs));
+    }
+    chi::u32 blobs_moved = 0;
+    for (auto &task : tasks) {
+      task->Wait();
+      if (task->return_code_.load() == 0) {
+        blobs_moved += task->blobs_moved_;
+      }
+      CHI_IPC->DelTask(task);
+    }
+    return blobs_moved;
+  }
+
+  /**
+   * Asynchronous rebalance of one container - returns immediately
+   * @param mctx Memory context
+   * @param container_id Container whose blobs are checked
+   * @param max_blobs Max blobs to move (0 = no limit)
+   * @return Task pointer for async operation
+   */
+  hipc::FullPtr<RebalanceBlobsTask>
+  AsyncRebalanceBlobs(const hipc::MemContext &mctx, chi::u32 container_id,
+                      chi::u32 max_blobs = 0) {
+    (void)mctx; // Suppress unused parameter warning
+    auto *ipc_manager = CHI_IPC;
+
+    // The pool has one container per node, so DirectHash(id) lands on
+    // container id
+    auto task = ipc_manager->NewTask<RebalanceBlobsTask>(
+        chi::CreateTaskId(), pool_id_,
+        chi::PoolQuery::DirectHash(container_id), container_id, max_blobs);
 
     ipc_manager->Enqueue(task);
     return task;
@@ -665,7 +1361,16 @@ public:
   explicit Tag(const TagId &tag_id);
 
   /**
-   * PutBlob - Allocates a SHM pointer and then calls PutBlob (SHM)
+   * AllocateIoBuffer - Allocates an I/O buffer directly in shared memory
+   * from the calling thread's staging pool. Fill it through data() and pass
+   * it to PutBlob, or read into it with GetBlob, to avoid the staging copy.
+   * @param size Size of the buffer in bytes
+   * @return Buffer that returns to the pool when destroyed
+   */
+  static IoBuffer AllocateIoBuffer(size_t size);
+
+  /**
+   * PutBlob - Copies data into a pooled SHM buffer and calls PutBlob (SHM)
    * @param blob_name Name of the blob
    * @param data Raw data pointer
    * @param data_size Size of data
@@ -674,6 +1379,16 @@ public:
   void PutBlob(const std::string &blob_name, const char *data, size_t data_size,
                size_t off = 0);
 
+  /**
+   * PutBlob (IoBuffer) - Stores a buffer from AllocateIoBuffer without copying
+   * @param blob_name Name of the blob
+   * @param data Buffer holding data.size() bytes of blob data
+   * @param off Offset within blob (default 0)
+   * @param score Blob score for placement decisions (default 1.0)
+   */
+  void PutBlob(const std::string &blob_name, const IoBuffer &data,
+               size_t off = 0, float score = 1.0f);
+
   /**
    * PutBlob (SHM) - Direct shared memory version
    * @param blob_name Name of the blob
@@ -704,7 +1419,7 @@ public:
                                           float score = 1.0f);
 
   /**
-   * GetBlob - Allocates shared memory, retrieves blob data, copies to output
+   * GetBlob - Retrieves blob data into a pooled SHM buffer, copies to output
    * buffer
    * @param blob_name Name of the blob to retrieve
    * @param data Output buffer to copy blob data into (must be pre-allocated by
@@ -716,6 +1431,15 @@ public:
   void GetBlob(const std::string &blob_name, char *data, size_t data_size,
                size_t off = 0);
 
+  /**
+   * GetBlob (IoBuffer) - Reads data.size() bytes into a buffer from
+   * AllocateIoBuffer without copying
+   * @param blob_name Name of the blob to retrieve
+   * @param data Output buffer
+   * @param off Offset within blob (default 0)
+   */
+  void GetBlob(const std::string &blob_name, IoBuffer &data, size_t off = 0);
+
   /**
    * GetBlob (SHM) - Retrieves blob data into pre-allocated shared memory buffer
    * @param blob_name Name of the blob to retrieve
@@ -729,6 +1453,70 @@ public:
   void GetBlob(const std::string &blob_name, hipc::Pointer data,
                size_t data_size, size_t off = 0);
 
+  /**
+   * Asynchronous GetBlob (SHM) - Caller must keep data alive until the task
+   * completes and check return_code_ before using it
+   * @param blob_name Name of the blob to retrieve
+   * @param data Shared memory pointer for output data
+   * @param data_size Size of data to retrieve
+   * @param off Offset within blob (default 0)
+   * @return Task pointer for async operation
+   */
+  hipc::FullPtr<GetBlobTask> AsyncGetBlob(const std::string &blob_name,
+                                          const hipc::Pointer &data,
+                                          size_t data_size, size_t off = 0);
+
+  /**
+   * PutBlobs - Stores many blobs in one task from one contiguous buffer
+   * @param requests Blobs to store; their payloads are laid out back to back
+   * in data, in request order. data_ is overwritten and return_code_ filled in
+   * @param data Raw data for all requests
+   * @note Stages the whole batch in a single pooled shared memory buffer
+   */
+  void PutBlobs(std::vector<BlobIoRequest> &requests, const char *data);
+
+  /**
+   * PutBlobs (SHM) - Stores many blobs whose data_ already points to shared
+   * memory
+   * @param requests Blobs to store; return_code_ is filled in for each
+   */
+  void PutBlobs(std::vector<BlobIoRequest> &requests);
+
+  /**
+   * Asynchronous PutBlobs (SHM) - Caller must keep every data_ buffer alive
+   * until the task completes
+   * @param requests Blobs to store
+   * @return Task pointer for async operation
+   */
+  hipc::FullPtr<PutBlobsTask>
+  AsyncPutBlobs(const std::vector<BlobIoRequest> &requests);
+
+  /**
+   * GetBlobs - Reads many blobs in one task into one contiguous buffer
+   * @param requests Blobs to read; their payloads are copied back to back
+   * into data, in request order. data_ is overwritten and return_code_ filled
+   * in
+   * @param data Output buffer large enough for all requests
+   * @note Stages the whole batch in a single pooled shared memory buffer
+   */
+  void GetBlobs(std::vector<BlobIoRequest> &requests, char *data);
+
+  /**
+   * GetBlobs (SHM) - Reads many blobs into the shared memory buffers their
+   * data_ points to
+   * @param requests Blobs to read; return_code_ is filled in for each
+   */
+  void GetBlobs(std::vector<BlobIoRequest> &requests);
+
+  /**
+   * Asynchronous GetBlobs (SHM) - Caller must keep every data_ buffer alive
+   * until the task completes
+   * @param requests Blobs to read
+   * @return Task pointer for async operation
+   */
+  hipc::FullPtr<GetBlobsTask>
+  AsyncGetBlobs(const std::vector<BlobIoRequest> &requests);
+
   /**
    * Get blob score
    * @param blob_name Name of the blob
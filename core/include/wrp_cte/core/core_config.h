@@ -13,16 +13,26 @@ namespace wrp_cte::core {
  * Performance configuration for CTE Core operations
  */
 struct PerformanceConfig {
-  chi::u32 target_stat_interval_ms_;    // Interval for updating target stats
+  chi::u32 target_stat_interval_ms_;    // Max age of target stats before placement requests a refresh
   chi::u32 max_concurrent_operations_;  // Max concurrent I/O operations
   float score_threshold_;               // Threshold for blob reorganization
   float score_difference_threshold_;    // Minimum score difference for reorganization
+  chi::u32 reorganize_interval_ms_;     // Period of background tier reorganization (0 = off)
+  chi::u32 reorganize_max_blobs_;       // Max blobs migrated per reorganization pass
+  chi::u32 watermark_check_interval_ms_; // Period of capacity watermark checks (0 = off)
+  chi::u32 flush_interval_ms_;          // Period of dirty file page write-back (0 = off)
+  chi::u32 telemetry_ring_size_;        // Telemetry entries retained for polling
 
   PerformanceConfig()
       : target_stat_interval_ms_(5000),
         max_concurrent_operations_(64),
         score_threshold_(0.7f),
-        score_difference_threshold_(0.05f) {}
+        score_difference_threshold_(0.05f),
+        reorganize_interval_ms_(0),
+        reorganize_max_blobs_(64),
+        watermark_check_interval_ms_(1000),
+        flush_interval_ms_(10000),
+        telemetry_ring_size_(1024) {}
 };
 
 /**
@@ -31,12 +41,14 @@ struct PerformanceConfig {
 struct TargetConfig {
   chi::u32 neighborhood_;               // Number of targets (nodes CTE can buffer to)
   chi::u32 default_target_timeout_ms_;  // Default timeout for target operations
-  chi::u32 poll_period_ms_;             // Period to rescan targets for statistics
+  chi::u32 poll_period_ms_;             // Period to rescan and rescore targets (0 = off)
+  chi::u32 virtual_nodes_;              // Hash ring points per container for blob/tag routing
 
   TargetConfig()
       : neighborhood_(4),
         default_target_timeout_ms_(30000),
-        poll_period_ms_(5000) {}
+        poll_period_ms_(5000),
+        virtual_nodes_(64) {}
 };
 
 /**
@@ -47,10 +59,14 @@ struct StorageDeviceConfig {
   std::string bdev_type_;     // Block device type ("file", "ram", etc.)
   chi::u64 capacity_limit_;   // Capacity limit in bytes (parsed from size string)
   float score_;               // Optional manual score (0.0-1.0), -1.0 means use automatic scoring
+  float high_watermark_;      // Used fraction of capacity that triggers demotion
+  float low_watermark_;       // Used fraction of capacity demotion drains down to
   
-  StorageDeviceConfig() : capacity_limit_(0), score_(-1.0f) {}
+  StorageDeviceConfig()
+      : capacity_limit_(0), score_(-1.0f), high_watermark_(0.9f), low_watermark_(0.7f) {}
   StorageDeviceConfig(const std::string& path, const std::string& bdev_type, chi::u64 capacity, float score = -1.0f)
-      : path_(path), bdev_type_(bdev_type), capacity_limit_(capacity), score_(score) {}
+      : path_(path), bdev_type_(bdev_type), capacity_limit_(capacity), score_(score),
+        high_watermark_(0.9f), low_watermark_(0.7f) {}
 };
 
 /**
@@ -66,10 +82,39 @@ struct StorageConfig {
  * Data Placement Engine configuration
  */
 struct DpeConfig {
-  std::string dpe_type_;  // DPE algorithm type ("random", "round_robin", "max_bw")
-  
-  DpeConfig() : dpe_type_("max_bw") {}
-  explicit DpeConfig(const std::string& dpe_type) : dpe_type_(dpe_type) {}
+  std::string dpe_type_;  // DPE algorithm type ("random", "round_robin", "max_bw", "weighted")
+  // Weighted DPE: blend of normalized target properties
+  float bandwidth_weight_;    // Write bandwidth relative to the fastest target
+  float latency_weight_;      // Lowest latency relative to the target's latency
+  float capacity_weight_;     // Fraction of the target's capacity still free
+  float score_fit_weight_;    // 1 - |target score - blob score|
+  chi::u64 large_blob_size_;  // Blobs at least this big are spread randomly
+  chi::u32 spread_width_;     // Top candidates a large blob is spread over
+  // Striping: new data is split into stripe units placed round-robin
+  chi::u64 stripe_unit_;      // Bytes per block of a striped allocation
+  chi::u32 stripe_width_;     // Targets a striped allocation spans (1 = off)
+
+  DpeConfig()
+      : dpe_type_("max_bw"), bandwidth_weight_(0.4f), latency_weight_(0.1f),
+        capacity_weight_(0.3f), score_fit_weight_(0.2f),
+        large_blob_size_(1024 * 1024), spread_width_(4),
+        stripe_unit_(4 * 1024 * 1024), stripe_width_(1) {}
+  explicit DpeConfig(const std::string& dpe_type) : DpeConfig() {
+    dpe_type_ = dpe_type;
+  }
+
+  bool operator==(const DpeConfig& other) const {
+    return dpe_type_ == other.dpe_type_ &&
+           bandwidth_weight_ == other.bandwidth_weight_ &&
+           latency_weight_ == other.latency_weight_ &&
+           capacity_weight_ == other.capacity_weight_ &&
+           score_fit_weight_ == other.score_fit_weight_ &&
+           large_blob_size_ == other.large_blob_size_ &&
+           spread_width_ == other.spread_width_ &&
+           stripe_unit_ == other.stripe_unit_ &&
+           stripe_width_ == other.stripe_width_;
+  }
+  bool operator!=(const DpeConfig& other) const { return !(*this == other); }
 };
 
 /**
@@ -137,6 +182,12 @@ class Config {
    * @return true if successful, false otherwise
    */
   bool SaveToFile(const std::string &config_file_path) const;
+
+  /**
+   * Save configuration to a YAML string
+   * @return YAML text accepted by LoadFromString
+   */
+  std::string SaveToString() const;
   
   /**
    * Validate configuration parameters
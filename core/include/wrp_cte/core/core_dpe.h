@@ -3,6 +3,8 @@
 
 #include <chimaera/chimaera.h>
 #include <wrp_cte/core/core_tasks.h>
+#include <wrp_cte/core/core_config.h>
+#include <utility>
 #include <vector>
 #include <string>
 #include <memory>
@@ -16,7 +18,50 @@ namespace wrp_cte::core {
 enum class DpeType : chi::u32 {
   kRandom = 0,    // Random placement
   kRoundRobin = 1, // Round-robin placement
-  kMaxBW = 2      // Max bandwidth placement
+  kMaxBW = 2,     // Max bandwidth placement
+  kWeighted = 3   // Weighted blend of bandwidth, latency, capacity, score fit
+};
+
+/** Number of DpeType values (size of per-worker DPE caches) */
+static constexpr size_t kDpeTypeCount = 4;
+
+/**
+ * Compact per-target descriptor used for placement decisions
+ * Holds only the fields a DPE reads, so snapshots are cheap to scan and copy
+ */
+struct TargetDesc {
+  chi::PoolId target_id_;       // Bdev pool ID of the target
+  float target_score_;          // Target score (0-1)
+  chi::u64 remaining_space_;    // Remaining space when the snapshot was taken
+  chi::u64 total_space_;        // Capacity the target was registered with
+  double write_bandwidth_mbps_; // Write bandwidth from bdev stats
+  double avg_latency_us_;       // Mean of read and write latency
+  bool is_local_;               // Target is on the placing container's node
+
+  TargetDesc()
+      : target_id_(chi::PoolId::GetNull()), target_score_(0.0f),
+        remaining_space_(0), total_space_(0), write_bandwidth_mbps_(0.0),
+        avg_latency_us_(0.0), is_local_(true) {}
+
+  explicit TargetDesc(const TargetInfo &info)
+      : target_id_(info.bdev_client_.pool_id_),
+        target_score_(info.target_score_),
+        remaining_space_(info.remaining_space_),
+        total_space_(info.total_space_),
+        write_bandwidth_mbps_(info.perf_metrics_.write_bandwidth_mbps_),
+        avg_latency_us_((info.perf_metrics_.read_latency_us_ +
+                         info.perf_metrics_.write_latency_us_) /
+                        2.0),
+        is_local_(info.is_local_) {}
+};
+
+/**
+ * Versioned snapshot of target descriptors
+ * Rebuilt by the runtime only when the target set or target stats change
+ */
+struct TargetSnapshot {
+  chi::u64 version_ = 0;
+  std::vector<TargetDesc> targets_;
 };
 
 /**
@@ -29,8 +74,21 @@ DpeType StringToDpeType(const std::string& dpe_str);
  */
 std::string DpeTypeToString(DpeType dpe_type);
 
+/**
+ * Auto score of a target: log(bw + 1) / log(max_bw + 1), clamped to [0, 1],
+ * so the fastest target scores 1.0 and one without bandwidth scores 0.0
+ * @param bandwidth Larger of the target's smoothed read and write bandwidth
+ * @param max_bandwidth Largest such bandwidth over all registered targets
+ */
+float ScoreTargetBandwidth(double bandwidth, double max_bandwidth);
+
 /**
  * Abstract Data Placement Engine interface
+ *
+ * Every engine puts all suitable targets on the placing container's node
+ * ahead of remote ones, so a blob spills to a neighbor only once the local
+ * targets are full; each engine's own policy orders targets within the local
+ * and the remote group.
  */
 class DataPlacementEngine {
 public:
@@ -38,14 +96,16 @@ public:
   
   /**
    * Select targets for data placement
-   * @param targets Available targets for placement
+   * @param targets Available targets for placement (local and remote)
    * @param blob_score Score of the blob (0-1)
    * @param data_size Size of data to be placed
-   * @return Vector of ordered targets, empty if no suitable targets
+   * @param ordered_targets Output: IDs of targets in placement order (cleared
+   *        first; left empty if no suitable targets). Capacity is reused.
    */
-  virtual std::vector<TargetInfo> SelectTargets(const std::vector<TargetInfo>& targets, 
-                                               float blob_score, 
-                                               chi::u64 data_size) = 0;
+  virtual void SelectTargets(const std::vector<TargetDesc>& targets,
+                             float blob_score,
+                             chi::u64 data_size,
+                             std::vector<chi::PoolId>& ordered_targets) = 0;
   
   /**
    * Get the DPE type
@@ -60,9 +120,10 @@ class RandomDpe : public DataPlacementEngine {
 public:
   RandomDpe();
   
-  std::vector<TargetInfo> SelectTargets(const std::vector<TargetInfo>& targets, 
-                                       float blob_score, 
-                                       chi::u64 data_size) override;
+  void SelectTargets(const std::vector<TargetDesc>& targets,
+                     float blob_score,
+                     chi::u64 data_size,
+                     std::vector<chi::PoolId>& ordered_targets) override;
   
   DpeType GetType() const override { return DpeType::kRandom; }
 
@@ -77,9 +138,10 @@ class RoundRobinDpe : public DataPlacementEngine {
 public:
   RoundRobinDpe();
   
-  std::vector<TargetInfo> SelectTargets(const std::vector<TargetInfo>& targets, 
-                                       float blob_score, 
-                                       chi::u64 data_size) override;
+  void SelectTargets(const std::vector<TargetDesc>& targets,
+                     float blob_score,
+                     chi::u64 data_size,
+                     std::vector<chi::PoolId>& ordered_targets) override;
   
   DpeType GetType() const override { return DpeType::kRoundRobin; }
 
@@ -94,14 +156,52 @@ class MaxBwDpe : public DataPlacementEngine {
 public:
   MaxBwDpe();
   
-  std::vector<TargetInfo> SelectTargets(const std::vector<TargetInfo>& targets, 
-                                       float blob_score, 
-                                       chi::u64 data_size) override;
+  void SelectTargets(const std::vector<TargetDesc>& targets,
+                     float blob_score,
+                     chi::u64 data_size,
+                     std::vector<chi::PoolId>& ordered_targets) override;
   
   DpeType GetType() const override { return DpeType::kMaxBW; }
 
 private:
   static constexpr chi::u64 kLatencyThreshold = 32 * 1024; // 32KB threshold
+  std::vector<const TargetDesc*> candidates_; // Reused sort buffer
+};
+
+/**
+ * Weighted Data Placement Engine
+ *
+ * Scores each target by a blend of its write bandwidth relative to the
+ * fastest target, its latency relative to the lowest, the free fraction of
+ * its capacity and how close its score is to the blob's, with the weights
+ * from DpeConfig. Because free capacity counts, a fast tier sheds load
+ * gradually as it fills instead of taking all traffic until it is full.
+ *
+ * The best spread_width targets are found with a linear-time selection.
+ * Small blobs take them best first; large blobs take them in a random order
+ * drawn in proportion to the weights, so consecutive large blobs spread over
+ * the top targets. The remaining targets follow unordered as spill-over.
+ */
+class WeightedDpe : public DataPlacementEngine {
+public:
+  explicit WeightedDpe(const DpeConfig& config = DpeConfig());
+
+  void SelectTargets(const std::vector<TargetDesc>& targets,
+                     float blob_score,
+                     chi::u64 data_size,
+                     std::vector<chi::PoolId>& ordered_targets) override;
+
+  DpeType GetType() const override { return DpeType::kWeighted; }
+
+private:
+  /** Append the suitable targets of one locality group, best first */
+  void SelectGroup(const std::vector<TargetDesc>& targets, bool is_local,
+                   float blob_score, chi::u64 data_size, double max_bandwidth,
+                   double min_latency, std::vector<chi::PoolId>& ordered_targets);
+
+  DpeConfig config_;
+  std::mt19937 rng_;
+  std::vector<std::pair<double, const TargetDesc*>> candidates_; // Reused
 };
 
 /**
@@ -112,9 +212,11 @@ public:
   /**
    * Create a DPE instance
    * @param dpe_type Type of DPE to create
+   * @param config Tuning for engines that take any (weighted)
    * @return Unique pointer to DPE instance
    */
-  static std::unique_ptr<DataPlacementEngine> CreateDpe(DpeType dpe_type);
+  static std::unique_ptr<DataPlacementEngine> CreateDpe(
+      DpeType dpe_type, const DpeConfig& config = DpeConfig());
   
   /**
    * Create a DPE instance from string
@@ -122,6 +224,17 @@ public:
    * @return Unique pointer to DPE instance
    */
   static std::unique_ptr<DataPlacementEngine> CreateDpe(const std::string& dpe_str);
+
+  /**
+   * Get the calling worker thread's cached DPE instance of the given type
+   * Instances are created on first use and live for the lifetime of the
+   * thread; an instance is rebuilt when called with a different config
+   * @param dpe_type Type of DPE to retrieve
+   * @param config Tuning the returned instance uses
+   * @return Reference to the thread's DPE instance
+   */
+  static DataPlacementEngine& GetWorkerDpe(
+      DpeType dpe_type, const DpeConfig& config = DpeConfig());
 };
 
 } // namespace wrp_cte::core
@@ -0,0 +1,79 @@
+#ifndef WRPCTE_CORE_HASH_RING_H_
+#define WRPCTE_CORE_HASH_RING_H_
+
+#include <chimaera/chimaera.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/**
+ * Consistent-hash ring mapping keys to containers
+ *
+ * Each container owns virtual_nodes points on a 64-bit ring and a key belongs
+ * to the container owning the first point at or after the key's position.
+ * Growing the pool from N to N+1 containers therefore moves only about
+ * 1/(N+1) of the keys, all of them to the new container, where a modulo
+ * mapping would move almost every key. Point positions depend only on the
+ * container ID and point index, so every process builds the same ring.
+ */
+class HashRing {
+public:
+  HashRing() : num_containers_(0), virtual_nodes_(0) {}
+
+  /**
+   * Rebuild the ring for containers [0, num_containers)
+   * @param virtual_nodes Points per container; more points even out load
+   */
+  void Build(chi::u32 num_containers, chi::u32 virtual_nodes) {
+    num_containers_ = std::max<chi::u32>(num_containers, 1);
+    virtual_nodes_ = std::max<chi::u32>(virtual_nodes, 1);
+    points_.clear();
+    points_.reserve(static_cast<size_t>(num_containers_) * virtual_nodes_);
+    for (chi::u32 container = 0; container < num_containers_; ++container) {
+      for (chi::u32 vnode = 0; vnode < virtual_nodes_; ++vnode) {
+        chi::u64 seed = (static_cast<chi::u64>(container) << 32) | vnode;
+        points_.emplace_back(Mix(seed), container);
+      }
+    }
+    std::sort(points_.begin(), points_.end());
+  }
+
+  /** Container owning a key (0 if the ring has not been built) */
+  chi::u32 GetOwner(chi::u64 key) const {
+    if (points_.empty()) {
+      return 0;
+    }
+    // Spread keys over the whole ring; raw hashes may use only 32 bits
+    std::pair<chi::u64, chi::u32> probe(Mix(key), 0);
+    auto it = std::lower_bound(points_.begin(), points_.end(), probe);
+    if (it == points_.end()) {
+      it = points_.begin(); // Wrap around
+    }
+    return it->second;
+  }
+
+  /** Containers the ring was built for (0 if not built) */
+  chi::u32 GetNumContainers() const { return num_containers_; }
+
+  /** Points per container */
+  chi::u32 GetVirtualNodes() const { return virtual_nodes_; }
+
+private:
+  /** splitmix64 finalizer: a fixed, well-mixed 64-bit permutation */
+  static chi::u64 Mix(chi::u64 x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  chi::u32 num_containers_;
+  chi::u32 virtual_nodes_;
+  std::vector<std::pair<chi::u64, chi::u32>> points_; // (position, container)
+};
+
+} // namespace wrp_cte::core
+
+#endif // WRPCTE_CORE_HASH_RING_H_
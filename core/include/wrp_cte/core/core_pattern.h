@@ -0,0 +1,221 @@
+#ifndef WRPCTE_CORE_PATTERN_H_
+#define WRPCTE_CORE_PATTERN_H_
+
+#include <cctype>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace wrp_cte::core {
+
+/**
+ * A compiled regular expression. The default engine is std::regex; a faster
+ * engine (e.g. a DFA-based one such as RE2) is plugged in by implementing
+ * this interface and installing a compiler with SetPatternCompiler().
+ */
+class PatternMatcher {
+public:
+  virtual ~PatternMatcher() = default;
+
+  /** Whether the pattern matches some substring of text */
+  virtual bool Search(const std::string &text) const = 0;
+
+  /** Whether the pattern matches all of text */
+  virtual bool Match(const std::string &text) const = 0;
+};
+
+/**
+ * Builds a PatternMatcher; throws std::regex_error (or another
+ * std::exception) on an invalid pattern
+ */
+using PatternCompiler =
+    std::function<std::shared_ptr<const PatternMatcher>(const std::string &)>;
+
+/** PatternMatcher backed by std::regex (ECMAScript, optimized for matching) */
+class StdRegexMatcher : public PatternMatcher {
+public:
+  explicit StdRegexMatcher(const std::string &pattern)
+      : regex_(pattern, std::regex::ECMAScript | std::regex::optimize) {}
+
+  bool Search(const std::string &text) const override {
+    return std::regex_search(text, regex_);
+  }
+
+  bool Match(const std::string &text) const override {
+    return std::regex_match(text, regex_);
+  }
+
+private:
+  std::regex regex_;
+};
+
+namespace detail {
+inline PatternCompiler &GetPatternCompilerSlot() {
+  static PatternCompiler compiler = [](const std::string &pattern) {
+    return std::make_shared<const StdRegexMatcher>(pattern);
+  };
+  return compiler;
+}
+} // namespace detail
+
+/**
+ * Replace the regex engine used for patterns compiled from now on. Call it
+ * before patterns are loaded; it is not synchronized with compilation.
+ */
+inline void SetPatternCompiler(PatternCompiler compiler) {
+  detail::GetPatternCompilerSlot() = std::move(compiler);
+}
+
+/**
+ * A regex compiled once, with a literal pre-filter that rejects most
+ * non-matching strings before the regex engine runs
+ *
+ * The pre-filter is the run of plain characters the pattern starts with
+ * (after an optional '^'), which every match must contain: a match of an
+ * anchored pattern starts with it, a match of an unanchored one contains it
+ * somewhere. Patterns with alternation get no pre-filter.
+ */
+class CompiledPattern {
+public:
+  /** Compile a pattern; throws if the engine rejects it */
+  explicit CompiledPattern(const std::string &pattern)
+      : pattern_(pattern), anchored_(false),
+        matcher_(detail::GetPatternCompilerSlot()(pattern)) {
+    ExtractLiteralPrefix();
+  }
+
+  /** Whether the pattern matches some substring of text */
+  bool Search(const std::string &text) const {
+    if (!prefix_.empty()) {
+      if (anchored_ ? text.compare(0, prefix_.size(), prefix_) != 0
+                    : text.find(prefix_) == std::string::npos) {
+        return false;
+      }
+    }
+    return matcher_->Search(text);
+  }
+
+  /** Whether the pattern matches all of text */
+  bool Match(const std::string &text) const {
+    if (!prefix_.empty() && text.compare(0, prefix_.size(), prefix_) != 0) {
+      return false;
+    }
+    return matcher_->Match(text);
+  }
+
+  const std::string &GetPattern() const { return pattern_; }
+
+  /** Literal every match starts with (anchored) or contains */
+  const std::string &GetLiteralPrefix() const { return prefix_; }
+
+private:
+  void ExtractLiteralPrefix() {
+    const std::string &p = pattern_;
+    for (size_t i = 0; i < p.size(); ++i) {
+      if (p[i] == '\\') {
+        ++i; // An escaped character is literal unless it is a class
+      } else if (p[i] == '|') {
+        return; // Alternation: no literal is required
+      }
+    }
+
+    size_t i = 0;
+    if (!p.empty() && p[0] == '^') {
+      anchored_ = true;
+      i = 1;
+    }
+    std::string prefix;
+    while (i < p.size()) {
+      char c = p[i];
+      size_t next = i + 1;
+      if (c == '\\') {
+        if (next >= p.size() || std::isalnum(static_cast<unsigned char>(
+                                    p[next]))) {
+          break; // \d, \w, \b, backreferences, ...
+        }
+        c = p[next];
+        next = i + 2;
+      } else if (std::string(".[]()*+?{}^$").find(c) != std::string::npos) {
+        break;
+      }
+      // A quantifier making this character optional ends the literal
+      if (next < p.size() &&
+          (p[next] == '*' || p[next] == '?' || p[next] == '{')) {
+        break;
+      }
+      prefix.push_back(c);
+      i = next;
+    }
+    prefix_ = std::move(prefix);
+  }
+
+  std::string pattern_;
+  std::string prefix_;
+  bool anchored_;
+  std::shared_ptr<const PatternMatcher> matcher_;
+};
+
+/**
+ * Thread-safe, bounded LRU of compiled patterns, so a pattern repeated
+ * across requests is compiled once
+ */
+class PatternCache {
+public:
+  explicit PatternCache(size_t capacity) : capacity_(capacity) {}
+
+  PatternCache(const PatternCache &) = delete;
+  PatternCache &operator=(const PatternCache &) = delete;
+
+  /**
+   * Get the compiled pattern, compiling and caching it on a miss
+   * @throws std::exception if the pattern does not compile (not cached)
+   */
+  std::shared_ptr<const CompiledPattern> Get(const std::string &pattern) {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      auto it = index_.find(pattern);
+      if (it != index_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return it->second->second;
+      }
+    }
+
+    // Compile outside the lock; a racing miss may compile the same pattern
+    auto compiled = std::make_shared<const CompiledPattern>(pattern);
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = index_.find(pattern);
+    if (it != index_.end()) {
+      return it->second->second;
+    }
+    lru_.emplace_front(pattern, compiled);
+    index_[pattern] = lru_.begin();
+    while (lru_.size() > capacity_) {
+      index_.erase(lru_.back().first);
+      lru_.pop_back();
+    }
+    return compiled;
+  }
+
+  /** Number of cached patterns */
+  size_t GetSize() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return lru_.size();
+  }
+
+private:
+  using Entry = std::pair<std::string, std::shared_ptr<const CompiledPattern>>;
+
+  size_t capacity_;
+  std::list<Entry> lru_; // Most recently used first
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  std::mutex lock_;
+};
+
+} // namespace wrp_cte::core
+
+#endif // WRPCTE_CORE_PATTERN_H_
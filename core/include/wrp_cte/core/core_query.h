@@ -0,0 +1,103 @@
+#ifndef WRPCTE_CORE_QUERY_H_
+#define WRPCTE_CORE_QUERY_H_
+
+#include <chimaera/chimaera.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/**
+ * Fetch one page of query results from one container
+ * @param pool_query Routes the request to a single container
+ * @param max_results Max names returned
+ * @param cursor In: where to resume ("" = start); out: where the next page
+ * starts ("" = the container has no more results)
+ * @param names Out: the page
+ * @return false if the request failed
+ */
+using QueryPageFetcher = std::function<bool(
+    const chi::PoolQuery &pool_query, chi::u32 max_results,
+    std::string &cursor, std::vector<std::string> &names)>;
+
+/**
+ * Lazily pages through the results of TagQuery, BlobQuery or
+ * GetContainedBlobs
+ *
+ * Containers are visited one after the other and each is drained page by page
+ * with its own continuation cursor, so at most one page of names is held at a
+ * time no matter how many results the query has. Results are unordered across
+ * containers and ordered by name within one. A container whose request fails
+ * is skipped; GetFailedPages() reports how many pages were lost that way.
+ */
+class QueryResultIterator {
+public:
+  /** Page size used when none is given */
+  static constexpr chi::u32 kDefaultPageSize = 1024;
+
+  /**
+   * @param fetch Issues one page request
+   * @param page_size Max names per page
+   */
+  QueryResultIterator(QueryPageFetcher fetch, chi::u32 page_size)
+      : fetch_(std::move(fetch)), page_size_(std::max<chi::u32>(page_size, 1)),
+        num_containers_(std::max<chi::u32>(CHI_IPC->GetNumHosts(), 1)),
+        container_(0), pos_(0), failed_pages_(0) {}
+
+  /**
+   * Get the next result, fetching the next page when the current one is used
+   * up
+   * @return false once every container is exhausted
+   */
+  bool Next(std::string &name) {
+    while (pos_ >= page_.size()) {
+      if (container_ >= num_containers_) {
+        return false;
+      }
+      FetchPage();
+    }
+    name = std::move(page_[pos_++]);
+    return true;
+  }
+
+  /** Pages whose request failed; their container was skipped */
+  size_t GetFailedPages() const { return failed_pages_; }
+
+private:
+  /** Replace the current page with the next page of the current container */
+  void FetchPage() {
+    page_.clear();
+    pos_ = 0;
+    // The pool has one container per node, so DirectHash(i) lands on
+    // container i
+    std::string cursor = cursor_;
+    bool ok = fetch_(chi::PoolQuery::DirectHash(container_), page_size_,
+                     cursor, page_);
+    if (!ok) {
+      ++failed_pages_;
+      page_.clear();
+    }
+    if (!ok || cursor.empty()) {
+      ++container_;
+      cursor_.clear();
+    } else {
+      cursor_ = std::move(cursor);
+    }
+  }
+
+  QueryPageFetcher fetch_;
+  chi::u32 page_size_;
+  chi::u32 num_containers_;
+  chi::u32 container_;            /**< Container being drained */
+  std::string cursor_;            /**< Its continuation cursor */
+  std::vector<std::string> page_; /**< Current page */
+  size_t pos_;                    /**< Next result in page_ */
+  size_t failed_pages_;
+};
+
+} // namespace wrp_cte::core
+
+#endif // WRPCTE_CORE_QUERY_H_
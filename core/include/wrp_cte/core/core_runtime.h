@@ -6,10 +6,20 @@
 #include <chimaera/comutex.h>
 #include <chimaera/corwlock.h>
 #include <chimaera/unordered_map_ll.h>
-#include <hermes_shm/data_structures/ipc/ring_queue.h>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <wrp_cte/core/core_client.h>
 #include <wrp_cte/core/core_config.h>
+#include <wrp_cte/core/core_dpe.h>
+#include <wrp_cte/core/core_hash_ring.h>
+#include <wrp_cte/core/core_pattern.h>
 #include <wrp_cte/core/core_tasks.h>
+#include <wrp_cte/core/core_telemetry.h>
 
 // Forward declarations to avoid circular dependency
 namespace wrp_cte::core {
@@ -27,7 +37,7 @@ public:
   using CreateParams = wrp_cte::core::CreateParams; // Required for CHI_TASK_CC
 
   Runtime() = default;
-  ~Runtime() override = default;
+  ~Runtime() override;
 
   /**
    * Create the container (Method::kCreate)
@@ -79,6 +89,19 @@ public:
    */
   void GetBlob(hipc::FullPtr<GetBlobTask> task, chi::RunContext &ctx);
 
+  /**
+   * Put many blobs of one tag (Method::kPutBlobs)
+   * Allocates space for every entry, then issues all bdev writes before
+   * waiting on any of them
+   */
+  void PutBlobs(hipc::FullPtr<PutBlobsTask> task, chi::RunContext &ctx);
+
+  /**
+   * Get many blobs of one tag (Method::kGetBlobs)
+   * Issues all bdev reads before waiting on any of them
+   */
+  void GetBlobs(hipc::FullPtr<GetBlobsTask> task, chi::RunContext &ctx);
+
   /**
    * Reorganize single blob (Method::kReorganizeBlob) - update score for single
    * blob
@@ -128,6 +151,14 @@ private:
   // Client for this ChiMod
   Client client_;
 
+  // A bdev read or write in flight, tagged with the batch entry it serves
+  template <typename BdevTaskT> struct PendingBdevIo {
+    hipc::FullPtr<BdevTaskT> task_;
+    chi::u64 expected_size_;
+    chi::PoolId target_id_;
+    size_t owner_; // Index of the batch entry (0 for single-blob I/O)
+  };
+
   // Target management data structures (using chi::unordered_map_ll for
   // thread-safe concurrent access)
   chi::unordered_map_ll<chi::PoolId, TargetInfo> registered_targets_;
@@ -139,8 +170,10 @@ private:
   chi::unordered_map_ll<std::string, TagId>
       tag_name_to_id_;                                   // tag_name -> tag_id
   chi::unordered_map_ll<TagId, TagInfo> tag_id_to_info_; // tag_id -> TagInfo
-  chi::unordered_map_ll<std::string, BlobInfo>
-      tag_blob_name_to_info_; // "tag_id.blob_name" -> BlobInfo
+  chi::unordered_map_ll<BlobKey, BlobInfo>
+      tag_blob_name_to_info_; // (tag_id, blob_name) -> BlobInfo
+  chi::unordered_map_ll<TagId, std::set<std::string>>
+      tag_blob_index_; // tag_id -> names of blobs held by this container
 
   // Atomic counters for thread-safe ID generation
   std::atomic<chi::u32>
@@ -154,6 +187,25 @@ private:
       target_locks_; // For registered_targets_
   std::vector<std::unique_ptr<chi::CoRwLock>>
       tag_locks_; // For tag management structures
+  std::vector<std::unique_ptr<chi::CoRwLock>>
+      blob_locks_; // For tag_blob_name_to_info_ (indexed by BlobKey hash)
+
+  // Placement state: DPE type parsed once from config, plus a compact
+  // versioned snapshot of registered targets that is rebuilt only when the
+  // target set or target stats change
+  DpeType dpe_type_;
+  std::atomic<chi::u64> target_version_;
+  TargetSnapshot target_snapshot_;
+  chi::CoRwLock target_snapshot_lock_;
+  // When StatTargets last published fresh stats, and whether placement has
+  // already asked the maintenance thread for a new pass
+  std::atomic<chi::u64> target_stats_time_ns_{0};
+  std::atomic<bool> target_stats_requested_{false};
+
+  // Sorted copy of the keys of tag_name_to_id_. Adapter tags are file paths,
+  // so most queries are path-prefix queries answered from one range of it.
+  std::set<std::string> tag_name_index_;
+  chi::CoRwLock tag_name_index_lock_;
 
   // Storage configuration (parsed from config file)
   std::vector<StorageDeviceConfig> storage_devices_;
@@ -161,11 +213,83 @@ private:
   // CTE configuration (replaces ConfigManager singleton)
   Config config_;
 
-  // Telemetry ring buffer for performance monitoring
-  static const size_t kTelemetryRingSize = 1024; // Ring buffer size
-  hipc::circular_mpsc_queue<CteTelemetry> telemetry_log_;
-  std::atomic<std::uint64_t>
-      telemetry_counter_; // Atomic counter for logical time
+  // Telemetry ring for performance monitoring; the ring also assigns the
+  // logical time of each entry (sized by performance.telemetry_ring_size)
+  TelemetryRing telemetry_log_;
+
+  // Per-operation latency histograms, broken down by phase
+  RuntimeStats runtime_stats_;
+
+  // Blob migration copies through a staging buffer of at most this many bytes,
+  // which bounds the bdev I/O in flight for a single blob
+  static constexpr chi::u64 kMigrationWindowSize = 4ULL * 1024 * 1024;
+
+  // Background maintenance: a timer thread that enqueues maintenance tasks
+  // to this container on a per-job period; the work itself runs on workers
+  enum MaintenanceJob : chi::u32 {
+    kReorganizeTiersJob = 0,
+    kEnforceWatermarksJob,
+    kFlushDirtyJob,
+    kStatTargetsJob,
+    kMaintenanceJobCount
+  };
+  struct MaintenanceSchedule {
+    std::chrono::milliseconds period_{0}; // 0 = job disabled
+    std::chrono::steady_clock::time_point next_run_;
+  };
+  MaintenanceSchedule maintenance_jobs_[kMaintenanceJobCount];
+  std::atomic<chi::u32> maintenance_requests_{0}; // Bit per job to run early
+  std::thread maintenance_thread_;
+  std::mutex maintenance_mutex_;
+  std::condition_variable maintenance_cv_;
+  bool maintenance_stop_ = false;
+
+  // Write-back of file tags: byte ranges of page blobs written since their
+  // last flush, kept per container. FlushTag registers a tag's backing file;
+  // ranges are recorded only for registered tags. Blobs put with
+  // kPutBlobIfAbsent mirror the file and are not dirty.
+  using DirtyRanges = std::map<chi::u64, chi::u64>; // Page offset -> end
+  struct DirtyFile {
+    std::string path_;
+    chi::u64 page_size_ = 0;
+    std::map<chi::u64, DirtyRanges> pages_; // Page index -> dirty ranges
+  };
+  std::unordered_map<TagId, DirtyFile, hshm::hash<TagId>> dirty_files_;
+  std::mutex dirty_mutex_;
+
+  // Blob and tag routing; rebuilt when the number of containers changes
+  HashRing hash_ring_;
+  chi::CoRwLock hash_ring_lock_;
+
+  // Blobs moved concurrently by RebalanceBlobs
+  static constexpr size_t kRebalanceBatch = 32;
+
+  // Weight of a new bdev sample in the smoothed target metrics; the rest
+  // comes from the previous smoothed value
+  static constexpr double kTargetStatEwmaWeight = 0.3;
+
+  // Write-back reads at most this many contiguous dirty bytes per run and
+  // keeps this many runs in flight
+  static constexpr chi::u64 kFlushRunSize = 16ULL * 1024 * 1024;
+  static constexpr size_t kFlushDepth = 4;
+
+  // Append cursors: the next append offset of each file tag, kept by the one
+  // container the tag's appends are routed to. Seeded from the tag size on
+  // the tag's first append, then raised by appends, by positional page writes
+  // run on this container and by the caller's floor; reset by TruncateTag.
+  struct AppendCursor {
+    chi::u64 next_ = 0;
+    chi::u64 page_size_ = 0;  // Page size of the tag's last append
+  };
+  std::unordered_map<TagId, AppendCursor, hshm::hash<TagId>> append_cursors_;
+  std::mutex append_mutex_;
+
+  // Compiled TagQuery/BlobQuery patterns, most recently used kept
+  static constexpr size_t kQueryPatternCacheSize = 64;
+  PatternCache query_patterns_{kQueryPatternCacheSize};
+
+  // Blob names read from the per-tag index at a time by a paged BlobQuery
+  static constexpr size_t kQueryScanBatch = 1024;
 
   /**
    * Get access to configuration manager
@@ -174,8 +298,22 @@ private:
 
   /**
    * Helper function to update target performance statistics
+   * Folds a fresh bdev sample into the target's EWMA-smoothed metrics and
+   * refreshes its remaining space; scores are left to NormalizeTargetScores
+   * @param sample Metrics returned by the target's bdev
+   * @param remaining_space Remaining space reported with the sample
    */
-  void UpdateTargetStats(const chi::PoolId &target_id, TargetInfo &target_info);
+  void UpdateTargetStats(TargetInfo &target_info,
+                         const chimaera::bdev::PerfMetrics &sample,
+                         chi::u64 remaining_space);
+
+  /**
+   * Score every auto-scored target as log(bw + 1) / log(max_bw + 1), where
+   * bw is the larger of its smoothed read and write bandwidth and max_bw is
+   * the largest such bandwidth over all registered targets. The caller holds
+   * the target stats lock for writing.
+   */
+  void NormalizeTargetScores();
 
   /**
    * Helper function to get manual score for a target from storage device config
@@ -185,6 +323,15 @@ private:
    */
   float GetManualScoreForTarget(const std::string &target_name);
 
+  /**
+   * Find the configured storage device a target was registered for
+   * @param target_name Target name (device path, optionally with a _node
+   * suffix, or storage_device_<index>)
+   * @return Device config, nullptr if the target is not from the config
+   */
+  const StorageDeviceConfig *FindDeviceForTarget(
+      const std::string &target_name) const;
+
   /**
    * Helper function to get or assign a tag ID
    */
@@ -202,6 +349,11 @@ private:
    */
   size_t GetTargetLockIndex(const chi::PoolId &target_id) const;
 
+  /**
+   * Target lock that serializes updates of target metrics and scores
+   */
+  size_t GetTargetStatsLockIndex() const;
+
   /**
    * Get tag lock index based on tag name hash
    */
@@ -212,6 +364,36 @@ private:
    */
   size_t GetTagLockIndex(const TagId &tag_id) const;
 
+  /**
+   * Get blob lock index from the key's precomputed hash
+   */
+  size_t GetBlobLockIndex(const BlobKey &blob_key) const;
+
+  /**
+   * Mark the target snapshot stale so the next placement rebuilds it
+   */
+  void InvalidateTargetSnapshot();
+
+  /**
+   * Rebuild target_snapshot_ from registered_targets_ if it is out of date
+   */
+  void RefreshTargetSnapshot();
+
+  /**
+   * Build a snapshot from registered_targets_ outside the snapshot lock and
+   * swap it in, so readers see either the old or the new one in full
+   */
+  void PublishTargetSnapshot();
+
+  /**
+   * Ask the maintenance thread for a StatTargets pass if the published stats
+   * are older than performance.target_stat_interval_ms; never blocks
+   */
+  void RequestTargetStatsIfStale();
+
+  /** Steady-clock time in nanoseconds */
+  static chi::u64 SteadyNowNs();
+
   /**
    * Allocate space from a target for new blob data
    * @param target_info Target to allocate from
@@ -224,28 +406,169 @@ private:
 
   /**
    * Free all blocks from a blob back to their respective targets
-   * @param blob_info BlobInfo containing blocks to free
+   * @param blob_info BlobInfo containing blocks to free; retired blocks are
+   * freed with them
    * @return 0 on success, non-zero on error
    */
   chi::u32 FreeAllBlobBlocks(BlobInfo &blob_info);
 
+  /**
+   * Hand blocks just swapped out of a blob to the blob while reads are in
+   * flight, so the last read frees them. Call under the blob write lock.
+   * @param blob_info Blob whose block list was swapped
+   * @param released Holds the swapped-out blocks; emptied if they are retired
+   */
+  void RetireBlocks(BlobInfo &blob_info, BlobInfo &released);
+
   /**
    * Check if blob exists and return pointer to BlobInfo if found
-   * @param blob_name Blob name to search for (required)
-   * @param tag_id Tag ID to search within
+   * @param blob_key Tag ID and blob name to search for (name required)
    * @return Pointer to BlobInfo if found, nullptr if not found
    */
-  BlobInfo *CheckBlobExists(const std::string &blob_name, const TagId &tag_id);
+  BlobInfo *CheckBlobExists(const BlobKey &blob_key);
 
   /**
-   * Create new blob with given parameters
-   * @param blob_name Name for the new blob (required)
-   * @param tag_id Tag ID to associate blob with
+   * Create new blob with given parameters, or find it if another task created
+   * it first. The lookup and insertion happen under one blob write lock.
+   * @param blob_key Tag ID and name for the new blob (name required)
    * @param blob_score Score/priority for the blob
-   * @return Pointer to created BlobInfo, nullptr on failure
+   * @param created Set to true only if this call inserted the blob
+   * @return Pointer to the blob's BlobInfo, nullptr on failure
+   */
+  BlobInfo *CreateNewBlob(const BlobKey &blob_key, float blob_score,
+                          bool &created);
+
+  /**
+   * Marks a write to a blob as in flight for its lifetime. A block-list swap
+   * (MigrateBlob, ShrinkBlob) is abandoned if any write was in flight or
+   * started or finished while the swapped-in copy was made.
    */
-  BlobInfo *CreateNewBlob(const std::string &blob_name, const TagId &tag_id,
-                          float blob_score);
+  class BlobWriteGuard {
+  public:
+    BlobWriteGuard() : runtime_(nullptr), lock_index_(0), blob_info_(nullptr) {}
+    BlobWriteGuard(Runtime *runtime, const BlobKey &blob_key,
+                   BlobInfo *blob_info);
+    BlobWriteGuard(BlobWriteGuard &&other) noexcept;
+    BlobWriteGuard &operator=(BlobWriteGuard &&other) noexcept;
+    BlobWriteGuard(const BlobWriteGuard &) = delete;
+    BlobWriteGuard &operator=(const BlobWriteGuard &) = delete;
+    ~BlobWriteGuard() { Release(); }
+
+    /** End the write early */
+    void Release();
+
+  private:
+    Runtime *runtime_;
+    size_t lock_index_;
+    BlobInfo *blob_info_;
+  };
+
+  /**
+   * Marks a read of a blob as in flight for its lifetime and holds a copy of
+   * the block list taken under the blob lock. Blocks a swap (MigrateBlob,
+   * ShrinkBlob) takes out of the blob stay allocated until every read in
+   * flight at the time has ended.
+   */
+  class BlobReadGuard {
+  public:
+    BlobReadGuard() : runtime_(nullptr), lock_index_(0), blob_info_(nullptr) {}
+    BlobReadGuard(Runtime *runtime, const BlobKey &blob_key,
+                  BlobInfo *blob_info);
+    BlobReadGuard(BlobReadGuard &&other) noexcept;
+    BlobReadGuard &operator=(BlobReadGuard &&other) noexcept;
+    BlobReadGuard(const BlobReadGuard &) = delete;
+    BlobReadGuard &operator=(const BlobReadGuard &) = delete;
+    ~BlobReadGuard() { Release(); }
+
+    /** Blocks to read from */
+    const std::vector<BlobBlock> &GetBlocks() const { return blocks_; }
+
+    /** End the read early */
+    void Release();
+
+  private:
+    Runtime *runtime_;
+    size_t lock_index_;
+    BlobInfo *blob_info_;
+    std::vector<BlobBlock> blocks_;
+  };
+
+  /**
+   * Add a tag name to tag_name_index_ (after inserting it in tag_name_to_id_)
+   */
+  void IndexTagName(const std::string &tag_name);
+
+  /**
+   * Remove a tag name from tag_name_index_
+   */
+  void UnindexTagName(const std::string &tag_name);
+
+  /**
+   * Names of the tags known here that fully match a pattern, in name order.
+   * Only the names starting with the pattern's literal prefix are tested; a
+   * pattern without one scans every name.
+   * @param after Return only names ordered after this one ("" = from start)
+   * @param limit Stop after this many names (0 = no limit)
+   */
+  std::vector<std::string> FindTagNames(const CompiledPattern &pattern,
+                                        const std::string &after = "",
+                                        size_t limit = 0);
+
+  /**
+   * Snapshot the names of all blobs this container holds for a tag
+   * @param tag_id Tag ID to list
+   * @return Blob names from the per-tag index (empty if the tag has no blobs)
+   */
+  std::vector<std::string> GetTagBlobNames(const TagId &tag_id);
+
+  /**
+   * Snapshot the tags this container holds blobs for. Every tag lock is held
+   * for reading while the index is walked.
+   */
+  std::vector<TagId> GetIndexedTagIds();
+
+  /**
+   * Hand the tags created here whose name now belongs to another container
+   * on the hash ring to that container, which becomes their canonical owner.
+   * Resolving the name there then yields the existing TagId instead of a new
+   * one that would orphan the tag's blobs.
+   * @return Number of tags handed over
+   */
+  chi::u32 HandOverTags(chi::u32 container_id);
+
+  /**
+   * One page of the names of the blobs this container holds for a tag, in
+   * name order
+   * @param after Return only names ordered after this one ("" = from start)
+   * @param limit Max names returned (0 = no limit)
+   */
+  std::vector<std::string> GetTagBlobNames(const TagId &tag_id,
+                                           const std::string &after,
+                                           size_t limit);
+
+  /**
+   * Read a blob's metadata and test it against BlobQuery predicates
+   * @param now Time the ages in stat are measured from
+   * @param stat Out: the blob's metadata (set whenever the blob exists)
+   * @return Whether the blob exists and satisfies every predicate
+   */
+  bool EvalBlobPredicate(const BlobKey &blob_key,
+                         const BlobQueryPredicate &predicate,
+                         const Timestamp &now, BlobQueryStat &stat);
+
+  /**
+   * BlobQuery cursor for resuming after blob_name of tag_name
+   */
+  static std::string EncodeBlobQueryCursor(const std::string &tag_name,
+                                           const std::string &blob_name);
+
+  /**
+   * Split a BlobQuery cursor
+   * @return false if the cursor is malformed
+   */
+  static bool DecodeBlobQueryCursor(const std::string &cursor,
+                                    std::string &tag_name,
+                                    std::string &blob_name);
 
   /**
    * Allocate new data blocks for blob expansion
@@ -253,10 +576,29 @@ private:
    * @param offset Offset where data starts (for determining required size)
    * @param size Size of data to accommodate
    * @param blob_score Score for target selection
+   * @param excluded_targets Targets that must not receive the new blocks
    * @return Error code: 0 for success, 1 for failure
    */
-  chi::u32 AllocateNewData(BlobInfo &blob_info, chi::u64 offset, chi::u64 size,
-                           float blob_score);
+  chi::u32 AllocateNewData(
+      BlobInfo &blob_info, chi::u64 offset, chi::u64 size, float blob_score,
+      const std::vector<chi::PoolId> &excluded_targets = {});
+
+  /**
+   * Allocate size bytes as stripe units placed round-robin on the first
+   * dpe.stripe_width targets of ordered_targets that can hold a unit, so
+   * ModifyExistingData and ReadData of any large range reach all of them
+   * @return Bytes left unallocated (size if fewer than two targets qualify)
+   */
+  chi::u64 AllocateStriped(BlobInfo &blob_info,
+                           const std::vector<chi::PoolId> &ordered_targets,
+                           chi::u64 size);
+
+  /**
+   * Allocate one block from a target and append it to the blob
+   * @return True if the block was allocated
+   */
+  bool AppendBlock(BlobInfo &blob_info, TargetInfo &target_info,
+                   chi::u64 size);
 
   /**
    * Write data to existing blob blocks
@@ -264,11 +606,13 @@ private:
    * @param offset Offset within blob where data starts
    * @param size Size of data to write
    * @param blob_data Pointer to data to write
+   * @param timer Optional operation timer charged for the io and wait phases
    * @return Error code: 0 for success, 1 for failure
    */
   chi::u32 ModifyExistingData(const std::vector<BlobBlock> &blocks,
                               hipc::Pointer data, size_t data_size,
-                              size_t data_offset_in_blob);
+                              size_t data_offset_in_blob,
+                              OpTimer *timer = nullptr);
 
   /**
    * Read existing blob data from blocks
@@ -276,10 +620,229 @@ private:
    * @param data Output buffer to read data into
    * @param data_size Size of data to read
    * @param data_offset_in_blob Offset within blob where reading starts
+   * @param timer Optional operation timer charged for the io and wait phases
    * @return Error code: 0 for success, 1 for failure
    */
   chi::u32 ReadData(const std::vector<BlobBlock> &blocks, hipc::Pointer data,
-                    size_t data_size, size_t data_offset_in_blob);
+                    size_t data_size, size_t data_offset_in_blob,
+                    OpTimer *timer = nullptr);
+
+  /**
+   * Issue async bdev writes covering a range of a blob without waiting
+   * @param blocks Blocks of the blob
+   * @param data Data to write
+   * @param data_size Size of data to write
+   * @param data_offset_in_blob Offset within blob where data starts
+   * @param owner Batch entry index recorded on each write
+   * @param writes Output writes in flight (appended)
+   */
+  void IssueWrites(const std::vector<BlobBlock> &blocks, hipc::Pointer data,
+                   size_t data_size, size_t data_offset_in_blob, size_t owner,
+                   std::vector<PendingBdevIo<chimaera::bdev::WriteTask>> &writes);
+
+  /**
+   * Wait for and free every write issued by IssueWrites
+   * @param writes Writes in flight (cleared)
+   * @param owner_failed Optional per-entry flags set for failed writes
+   * @return Number of writes that transferred fewer bytes than requested
+   */
+  chi::u32 WaitWrites(
+      std::vector<PendingBdevIo<chimaera::bdev::WriteTask>> &writes,
+      std::vector<bool> *owner_failed);
+
+  /**
+   * Issue async bdev reads covering a range of a blob without waiting
+   * @param blocks Blocks of the blob
+   * @param data Output buffer
+   * @param data_size Size of data to read
+   * @param data_offset_in_blob Offset within blob where reading starts
+   * @param owner Batch entry index recorded on each read
+   * @param reads Output reads in flight (appended)
+   */
+  void IssueReads(const std::vector<BlobBlock> &blocks, hipc::Pointer data,
+                  size_t data_size, size_t data_offset_in_blob, size_t owner,
+                  std::vector<PendingBdevIo<chimaera::bdev::ReadTask>> &reads);
+
+  /**
+   * Wait for and free every read issued by IssueReads
+   * @param reads Reads in flight (cleared)
+   * @param owner_failed Optional per-entry flags set for failed reads
+   * @return Number of reads that transferred fewer bytes than requested
+   */
+  chi::u32 WaitReads(std::vector<PendingBdevIo<chimaera::bdev::ReadTask>> &reads,
+                     std::vector<bool> *owner_failed);
+
+  /**
+   * Group batch entries by the container owning their blob on the hash ring
+   * @param tag_id Tag of the batch
+   * @param blob_names Concatenated blob names of the batch
+   * @param entries Batch entries
+   * @param groups Output entry indices per destination container
+   * @param group_owners Output container each group is routed to
+   */
+  void GroupBlobBatch(const TagId &tag_id, std::string_view blob_names,
+                      const hipc::vector<BlobBatchEntry> &entries,
+                      std::vector<std::vector<size_t>> &groups,
+                      std::vector<chi::u32> &group_owners);
+
+  /**
+   * Route a batch: straight to its container if every entry lives on one,
+   * otherwise locally so the handler can split it
+   */
+  chi::PoolQuery RouteBlobBatch(const TagId &tag_id,
+                                std::string_view blob_names,
+                                const hipc::vector<BlobBatchEntry> &entries);
+
+  /**
+   * Split a batch spanning several containers into one sub-batch per
+   * container, submit them and copy the per-entry results back
+   * @param task Batch task to split
+   * @param groups Entry indices per destination container
+   * @param group_owners Container each group is routed to
+   * @param submit Callable (requests, pool_query) -> async sub-batch task
+   */
+  template <typename BatchTaskT, typename SubmitFn>
+  void ForwardBlobBatch(hipc::FullPtr<BatchTaskT> task,
+                        const std::vector<std::vector<size_t>> &groups,
+                        const std::vector<chi::u32> &group_owners,
+                        SubmitFn submit);
+
+  /**
+   * Add one completed bdev read or write to a target's I/O counters
+   * @param target_id Target the I/O went to
+   * @param bytes Number of bytes transferred
+   * @param is_write True for a write, false for a read
+   */
+  void RecordTargetIo(const chi::PoolId &target_id, chi::u64 bytes,
+                      bool is_write);
+
+  /**
+   * Size-weighted target score of the targets currently holding a blob
+   * @param blocks Blocks of the blob
+   * @return Placement score (0.0-1.0), 0 if no block maps to a known target
+   */
+  float GetPlacementScore(const std::vector<BlobBlock> &blocks);
+
+  /**
+   * Score of the target the DPE would place a blob of this size on
+   * @param blob_score Score of the blob
+   * @param blob_size Size of the blob in bytes
+   * @param target_score Output score of the DPE's first choice
+   * @return True if some target has room for the whole blob
+   */
+  bool GetPreferredTargetScore(float blob_score, chi::u64 blob_size,
+                               float &target_score);
+
+  /**
+   * Move a blob's data onto the targets the DPE picks for a new score.
+   * New blocks are allocated and filled before blocks_ is swapped under the
+   * blob write lock; the old blocks are freed afterwards, or by the last
+   * read still using them.
+   * @param blob_key Key of the blob (selects the blob lock)
+   * @param blob_info Blob to migrate
+   * @param blob_score Score to place the blob by
+   * @param bytes_moved Output number of bytes copied
+   * @param excluded_targets Targets the blob must not be moved onto
+   * @param timer Optional operation timer charged for each phase of the move
+   * @return 0 on success, 1 buffer allocation failure, 2 placement failure,
+   * 3 copy failure, 4 blob written before or during the copy
+   */
+  chi::u32 MigrateBlob(const BlobKey &blob_key, BlobInfo &blob_info,
+                       float blob_score, chi::u64 &bytes_moved,
+                       const std::vector<chi::PoolId> &excluded_targets = {},
+                       OpTimer *timer = nullptr);
+
+  /**
+   * Shrink a blob to new_size bytes. Blocks wholly past the new size are
+   * freed; a block straddling it is copied into a smaller block on the same
+   * target and swapped in under the blob write lock. The released blocks are
+   * freed then, or by the last read still using them.
+   * @param blob_key Key of the blob (selects the blob lock)
+   * @param blob_info Blob to shrink
+   * @param new_size Size to shrink to; a blob no larger is left unchanged
+   * @param bytes_freed Output number of bytes removed from the blob
+   * @return 0 on success, 1 buffer allocation failure, 2 allocation failure,
+   * 3 copy failure, 4 blob written before or during the copy
+   */
+  chi::u32 ShrinkBlob(const BlobKey &blob_key, BlobInfo &blob_info,
+                      chi::u64 new_size, chi::u64 &bytes_freed);
+
+  /**
+   * Reserve size bytes at the end of a file tag
+   * @param min_offset Lowest offset the range may start at
+   * @param page_size Page size of the tag's page blobs
+   * @return Start of the reserved range
+   */
+  chi::u64 ReserveAppend(const TagId &tag_id, chi::u64 size,
+                         chi::u64 min_offset, chi::u64 page_size);
+
+  /**
+   * Raise a tag's append cursor past a positional write of a page blob.
+   * Does nothing unless this container holds the tag's append cursor.
+   * @param tag_id Tag of the blob
+   * @param blob_name Blob name; ignored unless it is a page index
+   * @param offset Offset of the write within the page
+   * @param size Bytes written
+   */
+  void RaiseAppendCursor(const TagId &tag_id, std::string_view blob_name,
+                         chi::u64 offset, chi::u64 size);
+
+  /**
+   * Record that [offset, offset + size) of a page blob was written. Nothing
+   * is recorded for a tag whose backing file is not registered.
+   * @param tag_id Tag of the blob
+   * @param blob_name Blob name; ignored unless it is a page index
+   * @param offset Offset of the write within the page
+   * @param size Bytes written
+   */
+  void MarkPageDirty(const TagId &tag_id, std::string_view blob_name,
+                     chi::u64 offset, chi::u64 size);
+
+  /**
+   * Register a tag's backing file for write-back. Only ranges written after
+   * registration are tracked.
+   */
+  void RegisterDirtyFile(const TagId &tag_id, const std::string &path,
+                         chi::u64 page_size);
+
+  /**
+   * Write the dirty ranges of one file back with coalesced, pipelined pwrites
+   * in offset order. Bytes of a page that were never written are left alone.
+   * Ranges that fail are marked dirty again.
+   * @param durable Sync the file to stable storage afterwards
+   * @return 0 on success, non-zero if any page failed
+   */
+  chi::u32 FlushDirtyFile(const TagId &tag_id, const DirtyFile &file,
+                          bool durable, chi::u64 &pages_flushed,
+                          chi::u64 &bytes_flushed, chi::u64 &failed_pages);
+
+  /**
+   * Start the maintenance thread if any maintenance job has a non-zero period
+   */
+  void StartMaintenanceThread();
+
+  /**
+   * Stop and join the maintenance thread (no-op if it is not running)
+   */
+  void StopMaintenanceThread();
+
+  /**
+   * Ask the maintenance thread to run a job now instead of at its next period
+   * @param job Job to run early (ignored if the job is disabled)
+   */
+  void RequestMaintenance(MaintenanceJob job);
+
+  /**
+   * Enqueue one maintenance job to this container and wait for it
+   * @param job Job to run
+   */
+  void RunMaintenanceJob(MaintenanceJob job);
+
+  /**
+   * Maintenance thread body: run each job when its period elapses or when it
+   * is requested early, until stopped
+   */
+  void MaintenanceLoop();
 
   /**
    * Log telemetry data for CTE operations
@@ -307,13 +870,16 @@ private:
   chi::u64 ParseCapacityToBytes(const std::string &capacity_str);
 
   /**
-   * Retrieve telemetry entries for analysis (non-destructive peek)
+   * Copy telemetry entries logged after a cursor (does not modify the ring)
    * @param entries Vector to store retrieved entries
-   * @param max_entries Maximum number of entries to retrieve
-   * @return Number of entries actually retrieved
+   * @param cursor Last logical time already seen by the caller
+   * @param max_entries Maximum number of entries to retrieve (0 = ring size)
+   * @param dropped Output count of entries overwritten before they were read
+   * @return Cursor to pass to the next call
    */
-  size_t GetTelemetryEntries(std::vector<CteTelemetry> &entries,
-                             size_t max_entries = 100);
+  std::uint64_t GetTelemetryEntries(std::vector<CteTelemetry> &entries,
+                                    std::uint64_t cursor, size_t max_entries,
+                                    std::uint64_t &dropped);
 
   /**
    * Poll telemetry log (Method::kPollTelemetryLog)
@@ -359,15 +925,114 @@ private:
    */
   void BlobQuery(hipc::FullPtr<BlobQueryTask> task, chi::RunContext &ctx);
 
+  /**
+   * Migrate blobs whose placement no longer fits their score
+   * (Method::kReorganizeTiers)
+   * @param task ReorganizeTiers task containing the pass limit and counters
+   * @param ctx Runtime context for task execution
+   */
+  void ReorganizeTiers(hipc::FullPtr<ReorganizeTiersTask> task,
+                       chi::RunContext &ctx);
+
+  /**
+   * Demote cold blobs off targets above their high watermark
+   * (Method::kEnforceWatermarks)
+   * @param task EnforceWatermarks task containing the pass limit and counters
+   * @param ctx Runtime context for task execution
+   */
+  void EnforceWatermarks(hipc::FullPtr<EnforceWatermarksTask> task,
+                         chi::RunContext &ctx);
+
+  /**
+   * Report latency histograms and per-target I/O counters
+   * (Method::kGetRuntimeStats)
+   * @param task GetRuntimeStats task containing the reset flag and results
+   * @param ctx Runtime context for task execution
+   */
+  void GetRuntimeStats(hipc::FullPtr<GetRuntimeStatsTask> task,
+                       chi::RunContext &ctx);
+
+  /**
+   * Store a range of a backing file as the page blobs of its tag
+   * (Method::kStageIn)
+   * @param task StageIn task containing the file range and counters
+   * @param ctx Runtime context for task execution
+   */
+  void StageIn(hipc::FullPtr<StageInTask> task, chi::RunContext &ctx);
+
+  /**
+   * Write the dirty page blobs of a tag back to its backing file
+   * (Method::kFlushTag)
+   * @param task FlushTag task containing the file and counters
+   * @param ctx Runtime context for task execution
+   */
+  void FlushTag(hipc::FullPtr<FlushTagTask> task, chi::RunContext &ctx);
+
+  /**
+   * Shrink a blob, freeing the blocks past its new size
+   * (Method::kTruncateBlob)
+   * @param task TruncateBlob task containing the blob and new size
+   * @param ctx Runtime context for task execution
+   */
+  void TruncateBlob(hipc::FullPtr<TruncateBlobTask> task,
+                    chi::RunContext &ctx);
+
+  /**
+   * Delete or shrink the page blobs of a tag past a new file size
+   * (Method::kTruncateTag)
+   * @param task TruncateTag task containing the new size and counters
+   * @param ctx Runtime context for task execution
+   */
+  void TruncateTag(hipc::FullPtr<TruncateTagTask> task, chi::RunContext &ctx);
+
+  /**
+   * Reserve the end of a file tag and write data there
+   * (Method::kAppendToTag)
+   * @param task AppendToTag task containing the data; receives the offset
+   * @param ctx Runtime context for task execution
+   */
+  void AppendToTag(hipc::FullPtr<AppendToTagTask> task, chi::RunContext &ctx);
+
+  /**
+   * Move the blobs held here whose hash ring owner is another container
+   * (Method::kRebalanceBlobs)
+   * @param task RebalanceBlobs task; receives the blobs and bytes moved
+   * @param ctx Runtime context for task execution
+   */
+  void RebalanceBlobs(hipc::FullPtr<RebalanceBlobsTask> task,
+                      chi::RunContext &ctx);
+
 private:
   /**
    * Helper function to compute hash-based pool query for blob operations
    * @param tag_id Tag ID for the blob
    * @param blob_name Blob name
-   * @return PoolQuery with DirectHash based on tag_id and blob_name
+   * @return PoolQuery with DirectHash to the blob's owner on the hash ring
    */
   chi::PoolQuery HashBlobToContainer(const TagId &tag_id,
-                                     const std::string &blob_name);
+                                     std::string_view blob_name);
+
+  /**
+   * Container owning a hash on the consistent-hash ring, rebuilding the ring
+   * first if the number of containers changed
+   */
+  chi::u32 GetOwnerContainer(chi::u64 hash);
+
+  /**
+   * ID of this container within the pool, which is also the DirectHash value
+   * that reaches it and its index on the hash ring
+   */
+  chi::u32 GetLocalContainerId() const;
+
+  /**
+   * Container a tag name is resolved by: the canonical owner of its TagInfo
+   */
+  chi::u32 GetTagOwnerContainer(const std::string &tag_name);
+
+  /**
+   * Hash of (tag_id, blob_name) used to pick a blob's container
+   */
+  static chi::u32 HashBlob(const TagId &tag_id, std::string_view blob_name);
 };
 
 } // namespace wrp_cte::core
@@ -0,0 +1,121 @@
+#ifndef WRPCTE_CORE_STAGING_H_
+#define WRPCTE_CORE_STAGING_H_
+
+#include <chimaera/chimaera.h>
+#include <cstddef>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/**
+ * Per-thread pool of shared memory staging buffers
+ *
+ * Buffers are grouped into power-of-two size classes from 4KB to 16MB.
+ * Released buffers are kept on the calling thread's free list for their class
+ * and handed back out by later Acquire() calls, so repeated PutBlob/GetBlob
+ * calls do not go through CHI_IPC->AllocateBuffer/FreeBuffer each time.
+ * Requests larger than the biggest class are allocated and freed directly.
+ */
+class StagingPool {
+public:
+  static constexpr chi::u32 kMinClassBits = 12; // 4KB
+  static constexpr chi::u32 kMaxClassBits = 24; // 16MB
+  static constexpr size_t kNumClasses = kMaxClassBits - kMinClassBits + 1;
+  static constexpr size_t kMaxBuffersPerClass = 4;
+  static constexpr size_t kMaxCachedBytes = 64ULL * 1024 * 1024;
+
+  StagingPool() : cached_bytes_(0) {}
+  ~StagingPool();
+
+  StagingPool(const StagingPool &) = delete;
+  StagingPool &operator=(const StagingPool &) = delete;
+
+  /** The calling thread's pool */
+  static StagingPool &Get();
+
+  /**
+   * Get a shared memory buffer of at least size bytes
+   * @return Null FullPtr if shared memory is exhausted
+   */
+  hipc::FullPtr<char> Acquire(size_t size);
+
+  /**
+   * Return a buffer obtained from Acquire(size) with the same size
+   */
+  void Release(const hipc::FullPtr<char> &buffer, size_t size);
+
+  /** Free every cached buffer of this thread */
+  void Trim();
+
+  /** Bytes currently held on this thread's free lists */
+  size_t GetCachedBytes() const { return cached_bytes_; }
+
+  /** Capacity of the buffer Acquire(size) hands out */
+  static size_t GetCapacity(size_t size);
+
+private:
+  /** Size class of a request, or kNumClasses if it is not pooled */
+  static size_t GetClass(size_t size);
+
+  std::vector<hipc::FullPtr<char>> free_lists_[kNumClasses];
+  size_t cached_bytes_;
+};
+
+/**
+ * Move-only shared memory I/O buffer drawn from the calling thread's
+ * StagingPool and returned to it on destruction. Data written through data()
+ * is visible to the runtime through shm() without another copy.
+ */
+class IoBuffer {
+public:
+  IoBuffer() : size_(0) {}
+
+  /** Acquire a buffer of size bytes; IsNull() if shared memory is exhausted */
+  explicit IoBuffer(size_t size)
+      : buffer_(StagingPool::Get().Acquire(size)), size_(size) {}
+
+  ~IoBuffer() { Reset(); }
+
+  IoBuffer(const IoBuffer &) = delete;
+  IoBuffer &operator=(const IoBuffer &) = delete;
+
+  IoBuffer(IoBuffer &&other) noexcept
+      : buffer_(other.buffer_), size_(other.size_) {
+    other.buffer_.SetNull();
+    other.size_ = 0;
+  }
+
+  IoBuffer &operator=(IoBuffer &&other) noexcept {
+    if (this != &other) {
+      Reset();
+      buffer_ = other.buffer_;
+      size_ = other.size_;
+      other.buffer_.SetNull();
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  /** Return the buffer to the pool */
+  void Reset() {
+    if (!buffer_.IsNull()) {
+      StagingPool::Get().Release(buffer_, size_);
+      buffer_.SetNull();
+    }
+    size_ = 0;
+  }
+
+  bool IsNull() const { return buffer_.IsNull(); }
+  char *data() { return buffer_.ptr_; }
+  const char *data() const { return buffer_.ptr_; }
+  size_t size() const { return size_; }
+  const hipc::Pointer &shm() const { return buffer_.shm_; }
+
+private:
+  hipc::FullPtr<char> buffer_;
+  size_t size_;
+};
+
+} // namespace wrp_cte::core
+
+#endif // WRPCTE_CORE_STAGING_H_
@@ -0,0 +1,309 @@
+#ifndef WRPCTE_CORE_STATS_H_
+#define WRPCTE_CORE_STATS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chimaera/chimaera.h>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/**
+ * Runtime operations with latency histograms
+ */
+enum class StatOp : chi::u32 {
+  kPutBlob = 0,
+  kGetBlob = 1,
+  kDelBlob = 2,
+  kReorganizeBlob = 3,
+  kTagQuery = 4,
+  kBlobQuery = 5,
+  kPutBlobs = 6,
+  kGetBlobs = 7,
+  kFlushTag = 8,
+  kCount
+};
+
+/**
+ * Phases an operation's latency is broken into. kTotal is the whole handler;
+ * the others are the time spent in each phase within it.
+ */
+enum class StatPhase : chi::u32 {
+  kTotal = 0,      // Whole operation
+  kMetadata = 1,   // Blob/tag table lookups and updates
+  kAllocation = 2, // Target selection, block allocation and freeing
+  kIo = 3,         // Issuing bdev reads/writes
+  kWait = 4,       // Waiting for bdev reads/writes to complete
+  kCount
+};
+
+static constexpr size_t kStatOpCount = static_cast<size_t>(StatOp::kCount);
+static constexpr size_t kStatPhaseCount =
+    static_cast<size_t>(StatPhase::kCount);
+
+inline const char *StatOpName(StatOp op) {
+  switch (op) {
+  case StatOp::kPutBlob:
+    return "PutBlob";
+  case StatOp::kGetBlob:
+    return "GetBlob";
+  case StatOp::kDelBlob:
+    return "DelBlob";
+  case StatOp::kReorganizeBlob:
+    return "ReorganizeBlob";
+  case StatOp::kTagQuery:
+    return "TagQuery";
+  case StatOp::kBlobQuery:
+    return "BlobQuery";
+  case StatOp::kPutBlobs:
+    return "PutBlobs";
+  case StatOp::kGetBlobs:
+    return "GetBlobs";
+  case StatOp::kFlushTag:
+    return "FlushTag";
+  default:
+    return "Unknown";
+  }
+}
+
+inline const char *StatPhaseName(StatPhase phase) {
+  switch (phase) {
+  case StatPhase::kTotal:
+    return "total";
+  case StatPhase::kMetadata:
+    return "metadata";
+  case StatPhase::kAllocation:
+    return "allocation";
+  case StatPhase::kIo:
+    return "io";
+  case StatPhase::kWait:
+    return "wait";
+  default:
+    return "unknown";
+  }
+}
+
+/**
+ * Latency summary of one (operation, phase) histogram, in nanoseconds
+ * Percentiles are bucket upper bounds (within 12.5% of the true value)
+ */
+struct LatencySummary {
+  chi::u32 op_;    // StatOp
+  chi::u32 phase_; // StatPhase
+  chi::u64 count_;
+  chi::u64 sum_ns_;
+  chi::u64 min_ns_;
+  chi::u64 max_ns_;
+  chi::u64 p50_ns_;
+  chi::u64 p90_ns_;
+  chi::u64 p99_ns_;
+  chi::u64 p999_ns_;
+
+  LatencySummary()
+      : op_(0), phase_(0), count_(0), sum_ns_(0), min_ns_(0), max_ns_(0),
+        p50_ns_(0), p90_ns_(0), p99_ns_(0), p999_ns_(0) {}
+
+  /**
+   * Merge a summary of the same series from another node. Counts, sums and
+   * extremes are exact; percentiles take the larger (pessimistic) value.
+   */
+  void Merge(const LatencySummary &other) {
+    if (other.count_ == 0) {
+      return;
+    }
+    min_ns_ = (count_ == 0) ? other.min_ns_ : std::min(min_ns_, other.min_ns_);
+    max_ns_ = std::max(max_ns_, other.max_ns_);
+    count_ += other.count_;
+    sum_ns_ += other.sum_ns_;
+    p50_ns_ = std::max(p50_ns_, other.p50_ns_);
+    p90_ns_ = std::max(p90_ns_, other.p90_ns_);
+    p99_ns_ = std::max(p99_ns_, other.p99_ns_);
+    p999_ns_ = std::max(p999_ns_, other.p999_ns_);
+  }
+
+  template <class Archive> void serialize(Archive &ar) {
+    ar(op_, phase_, count_, sum_ns_, min_ns_, max_ns_, p50_ns_, p90_ns_,
+       p99_ns_, p999_ns_);
+  }
+};
+
+/**
+ * Per-target I/O counters as reported by GetRuntimeStats
+ */
+struct TargetIoStats {
+  chi::PoolId target_id_;
+  chi::u64 bytes_read_;
+  chi::u64 bytes_written_;
+  chi::u64 ops_read_;
+  chi::u64 ops_written_;
+  chi::u64 remaining_space_;
+  chi::u64 blocks_allocated_; // Blocks this container placed on the target
+  bool is_local_;             // Target is on the reporting container's node
+
+  TargetIoStats()
+      : target_id_(chi::PoolId::GetNull()), bytes_read_(0), bytes_written_(0),
+        ops_read_(0), ops_written_(0), remaining_space_(0),
+        blocks_allocated_(0), is_local_(true) {}
+
+  template <class Archive> void serialize(Archive &ar) {
+    ar(target_id_, bytes_read_, bytes_written_, ops_read_, ops_written_,
+       remaining_space_, blocks_allocated_, is_local_);
+  }
+};
+
+/**
+ * Live per-target I/O counters, shared by every copy of a TargetInfo so
+ * concurrent reads and writes can bump them without the target lock
+ */
+struct TargetIoCounters {
+  std::atomic<chi::u64> bytes_read_{0};
+  std::atomic<chi::u64> bytes_written_{0};
+  std::atomic<chi::u64> ops_read_{0};
+  std::atomic<chi::u64> ops_written_{0};
+  std::atomic<chi::u64> blocks_allocated_{0};
+
+  void RecordRead(chi::u64 bytes) {
+    bytes_read_.fetch_add(bytes, std::memory_order_relaxed);
+    ops_read_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void RecordWrite(chi::u64 bytes) {
+    bytes_written_.fetch_add(bytes, std::memory_order_relaxed);
+    ops_written_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void RecordAllocation() {
+    blocks_allocated_.fetch_add(1, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * Client-side result of GetRuntimeStats
+ */
+struct RuntimeStatsReport {
+  std::vector<LatencySummary> latencies_; // Only series with samples
+  std::vector<TargetIoStats> targets_;
+};
+
+/**
+ * Lock-free log-linear latency histogram (HDR-style)
+ * Values below 8 ns get exact buckets; above that each power of two is split
+ * into 8 sub-buckets, covering up to 2^45 ns (~9.7 hours) with <= 12.5%
+ * relative error.
+ */
+class LatencyHistogram {
+public:
+  static constexpr chi::u32 kSubBucketBits = 3;
+  static constexpr chi::u64 kSubBuckets = 1ULL << kSubBucketBits;
+  static constexpr chi::u32 kMaxExponent = 44;
+  static constexpr size_t kBucketCount =
+      kSubBuckets + (kMaxExponent - kSubBucketBits + 1) * kSubBuckets;
+
+  LatencyHistogram() { Reset(); }
+
+  /** Record one sample (relaxed atomics; safe from any thread) */
+  void Record(chi::u64 value_ns);
+
+  /** Clear all samples */
+  void Reset();
+
+  /** Summarize the histogram; count_ is 0 if nothing was recorded */
+  LatencySummary Summarize(StatOp op, StatPhase phase) const;
+
+private:
+  static size_t BucketIndex(chi::u64 value_ns);
+  static chi::u64 BucketUpperBound(size_t index);
+
+  std::atomic<chi::u64> buckets_[kBucketCount];
+  std::atomic<chi::u64> count_;
+  std::atomic<chi::u64> sum_ns_;
+  std::atomic<chi::u64> min_ns_;
+  std::atomic<chi::u64> max_ns_;
+};
+
+/**
+ * Latency histograms for every (operation, phase) pair
+ */
+class RuntimeStats {
+public:
+  void Record(StatOp op, StatPhase phase, chi::u64 value_ns) {
+    histograms_[static_cast<size_t>(op)][static_cast<size_t>(phase)].Record(
+        value_ns);
+  }
+
+  /** Append summaries of all series with samples */
+  void Summarize(std::vector<LatencySummary> &summaries) const;
+
+  /** Clear all histograms */
+  void Reset();
+
+private:
+  LatencyHistogram histograms_[kStatOpCount][kStatPhaseCount];
+};
+
+/**
+ * Times one operation and the phases within it. The clock always runs in
+ * exactly one phase; Switch() charges the elapsed time to the current phase
+ * and starts the next. Samples are recorded when the timer is destroyed.
+ */
+class OpTimer {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  OpTimer(RuntimeStats &stats, StatOp op,
+          StatPhase first_phase = StatPhase::kMetadata)
+      : stats_(stats), op_(op), phase_(first_phase), start_(Clock::now()),
+        phase_start_(start_), phase_ns_{} {}
+
+  OpTimer(const OpTimer &) = delete;
+  OpTimer &operator=(const OpTimer &) = delete;
+
+  ~OpTimer() {
+    Clock::time_point now = Clock::now();
+    Charge(now);
+    stats_.Record(op_, StatPhase::kTotal, Elapsed(start_, now));
+    for (size_t i = 1; i < kStatPhaseCount; ++i) {
+      if (phase_ns_[i] > 0) {
+        stats_.Record(op_, static_cast<StatPhase>(i), phase_ns_[i]);
+      }
+    }
+  }
+
+  /** Charge time so far to the current phase and enter another */
+  void Switch(StatPhase phase) {
+    if (phase == phase_) {
+      return;
+    }
+    Clock::time_point now = Clock::now();
+    Charge(now);
+    phase_ = phase;
+    phase_start_ = now;
+  }
+
+  /** Phase the clock is currently charging */
+  StatPhase GetPhase() const { return phase_; }
+
+private:
+  static chi::u64 Elapsed(Clock::time_point from, Clock::time_point to) {
+    return static_cast<chi::u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(to - from)
+            .count());
+  }
+
+  void Charge(Clock::time_point now) {
+    phase_ns_[static_cast<size_t>(phase_)] += Elapsed(phase_start_, now);
+  }
+
+  RuntimeStats &stats_;
+  StatOp op_;
+  StatPhase phase_;
+  Clock::time_point start_;
+  Clock::time_point phase_start_;
+  chi::u64 phase_ns_[kStatPhaseCount];
+};
+
+} // namespace wrp_cte::core
+
+#endif // WRPCTE_CORE_STATS_H_
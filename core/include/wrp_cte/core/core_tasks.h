@@ -4,6 +4,7 @@
 #include <chimaera/chimaera.h>
 #include <wrp_cte/core/autogen/core_methods.h>
 #include <wrp_cte/core/core_config.h>
+#include <wrp_cte/core/core_stats.h>
 // Include admin tasks for GetOrCreatePoolTask
 #include <chimaera/admin/admin_tasks.h>
 // Include bdev tasks for BdevType enum
@@ -12,6 +13,12 @@
 #include <chimaera/bdev/bdev_client.h>
 #include <yaml-cpp/yaml.h>
 #include <chrono>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
 
 namespace wrp_cte::core {
 
@@ -21,6 +28,16 @@ static constexpr chi::PoolId kCtePoolId(512, 0);
 // CTE Core Pool Name constant
 static constexpr const char* kCtePoolName = "wrp_cte_core";
 
+// PutBlob/PutBlobs flag: leave blobs that already exist untouched. Stage-in
+// uses it so data read from a backing file never replaces newer data.
+static constexpr chi::u32 kPutBlobIfAbsent = 0x1;
+
+// GetBlob/GetBlobs return code for a blob that does not exist
+static constexpr chi::u32 kBlobNotFound = 6;
+
+// FlushTag flag: sync the backing file to stable storage after writing it
+static constexpr chi::u32 kFlushDurable = 0x1;
+
 // Timestamp type definition
 using Timestamp = std::chrono::time_point<std::chrono::steady_clock>;
 
@@ -29,7 +46,7 @@ using Timestamp = std::chrono::time_point<std::chrono::steady_clock>;
  * Contains configuration parameters for CTE container creation
  */
 struct CreateParams {
-  // CTE configuration object (not serialized, loaded from pool_config)
+  // CTE configuration object (loaded from pool_config or set by the caller)
   Config config_;
 
   // Required: chimod library name for module manager
@@ -63,8 +80,16 @@ struct CreateParams {
 
   // Serialization support for cereal
   template <class Archive> void serialize(Archive &ar) {
-    // Config is not serialized - it's loaded from pool_config.config_ in LoadConfig
-    (void)ar;
+    // The config travels as YAML, so pools created through Client::Create
+    // run with the caller's config and not the defaults
+    std::string config_yaml;
+    if (!Archive::is_loading::value) {
+      config_yaml = config_.SaveToString();
+    }
+    ar(config_yaml);
+    if (Archive::is_loading::value && !config_yaml.empty()) {
+      config_.LoadFromString(config_yaml);
+    }
   }
 
   /**
@@ -99,24 +124,32 @@ using DestroyTask = chimaera::admin::DestroyTask;
 /**
  * Target information structure
  */
+/** RegisterTarget node meaning "the node of the registering container" */
+static constexpr chi::u32 kLocalTargetNode = 0xFFFFFFFFu;
+
 struct TargetInfo {
   std::string target_name_;
   std::string bdev_pool_name_;
   chimaera::bdev::Client bdev_client_; // Bdev client for this target
   chi::PoolQuery target_query_;        // Target pool query for bdev API calls
-  chi::u64 bytes_read_;
-  chi::u64 bytes_written_;
-  chi::u64 ops_read_;
-  chi::u64 ops_written_;
+  // Byte/op counters; shared so every copy of this TargetInfo updates them
+  std::shared_ptr<TargetIoCounters> io_counters_;
   float target_score_;       // Target score (0-1, normalized log bandwidth)
   chi::u64 remaining_space_; // Remaining allocatable space in bytes
+  chi::u64 total_space_;     // Capacity the target was registered with
+  float high_watermark_;     // Used fraction that triggers demotion
+  float low_watermark_;      // Used fraction demotion drains down to
   chimaera::bdev::PerfMetrics perf_metrics_; // Performance metrics from bdev
+  chi::u32 node_id_;         // Container whose node hosts the device
+  bool is_local_;            // Device is on this container's node
 
   TargetInfo() = default;
 
   explicit TargetInfo(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
-      : bytes_read_(0), bytes_written_(0), ops_read_(0), ops_written_(0),
-        target_score_(0.0f), remaining_space_(0) {
+      : io_counters_(std::make_shared<TargetIoCounters>()),
+        target_score_(0.0f), remaining_space_(0), total_space_(0),
+        high_watermark_(1.0f), low_watermark_(1.0f), node_id_(0),
+        is_local_(true) {
     // std::string doesn't need allocator, chi::u64 and float are POD types
     (void)alloc; // Suppress unused parameter warning
   }
@@ -132,12 +165,13 @@ struct RegisterTargetTask : public chi::Task {
   IN chi::u64 total_size_;                // Total size for allocation
   IN chi::PoolQuery target_query_;        // Target pool query for bdev API calls
   IN chi::PoolId bdev_id_;                // PoolId to create for the underlying bdev
+  IN chi::u32 target_node_; // Container whose node hosts the device
 
   // SHM constructor
   explicit RegisterTargetTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
       : chi::Task(alloc), target_name_(alloc),
         bdev_type_(chimaera::bdev::BdevType::kFile), total_size_(0),
-        bdev_id_(chi::PoolId::GetNull()) {}
+        bdev_id_(chi::PoolId::GetNull()), target_node_(kLocalTargetNode) {}
 
   // Emplace constructor
   explicit RegisterTargetTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
@@ -148,10 +182,12 @@ struct RegisterTargetTask : public chi::Task {
                               chimaera::bdev::BdevType bdev_type,
                               chi::u64 total_size,
                               const chi::PoolQuery &target_query,
-                              const chi::PoolId &bdev_id)
+                              const chi::PoolId &bdev_id,
+                              chi::u32 target_node = kLocalTargetNode)
       : chi::Task(alloc, task_id, pool_id, pool_query, Method::kRegisterTarget),
         target_name_(alloc, target_name), bdev_type_(bdev_type),
-        total_size_(total_size), target_query_(target_query), bdev_id_(bdev_id) {
+        total_size_(total_size), target_query_(target_query), bdev_id_(bdev_id),
+        target_node_(target_node) {
     task_id_ = task_id;
     pool_id_ = pool_id;
     method_ = Method::kRegisterTarget;
@@ -163,7 +199,8 @@ struct RegisterTargetTask : public chi::Task {
    * Serialize IN and INOUT parameters
    */
   template <typename Archive> void SerializeIn(Archive &ar) {
-    ar(target_name_, bdev_type_, total_size_, target_query_, bdev_id_);
+    ar(target_name_, bdev_type_, total_size_, target_query_, bdev_id_,
+       target_node_);
   }
 
   /**
@@ -182,6 +219,7 @@ struct RegisterTargetTask : public chi::Task {
     total_size_ = other->total_size_;
     target_query_ = other->target_query_;
     bdev_id_ = other->bdev_id_;
+    target_node_ = other->target_node_;
   }
 };
 
@@ -433,16 +471,26 @@ struct BlobInfo {
   float score_;             // 0-1 score for reorganization
   Timestamp last_modified_; // Last modification time
   Timestamp last_read_;     // Last read time
+  // Guarded by the blob lock: writes in flight, and a generation bumped when
+  // a write starts or ends or the block list is swapped
+  chi::u32 writers_;
+  chi::u64 write_gen_;
+  // Guarded by the blob lock: reads in flight, and blocks swapped out while
+  // reads were in flight, freed when the last of them ends
+  chi::u32 readers_;
+  std::vector<BlobBlock> retired_blocks_;
 
   BlobInfo()
       : blob_name_(), blocks_(), score_(0.0f),
         last_modified_(std::chrono::steady_clock::now()),
-        last_read_(std::chrono::steady_clock::now()) {}
+        last_read_(std::chrono::steady_clock::now()), writers_(0),
+        write_gen_(0), readers_(0) {}
 
   explicit BlobInfo(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
       : blob_name_(), blocks_(), score_(0.0f),
         last_modified_(std::chrono::steady_clock::now()),
-        last_read_(std::chrono::steady_clock::now()) {
+        last_read_(std::chrono::steady_clock::now()), writers_(0),
+        write_gen_(0), readers_(0) {
     (void)alloc; // Suppress unused parameter warning
   }
 
@@ -450,7 +498,8 @@ struct BlobInfo {
            const std::string &blob_name, float score)
       : blob_name_(blob_name), blocks_(), score_(score),
         last_modified_(std::chrono::steady_clock::now()),
-        last_read_(std::chrono::steady_clock::now()) {
+        last_read_(std::chrono::steady_clock::now()), writers_(0),
+        write_gen_(0), readers_(0) {
     (void)alloc; // Suppress unused parameter warning
   }
 
@@ -466,6 +515,108 @@ struct BlobInfo {
   }
 };
 
+/**
+ * Key for the per-container blob table
+ * Stores the owning TagId and a hash of (tag_id, blob_name) computed once at
+ * construction, so lock and bucket selection never rehash the name. The name is
+ * kept only to resolve hash collisions on lookup.
+ *
+ * A key made with View() borrows the caller's name instead of copying it, so
+ * a lookup allocates nothing; the borrowed name must outlive the key. Copying
+ * any key (e.g. when the map inserts it) makes an owning copy.
+ */
+struct BlobKey {
+  TagId tag_id_;
+  chi::u64 hash_;         // Combined hash of tag_id_ and the name
+  std::string blob_name_; // Owned name; empty for a borrowed key
+  std::string_view name_; // The name: blob_name_ or the borrowed one
+
+  BlobKey() : tag_id_(TagId::GetNull()), hash_(0), blob_name_(), name_() {}
+
+  BlobKey(const TagId &tag_id, std::string blob_name)
+      : tag_id_(tag_id), hash_(0), blob_name_(std::move(blob_name)) {
+    name_ = blob_name_;
+    hash_ = Hash(tag_id_, name_);
+  }
+
+  /** Key borrowing blob_name for a lookup */
+  static BlobKey View(const TagId &tag_id, std::string_view blob_name) {
+    BlobKey key;
+    key.tag_id_ = tag_id;
+    key.name_ = blob_name;
+    key.hash_ = Hash(tag_id, blob_name);
+    return key;
+  }
+
+  BlobKey(const BlobKey &other)
+      : tag_id_(other.tag_id_), hash_(other.hash_),
+        blob_name_(other.name_) {
+    name_ = blob_name_;
+  }
+
+  BlobKey(BlobKey &&other) noexcept
+      : tag_id_(other.tag_id_), hash_(other.hash_) {
+    if (other.IsBorrowed()) {
+      name_ = other.name_; // Still borrowed from the same caller
+    } else {
+      blob_name_ = std::move(other.blob_name_);
+      name_ = blob_name_;
+      other.name_ = other.blob_name_;
+    }
+  }
+
+  BlobKey &operator=(const BlobKey &other) {
+    if (this != &other) {
+      tag_id_ = other.tag_id_;
+      hash_ = other.hash_;
+      blob_name_.assign(other.name_.data(), other.name_.size());
+      name_ = blob_name_;
+    }
+    return *this;
+  }
+
+  BlobKey &operator=(BlobKey &&other) noexcept {
+    if (this != &other) {
+      tag_id_ = other.tag_id_;
+      hash_ = other.hash_;
+      if (other.IsBorrowed()) {
+        blob_name_.clear();
+        name_ = other.name_;
+      } else {
+        blob_name_ = std::move(other.blob_name_);
+        name_ = blob_name_;
+        other.name_ = other.blob_name_;
+      }
+    }
+    return *this;
+  }
+
+  /** The blob name */
+  std::string_view GetName() const { return name_; }
+
+  /**
+   * Combine the tag ID and blob name into a single 64-bit hash
+   */
+  static chi::u64 Hash(const TagId &tag_id, std::string_view blob_name) {
+    chi::u64 tag_bits = (static_cast<chi::u64>(tag_id.major_) << 32) |
+                        static_cast<chi::u64>(tag_id.minor_);
+    chi::u64 hash_value = std::hash<std::string_view>()(blob_name);
+    hash_value ^= std::hash<chi::u64>()(tag_bits) + 0x9e3779b97f4a7c15ULL +
+                  (hash_value << 6) + (hash_value >> 2);
+    return hash_value;
+  }
+
+  bool operator==(const BlobKey &other) const {
+    return hash_ == other.hash_ && tag_id_ == other.tag_id_ &&
+           name_ == other.name_;
+  }
+
+  bool operator!=(const BlobKey &other) const { return !(*this == other); }
+
+private:
+  bool IsBorrowed() const { return name_.data() != blob_name_.data(); }
+};
+
 /**
  * CTE Operation types for telemetry
  */
@@ -580,12 +731,14 @@ struct PutBlobTask : public chi::Task {
   IN hipc::Pointer blob_data_;   // Blob data (shared memory pointer)
   IN float score_;               // Score 0-1 for placement decisions
   IN chi::u32 flags_;            // Operation flags
+  OUT bool blob_created_;        // This put created the blob
 
   // SHM constructor
   explicit PutBlobTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
       : chi::Task(alloc), tag_id_(TagId::GetNull()), blob_name_(alloc),
         offset_(0), size_(0),
-        blob_data_(hipc::Pointer::GetNull()), score_(0.5f), flags_(0) {}
+        blob_data_(hipc::Pointer::GetNull()), score_(0.5f), flags_(0),
+        blob_created_(false) {}
 
   // Emplace constructor
   explicit PutBlobTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
@@ -597,7 +750,7 @@ struct PutBlobTask : public chi::Task {
       : chi::Task(alloc, task_id, pool_id, pool_query, Method::kPutBlob),
         tag_id_(tag_id), blob_name_(alloc, blob_name),
         offset_(offset), size_(size), blob_data_(blob_data), score_(score),
-        flags_(flags) {
+        flags_(flags), blob_created_(false) {
     task_id_ = task_id;
     pool_id_ = pool_id;
     method_ = Method::kPutBlob;
@@ -618,7 +771,7 @@ struct PutBlobTask : public chi::Task {
    * Serialize OUT and INOUT parameters
    */
   template <typename Archive> void SerializeOut(Archive &ar) {
-    ar(blob_name_);
+    ar(blob_name_, blob_created_);
     // No bulk transfer needed for PutBlob output (metadata only)
   }
 
@@ -633,6 +786,7 @@ struct PutBlobTask : public chi::Task {
     blob_data_ = other->blob_data_;
     score_ = other->score_;
     flags_ = other->flags_;
+    blob_created_ = other->blob_created_;
   }
 };
 
@@ -702,6 +856,203 @@ struct GetBlobTask : public chi::Task {
   }
 };
 
+/**
+ * One blob of a PutBlobs/GetBlobs batch as passed to the client API
+ */
+struct BlobIoRequest {
+  std::string blob_name_; // Blob name (required)
+  chi::u64 offset_;       // Offset within blob
+  chi::u64 size_;         // Bytes to write or read
+  hipc::Pointer data_;    // Shared memory buffer holding/receiving the data
+  float score_;           // Score 0-1 for placement decisions (puts only)
+  chi::u32 return_code_;  // Result of this blob's operation (0 = success)
+
+  BlobIoRequest()
+      : offset_(0), size_(0), data_(hipc::Pointer::GetNull()), score_(1.0f),
+        return_code_(0) {}
+
+  BlobIoRequest(const std::string &blob_name, chi::u64 offset, chi::u64 size,
+                hipc::Pointer data = hipc::Pointer::GetNull(),
+                float score = 1.0f)
+      : blob_name_(blob_name), offset_(offset), size_(size), data_(data),
+        score_(score), return_code_(0) {}
+};
+
+/**
+ * One blob of a PutBlobs/GetBlobs batch as carried in the task. Names are
+ * packed into the task's blob_names_ string so an entry stays fixed-size.
+ */
+struct BlobBatchEntry {
+  chi::u32 name_off_;    // Offset of the name within blob_names_
+  chi::u32 name_len_;    // Length of the name
+  chi::u64 offset_;      // Offset within blob
+  chi::u64 size_;        // Bytes to write or read
+  hipc::Pointer data_;   // Shared memory buffer holding/receiving the data
+  float score_;          // Score 0-1 for placement decisions (puts only)
+  chi::u32 return_code_; // Result of this blob's operation (0 = success)
+
+  BlobBatchEntry()
+      : name_off_(0), name_len_(0), offset_(0), size_(0),
+        data_(hipc::Pointer::GetNull()), score_(1.0f), return_code_(0) {}
+
+  /**
+   * Serialize entry metadata; data buffers are moved separately as bulk
+   */
+  template <class Archive> void serialize(Archive &ar) {
+    ar(name_off_, name_len_, offset_, size_, score_, return_code_);
+  }
+};
+
+/**
+ * Pack client requests into batch entries and a shared name buffer
+ */
+inline void PackBlobBatch(const std::vector<BlobIoRequest> &requests,
+                          hipc::vector<BlobBatchEntry> &entries,
+                          hipc::string &blob_names) {
+  std::string names;
+  entries.reserve(requests.size());
+  for (const auto &request : requests) {
+    BlobBatchEntry entry;
+    entry.name_off_ = static_cast<chi::u32>(names.size());
+    entry.name_len_ = static_cast<chi::u32>(request.blob_name_.size());
+    entry.offset_ = request.offset_;
+    entry.size_ = request.size_;
+    entry.data_ = request.data_;
+    entry.score_ = request.score_;
+    names += request.blob_name_;
+    entries.push_back(entry);
+  }
+  blob_names = names;
+}
+
+/**
+ * PutBlobs task - Store many blobs of one tag in a single runtime message
+ */
+struct PutBlobsTask : public chi::Task {
+  IN TagId tag_id_;                        // Tag ID for blob grouping
+  IN chi::u32 flags_;                      // Operation flags
+  IN hipc::string blob_names_;             // Concatenated blob names
+  INOUT hipc::vector<BlobBatchEntry> entries_; // Blobs; OUT per-blob codes
+  OUT chi::u32 failed_count_;              // Number of entries that failed
+
+  // SHM constructor
+  explicit PutBlobsTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
+      : chi::Task(alloc), tag_id_(TagId::GetNull()), flags_(0),
+        blob_names_(alloc), entries_(alloc), failed_count_(0) {}
+
+  // Emplace constructor
+  explicit PutBlobsTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
+                        const chi::TaskId &task_id, const chi::PoolId &pool_id,
+                        const chi::PoolQuery &pool_query, const TagId &tag_id,
+                        const std::vector<BlobIoRequest> &requests,
+                        chi::u32 flags)
+      : chi::Task(alloc, task_id, pool_id, pool_query, Method::kPutBlobs),
+        tag_id_(tag_id), flags_(flags), blob_names_(alloc), entries_(alloc),
+        failed_count_(0) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kPutBlobs;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+    PackBlobBatch(requests, entries_, blob_names_);
+  }
+
+  /**
+   * Serialize IN and INOUT parameters
+   */
+  template <typename Archive> void SerializeIn(Archive &ar) {
+    ar(tag_id_, flags_, blob_names_, entries_);
+    // Use BULK_XFER to transfer each blob's data from client to runtime
+    for (auto &entry : entries_) {
+      ar.bulk(entry.data_, entry.size_, BULK_XFER);
+    }
+  }
+
+  /**
+   * Serialize OUT and INOUT parameters
+   */
+  template <typename Archive> void SerializeOut(Archive &ar) {
+    ar(entries_, failed_count_);
+  }
+
+  /**
+   * Copy from another PutBlobsTask
+   */
+  void Copy(const hipc::FullPtr<PutBlobsTask> &other) {
+    tag_id_ = other->tag_id_;
+    flags_ = other->flags_;
+    blob_names_ = other->blob_names_;
+    entries_ = other->entries_;
+    failed_count_ = other->failed_count_;
+  }
+};
+
+/**
+ * GetBlobs task - Read many blobs of one tag in a single runtime message
+ */
+struct GetBlobsTask : public chi::Task {
+  IN TagId tag_id_;                        // Tag ID for blob lookup
+  IN chi::u32 flags_;                      // Operation flags
+  IN hipc::string blob_names_;             // Concatenated blob names
+  INOUT hipc::vector<BlobBatchEntry> entries_; // Blobs; OUT per-blob codes
+  OUT chi::u32 failed_count_;              // Number of entries that failed
+
+  // SHM constructor
+  explicit GetBlobsTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
+      : chi::Task(alloc), tag_id_(TagId::GetNull()), flags_(0),
+        blob_names_(alloc), entries_(alloc), failed_count_(0) {}
+
+  // Emplace constructor
+  explicit GetBlobsTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
+                        const chi::TaskId &task_id, const chi::PoolId &pool_id,
+                        const chi::PoolQuery &pool_query, const TagId &tag_id,
+                        const std::vector<BlobIoRequest> &requests,
+                        chi::u32 flags)
+      : chi::Task(alloc, task_id, pool_id, pool_query, Method::kGetBlobs),
+        tag_id_(tag_id), flags_(flags), blob_names_(alloc), entries_(alloc),
+        failed_count_(0) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kGetBlobs;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+    PackBlobBatch(requests, entries_, blob_names_);
+  }
+
+  /**
+   * Serialize IN and INOUT parameters
+   */
+  template <typename Archive> void SerializeIn(Archive &ar) {
+    ar(tag_id_, flags_, blob_names_, entries_);
+    // Use BULK_EXPOSE - metadata only, runtime will allocate buffers for reads
+    for (auto &entry : entries_) {
+      ar.bulk(entry.data_, entry.size_, BULK_EXPOSE);
+    }
+  }
+
+  /**
+   * Serialize OUT and INOUT parameters
+   */
+  template <typename Archive> void SerializeOut(Archive &ar) {
+    ar(entries_, failed_count_);
+    // Use BULK_XFER to transfer read data back to client
+    for (auto &entry : entries_) {
+      ar.bulk(entry.data_, entry.size_, BULK_XFER);
+    }
+  }
+
+  /**
+   * Copy from another GetBlobsTask
+   */
+  void Copy(const hipc::FullPtr<GetBlobsTask> &other) {
+    tag_id_ = other->tag_id_;
+    flags_ = other->flags_;
+    blob_names_ = other->blob_names_;
+    entries_ = other->entries_;
+    failed_count_ = other->failed_count_;
+  }
+};
+
 /**
  * ReorganizeBlob task - Change score for a single blob
  */
@@ -921,28 +1272,32 @@ struct GetTagSizeTask : public chi::Task {
 };
 
 /**
- * PollTelemetryLog task - Poll telemetry log with minimum logical time filter
+ * PollTelemetryLog task - Copy telemetry entries logged after a cursor
+ * Pass last_logical_time_ from one poll as minimum_logical_time_ of the next
  */
 struct PollTelemetryLogTask : public chi::Task {
-  IN std::uint64_t minimum_logical_time_;  // Minimum logical time filter
-  OUT std::uint64_t last_logical_time_;    // Last logical time scanned
+  IN std::uint64_t minimum_logical_time_;  // Cursor: return entries after it
+  IN chi::u32 max_entries_;                // Max entries (0 = ring size)
+  OUT std::uint64_t last_logical_time_;    // Cursor for the next poll
+  OUT std::uint64_t dropped_entries_;      // Entries overwritten before read
   OUT hipc::vector<CteTelemetry> entries_; // Retrieved telemetry entries
 
   // SHM constructor
   explicit PollTelemetryLogTask(
       const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
-      : chi::Task(alloc), minimum_logical_time_(0), last_logical_time_(0),
-        entries_(alloc) {}
+      : chi::Task(alloc), minimum_logical_time_(0), max_entries_(0),
+        last_logical_time_(0), dropped_entries_(0), entries_(alloc) {}
 
   // Emplace constructor
   explicit PollTelemetryLogTask(
       const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
       const chi::TaskId &task_id, const chi::PoolId &pool_id,
-      const chi::PoolQuery &pool_query, std::uint64_t minimum_logical_time)
+      const chi::PoolQuery &pool_query, std::uint64_t minimum_logical_time,
+      chi::u32 max_entries = 0)
       : chi::Task(alloc, task_id, pool_id, pool_query,
                   Method::kPollTelemetryLog),
-        minimum_logical_time_(minimum_logical_time), last_logical_time_(0),
-        entries_(alloc) {
+        minimum_logical_time_(minimum_logical_time), max_entries_(max_entries),
+        last_logical_time_(0), dropped_entries_(0), entries_(alloc) {
     task_id_ = task_id;
     pool_id_ = pool_id;
     method_ = Method::kPollTelemetryLog;
@@ -954,14 +1309,14 @@ struct PollTelemetryLogTask : public chi::Task {
    * Serialize IN and INOUT parameters
    */
   template <typename Archive> void SerializeIn(Archive &ar) {
-    ar(minimum_logical_time_);
+    ar(minimum_logical_time_, max_entries_);
   }
 
   /**
    * Serialize OUT and INOUT parameters
    */
   template <typename Archive> void SerializeOut(Archive &ar) {
-    ar(last_logical_time_, entries_);
+    ar(last_logical_time_, dropped_entries_, entries_);
   }
 
   /**
@@ -969,7 +1324,9 @@ struct PollTelemetryLogTask : public chi::Task {
    */
   void Copy(const hipc::FullPtr<PollTelemetryLogTask> &other) {
     minimum_logical_time_ = other->minimum_logical_time_;
+    max_entries_ = other->max_entries_;
     last_logical_time_ = other->last_logical_time_;
+    dropped_entries_ = other->dropped_entries_;
     entries_ = other->entries_;
   }
 };
@@ -1085,22 +1442,28 @@ struct GetBlobSizeTask : public chi::Task {
  */
 struct GetContainedBlobsTask : public chi::Task {
   IN TagId tag_id_; // Tag ID to query
+  IN chi::u32 max_results_;  // Max names per container (0 = all)
+  IN hipc::string cursor_;   // Resume point from next_cursor_ ("" = start)
   OUT chi::ipc::vector<chi::ipc::string>
       blob_names_; // Vector of blob names in the tag
+  OUT hipc::string next_cursor_; // Where the next page starts ("" = done)
 
   // SHM constructor
   explicit GetContainedBlobsTask(
       const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
-      : chi::Task(alloc), tag_id_(TagId::GetNull()), blob_names_(alloc) {}
+      : chi::Task(alloc), tag_id_(TagId::GetNull()), max_results_(0),
+        cursor_(alloc), blob_names_(alloc), next_cursor_(alloc) {}
 
   // Emplace constructor
   explicit GetContainedBlobsTask(
       const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
       const chi::TaskId &task_id, const chi::PoolId &pool_id,
-      const chi::PoolQuery &pool_query, const TagId &tag_id)
+      const chi::PoolQuery &pool_query, const TagId &tag_id,
+      chi::u32 max_results = 0, const std::string &cursor = "")
       : chi::Task(alloc, task_id, pool_id, pool_query,
                   Method::kGetContainedBlobs),
-        tag_id_(tag_id), blob_names_(alloc) {
+        tag_id_(tag_id), max_results_(max_results), cursor_(alloc, cursor),
+        blob_names_(alloc), next_cursor_(alloc) {
     task_id_ = task_id;
     pool_id_ = pool_id;
     method_ = Method::kGetContainedBlobs;
@@ -1111,13 +1474,15 @@ struct GetContainedBlobsTask : public chi::Task {
   /**
    * Serialize IN and INOUT parameters
    */
-  template <typename Archive> void SerializeIn(Archive &ar) { ar(tag_id_); }
+  template <typename Archive> void SerializeIn(Archive &ar) {
+    ar(tag_id_, max_results_, cursor_);
+  }
 
   /**
    * Serialize OUT and INOUT parameters
    */
   template <typename Archive> void SerializeOut(Archive &ar) {
-    ar(blob_names_);
+    ar(blob_names_, next_cursor_);
   }
 
   /**
@@ -1125,12 +1490,16 @@ struct GetContainedBlobsTask : public chi::Task {
    */
   void Copy(const hipc::FullPtr<GetContainedBlobsTask> &other) {
     tag_id_ = other->tag_id_;
+    max_results_ = other->max_results_;
+    cursor_ = other->cursor_;
     blob_names_ = other->blob_names_;
+    next_cursor_ = other->next_cursor_;
   }
 
   /**
    * Aggregate results from a replica task
-   * Merges the blob_names_ vectors from multiple nodes
+   * Merges the blob_names_ vectors from multiple nodes. Cursors belong to one
+   * container, so paged requests must target a single container.
    */
   void Aggregate(const hipc::FullPtr<GetContainedBlobsTask> &replica) {
     // Merge blob names from replica into this task's blob_names_
@@ -1145,20 +1514,27 @@ struct GetContainedBlobsTask : public chi::Task {
  */
 struct TagQueryTask : public chi::Task {
   IN hipc::string tag_regex_;              // Tag regex pattern
+  IN chi::u32 max_results_;                // Max names per container (0 = all)
+  IN hipc::string cursor_;                 // Resume point ("" = start)
   OUT hipc::vector<hipc::string> tag_names_; // Matching tag names
+  OUT hipc::string next_cursor_;           // Next page start ("" = done)
 
   // SHM constructor
   explicit TagQueryTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
-      : chi::Task(alloc), tag_regex_(alloc), tag_names_(alloc) {}
+      : chi::Task(alloc), tag_regex_(alloc), max_results_(0), cursor_(alloc),
+        tag_names_(alloc), next_cursor_(alloc) {}
 
   // Emplace constructor
   explicit TagQueryTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
                         const chi::TaskId &task_id,
                         const chi::PoolId &pool_id,
                         const chi::PoolQuery &pool_query,
-                        const std::string &tag_regex)
+                        const std::string &tag_regex,
+                        chi::u32 max_results = 0,
+                        const std::string &cursor = "")
       : chi::Task(alloc, task_id, pool_id, pool_query, Method::kTagQuery),
-        tag_regex_(alloc, tag_regex), tag_names_(alloc) {
+        tag_regex_(alloc, tag_regex), max_results_(max_results),
+        cursor_(alloc, cursor), tag_names_(alloc), next_cursor_(alloc) {
     task_id_ = task_id;
     pool_id_ = pool_id;
     method_ = Method::kTagQuery;
@@ -1170,14 +1546,14 @@ struct TagQueryTask : public chi::Task {
    * Serialize IN and INOUT parameters
    */
   template <typename Archive> void SerializeIn(Archive &ar) {
-    ar(tag_regex_);
+    ar(tag_regex_, max_results_, cursor_);
   }
 
   /**
    * Serialize OUT and INOUT parameters
    */
   template <typename Archive> void SerializeOut(Archive &ar) {
-    ar(tag_names_);
+    ar(tag_names_, next_cursor_);
   }
 
   /**
@@ -1185,7 +1561,10 @@ struct TagQueryTask : public chi::Task {
    */
   void Copy(const hipc::FullPtr<TagQueryTask> &other) {
     tag_regex_ = other->tag_regex_;
+    max_results_ = other->max_results_;
+    cursor_ = other->cursor_;
     tag_names_ = other->tag_names_;
+    next_cursor_ = other->next_cursor_;
   }
 
   /**
@@ -1199,17 +1578,83 @@ struct TagQueryTask : public chi::Task {
   }
 };
 
+/**
+ * Optional metadata predicates of a BlobQuery, evaluated server-side against
+ * each name match. The defaults match every blob.
+ */
+struct BlobQueryPredicate {
+  chi::u64 min_size_;        // Min blob size in bytes
+  chi::u64 max_size_;        // Max blob size in bytes
+  float min_score_;          // Min blob score
+  float max_score_;          // Max blob score
+  chi::u64 min_read_age_ms_; // Only blobs not read for this long (0 = any)
+  chi::PoolId target_id_;    // Only blobs with a block on this target (null = any)
+
+  BlobQueryPredicate()
+      : min_size_(0), max_size_(std::numeric_limits<chi::u64>::max()),
+        min_score_(std::numeric_limits<float>::lowest()),
+        max_score_(std::numeric_limits<float>::max()), min_read_age_ms_(0),
+        target_id_(chi::PoolId::GetNull()) {}
+
+  /** Whether any predicate differs from its match-all default */
+  bool IsSet() const {
+    BlobQueryPredicate all;
+    return min_size_ != all.min_size_ || max_size_ != all.max_size_ ||
+           min_score_ != all.min_score_ || max_score_ != all.max_score_ ||
+           min_read_age_ms_ != all.min_read_age_ms_ ||
+           !(target_id_ == all.target_id_);
+  }
+
+  template <class Archive> void serialize(Archive &ar) {
+    ar(min_size_, max_size_, min_score_, max_score_, min_read_age_ms_,
+       target_id_);
+  }
+};
+
+/**
+ * Metadata of one BlobQuery match. Ages are relative to when the query ran,
+ * since runtime timestamps are not comparable across processes.
+ */
+struct BlobQueryStat {
+  TagId tag_id_;             // Tag holding the blob
+  chi::u64 size_;            // Blob size in bytes
+  float score_;              // Blob score
+  chi::u64 modified_age_ms_; // Time since the last write
+  chi::u64 read_age_ms_;     // Time since the last read
+  chi::PoolId target_id_;    // Target holding most of the blob's bytes
+  chi::u32 num_blocks_;      // Blocks making up the blob
+
+  BlobQueryStat()
+      : tag_id_(TagId::GetNull()), size_(0), score_(0.0f),
+        modified_age_ms_(0), read_age_ms_(0),
+        target_id_(chi::PoolId::GetNull()), num_blocks_(0) {}
+
+  template <class Archive> void serialize(Archive &ar) {
+    ar(tag_id_, size_, score_, modified_age_ms_, read_age_ms_, target_id_,
+       num_blocks_);
+  }
+};
+
 /**
  * BlobQuery task - Query blobs by tag and blob regex patterns
  */
 struct BlobQueryTask : public chi::Task {
   IN hipc::string tag_regex_;               // Tag regex pattern
   IN hipc::string blob_regex_;              // Blob regex pattern
+  IN chi::u32 max_results_;                 // Max names per container (0 = all)
+  IN hipc::string cursor_;                  // Resume point ("" = start)
+  IN BlobQueryPredicate predicate_;         // Metadata filters on matches
+  IN bool with_stats_;                      // Fill blob_stats_
   OUT hipc::vector<hipc::string> blob_names_; // Matching blob names
+  OUT hipc::vector<BlobQueryStat> blob_stats_; // blob_stats_[i] describes
+                                               // blob_names_[i]
+  OUT hipc::string next_cursor_;            // Next page start ("" = done)
 
   // SHM constructor
   explicit BlobQueryTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
-      : chi::Task(alloc), tag_regex_(alloc), blob_regex_(alloc), blob_names_(alloc) {}
+      : chi::Task(alloc), tag_regex_(alloc), blob_regex_(alloc),
+        max_results_(0), cursor_(alloc), with_stats_(false),
+        blob_names_(alloc), blob_stats_(alloc), next_cursor_(alloc) {}
 
   // Emplace constructor
   explicit BlobQueryTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
@@ -1217,9 +1662,17 @@ struct BlobQueryTask : public chi::Task {
                          const chi::PoolId &pool_id,
                          const chi::PoolQuery &pool_query,
                          const std::string &tag_regex,
-                         const std::string &blob_regex)
+                         const std::string &blob_regex,
+                         chi::u32 max_results = 0,
+                         const std::string &cursor = "",
+                         const BlobQueryPredicate &predicate =
+                             BlobQueryPredicate(),
+                         bool with_stats = false)
       : chi::Task(alloc, task_id, pool_id, pool_query, Method::kBlobQuery),
-        tag_regex_(alloc, tag_regex), blob_regex_(alloc, blob_regex), blob_names_(alloc) {
+        tag_regex_(alloc, tag_regex), blob_regex_(alloc, blob_regex),
+        max_results_(max_results), cursor_(alloc, cursor),
+        predicate_(predicate), with_stats_(with_stats), blob_names_(alloc),
+        blob_stats_(alloc), next_cursor_(alloc) {
     task_id_ = task_id;
     pool_id_ = pool_id;
     method_ = Method::kBlobQuery;
@@ -1231,14 +1684,15 @@ struct BlobQueryTask : public chi::Task {
    * Serialize IN and INOUT parameters
    */
   template <typename Archive> void SerializeIn(Archive &ar) {
-    ar(tag_regex_, blob_regex_);
+    ar(tag_regex_, blob_regex_, max_results_, cursor_, predicate_,
+       with_stats_);
   }
 
   /**
    * Serialize OUT and INOUT parameters
    */
   template <typename Archive> void SerializeOut(Archive &ar) {
-    ar(blob_names_);
+    ar(blob_names_, blob_stats_, next_cursor_);
   }
 
   /**
@@ -1247,20 +1701,679 @@ struct BlobQueryTask : public chi::Task {
   void Copy(const hipc::FullPtr<BlobQueryTask> &other) {
     tag_regex_ = other->tag_regex_;
     blob_regex_ = other->blob_regex_;
+    max_results_ = other->max_results_;
+    cursor_ = other->cursor_;
+    predicate_ = other->predicate_;
+    with_stats_ = other->with_stats_;
     blob_names_ = other->blob_names_;
+    blob_stats_ = other->blob_stats_;
+    next_cursor_ = other->next_cursor_;
   }
 
   /**
    * Aggregate results from multiple nodes
    */
   void Aggregate(const hipc::FullPtr<BlobQueryTask> &other) {
-    // Append blob names from other task
+    // Append blob names (and their stats) from other task
     for (const auto &blob_name : other->blob_names_) {
       blob_names_.emplace_back(blob_name);
     }
+    for (const auto &blob_stat : other->blob_stats_) {
+      blob_stats_.emplace_back(blob_stat);
+    }
+  }
+};
+
+/**
+ * ReorganizeTiers task - Migrate blobs whose placement no longer fits their
+ * score (hot blobs up to faster targets, cold blobs down to slower ones)
+ */
+struct ReorganizeTiersTask : public chi::Task {
+  IN chi::u32 max_blobs_;       // Max blobs to migrate per container (0 = all)
+  OUT chi::u32 blobs_promoted_; // Blobs moved to a faster target
+  OUT chi::u32 blobs_demoted_;  // Blobs moved to a slower target
+  OUT chi::u64 bytes_moved_;    // Total bytes copied between targets
+
+  // SHM constructor
+  explicit ReorganizeTiersTask(
+      const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
+      : chi::Task(alloc), max_blobs_(0), blobs_promoted_(0), blobs_demoted_(0),
+        bytes_moved_(0) {}
+
+  // Emplace constructor
+  explicit ReorganizeTiersTask(
+      const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
+      const chi::TaskId &task_id, const chi::PoolId &pool_id,
+      const chi::PoolQuery &pool_query, chi::u32 max_blobs)
+      : chi::Task(alloc, task_id, pool_id, pool_query,
+                  Method::kReorganizeTiers),
+        max_blobs_(max_blobs), blobs_promoted_(0), blobs_demoted_(0),
+        bytes_moved_(0) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kReorganizeTiers;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  /**
+   * Serialize IN and INOUT parameters
+   */
+  template <typename Archive> void SerializeIn(Archive &ar) { ar(max_blobs_); }
+
+  /**
+   * Serialize OUT and INOUT parameters
+   */
+  template <typename Archive> void SerializeOut(Archive &ar) {
+    ar(blobs_promoted_, blobs_demoted_, bytes_moved_);
+  }
+
+  /**
+   * Copy from another ReorganizeTiersTask
+   */
+  void Copy(const hipc::FullPtr<ReorganizeTiersTask> &other) {
+    max_blobs_ = other->max_blobs_;
+    blobs_promoted_ = other->blobs_promoted_;
+    blobs_demoted_ = other->blobs_demoted_;
+    bytes_moved_ = other->bytes_moved_;
+  }
+
+  /**
+   * Aggregate results from multiple nodes
+   */
+  void Aggregate(const hipc::FullPtr<ReorganizeTiersTask> &other) {
+    blobs_promoted_ += other->blobs_promoted_;
+    blobs_demoted_ += other->blobs_demoted_;
+    bytes_moved_ += other->bytes_moved_;
+  }
+};
+
+/**
+ * EnforceWatermarks task - Demote the coldest blobs off targets whose used
+ * space is above their high watermark until they drop below the low one
+ */
+struct EnforceWatermarksTask : public chi::Task {
+  IN chi::u32 max_blobs_;      // Max blobs to demote per container (0 = all)
+  OUT chi::u32 targets_over_;  // Targets found above their high watermark
+  OUT chi::u32 blobs_demoted_; // Blobs moved to a slower target
+  OUT chi::u64 bytes_moved_;   // Total bytes copied between targets
+
+  // SHM constructor
+  explicit EnforceWatermarksTask(
+      const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
+      : chi::Task(alloc), max_blobs_(0), targets_over_(0), blobs_demoted_(0),
+        bytes_moved_(0) {}
+
+  // Emplace constructor
+  explicit EnforceWatermarksTask(
+      const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
+      const chi::TaskId &task_id, const chi::PoolId &pool_id,
+      const chi::PoolQuery &pool_query, chi::u32 max_blobs)
+      : chi::Task(alloc, task_id, pool_id, pool_query,
+                  Method::kEnforceWatermarks),
+        max_blobs_(max_blobs), targets_over_(0), blobs_demoted_(0),
+        bytes_moved_(0) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kEnforceWatermarks;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  /**
+   * Serialize IN and INOUT parameters
+   */
+  template <typename Archive> void SerializeIn(Archive &ar) { ar(max_blobs_); }
+
+  /**
+   * Serialize OUT and INOUT parameters
+   */
+  template <typename Archive> void SerializeOut(Archive &ar) {
+    ar(targets_over_, blobs_demoted_, bytes_moved_);
+  }
+
+  /**
+   * Copy from another EnforceWatermarksTask
+   */
+  void Copy(const hipc::FullPtr<EnforceWatermarksTask> &other) {
+    max_blobs_ = other->max_blobs_;
+    targets_over_ = other->targets_over_;
+    blobs_demoted_ = other->blobs_demoted_;
+    bytes_moved_ = other->bytes_moved_;
+  }
+
+  /**
+   * Aggregate results from multiple nodes
+   */
+  void Aggregate(const hipc::FullPtr<EnforceWatermarksTask> &other) {
+    targets_over_ += other->targets_over_;
+    blobs_demoted_ += other->blobs_demoted_;
+    bytes_moved_ += other->bytes_moved_;
+  }
+};
+
+/**
+ * GetRuntimeStats task - Report per-operation latency histograms and
+ * per-target I/O counters, optionally resetting the histograms
+ */
+struct GetRuntimeStatsTask : public chi::Task {
+  IN bool reset_; // Clear the histograms after reading them
+  OUT hipc::vector<LatencySummary> latencies_; // Series with samples
+  OUT hipc::vector<TargetIoStats> targets_;    // One entry per target
+
+  // SHM constructor
+  explicit GetRuntimeStatsTask(
+      const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
+      : chi::Task(alloc), reset_(false), latencies_(alloc), targets_(alloc) {}
+
+  // Emplace constructor
+  explicit GetRuntimeStatsTask(
+      const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
+      const chi::TaskId &task_id, const chi::PoolId &pool_id,
+      const chi::PoolQuery &pool_query, bool reset)
+      : chi::Task(alloc, task_id, pool_id, pool_query,
+                  Method::kGetRuntimeStats),
+        reset_(reset), latencies_(alloc), targets_(alloc) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kGetRuntimeStats;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  /**
+   * Serialize IN and INOUT parameters
+   */
+  template <typename Archive> void SerializeIn(Archive &ar) { ar(reset_); }
+
+  /**
+   * Serialize OUT and INOUT parameters
+   */
+  template <typename Archive> void SerializeOut(Archive &ar) {
+    ar(latencies_, targets_);
+  }
+
+  /**
+   * Copy from another GetRuntimeStatsTask
+   */
+  void Copy(const hipc::FullPtr<GetRuntimeStatsTask> &other) {
+    reset_ = other->reset_;
+    latencies_ = other->latencies_;
+    targets_ = other->targets_;
+  }
+
+  /**
+   * Aggregate results from multiple nodes: histograms of the same
+   * (operation, phase) are merged, target counters are concatenated
+   */
+  void Aggregate(const hipc::FullPtr<GetRuntimeStatsTask> &other) {
+    for (const auto &summary : other->latencies_) {
+      bool merged = false;
+      for (auto &existing : latencies_) {
+        if (existing.op_ == summary.op_ && existing.phase_ == summary.phase_) {
+          existing.Merge(summary);
+          merged = true;
+          break;
+        }
+      }
+      if (!merged) {
+        latencies_.push_back(summary);
+      }
+    }
+    for (const auto &target : other->targets_) {
+      targets_.push_back(target);
+    }
+  }
+};
+
+/**
+ * StageIn task - Read a range of a backing file and store it as the page
+ * blobs of the tag named after the file. Pages that already exist in CTE are
+ * left untouched.
+ */
+struct StageInTask : public chi::Task {
+  IN hipc::string path_;   // Backing file; also the tag name
+  IN chi::u64 offset_;     // First byte to stage (rounded down to a page)
+  IN chi::u64 size_;       // Bytes to stage (0 = to end of file)
+  IN chi::u64 page_size_;  // Page size; blob i holds bytes [i, i+1) * page
+  IN float score_;         // Score of the staged blobs
+  OUT chi::u32 pages_staged_; // Pages read from the file and stored
+  OUT chi::u64 bytes_staged_; // Bytes read from the file and stored
+
+  // SHM constructor
+  explicit StageInTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
+      : chi::Task(alloc), path_(alloc), offset_(0), size_(0), page_size_(0),
+        score_(1.0f), pages_staged_(0), bytes_staged_(0) {}
+
+  // Emplace constructor
+  explicit StageInTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
+                       const chi::TaskId &task_id, const chi::PoolId &pool_id,
+                       const chi::PoolQuery &pool_query,
+                       const std::string &path, chi::u64 offset, chi::u64 size,
+                       chi::u64 page_size, float score)
+      : chi::Task(alloc, task_id, pool_id, pool_query, Method::kStageIn),
+        path_(alloc, path), offset_(offset), size_(size),
+        page_size_(page_size), score_(score), pages_staged_(0),
+        bytes_staged_(0) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kStageIn;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  /**
+   * Serialize IN and INOUT parameters
+   */
+  template <typename Archive> void SerializeIn(Archive &ar) {
+    ar(path_, offset_, size_, page_size_, score_);
+  }
+
+  /**
+   * Serialize OUT and INOUT parameters
+   */
+  template <typename Archive> void SerializeOut(Archive &ar) {
+    ar(pages_staged_, bytes_staged_);
+  }
+
+  /**
+   * Copy from another StageInTask
+   */
+  void Copy(const hipc::FullPtr<StageInTask> &other) {
+    path_ = other->path_;
+    offset_ = other->offset_;
+    size_ = other->size_;
+    page_size_ = other->page_size_;
+    score_ = other->score_;
+    pages_staged_ = other->pages_staged_;
+    bytes_staged_ = other->bytes_staged_;
+  }
+};
+
+/**
+ * FlushTag task - Write the page blobs of a tag written since its last flush
+ * back to the tag's backing file. The first FlushTag of a tag registers the
+ * file with each container; registered tags are also flushed periodically.
+ * A null tag_id_ flushes every registered tag of the container.
+ */
+struct FlushTagTask : public chi::Task {
+  IN TagId tag_id_;           // Tag to flush (null = all registered tags)
+  IN hipc::string path_;      // Backing file of the tag
+  IN chi::u64 page_size_;     // Page size; blob i holds bytes [i, i+1) * page
+  IN chi::u32 flags_;         // kFlushDurable
+  OUT chi::u64 pages_flushed_; // Pages written to the file
+  OUT chi::u64 bytes_flushed_; // Bytes written to the file
+  OUT chi::u64 failed_pages_;  // Pages left dirty because a step failed
+  OUT chi::u64 elapsed_ns_;    // Time spent flushing (slowest container)
+
+  // SHM constructor
+  explicit FlushTagTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
+      : chi::Task(alloc), tag_id_(TagId::GetNull()), path_(alloc),
+        page_size_(0), flags_(0), pages_flushed_(0), bytes_flushed_(0),
+        failed_pages_(0), elapsed_ns_(0) {}
+
+  // Emplace constructor
+  explicit FlushTagTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
+                        const chi::TaskId &task_id, const chi::PoolId &pool_id,
+                        const chi::PoolQuery &pool_query, const TagId &tag_id,
+                        const std::string &path, chi::u64 page_size,
+                        chi::u32 flags)
+      : chi::Task(alloc, task_id, pool_id, pool_query, Method::kFlushTag),
+        tag_id_(tag_id), path_(alloc, path), page_size_(page_size),
+        flags_(flags), pages_flushed_(0), bytes_flushed_(0), failed_pages_(0),
+        elapsed_ns_(0) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kFlushTag;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  /**
+   * Serialize IN and INOUT parameters
+   */
+  template <typename Archive> void SerializeIn(Archive &ar) {
+    ar(tag_id_, path_, page_size_, flags_);
+  }
+
+  /**
+   * Serialize OUT and INOUT parameters
+   */
+  template <typename Archive> void SerializeOut(Archive &ar) {
+    ar(pages_flushed_, bytes_flushed_, failed_pages_, elapsed_ns_);
+  }
+
+  /**
+   * Copy from another FlushTagTask
+   */
+  void Copy(const hipc::FullPtr<FlushTagTask> &other) {
+    tag_id_ = other->tag_id_;
+    path_ = other->path_;
+    page_size_ = other->page_size_;
+    flags_ = other->flags_;
+    pages_flushed_ = other->pages_flushed_;
+    bytes_flushed_ = other->bytes_flushed_;
+    failed_pages_ = other->failed_pages_;
+    elapsed_ns_ = other->elapsed_ns_;
+  }
+
+  /**
+   * Aggregate results from multiple nodes; containers flush in parallel, so
+   * the elapsed time is the slowest one's
+   */
+  void Aggregate(const hipc::FullPtr<FlushTagTask> &other) {
+    pages_flushed_ += other->pages_flushed_;
+    bytes_flushed_ += other->bytes_flushed_;
+    failed_pages_ += other->failed_pages_;
+    elapsed_ns_ = std::max(elapsed_ns_, other->elapsed_ns_);
+  }
+};
+
+/**
+ * Client-side result of FlushTag
+ */
+struct FlushReport {
+  bool success_;          // Every dirty page was written back
+  chi::u64 pages_;        // Pages written to the file
+  chi::u64 bytes_;        // Bytes written to the file
+  chi::u64 elapsed_ns_;   // Time spent flushing
+
+  FlushReport() : success_(false), pages_(0), bytes_(0), elapsed_ns_(0) {}
+
+  /** Write-back bandwidth in MB/s (0 if nothing was written) */
+  double GetBandwidthMBps() const {
+    if (elapsed_ns_ == 0) {
+      return 0.0;
+    }
+    return (static_cast<double>(bytes_) / (1024.0 * 1024.0)) /
+           (static_cast<double>(elapsed_ns_) / 1e9);
+  }
+};
+
+/**
+ * TruncateBlob task - Shrink a blob to new_size_ bytes. Blocks wholly past the
+ * new size are freed; a block straddling it is replaced by a smaller copy.
+ * A blob already no larger than new_size_ is left unchanged.
+ */
+struct TruncateBlobTask : public chi::Task {
+  IN TagId tag_id_;           // Tag containing the blob
+  IN hipc::string blob_name_; // Blob to shrink
+  IN chi::u64 new_size_;      // Size to shrink the blob to
+  OUT chi::u64 bytes_freed_;  // Bytes released from the blob
+
+  // SHM constructor
+  explicit TruncateBlobTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
+      : chi::Task(alloc), tag_id_(TagId::GetNull()), blob_name_(alloc),
+        new_size_(0), bytes_freed_(0) {}
+
+  // Emplace constructor
+  explicit TruncateBlobTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
+                            const chi::TaskId &task_id,
+                            const chi::PoolId &pool_id,
+                            const chi::PoolQuery &pool_query,
+                            const TagId &tag_id, const std::string &blob_name,
+                            chi::u64 new_size)
+      : chi::Task(alloc, task_id, pool_id, pool_query, Method::kTruncateBlob),
+        tag_id_(tag_id), blob_name_(alloc, blob_name), new_size_(new_size),
+        bytes_freed_(0) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kTruncateBlob;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  /**
+   * Serialize IN and INOUT parameters
+   */
+  template <typename Archive> void SerializeIn(Archive &ar) {
+    ar(tag_id_, blob_name_, new_size_);
+  }
+
+  /**
+   * Serialize OUT and INOUT parameters
+   */
+  template <typename Archive> void SerializeOut(Archive &ar) {
+    ar(bytes_freed_);
+  }
+
+  /**
+   * Copy from another TruncateBlobTask
+   */
+  void Copy(const hipc::FullPtr<TruncateBlobTask> &other) {
+    tag_id_ = other->tag_id_;
+    blob_name_ = other->blob_name_;
+    new_size_ = other->new_size_;
+    bytes_freed_ = other->bytes_freed_;
+  }
+};
+
+/**
+ * TruncateTag task - Truncate the file held in a tag's page blobs to
+ * new_size_ bytes: pages starting at or past the new size are deleted and the
+ * page containing it is shrunk with TruncateBlob. Every container truncates
+ * the pages it holds.
+ */
+struct TruncateTagTask : public chi::Task {
+  IN TagId tag_id_;           // Tag of the file
+  IN chi::u64 new_size_;      // New file size in bytes
+  IN chi::u64 page_size_;     // Page size; blob i holds bytes [i, i+1) * page
+  OUT chi::u64 pages_deleted_; // Page blobs deleted
+  OUT chi::u64 bytes_freed_;   // Bytes released from deleted and shrunk pages
+
+  // SHM constructor
+  explicit TruncateTagTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
+      : chi::Task(alloc), tag_id_(TagId::GetNull()), new_size_(0),
+        page_size_(0), pages_deleted_(0), bytes_freed_(0) {}
+
+  // Emplace constructor
+  explicit TruncateTagTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
+                           const chi::TaskId &task_id,
+                           const chi::PoolId &pool_id,
+                           const chi::PoolQuery &pool_query,
+                           const TagId &tag_id, chi::u64 new_size,
+                           chi::u64 page_size)
+      : chi::Task(alloc, task_id, pool_id, pool_query, Method::kTruncateTag),
+        tag_id_(tag_id), new_size_(new_size), page_size_(page_size),
+        pages_deleted_(0), bytes_freed_(0) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kTruncateTag;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  /**
+   * Serialize IN and INOUT parameters
+   */
+  template <typename Archive> void SerializeIn(Archive &ar) {
+    ar(tag_id_, new_size_, page_size_);
+  }
+
+  /**
+   * Serialize OUT and INOUT parameters
+   */
+  template <typename Archive> void SerializeOut(Archive &ar) {
+    ar(pages_deleted_, bytes_freed_);
+  }
+
+  /**
+   * Copy from another TruncateTagTask
+   */
+  void Copy(const hipc::FullPtr<TruncateTagTask> &other) {
+    tag_id_ = other->tag_id_;
+    new_size_ = other->new_size_;
+    page_size_ = other->page_size_;
+    pages_deleted_ = other->pages_deleted_;
+    bytes_freed_ = other->bytes_freed_;
+  }
+
+  /**
+   * Aggregate results from multiple nodes
+   */
+  void Aggregate(const hipc::FullPtr<TruncateTagTask> &other) {
+    pages_deleted_ += other->pages_deleted_;
+    bytes_freed_ += other->bytes_freed_;
+  }
+};
+
+/**
+ * AppendToTag task - Reserve [offset_, offset_ + size_) at the end of a file
+ * tag and write data there as page blobs. Reservations of one tag are made by
+ * a single container, so concurrent appends never overlap.
+ */
+struct AppendToTagTask : public chi::Task {
+  IN TagId tag_id_;          // Tag of the file
+  IN chi::u64 size_;         // Bytes to append
+  IN hipc::Pointer data_;    // Data to append (shared memory pointer)
+  IN chi::u64 page_size_;    // Page size; blob i holds bytes [i, i+1) * page
+  IN float score_;           // Score of the written pages
+  IN chi::u64 min_offset_;   // Lowest offset to append at (known file size)
+  OUT chi::u64 offset_;      // Offset the data was appended at
+
+  // SHM constructor
+  explicit AppendToTagTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
+      : chi::Task(alloc), tag_id_(TagId::GetNull()), size_(0),
+        data_(hipc::Pointer::GetNull()), page_size_(0), score_(1.0f),
+        min_offset_(0), offset_(0) {}
+
+  // Emplace constructor
+  explicit AppendToTagTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
+                           const chi::TaskId &task_id,
+                           const chi::PoolId &pool_id,
+                           const chi::PoolQuery &pool_query,
+                           const TagId &tag_id, hipc::Pointer data,
+                           chi::u64 size, chi::u64 page_size, float score,
+                           chi::u64 min_offset = 0)
+      : chi::Task(alloc, task_id, pool_id, pool_query, Method::kAppendToTag),
+        tag_id_(tag_id), size_(size), data_(data), page_size_(page_size),
+        score_(score), min_offset_(min_offset), offset_(0) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kAppendToTag;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  /**
+   * Serialize IN and INOUT parameters
+   */
+  template <typename Archive> void SerializeIn(Archive &ar) {
+    ar(tag_id_, size_, page_size_, score_, min_offset_);
+    // Use BULK_XFER to transfer the appended data from client to runtime
+    ar.bulk(data_, size_, BULK_XFER);
+  }
+
+  /**
+   * Serialize OUT and INOUT parameters
+   */
+  template <typename Archive> void SerializeOut(Archive &ar) {
+    ar(offset_);
+  }
+
+  /**
+   * Copy from another AppendToTagTask
+   */
+  void Copy(const hipc::FullPtr<AppendToTagTask> &other) {
+    tag_id_ = other->tag_id_;
+    size_ = other->size_;
+    data_ = other->data_;
+    page_size_ = other->page_size_;
+    score_ = other->score_;
+    min_offset_ = other->min_offset_;
+    offset_ = other->offset_;
+  }
+};
+
+/**
+ * RebalanceBlobs task - Move the blobs held by one container whose owner on
+ * the consistent-hash ring is now another container
+ */
+struct RebalanceBlobsTask : public chi::Task {
+  IN chi::u32 container_id_; // Container the task is routed to
+  IN chi::u32 max_blobs_;    // Max blobs to move (0 = all)
+  OUT chi::u32 blobs_moved_; // Blobs copied to their new owner and removed
+  OUT chi::u32 blobs_deferred_; // Blobs left for a later pass (dirty/failed)
+  OUT chi::u64 bytes_moved_; // Total bytes copied to new owners
+  OUT chi::u32 tags_moved_;  // Tags handed to their new canonical owner
+
+  // SHM constructor
+  explicit RebalanceBlobsTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc)
+      : chi::Task(alloc), container_id_(0), max_blobs_(0), blobs_moved_(0),
+        blobs_deferred_(0), bytes_moved_(0), tags_moved_(0) {}
+
+  // Emplace constructor
+  explicit RebalanceBlobsTask(const hipc::CtxAllocator<CHI_MAIN_ALLOC_T> &alloc,
+                              const chi::TaskId &task_id,
+                              const chi::PoolId &pool_id,
+                              const chi::PoolQuery &pool_query,
+                              chi::u32 container_id, chi::u32 max_blobs)
+      : chi::Task(alloc, task_id, pool_id, pool_query,
+                  Method::kRebalanceBlobs),
+        container_id_(container_id), max_blobs_(max_blobs), blobs_moved_(0),
+        blobs_deferred_(0), bytes_moved_(0), tags_moved_(0) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kRebalanceBlobs;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  /**
+   * Serialize IN and INOUT parameters
+   */
+  template <typename Archive> void SerializeIn(Archive &ar) {
+    ar(container_id_, max_blobs_);
+  }
+
+  /**
+   * Serialize OUT and INOUT parameters
+   */
+  template <typename Archive> void SerializeOut(Archive &ar) {
+    ar(blobs_moved_, blobs_deferred_, bytes_moved_, tags_moved_);
+  }
+
+  /**
+   * Copy from another RebalanceBlobsTask
+   */
+  void Copy(const hipc::FullPtr<RebalanceBlobsTask> &other) {
+    container_id_ = other->container_id_;
+    max_blobs_ = other->max_blobs_;
+    blobs_moved_ = other->blobs_moved_;
+    blobs_deferred_ = other->blobs_deferred_;
+    bytes_moved_ = other->bytes_moved_;
+    tags_moved_ = other->tags_moved_;
+  }
+
+  /**
+   * Aggregate results from multiple nodes
+   */
+  void Aggregate(const hipc::FullPtr<RebalanceBlobsTask> &other) {
+    blobs_moved_ += other->blobs_moved_;
+    blobs_deferred_ += other->blobs_deferred_;
+    bytes_moved_ += other->bytes_moved_;
+    tags_moved_ += other->tags_moved_;
   }
 };
 
 } // namespace wrp_cte::core
 
+// Hash specializations for BlobKey: reuse the precomputed hash so the map
+// bucket and the runtime's blob lock are selected from the same value
+namespace hshm {
+template <> struct hash<wrp_cte::core::BlobKey> {
+  std::size_t operator()(const wrp_cte::core::BlobKey &key) const {
+    return static_cast<std::size_t>(key.hash_);
+  }
+};
+} // namespace hshm
+
+namespace std {
+template <> struct hash<wrp_cte::core::BlobKey> {
+  std::size_t operator()(const wrp_cte::core::BlobKey &key) const {
+    return static_cast<std::size_t>(key.hash_);
+  }
+};
+} // namespace std
+
 #endif // WRPCTE_CORE_TASKS_H_
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef WRPCTE_CORE_TELEMETRY_H_
+#define WRPCTE_CORE_TELEMETRY_H_
+
+#include <atomic>
+#include <chimaera/chimaera.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <wrp_cte/core/core_tasks.h>
+
+namespace wrp_cte::core {
+
+/**
+ * Fixed-size telemetry ring indexed by logical time
+ *
+ * Producers claim a logical time with one atomic increment and publish the
+ * entry into slot (logical_time - 1) % capacity under a per-slot sequence
+ * number. Readers never mutate the ring: they copy entries after a caller
+ * cursor and use the sequence number to detect slots that were overwritten
+ * or are still being written.
+ */
+class TelemetryRing {
+public:
+  /** Default number of entries retained */
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  explicit TelemetryRing(size_t capacity = kDefaultCapacity);
+
+  /**
+   * Discard all entries and resize the ring
+   * Not safe to call concurrently with Push or Read
+   * @param capacity Number of entries to retain (at least 1)
+   */
+  void Reset(size_t capacity);
+
+  /**
+   * Append an entry, assigning it the next logical time
+   * @param entry Entry to publish (its logical_time_ is overwritten)
+   * @return Logical time assigned to the entry
+   */
+  std::uint64_t Push(CteTelemetry entry);
+
+  /**
+   * Copy entries with logical time greater than cursor, oldest first
+   * @param cursor Last logical time the caller has already seen
+   * @param max_entries Max entries to copy (0 = up to the ring capacity)
+   * @param entries Output entries (appended)
+   * @param dropped Output count of entries after cursor that were overwritten
+   * before they could be copied
+   * @return New cursor: the last logical time consumed (>= cursor)
+   */
+  std::uint64_t Read(std::uint64_t cursor, size_t max_entries,
+                     std::vector<CteTelemetry> &entries,
+                     std::uint64_t &dropped) const;
+
+  /**
+   * Logical time of the most recently claimed entry (0 if none)
+   */
+  std::uint64_t GetHead() const { return head_.load(std::memory_order_acquire); }
+
+  /**
+   * Number of entries currently retained
+   */
+  size_t GetSize() const;
+
+  /**
+   * Maximum number of entries retained
+   */
+  size_t GetCapacity() const { return capacity_; }
+
+private:
+  /** Sequence value of a slot holding a published entry for logical_time */
+  static std::uint64_t Published(std::uint64_t logical_time) {
+    return logical_time << 1;
+  }
+
+  struct Slot {
+    std::atomic<std::uint64_t> seq_{0}; // Published(t), or odd while writing
+    CteTelemetry entry_;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t capacity_;
+  std::atomic<std::uint64_t> head_; // Last logical time handed out
+};
+
+} // namespace wrp_cte::core
+
+#endif // WRPCTE_CORE_TELEMETRY_H_
@@ -103,6 +103,50 @@ void Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr, chi::RunCo
       BlobQuery(task_ptr.Cast<BlobQueryTask>(), rctx);
       break;
     }
+    case Method::kReorganizeTiers: {
+      ReorganizeTiers(task_ptr.Cast<ReorganizeTiersTask>(), rctx);
+      break;
+    }
+    case Method::kEnforceWatermarks: {
+      EnforceWatermarks(task_ptr.Cast<EnforceWatermarksTask>(), rctx);
+      break;
+    }
+    case Method::kGetRuntimeStats: {
+      GetRuntimeStats(task_ptr.Cast<GetRuntimeStatsTask>(), rctx);
+      break;
+    }
+    case Method::kPutBlobs: {
+      PutBlobs(task_ptr.Cast<PutBlobsTask>(), rctx);
+      break;
+    }
+    case Method::kGetBlobs: {
+      GetBlobs(task_ptr.Cast<GetBlobsTask>(), rctx);
+      break;
+    }
+    case Method::kStageIn: {
+      StageIn(task_ptr.Cast<StageInTask>(), rctx);
+      break;
+    }
+    case Method::kFlushTag: {
+      FlushTag(task_ptr.Cast<FlushTagTask>(), rctx);
+      break;
+    }
+    case Method::kTruncateBlob: {
+      TruncateBlob(task_ptr.Cast<TruncateBlobTask>(), rctx);
+      break;
+    }
+    case Method::kTruncateTag: {
+      TruncateTag(task_ptr.Cast<TruncateTagTask>(), rctx);
+      break;
+    }
+    case Method::kAppendToTag: {
+      AppendToTag(task_ptr.Cast<AppendToTagTask>(), rctx);
+      break;
+    }
+    case Method::kRebalanceBlobs: {
+      RebalanceBlobs(task_ptr.Cast<RebalanceBlobsTask>(), rctx);
+      break;
+    }
     default: {
       // Unknown method - do nothing
       break;
@@ -191,6 +235,50 @@ void Runtime::Del(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr) {
       ipc_manager->DelTask(task_ptr.Cast<BlobQueryTask>());
       break;
     }
+    case Method::kReorganizeTiers: {
+      ipc_manager->DelTask(task_ptr.Cast<ReorganizeTiersTask>());
+      break;
+    }
+    case Method::kEnforceWatermarks: {
+      ipc_manager->DelTask(task_ptr.Cast<EnforceWatermarksTask>());
+      break;
+    }
+    case Method::kGetRuntimeStats: {
+      ipc_manager->DelTask(task_ptr.Cast<GetRuntimeStatsTask>());
+      break;
+    }
+    case Method::kPutBlobs: {
+      ipc_manager->DelTask(task_ptr.Cast<PutBlobsTask>());
+      break;
+    }
+    case Method::kGetBlobs: {
+      ipc_manager->DelTask(task_ptr.Cast<GetBlobsTask>());
+      break;
+    }
+    case Method::kStageIn: {
+      ipc_manager->DelTask(task_ptr.Cast<StageInTask>());
+      break;
+    }
+    case Method::kFlushTag: {
+      ipc_manager->DelTask(task_ptr.Cast<FlushTagTask>());
+      break;
+    }
+    case Method::kTruncateBlob: {
+      ipc_manager->DelTask(task_ptr.Cast<TruncateBlobTask>());
+      break;
+    }
+    case Method::kTruncateTag: {
+      ipc_manager->DelTask(task_ptr.Cast<TruncateTagTask>());
+      break;
+    }
+    case Method::kAppendToTag: {
+      ipc_manager->DelTask(task_ptr.Cast<AppendToTagTask>());
+      break;
+    }
+    case Method::kRebalanceBlobs: {
+      ipc_manager->DelTask(task_ptr.Cast<RebalanceBlobsTask>());
+      break;
+    }
     default: {
       // For unknown methods, still try to delete from main segment
       ipc_manager->DelTask(task_ptr);
@@ -297,6 +385,61 @@ void Runtime::SaveTask(chi::u32 method, chi::SaveTaskArchive& archive,
       archive << *typed_task;
       break;
     }
+    case Method::kReorganizeTiers: {
+      auto typed_task = task_ptr.Cast<ReorganizeTiersTask>();
+      archive << *typed_task;
+      break;
+    }
+    case Method::kEnforceWatermarks: {
+      auto typed_task = task_ptr.Cast<EnforceWatermarksTask>();
+      archive << *typed_task;
+      break;
+    }
+    case Method::kGetRuntimeStats: {
+      auto typed_task = task_ptr.Cast<GetRuntimeStatsTask>();
+      archive << *typed_task;
+      break;
+    }
+    case Method::kPutBlobs: {
+      auto typed_task = task_ptr.Cast<PutBlobsTask>();
+      archive << *typed_task;
+      break;
+    }
+    case Method::kGetBlobs: {
+      auto typed_task = task_ptr.Cast<GetBlobsTask>();
+      archive << *typed_task;
+      break;
+    }
+    case Method::kStageIn: {
+      auto typed_task = task_ptr.Cast<StageInTask>();
+      archive << *typed_task;
+      break;
+    }
+    case Method::kFlushTag: {
+      auto typed_task = task_ptr.Cast<FlushTagTask>();
+      archive << *typed_task;
+      break;
+    }
+    case Method::kTruncateBlob: {
+      auto typed_task = task_ptr.Cast<TruncateBlobTask>();
+      archive << *typed_task;
+      break;
+    }
+    case Method::kTruncateTag: {
+      auto typed_task = task_ptr.Cast<TruncateTagTask>();
+      archive << *typed_task;
+      break;
+    }
+    case Method::kAppendToTag: {
+      auto typed_task = task_ptr.Cast<AppendToTagTask>();
+      archive << *typed_task;
+      break;
+    }
+    case Method::kRebalanceBlobs: {
+      auto typed_task = task_ptr.Cast<RebalanceBlobsTask>();
+      archive << *typed_task;
+      break;
+    }
     default: {
       // Unknown method - do nothing
       break;
@@ -480,6 +623,105 @@ void Runtime::LoadTask(chi::u32 method, chi::LoadTaskArchive& archive,
       archive >> *typed_task;
       break;
     }
+    case Method::kReorganizeTiers: {
+      // Allocate task using typed NewTask if not already allocated
+      if (task_ptr.IsNull()) {
+        task_ptr = ipc_manager->NewTask<ReorganizeTiersTask>().template Cast<chi::Task>();
+      }
+      auto typed_task = task_ptr.Cast<ReorganizeTiersTask>();
+      archive >> *typed_task;
+      break;
+    }
+    case Method::kEnforceWatermarks: {
+      // Allocate task using typed NewTask if not already allocated
+      if (task_ptr.IsNull()) {
+        task_ptr = ipc_manager->NewTask<EnforceWatermarksTask>().template Cast<chi::Task>();
+      }
+      auto typed_task = task_ptr.Cast<EnforceWatermarksTask>();
+      archive >> *typed_task;
+      break;
+    }
+    case Method::kGetRuntimeStats: {
+      // Allocate task using typed NewTask if not already allocated
+      if (task_ptr.IsNull()) {
+        task_ptr = ipc_manager->NewTask<GetRuntimeStatsTask>().template Cast<chi::Task>();
+      }
+      auto typed_task = task_ptr.Cast<GetRuntimeStatsTask>();
+      archive >> *typed_task;
+      break;
+    }
+    case Method::kPutBlobs: {
+      // Allocate task using typed NewTask if not already allocated
+      if (task_ptr.IsNull()) {
+        task_ptr = ipc_manager->NewTask<PutBlobsTask>().template Cast<chi::Task>();
+      }
+      auto typed_task = task_ptr.Cast<PutBlobsTask>();
+      archive >> *typed_task;
+      break;
+    }
+    case Method::kGetBlobs: {
+      // Allocate task using typed NewTask if not already allocated
+      if (task_ptr.IsNull()) {
+        task_ptr = ipc_manager->NewTask<GetBlobsTask>().template Cast<chi::Task>();
+      }
+      auto typed_task = task_ptr.Cast<GetBlobsTask>();
+      archive >> *typed_task;
+      break;
+    }
+    case Method::kStageIn: {
+      // Allocate task using typed NewTask if not already allocated
+      if (task_ptr.IsNull()) {
+        task_ptr = ipc_manager->NewTask<StageInTask>().template Cast<chi::Task>();
+      }
+      auto typed_task = task_ptr.Cast<StageInTask>();
+      archive >> *typed_task;
+      break;
+    }
+    case Method::kFlushTag: {
+      // Allocate task using typed NewTask if not already allocated
+      if (task_ptr.IsNull()) {
+        task_ptr = ipc_manager->NewTask<FlushTagTask>().template Cast<chi::Task>();
+      }
+      auto typed_task = task_ptr.Cast<FlushTagTask>();
+      archive >> *typed_task;
+      break;
+    }
+    case Method::kTruncateBlob: {
+      // Allocate task using typed NewTask if not already allocated
+      if (task_ptr.IsNull()) {
+        task_ptr = ipc_manager->NewTask<TruncateBlobTask>().template Cast<chi::Task>();
+      }
+      auto typed_task = task_ptr.Cast<TruncateBlobTask>();
+      archive >> *typed_task;
+      break;
+    }
+    case Method::kTruncateTag: {
+      // Allocate task using typed NewTask if not already allocated
+      if (task_ptr.IsNull()) {
+        task_ptr = ipc_manager->NewTask<TruncateTagTask>().template Cast<chi::Task>();
+      }
+      auto typed_task = task_ptr.Cast<TruncateTagTask>();
+      archive >> *typed_task;
+      break;
+    }
+    case Method::kAppendToTag: {
+      // Allocate task using typed NewTask if not already allocated
+      if (task_ptr.IsNull()) {
+        task_ptr = ipc_manager->NewTask<AppendToTagTask>().template Cast<chi::Task>();
+      }
+      auto typed_task = task_ptr.Cast<AppendToTagTask>();
+      archive >> *typed_task;
+      break;
+    }
+    case Method::kRebalanceBlobs: {
+      // Allocate task using typed NewTask if not already allocated
+      if (task_ptr.IsNull()) {
+        task_ptr = ipc_manager->NewTask<RebalanceBlobsTask>().template Cast<chi::Task>();
+      }
+      auto typed_task = task_ptr.Cast<RebalanceBlobsTask>();
+      archive >> *typed_task;
+      break;
+    }
     default: {
       // Unknown method - do nothing
       break;
@@ -742,6 +984,149 @@ void Runtime::NewCopy(chi::u32 method, const hipc::FullPtr<chi::Task>& orig_task
       }
       break;
     }
+    case Method::kReorganizeTiers: {
+      // Allocate new task using SHM default constructor
+      auto typed_task = ipc_manager->NewTask<ReorganizeTiersTask>();
+      if (!typed_task.IsNull()) {
+        // Copy base Task fields first
+        typed_task.template Cast<chi::Task>()->Copy(orig_task);
+        // Then copy task-specific fields
+        typed_task->Copy(orig_task.Cast<ReorganizeTiersTask>());
+        // Cast to base Task type for return
+        dup_task = typed_task.template Cast<chi::Task>();
+      }
+      break;
+    }
+    case Method::kEnforceWatermarks: {
+      // Allocate new task using SHM default constructor
+      auto typed_task = ipc_manager->NewTask<EnforceWatermarksTask>();
+      if (!typed_task.IsNull()) {
+        // Copy base Task fields first
+        typed_task.template Cast<chi::Task>()->Copy(orig_task);
+        // Then copy task-specific fields
+        typed_task->Copy(orig_task.Cast<EnforceWatermarksTask>());
+        // Cast to base Task type for return
+        dup_task = typed_task.template Cast<chi::Task>();
+      }
+      break;
+    }
+    case Method::kGetRuntimeStats: {
+      // Allocate new task using SHM default constructor
+      auto typed_task = ipc_manager->NewTask<GetRuntimeStatsTask>();
+      if (!typed_task.IsNull()) {
+        // Copy base Task fields first
+        typed_task.template Cast<chi::Task>()->Copy(orig_task);
+        // Then copy task-specific fields
+        typed_task->Copy(orig_task.Cast<GetRuntimeStatsTask>());
+        // Cast to base Task type for return
+        dup_task = typed_task.template Cast<chi::Task>();
+      }
+      break;
+    }
+    case Method::kPutBlobs: {
+      // Allocate new task using SHM default constructor
+      auto typed_task = ipc_manager->NewTask<PutBlobsTask>();
+      if (!typed_task.IsNull()) {
+        // Copy base Task fields first
+        typed_task.template Cast<chi::Task>()->Copy(orig_task);
+        // Then copy task-specific fields
+        typed_task->Copy(orig_task.Cast<PutBlobsTask>());
+        // Cast to base Task type for return
+        dup_task = typed_task.template Cast<chi::Task>();
+      }
+      break;
+    }
+    case Method::kGetBlobs: {
+      // Allocate new task using SHM default constructor
+      auto typed_task = ipc_manager->NewTask<GetBlobsTask>();
+      if (!typed_task.IsNull()) {
+        // Copy base Task fields first
+        typed_task.template Cast<chi::Task>()->Copy(orig_task);
+        // Then copy task-specific fields
+        typed_task->Copy(orig_task.Cast<GetBlobsTask>());
+        // Cast to base Task type for return
+        dup_task = typed_task.template Cast<chi::Task>();
+      }
+      break;
+    }
+    case Method::kStageIn: {
+      // Allocate new task using SHM default constructor
+      auto typed_task = ipc_manager->NewTask<StageInTask>();
+      if (!typed_task.IsNull()) {
+        // Copy base Task fields first
+        typed_task.template Cast<chi::Task>()->Copy(orig_task);
+        // Then copy task-specific fields
+        typed_task->Copy(orig_task.Cast<StageInTask>());
+        // Cast to base Task type for return
+        dup_task = typed_task.template Cast<chi::Task>();
+      }
+      break;
+    }
+    case Method::kFlushTag: {
+      // Allocate new task using SHM default constructor
+      auto typed_task = ipc_manager->NewTask<FlushTagTask>();
+      if (!typed_task.IsNull()) {
+        // Copy base Task fields first
+        typed_task.template Cast<chi::Task>()->Copy(orig_task);
+        // Then copy task-specific fields
+        typed_task->Copy(orig_task.Cast<FlushTagTask>());
+        // Cast to base Task type for return
+        dup_task = typed_task.template Cast<chi::Task>();
+      }
+      break;
+    }
+    case Method::kTruncateBlob: {
+      // Allocate new task using SHM default constructor
+      auto typed_task = ipc_manager->NewTask<TruncateBlobTask>();
+      if (!typed_task.IsNull()) {
+        // Copy base Task fields first
+        typed_task.template Cast<chi::Task>()->Copy(orig_task);
+        // Then copy task-specific fields
+        typed_task->Copy(orig_task.Cast<TruncateBlobTask>());
+        // Cast to base Task type for return
+        dup_task = typed_task.template Cast<chi::Task>();
+      }
+      break;
+    }
+    case Method::kTruncateTag: {
+      // Allocate new task using SHM default constructor
+      auto typed_task = ipc_manager->NewTask<TruncateTagTask>();
+      if (!typed_task.IsNull()) {
+        // Copy base Task fields first
+        typed_task.template Cast<chi::Task>()->Copy(orig_task);
+        // Then copy task-specific fields
+        typed_task->Copy(orig_task.Cast<TruncateTagTask>());
+        // Cast to base Task type for return
+        dup_task = typed_task.template Cast<chi::Task>();
+      }
+      break;
+    }
+    case Method::kAppendToTag: {
+      // Allocate new task using SHM default constructor
+      auto typed_task = ipc_manager->NewTask<AppendToTagTask>();
+      if (!typed_task.IsNull()) {
+        // Copy base Task fields first
+        typed_task.template Cast<chi::Task>()->Copy(orig_task);
+        // Then copy task-specific fields
+        typed_task->Copy(orig_task.Cast<AppendToTagTask>());
+        // Cast to base Task type for return
+        dup_task = typed_task.template Cast<chi::Task>();
+      }
+      break;
+    }
+    case Method::kRebalanceBlobs: {
+      // Allocate new task using SHM default constructor
+      auto typed_task = ipc_manager->NewTask<RebalanceBlobsTask>();
+      if (!typed_task.IsNull()) {
+        // Copy base Task fields first
+        typed_task.template Cast<chi::Task>()->Copy(orig_task);
+        // Then copy task-specific fields
+        typed_task->Copy(orig_task.Cast<RebalanceBlobsTask>());
+        // Cast to base Task type for return
+        dup_task = typed_task.template Cast<chi::Task>();
+      }
+      break;
+    }
     default: {
       // For unknown methods, create base Task copy
       auto typed_task = ipc_manager->NewTask<chi::Task>();
@@ -930,6 +1315,105 @@ void Runtime::Aggregate(chi::u32 method, hipc::FullPtr<chi::Task> origin_task,
       CHI_AGGREGATE_OR_COPY(typed_origin, typed_replica);
       break;
     }
+    case Method::kReorganizeTiers: {
+      auto typed_origin = origin_task.Cast<ReorganizeTiersTask>();
+      auto typed_replica = replica_task.Cast<ReorganizeTiersTask>();
+      // Call base Task aggregate to propagate return codes
+      origin_task->Aggregate(replica_task);
+      // Use SFINAE-based macro to call task-specific Aggregate if available, otherwise Copy
+      CHI_AGGREGATE_OR_COPY(typed_origin, typed_replica);
+      break;
+    }
+    case Method::kEnforceWatermarks: {
+      auto typed_origin = origin_task.Cast<EnforceWatermarksTask>();
+      auto typed_replica = replica_task.Cast<EnforceWatermarksTask>();
+      // Call base Task aggregate to propagate return codes
+      origin_task->Aggregate(replica_task);
+      // Use SFINAE-based macro to call task-specific Aggregate if available, otherwise Copy
+      CHI_AGGREGATE_OR_COPY(typed_origin, typed_replica);
+      break;
+    }
+    case Method::kGetRuntimeStats: {
+      auto typed_origin = origin_task.Cast<GetRuntimeStatsTask>();
+      auto typed_replica = replica_task.Cast<GetRuntimeStatsTask>();
+      // Call base Task aggregate to propagate return codes
+      origin_task->Aggregate(replica_task);
+      // Use SFINAE-based macro to call task-specific Aggregate if available, otherwise Copy
+      CHI_AGGREGATE_OR_COPY(typed_origin, typed_replica);
+      break;
+    }
+    case Method::kPutBlobs: {
+      auto typed_origin = origin_task.Cast<PutBlobsTask>();
+      auto typed_replica = replica_task.Cast<PutBlobsTask>();
+      // Call base Task aggregate to propagate return codes
+      origin_task->Aggregate(replica_task);
+      // Use SFINAE-based macro to call task-specific Aggregate if available, otherwise Copy
+      CHI_AGGREGATE_OR_COPY(typed_origin, typed_replica);
+      break;
+    }
+    case Method::kGetBlobs: {
+      auto typed_origin = origin_task.Cast<GetBlobsTask>();
+      auto typed_replica = replica_task.Cast<GetBlobsTask>();
+      // Call base Task aggregate to propagate return codes
+      origin_task->Aggregate(replica_task);
+      // Use SFINAE-based macro to call task-specific Aggregate if available, otherwise Copy
+      CHI_AGGREGATE_OR_COPY(typed_origin, typed_replica);
+      break;
+    }
+    case Method::kStageIn: {
+      auto typed_origin = origin_task.Cast<StageInTask>();
+      auto typed_replica = replica_task.Cast<StageInTask>();
+      // Call base Task aggregate to propagate return codes
+      origin_task->Aggregate(replica_task);
+      // Use SFINAE-based macro to call task-specific Aggregate if available, otherwise Copy
+      CHI_AGGREGATE_OR_COPY(typed_origin, typed_replica);
+      break;
+    }
+    case Method::kFlushTag: {
+      auto typed_origin = origin_task.Cast<FlushTagTask>();
+      auto typed_replica = replica_task.Cast<FlushTagTask>();
+      // Call base Task aggregate to propagate return codes
+      origin_task->Aggregate(replica_task);
+      // Use SFINAE-based macro to call task-specific Aggregate if available, otherwise Copy
+      CHI_AGGREGATE_OR_COPY(typed_origin, typed_replica);
+      break;
+    }
+    case Method::kTruncateBlob: {
+      auto typed_origin = origin_task.Cast<TruncateBlobTask>();
+      auto typed_replica = replica_task.Cast<TruncateBlobTask>();
+      // Call base Task aggregate to propagate return codes
+      origin_task->Aggregate(replica_task);
+      // Use SFINAE-based macro to call task-specific Aggregate if available, otherwise Copy
+      CHI_AGGREGATE_OR_COPY(typed_origin, typed_replica);
+      break;
+    }
+    case Method::kTruncateTag: {
+      auto typed_origin = origin_task.Cast<TruncateTagTask>();
+      auto typed_replica = replica_task.Cast<TruncateTagTask>();
+      // Call base Task aggregate to propagate return codes
+      origin_task->Aggregate(replica_task);
+      // Use SFINAE-based macro to call task-specific Aggregate if available, otherwise Copy
+      CHI_AGGREGATE_OR_COPY(typed_origin, typed_replica);
+      break;
+    }
+    case Method::kAppendToTag: {
+      auto typed_origin = origin_task.Cast<AppendToTagTask>();
+      auto typed_replica = replica_task.Cast<AppendToTagTask>();
+      // Call base Task aggregate to propagate return codes
+      origin_task->Aggregate(replica_task);
+      // Use SFINAE-based macro to call task-specific Aggregate if available, otherwise Copy
+      CHI_AGGREGATE_OR_COPY(typed_origin, typed_replica);
+      break;
+    }
+    case Method::kRebalanceBlobs: {
+      auto typed_origin = origin_task.Cast<RebalanceBlobsTask>();
+      auto typed_replica = replica_task.Cast<RebalanceBlobsTask>();
+      // Call base Task aggregate to propagate return codes
+      origin_task->Aggregate(replica_task);
+      // Use SFINAE-based macro to call task-specific Aggregate if available, otherwise Copy
+      CHI_AGGREGATE_OR_COPY(typed_origin, typed_replica);
+      break;
+    }
     default: {
       // For unknown methods, use base Task Aggregate (which also propagates return codes)
       origin_task->Aggregate(replica_task);
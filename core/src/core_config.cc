@@ -118,6 +118,12 @@ bool Config::SaveToFile(const std::string &config_file_path) const {
   }
 }
 
+std::string Config::SaveToString() const {
+  YAML::Emitter emitter;
+  EmitYaml(emitter);
+  return emitter.c_str();
+}
+
 bool Config::Validate() const {
   // Validate performance configuration
   if (performance_.target_stat_interval_ms_ == 0 || performance_.target_stat_interval_ms_ > 60000) {
@@ -140,6 +146,31 @@ bool Config::Validate() const {
     return false;
   }
 
+  if (performance_.reorganize_interval_ms_ > 3600000) {
+    HELOG(kError, "Config validation error: Invalid reorganize_interval_ms {} (must be 0-3600000)", performance_.reorganize_interval_ms_);
+    return false;
+  }
+
+  if (performance_.reorganize_max_blobs_ == 0) {
+    HELOG(kError, "Config validation error: Invalid reorganize_max_blobs {} (must be at least 1)", performance_.reorganize_max_blobs_);
+    return false;
+  }
+
+  if (performance_.watermark_check_interval_ms_ > 3600000) {
+    HELOG(kError, "Config validation error: Invalid watermark_check_interval_ms {} (must be 0-3600000)", performance_.watermark_check_interval_ms_);
+    return false;
+  }
+
+  if (performance_.flush_interval_ms_ > 3600000) {
+    HELOG(kError, "Config validation error: Invalid flush_interval_ms {} (must be 0-3600000)", performance_.flush_interval_ms_);
+    return false;
+  }
+
+  if (performance_.telemetry_ring_size_ < 16 || performance_.telemetry_ring_size_ > (1u << 24)) {
+    HELOG(kError, "Config validation error: Invalid telemetry_ring_size {} (must be 16-16777216)", performance_.telemetry_ring_size_);
+    return false;
+  }
+
   // Validate target configuration
   if (targets_.neighborhood_ == 0 || targets_.neighborhood_ > 1024) {
     HELOG(kError, "Config validation error: Invalid neighborhood {} (must be 1-1024)", targets_.neighborhood_);
@@ -150,6 +181,38 @@ bool Config::Validate() const {
     HELOG(kError, "Config validation error: Invalid default_target_timeout_ms {} (must be 1-300000)", targets_.default_target_timeout_ms_);
     return false;
   }
+
+  if (targets_.poll_period_ms_ > 3600000) {
+    HELOG(kError, "Config validation error: Invalid poll_period_ms {} (must be 0-3600000)", targets_.poll_period_ms_);
+    return false;
+  }
+
+  if (targets_.virtual_nodes_ == 0 || targets_.virtual_nodes_ > 4096) {
+    HELOG(kError, "Config validation error: Invalid virtual_nodes {} (must be 1-4096)", targets_.virtual_nodes_);
+    return false;
+  }
+
+  // Validate DPE configuration
+  if (dpe_.bandwidth_weight_ < 0.0f || dpe_.latency_weight_ < 0.0f ||
+      dpe_.capacity_weight_ < 0.0f || dpe_.score_fit_weight_ < 0.0f) {
+    HELOG(kError, "Config validation error: DPE weights must not be negative");
+    return false;
+  }
+
+  if (dpe_.spread_width_ == 0 || dpe_.spread_width_ > 64) {
+    HELOG(kError, "Config validation error: Invalid spread_width {} (must be 1-64)", dpe_.spread_width_);
+    return false;
+  }
+
+  if (dpe_.stripe_unit_ < 4096) {
+    HELOG(kError, "Config validation error: Invalid stripe_unit {} (must be at least 4KB)", dpe_.stripe_unit_);
+    return false;
+  }
+
+  if (dpe_.stripe_width_ == 0 || dpe_.stripe_width_ > 64) {
+    HELOG(kError, "Config validation error: Invalid stripe_width {} (must be 1-64)", dpe_.stripe_width_);
+    return false;
+  }
   
   return true;
 }
@@ -167,6 +230,21 @@ std::string Config::GetParameterString(const std::string &param_name) const {
   if (param_name == "score_difference_threshold") {
     return std::to_string(performance_.score_difference_threshold_);
   }
+  if (param_name == "reorganize_interval_ms") {
+    return std::to_string(performance_.reorganize_interval_ms_);
+  }
+  if (param_name == "reorganize_max_blobs") {
+    return std::to_string(performance_.reorganize_max_blobs_);
+  }
+  if (param_name == "watermark_check_interval_ms") {
+    return std::to_string(performance_.watermark_check_interval_ms_);
+  }
+  if (param_name == "flush_interval_ms") {
+    return std::to_string(performance_.flush_interval_ms_);
+  }
+  if (param_name == "telemetry_ring_size") {
+    return std::to_string(performance_.telemetry_ring_size_);
+  }
   if (param_name == "neighborhood") {
     return std::to_string(targets_.neighborhood_);
   }
@@ -176,6 +254,33 @@ std::string Config::GetParameterString(const std::string &param_name) const {
   if (param_name == "poll_period_ms") {
     return std::to_string(targets_.poll_period_ms_);
   }
+  if (param_name == "virtual_nodes") {
+    return std::to_string(targets_.virtual_nodes_);
+  }
+  if (param_name == "bandwidth_weight") {
+    return std::to_string(dpe_.bandwidth_weight_);
+  }
+  if (param_name == "latency_weight") {
+    return std::to_string(dpe_.latency_weight_);
+  }
+  if (param_name == "capacity_weight") {
+    return std::to_string(dpe_.capacity_weight_);
+  }
+  if (param_name == "score_fit_weight") {
+    return std::to_string(dpe_.score_fit_weight_);
+  }
+  if (param_name == "large_blob_size") {
+    return std::to_string(dpe_.large_blob_size_);
+  }
+  if (param_name == "spread_width") {
+    return std::to_string(dpe_.spread_width_);
+  }
+  if (param_name == "stripe_unit") {
+    return std::to_string(dpe_.stripe_unit_);
+  }
+  if (param_name == "stripe_width") {
+    return std::to_string(dpe_.stripe_width_);
+  }
   
   return ""; // Parameter not found
 }
@@ -199,6 +304,26 @@ bool Config::SetParameterFromString(const std::string &param_name,
       performance_.score_difference_threshold_ = std::stof(value);
       return true;
     }
+    if (param_name == "reorganize_interval_ms") {
+      performance_.reorganize_interval_ms_ = static_cast<chi::u32>(std::stoul(value));
+      return true;
+    }
+    if (param_name == "reorganize_max_blobs") {
+      performance_.reorganize_max_blobs_ = static_cast<chi::u32>(std::stoul(value));
+      return true;
+    }
+    if (param_name == "watermark_check_interval_ms") {
+      performance_.watermark_check_interval_ms_ = static_cast<chi::u32>(std::stoul(value));
+      return true;
+    }
+    if (param_name == "flush_interval_ms") {
+      performance_.flush_interval_ms_ = static_cast<chi::u32>(std::stoul(value));
+      return true;
+    }
+    if (param_name == "telemetry_ring_size") {
+      performance_.telemetry_ring_size_ = static_cast<chi::u32>(std::stoul(value));
+      return true;
+    }
     if (param_name == "neighborhood") {
       targets_.neighborhood_ = static_cast<chi::u32>(std::stoul(value));
       return true;
@@ -211,6 +336,40 @@ bool Config::SetParameterFromString(const std::string &param_name,
       targets_.poll_period_ms_ = static_cast<chi::u32>(std::stoul(value));
       return true;
     }
+    if (param_name == "virtual_nodes") {
+      targets_.virtual_nodes_ = static_cast<chi::u32>(std::stoul(value));
+      return true;
+    }
+    if (param_name == "bandwidth_weight") {
+      dpe_.bandwidth_weight_ = std::stof(value);
+      return true;
+    }
+    if (param_name == "latency_weight") {
+      dpe_.latency_weight_ = std::stof(value);
+      return true;
+    }
+    if (param_name == "capacity_weight") {
+      dpe_.capacity_weight_ = std::stof(value);
+      return true;
+    }
+    if (param_name == "score_fit_weight") {
+      dpe_.score_fit_weight_ = std::stof(value);
+      return true;
+    }
+    if (param_name == "large_blob_size") {
+      return ParseSizeString(value, dpe_.large_blob_size_);
+    }
+    if (param_name == "spread_width") {
+      dpe_.spread_width_ = static_cast<chi::u32>(std::stoul(value));
+      return true;
+    }
+    if (param_name == "stripe_unit") {
+      return ParseSizeString(value, dpe_.stripe_unit_);
+    }
+    if (param_name == "stripe_width") {
+      dpe_.stripe_width_ = static_cast<chi::u32>(std::stoul(value));
+      return true;
+    }
     
     return false; // Parameter not found
     
@@ -269,6 +428,11 @@ void Config::EmitYaml(YAML::Emitter &emitter) const {
   emitter << YAML::Key << "max_concurrent_operations" << YAML::Value << performance_.max_concurrent_operations_;
   emitter << YAML::Key << "score_threshold" << YAML::Value << performance_.score_threshold_;
   emitter << YAML::Key << "score_difference_threshold" << YAML::Value << performance_.score_difference_threshold_;
+  emitter << YAML::Key << "reorganize_interval_ms" << YAML::Value << performance_.reorganize_interval_ms_;
+  emitter << YAML::Key << "reorganize_max_blobs" << YAML::Value << performance_.reorganize_max_blobs_;
+  emitter << YAML::Key << "watermark_check_interval_ms" << YAML::Value << performance_.watermark_check_interval_ms_;
+  emitter << YAML::Key << "flush_interval_ms" << YAML::Value << performance_.flush_interval_ms_;
+  emitter << YAML::Key << "telemetry_ring_size" << YAML::Value << performance_.telemetry_ring_size_;
   emitter << YAML::EndMap;
 
   // Emit target configuration
@@ -276,6 +440,7 @@ void Config::EmitYaml(YAML::Emitter &emitter) const {
   emitter << YAML::Key << "neighborhood" << YAML::Value << targets_.neighborhood_;
   emitter << YAML::Key << "default_target_timeout_ms" << YAML::Value << targets_.default_target_timeout_ms_;
   emitter << YAML::Key << "poll_period_ms" << YAML::Value << targets_.poll_period_ms_;
+  emitter << YAML::Key << "virtual_nodes" << YAML::Value << targets_.virtual_nodes_;
   emitter << YAML::EndMap;
   
   // Emit storage configuration
@@ -291,6 +456,8 @@ void Config::EmitYaml(YAML::Emitter &emitter) const {
       if (device.score_ >= 0.0f) {
         emitter << YAML::Key << "score" << YAML::Value << device.score_;
       }
+      emitter << YAML::Key << "high_watermark" << YAML::Value << device.high_watermark_;
+      emitter << YAML::Key << "low_watermark" << YAML::Value << device.low_watermark_;
       
       emitter << YAML::EndMap;
     }
@@ -300,6 +467,14 @@ void Config::EmitYaml(YAML::Emitter &emitter) const {
   // Emit DPE configuration
   emitter << YAML::Key << "dpe" << YAML::Value << YAML::BeginMap;
   emitter << YAML::Key << "dpe_type" << YAML::Value << dpe_.dpe_type_;
+  emitter << YAML::Key << "bandwidth_weight" << YAML::Value << dpe_.bandwidth_weight_;
+  emitter << YAML::Key << "latency_weight" << YAML::Value << dpe_.latency_weight_;
+  emitter << YAML::Key << "capacity_weight" << YAML::Value << dpe_.capacity_weight_;
+  emitter << YAML::Key << "score_fit_weight" << YAML::Value << dpe_.score_fit_weight_;
+  emitter << YAML::Key << "large_blob_size" << YAML::Value << FormatSizeBytes(dpe_.large_blob_size_);
+  emitter << YAML::Key << "spread_width" << YAML::Value << dpe_.spread_width_;
+  emitter << YAML::Key << "stripe_unit" << YAML::Value << FormatSizeBytes(dpe_.stripe_unit_);
+  emitter << YAML::Key << "stripe_width" << YAML::Value << dpe_.stripe_width_;
   emitter << YAML::EndMap;
   
   emitter << YAML::EndMap;
@@ -322,6 +497,26 @@ bool Config::ParsePerformanceConfig(const YAML::Node &node) {
     performance_.score_difference_threshold_ = node["score_difference_threshold"].as<float>();
   }
 
+  if (node["reorganize_interval_ms"]) {
+    performance_.reorganize_interval_ms_ = node["reorganize_interval_ms"].as<chi::u32>();
+  }
+
+  if (node["reorganize_max_blobs"]) {
+    performance_.reorganize_max_blobs_ = node["reorganize_max_blobs"].as<chi::u32>();
+  }
+
+  if (node["watermark_check_interval_ms"]) {
+    performance_.watermark_check_interval_ms_ = node["watermark_check_interval_ms"].as<chi::u32>();
+  }
+
+  if (node["flush_interval_ms"]) {
+    performance_.flush_interval_ms_ = node["flush_interval_ms"].as<chi::u32>();
+  }
+
+  if (node["telemetry_ring_size"]) {
+    performance_.telemetry_ring_size_ = node["telemetry_ring_size"].as<chi::u32>();
+  }
+
   return true;
 }
 
@@ -338,6 +533,10 @@ bool Config::ParseTargetConfig(const YAML::Node &node) {
     targets_.poll_period_ms_ = node["poll_period_ms"].as<chi::u32>();
   }
 
+  if (node["virtual_nodes"]) {
+    targets_.virtual_nodes_ = node["virtual_nodes"].as<chi::u32>();
+  }
+
   return true;
 }
 
@@ -399,6 +598,21 @@ bool Config::ParseStorageConfig(const YAML::Node &node) {
       }
     }
     // score_ defaults to -1.0f (use automatic scoring) if not specified
+
+    // Parse capacity watermarks (optional, fractions of capacity_limit)
+    if (device_node["high_watermark"]) {
+      device_config.high_watermark_ = device_node["high_watermark"].as<float>();
+    }
+    if (device_node["low_watermark"]) {
+      device_config.low_watermark_ = device_node["low_watermark"].as<float>();
+    }
+    if (device_config.low_watermark_ < 0.0f ||
+        device_config.low_watermark_ > device_config.high_watermark_ ||
+        device_config.high_watermark_ > 1.0f) {
+      HELOG(kError, "Config error: Storage device watermarks must satisfy 0.0 <= low ({}) <= high ({}) <= 1.0 for device {}",
+            device_config.low_watermark_, device_config.high_watermark_, device_config.path_);
+      return false;
+    }
     
     // Validate parsed values
     if (device_config.path_.empty()) {
@@ -424,13 +638,47 @@ bool Config::ParseDpeConfig(const YAML::Node &node) {
     
     // Validate DPE type
     if (dpe_type != "random" && dpe_type != "round_robin" && 
-        dpe_type != "roundrobin" && dpe_type != "max_bw" && dpe_type != "maxbw") {
-      HELOG(kError, "Config error: Invalid dpe_type '{}' (must be 'random', 'round_robin', or 'max_bw')", dpe_type);
+        dpe_type != "roundrobin" && dpe_type != "max_bw" && dpe_type != "maxbw" &&
+        dpe_type != "weighted") {
+      HELOG(kError, "Config error: Invalid dpe_type '{}' (must be 'random', 'round_robin', 'max_bw', or 'weighted')", dpe_type);
       return false;
     }
     
     dpe_.dpe_type_ = dpe_type;
   }
+
+  if (node["bandwidth_weight"]) {
+    dpe_.bandwidth_weight_ = node["bandwidth_weight"].as<float>();
+  }
+  if (node["latency_weight"]) {
+    dpe_.latency_weight_ = node["latency_weight"].as<float>();
+  }
+  if (node["capacity_weight"]) {
+    dpe_.capacity_weight_ = node["capacity_weight"].as<float>();
+  }
+  if (node["score_fit_weight"]) {
+    dpe_.score_fit_weight_ = node["score_fit_weight"].as<float>();
+  }
+  if (node["large_blob_size"]) {
+    std::string size_str = node["large_blob_size"].as<std::string>();
+    if (!ParseSizeString(size_str, dpe_.large_blob_size_)) {
+      HELOG(kError, "Config error: Invalid large_blob_size format '{}'", size_str);
+      return false;
+    }
+  }
+  if (node["spread_width"]) {
+    dpe_.spread_width_ = node["spread_width"].as<chi::u32>();
+  }
+  if (node["stripe_unit"]) {
+    std::string size_str = node["stripe_unit"].as<std::string>();
+    if (!ParseSizeString(size_str, dpe_.stripe_unit_)) {
+      HELOG(kError, "Config error: Invalid stripe_unit format '{}'", size_str);
+      return false;
+    }
+  }
+  if (node["stripe_width"]) {
+    dpe_.stripe_width_ = node["stripe_width"].as<chi::u32>();
+  }
   
   HILOG(kInfo, "Parsed DPE configuration: type={}", dpe_.dpe_type_);
   return true;
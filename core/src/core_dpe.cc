@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <iostream>
 #include <chrono>
+#include <cmath>
 #include "hermes_shm/util/logging.h"
 
 namespace wrp_cte::core {
@@ -9,6 +10,32 @@ namespace wrp_cte::core {
 // Static member definition for round-robin counter
 std::atomic<chi::u32> RoundRobinDpe::round_robin_counter_(0);
 
+namespace {
+
+/**
+ * Fill ordered_targets with the targets that can hold data_size, local ones
+ * first
+ * @return Number of local targets (they occupy the front of the vector)
+ */
+size_t FilterLocalFirst(const std::vector<TargetDesc>& targets,
+                        chi::u64 data_size,
+                        std::vector<chi::PoolId>& ordered_targets) {
+  for (const auto& target : targets) {
+    if (target.is_local_ && target.remaining_space_ >= data_size) {
+      ordered_targets.push_back(target.target_id_);
+    }
+  }
+  size_t num_local = ordered_targets.size();
+  for (const auto& target : targets) {
+    if (!target.is_local_ && target.remaining_space_ >= data_size) {
+      ordered_targets.push_back(target.target_id_);
+    }
+  }
+  return num_local;
+}
+
+}  // namespace
+
 // DPE Type conversion functions
 DpeType StringToDpeType(const std::string& dpe_str) {
   if (dpe_str == "random") {
@@ -17,6 +44,8 @@ DpeType StringToDpeType(const std::string& dpe_str) {
     return DpeType::kRoundRobin;
   } else if (dpe_str == "max_bw" || dpe_str == "maxbw") {
     return DpeType::kMaxBW;
+  } else if (dpe_str == "weighted") {
+    return DpeType::kWeighted;
   } else {
     HELOG(kError, "Unknown DPE type: {}, defaulting to random", dpe_str);
     return DpeType::kRandom;
@@ -31,135 +60,258 @@ std::string DpeTypeToString(DpeType dpe_type) {
       return "round_robin";
     case DpeType::kMaxBW:
       return "max_bw";
+    case DpeType::kWeighted:
+      return "weighted";
     default:
       return "random";
   }
 }
 
+float ScoreTargetBandwidth(double bandwidth, double max_bandwidth) {
+  if (bandwidth <= 0.0 || max_bandwidth <= 0.0) {
+    return 0.0f;
+  }
+  float score = static_cast<float>(std::log(bandwidth + 1.0) /
+                                   std::log(max_bandwidth + 1.0));
+  return std::max(0.0f, std::min(1.0f, score));
+}
+
 // RandomDpe Implementation
 RandomDpe::RandomDpe() : rng_(std::chrono::steady_clock::now().time_since_epoch().count()) {
 }
 
-std::vector<TargetInfo> RandomDpe::SelectTargets(const std::vector<TargetInfo>& targets, 
-                                                float blob_score, 
-                                                chi::u64 data_size) {
-  std::vector<TargetInfo> result;
-  
-  if (targets.empty()) {
-    return result;
-  }
+void RandomDpe::SelectTargets(const std::vector<TargetDesc>& targets,
+                              float blob_score,
+                              chi::u64 data_size,
+                              std::vector<chi::PoolId>& ordered_targets) {
+  ordered_targets.clear();
 
   // Filter targets with sufficient space
-  for (const auto& target : targets) {
-    if (target.remaining_space_ >= data_size) {
-      result.push_back(target);
-    }
-  }
+  size_t num_local = FilterLocalFirst(targets, data_size, ordered_targets);
 
-  if (result.empty()) {
-    return result;  // No targets have space
-  }
-
-  // Randomly shuffle the filtered targets
-  std::shuffle(result.begin(), result.end(), rng_);
-  
-  return result;
+  // Randomly shuffle the local and the remote targets separately
+  auto split = ordered_targets.begin() + num_local;
+  std::shuffle(ordered_targets.begin(), split, rng_);
+  std::shuffle(split, ordered_targets.end(), rng_);
 }
 
 // RoundRobinDpe Implementation  
 RoundRobinDpe::RoundRobinDpe() {
 }
 
-std::vector<TargetInfo> RoundRobinDpe::SelectTargets(const std::vector<TargetInfo>& targets, 
-                                                    float blob_score, 
-                                                    chi::u64 data_size) {
-  std::vector<TargetInfo> result;
-  
-  if (targets.empty()) {
-    return result;
-  }
+void RoundRobinDpe::SelectTargets(const std::vector<TargetDesc>& targets,
+                                  float blob_score,
+                                  chi::u64 data_size,
+                                  std::vector<chi::PoolId>& ordered_targets) {
+  ordered_targets.clear();
 
   // Filter targets with sufficient space
-  for (const auto& target : targets) {
-    if (target.remaining_space_ >= data_size) {
-      result.push_back(target);
-    }
-  }
+  size_t num_local = FilterLocalFirst(targets, data_size, ordered_targets);
 
-  if (result.empty()) {
-    return result;  // No targets have space
+  if (ordered_targets.empty()) {
+    return;  // No targets have space
   }
 
-  // Shift the target vector to the left (circular rotation)
+  // Shift the local and the remote targets to the left (circular rotation)
   chi::u32 counter = round_robin_counter_.fetch_add(1);
-  size_t shift_amount = counter % result.size();
-  
-  if (shift_amount > 0) {
-    std::rotate(result.begin(), result.begin() + shift_amount, result.end());
-  }
-  
-  return result;
+  auto rotate = [counter](std::vector<chi::PoolId>::iterator first,
+                          std::vector<chi::PoolId>::iterator last) {
+    size_t count = static_cast<size_t>(last - first);
+    if (count > 1 && counter % count > 0) {
+      std::rotate(first, first + counter % count, last);
+    }
+  };
+  auto split = ordered_targets.begin() + num_local;
+  rotate(ordered_targets.begin(), split);
+  rotate(split, ordered_targets.end());
 }
 
 // MaxBwDpe Implementation
 MaxBwDpe::MaxBwDpe() {
 }
 
-std::vector<TargetInfo> MaxBwDpe::SelectTargets(const std::vector<TargetInfo>& targets, 
-                                               float blob_score, 
-                                               chi::u64 data_size) {
-  std::vector<TargetInfo> result;
-  
-  if (targets.empty()) {
-    return result;
-  }
+void MaxBwDpe::SelectTargets(const std::vector<TargetDesc>& targets,
+                             float blob_score,
+                             chi::u64 data_size,
+                             std::vector<chi::PoolId>& ordered_targets) {
+  ordered_targets.clear();
 
   // Filter targets with sufficient space
-  std::vector<TargetInfo> available_targets;
+  candidates_.clear();
   for (const auto& target : targets) {
     if (target.remaining_space_ >= data_size) {
-      available_targets.push_back(target);
+      candidates_.push_back(&target);
     }
   }
 
-  if (available_targets.empty()) {
-    return result;  // No targets have space
+  if (candidates_.empty()) {
+    return;  // No targets have space
   }
 
-  // Sort targets by performance metrics
+  // Sort targets by locality first (local before remote), then by
+  // performance metrics
   if (data_size >= kLatencyThreshold) {
     // Sort by write bandwidth (descending)
-    std::sort(available_targets.begin(), available_targets.end(),
-              [](const TargetInfo& a, const TargetInfo& b) {
-                return a.perf_metrics_.write_bandwidth_mbps_ > b.perf_metrics_.write_bandwidth_mbps_;
+    std::sort(candidates_.begin(), candidates_.end(),
+              [](const TargetDesc* a, const TargetDesc* b) {
+                if (a->is_local_ != b->is_local_) {
+                  return a->is_local_;
+                }
+                return a->write_bandwidth_mbps_ > b->write_bandwidth_mbps_;
               });
   } else {
     // Sort by latency (ascending - lower is better)
-    std::sort(available_targets.begin(), available_targets.end(),
-              [](const TargetInfo& a, const TargetInfo& b) {
-                double avg_latency_a = (a.perf_metrics_.read_latency_us_ + a.perf_metrics_.write_latency_us_) / 2.0;
-                double avg_latency_b = (b.perf_metrics_.read_latency_us_ + b.perf_metrics_.write_latency_us_) / 2.0;
-                return avg_latency_a < avg_latency_b;
+    std::sort(candidates_.begin(), candidates_.end(),
+              [](const TargetDesc* a, const TargetDesc* b) {
+                if (a->is_local_ != b->is_local_) {
+                  return a->is_local_;
+                }
+                return a->avg_latency_us_ < b->avg_latency_us_;
               });
   }
 
-  // Filter out targets that have too high of a score
-  for (const auto& target : available_targets) {
-    if (target.target_score_ <= blob_score) {
-      result.push_back(target);
+  // Within each locality group, filter out targets that have too high of a
+  // score; if none in the group has an acceptable score, keep its best
+  // performing one. A local target of the wrong tier thus still comes before
+  // every remote target.
+  auto group_begin = candidates_.begin();
+  while (group_begin != candidates_.end()) {
+    bool is_local = (*group_begin)->is_local_;
+    auto group_end = std::find_if(
+        group_begin, candidates_.end(),
+        [is_local](const TargetDesc* t) { return t->is_local_ != is_local; });
+    size_t group_start = ordered_targets.size();
+    for (auto it = group_begin; it != group_end; ++it) {
+      if ((*it)->target_score_ <= blob_score) {
+        ordered_targets.push_back((*it)->target_id_);
+      }
+    }
+    if (ordered_targets.size() == group_start) {
+      ordered_targets.push_back((*group_begin)->target_id_);
     }
+    group_begin = group_end;
   }
+}
 
-  // If no target has acceptable score, return the best performing one
-  if (result.empty() && !available_targets.empty()) {
-    result.push_back(available_targets[0]);
+// WeightedDpe Implementation
+WeightedDpe::WeightedDpe(const DpeConfig& config)
+    : config_(config),
+      rng_(std::chrono::steady_clock::now().time_since_epoch().count()) {
+}
+
+void WeightedDpe::SelectTargets(const std::vector<TargetDesc>& targets,
+                                float blob_score,
+                                chi::u64 data_size,
+                                std::vector<chi::PoolId>& ordered_targets) {
+  ordered_targets.clear();
+
+  // Normalization bounds over the targets with sufficient space
+  double max_bandwidth = 0.0;
+  double min_latency = 0.0;
+  for (const auto& target : targets) {
+    if (target.remaining_space_ < data_size) {
+      continue;
+    }
+    max_bandwidth = std::max(max_bandwidth, target.write_bandwidth_mbps_);
+    if (target.avg_latency_us_ > 0.0 &&
+        (min_latency == 0.0 || target.avg_latency_us_ < min_latency)) {
+      min_latency = target.avg_latency_us_;
+    }
   }
 
-  return result;
+  // Local targets before remote ones, as for every engine
+  SelectGroup(targets, true, blob_score, data_size, max_bandwidth, min_latency,
+              ordered_targets);
+  SelectGroup(targets, false, blob_score, data_size, max_bandwidth,
+              min_latency, ordered_targets);
+}
+
+void WeightedDpe::SelectGroup(const std::vector<TargetDesc>& targets,
+                              bool is_local, float blob_score,
+                              chi::u64 data_size, double max_bandwidth,
+                              double min_latency,
+                              std::vector<chi::PoolId>& ordered_targets) {
+  // Weigh every target of the group with sufficient space
+  candidates_.clear();
+  for (const auto& target : targets) {
+    if (target.is_local_ != is_local || target.remaining_space_ < data_size) {
+      continue;
+    }
+    double bandwidth = max_bandwidth > 0.0
+                           ? target.write_bandwidth_mbps_ / max_bandwidth
+                           : 0.0;
+    // No latency sample counts as the lowest latency
+    double latency = (min_latency > 0.0 && target.avg_latency_us_ > 0.0)
+                         ? min_latency / target.avg_latency_us_
+                         : 1.0;
+    double capacity = target.total_space_ > 0
+                          ? static_cast<double>(target.remaining_space_) /
+                                static_cast<double>(target.total_space_)
+                          : 0.0;
+    double score_fit =
+        1.0 - std::min(1.0, static_cast<double>(std::abs(
+                                target.target_score_ - blob_score)));
+    double weight = config_.bandwidth_weight_ * bandwidth +
+                    config_.latency_weight_ * latency +
+                    config_.capacity_weight_ * std::min(1.0, capacity) +
+                    config_.score_fit_weight_ * score_fit;
+    candidates_.emplace_back(weight, &target);
+  }
+  if (candidates_.empty()) {
+    return;
+  }
+
+  // Move the best spread_width candidates to the front in linear time; only
+  // those few are ordered
+  auto by_weight = [](const std::pair<double, const TargetDesc*>& a,
+                      const std::pair<double, const TargetDesc*>& b) {
+    return a.first > b.first;
+  };
+  size_t top = std::min<size_t>(std::max<chi::u32>(config_.spread_width_, 1),
+                                candidates_.size());
+  auto top_end = candidates_.begin() + top;
+  if (top < candidates_.size()) {
+    std::nth_element(candidates_.begin(), top_end - 1, candidates_.end(),
+                     by_weight);
+  }
+
+  if (data_size >= config_.large_blob_size_) {
+    // Draw the top candidates without replacement, each with probability
+    // proportional to its weight
+    for (auto it = candidates_.begin(); it != top_end; ++it) {
+      double total = 0.0;
+      for (auto rest = it; rest != top_end; ++rest) {
+        total += std::max(rest->first, 0.0);
+      }
+      auto pick = it;
+      if (total > 0.0) {
+        double point =
+            std::uniform_real_distribution<double>(0.0, total)(rng_);
+        for (auto rest = it; rest != top_end; ++rest) {
+          point -= std::max(rest->first, 0.0);
+          if (point <= 0.0) {
+            pick = rest;
+            break;
+          }
+        }
+      } else {
+        pick = it + std::uniform_int_distribution<size_t>(
+                        0, static_cast<size_t>(top_end - it) - 1)(rng_);
+      }
+      std::iter_swap(it, pick);
+    }
+  } else {
+    std::sort(candidates_.begin(), top_end, by_weight);
+  }
+
+  for (const auto& candidate : candidates_) {
+    ordered_targets.push_back(candidate.second->target_id_);
+  }
 }
 
 // DpeFactory Implementation
-std::unique_ptr<DataPlacementEngine> DpeFactory::CreateDpe(DpeType dpe_type) {
+std::unique_ptr<DataPlacementEngine> DpeFactory::CreateDpe(
+    DpeType dpe_type, const DpeConfig& config) {
   switch (dpe_type) {
     case DpeType::kRandom:
       return std::make_unique<RandomDpe>();
@@ -167,6 +319,8 @@ std::unique_ptr<DataPlacementEngine> DpeFactory::CreateDpe(DpeType dpe_type) {
       return std::make_unique<RoundRobinDpe>();
     case DpeType::kMaxBW:
       return std::make_unique<MaxBwDpe>();
+    case DpeType::kWeighted:
+      return std::make_unique<WeightedDpe>(config);
     default:
       HELOG(kError, "Unknown DPE type, defaulting to Random");
       return std::make_unique<RandomDpe>();
@@ -177,4 +331,26 @@ std::unique_ptr<DataPlacementEngine> DpeFactory::CreateDpe(const std::string& dp
   return CreateDpe(StringToDpeType(dpe_str));
 }
 
-} // namespace wrp_cte::core
\ No newline at end of file
+DataPlacementEngine& DpeFactory::GetWorkerDpe(DpeType dpe_type,
+                                              const DpeConfig& config) {
+  // Each worker thread keeps one engine per type, so RNG and sort buffers are
+  // never shared and never rebuilt on the allocation path. The engine is
+  // rebuilt when a caller passes different tuning than it was built with.
+  struct CachedDpe {
+    std::unique_ptr<DataPlacementEngine> engine_;
+    DpeConfig config_;
+  };
+  thread_local CachedDpe engines[kDpeTypeCount];
+  size_t index = static_cast<size_t>(dpe_type);
+  if (index >= kDpeTypeCount) {
+    index = static_cast<size_t>(DpeType::kRandom);
+  }
+  CachedDpe& cached = engines[index];
+  if (!cached.engine_ || cached.config_ != config) {
+    cached.engine_ = CreateDpe(static_cast<DpeType>(index), config);
+    cached.config_ = config;
+  }
+  return *cached.engine_;
+}
+
+} // namespace wrp_cte::core
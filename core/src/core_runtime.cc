@@ -4,11 +4,17 @@
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <fcntl.h>
 #include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
-#include <regex>
 #include <string>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <unordered_map>
+#include <unordered_set>
 #include <wrp_cte/core/core_config.h>
 #include <wrp_cte/core/core_dpe.h>
 #include <wrp_cte/core/core_runtime.h>
@@ -21,6 +27,81 @@ using chi::Worker;
 
 // No more static member definitions - using instance-based locking
 
+namespace {
+
+/**
+ * Reusable target-ID vector for AllocateNewData. A task may yield while
+ * allocating from a bdev, so each call checks out its own vector from a
+ * per-thread free list instead of sharing one; capacity survives across calls
+ * so steady-state placement does not allocate.
+ */
+class PlacementBuffer {
+public:
+  PlacementBuffer() {
+    auto &free_list = FreeList();
+    if (!free_list.empty()) {
+      ids_ = std::move(free_list.back());
+      free_list.pop_back();
+    }
+    ids_.clear();
+  }
+
+  ~PlacementBuffer() { FreeList().push_back(std::move(ids_)); }
+
+  PlacementBuffer(const PlacementBuffer &) = delete;
+  PlacementBuffer &operator=(const PlacementBuffer &) = delete;
+
+  std::vector<chi::PoolId> &operator*() { return ids_; }
+
+private:
+  static std::vector<std::vector<chi::PoolId>> &FreeList() {
+    thread_local std::vector<std::vector<chi::PoolId>> free_list;
+    return free_list;
+  }
+
+  std::vector<chi::PoolId> ids_;
+};
+
+/** View a task's name without copying it */
+template <typename StringT> std::string_view NameView(const StringT &name) {
+  return std::string_view(name.data(), name.size());
+}
+
+/**
+ * Parse the page index of an adapter page blob ("0", "1", ...)
+ * @return false if the name is not a page index
+ */
+bool ParsePageIndex(std::string_view blob_name, chi::u64 &page_index) {
+  if (blob_name.empty() || blob_name.size() > 19) {
+    return false;
+  }
+  page_index = 0;
+  for (char c : blob_name) {
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    page_index = page_index * 10 + static_cast<chi::u64>(c - '0');
+  }
+  return true;
+}
+
+/** Add [begin, end) to a page's dirty ranges, merging touching ranges */
+void AddDirtyRange(std::map<chi::u64, chi::u64> &ranges, chi::u64 begin,
+                   chi::u64 end) {
+  auto it = ranges.upper_bound(begin);
+  if (it != ranges.begin() && std::prev(it)->second >= begin) {
+    --it;
+    begin = it->first;
+  }
+  while (it != ranges.end() && it->first <= end) {
+    end = std::max(end, it->second);
+    it = ranges.erase(it);
+  }
+  ranges.emplace(begin, end);
+}
+
+} // namespace
+
 chi::u64 Runtime::ParseCapacityToBytes(const std::string &capacity_str) {
   if (capacity_str.empty()) {
     return 0;
@@ -64,6 +145,8 @@ chi::u64 Runtime::ParseCapacityToBytes(const std::string &capacity_str) {
   return static_cast<chi::u64>(value * multiplier);
 }
 
+Runtime::~Runtime() { StopMaintenanceThread(); }
+
 void Runtime::Create(hipc::FullPtr<CreateTask> task, chi::RunContext &ctx) {
   // Initialize unordered_map_ll instances with 64 buckets to match lock count
   // This ensures each bucket can have its own lock for maximum concurrency
@@ -74,32 +157,38 @@ void Runtime::Create(hipc::FullPtr<CreateTask> task, chi::RunContext &ctx) {
   tag_name_to_id_ = chi::unordered_map_ll<std::string, TagId>(kMaxLocks);
   tag_id_to_info_ = chi::unordered_map_ll<TagId, TagInfo>(kMaxLocks);
   tag_blob_name_to_info_ =
-      chi::unordered_map_ll<std::string, BlobInfo>(kMaxLocks);
+      chi::unordered_map_ll<BlobKey, BlobInfo>(kMaxLocks);
+  tag_blob_index_ =
+      chi::unordered_map_ll<TagId, std::set<std::string>>(kMaxLocks);
 
   // Initialize lock vectors for concurrent access
   target_locks_.reserve(kMaxLocks);
   tag_locks_.reserve(kMaxLocks);
+  blob_locks_.reserve(kMaxLocks);
   for (size_t i = 0; i < kMaxLocks; ++i) {
     target_locks_.emplace_back(std::make_unique<chi::CoRwLock>());
     tag_locks_.emplace_back(std::make_unique<chi::CoRwLock>());
+    blob_locks_.emplace_back(std::make_unique<chi::CoRwLock>());
   }
 
   // Get main allocator from IPC manager
   auto *ipc_manager = CHI_IPC;
   auto *main_allocator = ipc_manager->GetMainAllocator();
 
-  // Initialize telemetry ring buffer
-  telemetry_log_ = hipc::circular_mpsc_queue<CteTelemetry>(main_allocator,
-                                                           kTelemetryRingSize);
-
   // Initialize atomic counters
   next_tag_id_minor_ = 1;
-  telemetry_counter_ = 0;
+  target_version_ = 1;
+  // Targets are sampled as they register, so stats start out fresh
+  target_stats_time_ns_ = SteadyNowNs();
 
   // Get configuration from params (loaded from pool_config.config_ via
   // LoadConfig)
   auto params = task->GetParams(main_allocator);
   config_ = params.config_;
+  dpe_type_ = StringToDpeType(config_.dpe_.dpe_type_);
+
+  // Initialize telemetry ring (before any target or tag operation logs)
+  telemetry_log_.Reset(config_.performance_.telemetry_ring_size_);
 
   // Configuration is now loaded from compose pool_config via
   // CreateParams::LoadConfig()
@@ -164,9 +253,9 @@ void Runtime::Create(hipc::FullPtr<CreateTask> task, chi::RunContext &ctx) {
               "bdev_id=({},{})",
               client_.pool_id_, target_path, device.bdev_type_, capacity_bytes,
               container_hash, bdev_id.major_, bdev_id.minor_);
-        chi::u32 result =
-            client_.RegisterTarget(hipc::MemContext(), target_path, bdev_type,
-                                   capacity_bytes, target_query, bdev_id);
+        chi::u32 result = client_.RegisterTarget(
+            hipc::MemContext(), target_path, bdev_type, capacity_bytes,
+            target_query, bdev_id, container_hash);
 
         if (result == 0) {
           HILOG(kDebug, "  - Registered target: {} ({}, {} bytes) on node {}",
@@ -192,18 +281,30 @@ void Runtime::Create(hipc::FullPtr<CreateTask> task, chi::RunContext &ctx) {
 
   HILOG(kInfo, "Configuration: neighborhood={}, poll_period_ms={}",
         config_.targets_.neighborhood_, config_.targets_.poll_period_ms_);
+
+  StartMaintenanceThread();
 }
 
 void Runtime::Destroy(hipc::FullPtr<DestroyTask> task, chi::RunContext &ctx) {
   try {
+    // Stop background maintenance before tearing down the tables it walks
+    StopMaintenanceThread();
+
     // Clear all registered targets and their associated data
     registered_targets_.clear();
     target_name_to_id_.clear();
+    target_snapshot_.targets_.clear();
+    InvalidateTargetSnapshot();
 
     // Clear tag and blob management structures
     tag_name_to_id_.clear();
+    {
+      chi::ScopedCoRwWriteLock index_lock(tag_name_index_lock_);
+      tag_name_index_.clear();
+    }
     tag_id_to_info_.clear();
     tag_blob_name_to_info_.clear();
+    tag_blob_index_.clear();
 
     // Reset atomic counters
     next_tag_id_minor_.store(1);
@@ -214,6 +315,7 @@ void Runtime::Destroy(hipc::FullPtr<DestroyTask> task, chi::RunContext &ctx) {
     // Clear lock vectors
     target_locks_.clear();
     tag_locks_.clear();
+    blob_locks_.clear();
 
     // Set success status
     task->return_code_ = 0;
@@ -288,10 +390,6 @@ void Runtime::RegisterTarget(hipc::FullPtr<RegisterTargetTask> task,
     target_info.bdev_client_ = std::move(bdev_client);
     target_info.target_query_ =
         task->target_query_; // Store target query for bdev API calls
-    target_info.bytes_read_ = 0;
-    target_info.bytes_written_ = 0;
-    target_info.ops_read_ = 0;
-    target_info.ops_written_ = 0;
     // Check if this target has a manually configured score from storage device
     // config
     float manual_score = GetManualScoreForTarget(target_name);
@@ -305,8 +403,23 @@ void Runtime::RegisterTarget(hipc::FullPtr<RegisterTargetTask> task,
     }
     target_info.remaining_space_ =
         total_size; // Use actual remaining space from bdev
+    target_info.total_space_ = total_size;
+    const StorageDeviceConfig *device = FindDeviceForTarget(target_name);
+    StorageDeviceConfig default_device;
+    if (device == nullptr) {
+      device = &default_device; // Targets registered by API use the defaults
+    }
+    target_info.high_watermark_ = device->high_watermark_;
+    target_info.low_watermark_ = device->low_watermark_;
     target_info.perf_metrics_ =
         perf_metrics; // Store the entire PerfMetrics structure
+    // Targets registered without a node (e.g. through the client API with a
+    // Local target query) are on this node
+    chi::u32 local_node = CHI_IPC->GetNodeId();
+    target_info.node_id_ = task->target_node_ == kLocalTargetNode
+                               ? local_node
+                               : task->target_node_;
+    target_info.is_local_ = target_info.node_id_ == local_node;
 
     // Register the target using TargetId as key
     {
@@ -315,6 +428,13 @@ void Runtime::RegisterTarget(hipc::FullPtr<RegisterTargetTask> task,
       target_name_to_id_.insert_or_assign(target_name,
                                           target_id); // Maintain reverse lookup
     }
+    {
+      // The new target may be the fastest one, which rescales every score
+      chi::ScopedCoRwWriteLock stats_lock(
+          *target_locks_[GetTargetStatsLockIndex()]);
+      NormalizeTargetScores();
+    }
+    InvalidateTargetSnapshot();
 
     task->return_code_.store(0); // Success
     HILOG(kDebug,
@@ -369,6 +489,7 @@ void Runtime::UnregisterTarget(hipc::FullPtr<UnregisterTargetTask> task,
       registered_targets_.erase(target_id);
       target_name_to_id_.erase(target_name); // Remove reverse lookup
     }
+    InvalidateTargetSnapshot();
 
     task->return_code_.store(0); // Success
     HILOG(kDebug, "Target '{}' unregistered", target_name);
@@ -418,18 +539,59 @@ void Runtime::StatTargets(hipc::FullPtr<StatTargetsTask> task,
   }
 
   try {
-    // Update performance stats for all registered targets
     // Use a single lock based on hash of operation type for stats
-    size_t lock_index =
-        std::hash<std::string>{}("stat_targets") % target_locks_.size();
-    chi::ScopedCoRwReadLock read_lock(*target_locks_[lock_index]);
+    size_t lock_index = GetTargetStatsLockIndex();
 
-    // Update stats for all targets - read lock is sufficient since we're only
-    // updating values, not modifying map structure
-    registered_targets_.for_each(
-        [this](const chi::PoolId &target_id, TargetInfo &target_info) {
-          UpdateTargetStats(target_id, target_info);
-        });
+    // Step 1: Copy the bdev client of every registered target
+    std::vector<chi::PoolId> target_ids;
+    std::vector<chimaera::bdev::Client> bdev_clients;
+    {
+      chi::ScopedCoRwReadLock read_lock(*target_locks_[lock_index]);
+      registered_targets_.for_each(
+          [&](const chi::PoolId &target_id, const TargetInfo &target_info) {
+            target_ids.push_back(target_id);
+            bdev_clients.push_back(target_info.bdev_client_);
+          });
+    }
+
+    // Step 2: Sample all targets in parallel; no lock is held while the
+    // samples are in flight
+    std::vector<hipc::FullPtr<chimaera::bdev::StatTask>> stat_tasks;
+    stat_tasks.reserve(bdev_clients.size());
+    for (auto &bdev_client : bdev_clients) {
+      stat_tasks.push_back(bdev_client.AsyncGetStats(hipc::MemContext()));
+    }
+    std::vector<chimaera::bdev::PerfMetrics> samples(stat_tasks.size());
+    std::vector<chi::u64> remaining(stat_tasks.size(), 0);
+    std::vector<bool> sampled(stat_tasks.size(), false);
+    for (size_t i = 0; i < stat_tasks.size(); ++i) {
+      stat_tasks[i]->Wait();
+      if (stat_tasks[i]->return_code_.load() == 0) {
+        samples[i] = stat_tasks[i]->metrics_;
+        remaining[i] = stat_tasks[i]->remaining_size_;
+        sampled[i] = true;
+      }
+      CHI_IPC->DelTask(stat_tasks[i]);
+    }
+
+    // Step 3: Fold the samples in under the write lock, since the smoothed
+    // metrics and scores are read-modify-written. Scores need the maximum
+    // over all targets, so they are computed in a second pass. Targets
+    // unregistered meanwhile are skipped.
+    {
+      chi::ScopedCoRwWriteLock write_lock(*target_locks_[lock_index]);
+      for (size_t i = 0; i < target_ids.size(); ++i) {
+        TargetInfo *target_info = registered_targets_.find(target_ids[i]);
+        if (sampled[i] && target_info != nullptr) {
+          UpdateTargetStats(*target_info, samples[i], remaining[i]);
+        }
+      }
+      NormalizeTargetScores();
+    }
+
+    // Step 4: Swap in a snapshot with the new stats so placement does not
+    // rebuild it on the allocation path
+    PublishTargetSnapshot();
 
     task->return_code_.store(0); // Success
 
@@ -451,10 +613,10 @@ void Runtime::GetOrCreateTag(
       // Tag exists locally, resolve locally
       task->pool_query_ = chi::PoolQuery::Local();
     } else {
-      // Tag doesn't exist locally, route to canonical node using DirectHash
-      std::hash<std::string> string_hasher;
-      chi::u32 hash_value = static_cast<chi::u32>(string_hasher(tag_name));
-      task->pool_query_ = chi::PoolQuery::DirectHash(hash_value);
+      // Tag doesn't exist locally, route to its canonical container on the
+      // hash ring
+      task->pool_query_ =
+          chi::PoolQuery::DirectHash(GetTagOwnerContainer(tag_name));
     }
     return;
   }
@@ -467,9 +629,11 @@ void Runtime::GetOrCreateTag(
 
     // Check if this is a returning task from a remote canonical node
     // If preferred_id is already set and not local, we're receiving a remote
-    // tag
+    // tag. A tag handed over by RebalanceBlobs arrives at the name's owner on
+    // the ring instead, which becomes canonical for it.
     bool is_remote_tag =
-        (preferred_id.major_ != 0 && preferred_id.major_ != local_node_id);
+        (preferred_id.major_ != 0 && preferred_id.major_ != local_node_id &&
+         GetTagOwnerContainer(tag_name) != GetLocalContainerId());
 
     if (is_remote_tag) {
       // Non-canonical node: Only cache the name→TagId mapping
@@ -481,6 +645,7 @@ void Runtime::GetOrCreateTag(
       if (existing_tag_id_ptr == nullptr) {
         // Cache the mapping without creating TagInfo
         tag_name_to_id_.insert_or_assign(tag_name, preferred_id);
+        IndexTagName(tag_name);
       }
 
       task->tag_id_ = preferred_id;
@@ -519,23 +684,22 @@ void Runtime::PutBlob(hipc::FullPtr<PutBlobTask> task, chi::RunContext &ctx) {
   // Dynamic scheduling phase - determine routing
   if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
     task->pool_query_ =
-        HashBlobToContainer(task->tag_id_, task->blob_name_.str());
+        HashBlobToContainer(task->tag_id_, NameView(task->blob_name_));
     return;
   }
 
+  OpTimer timer(runtime_stats_, StatOp::kPutBlob);
   try {
     // Extract input parameters
     TagId tag_id = task->tag_id_;
-    std::string blob_name = task->blob_name_.str();
+    BlobKey blob_key = BlobKey::View(tag_id, NameView(task->blob_name_));
+    std::string_view blob_name = blob_key.GetName();
     chi::u64 offset = task->offset_;
     chi::u64 size = task->size_;
     hipc::Pointer blob_data = task->blob_data_;
     float blob_score = task->score_;
     chi::u32 flags = task->flags_;
 
-    // Suppress unused variable warning for flags - may be used in future
-    (void)flags;
-
     // Validate input parameters
     if (size == 0) {
       task->return_code_.store(2); // Error: Invalid size (zero)
@@ -554,24 +718,34 @@ void Runtime::PutBlob(hipc::FullPtr<PutBlobTask> task, chi::RunContext &ctx) {
     }
 
     // Step 1: Check if blob exists
-    BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
-    bool blob_found = (blob_info_ptr != nullptr);
+    BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
+    bool blob_created = false;
 
-    // Step 2: Create blob if it doesn't exist
-    if (!blob_found) {
-      blob_info_ptr = CreateNewBlob(blob_name, tag_id, blob_score);
+    // Step 2: Create blob if it doesn't exist. Another put may create it
+    // first, in which case CreateNewBlob returns that blob instead.
+    if (blob_info_ptr == nullptr) {
+      blob_info_ptr = CreateNewBlob(blob_key, blob_score, blob_created);
       if (blob_info_ptr == nullptr) {
         task->return_code_.store(5); // Error: Failed to create blob
         return;
       }
     }
+    task->blob_created_ = blob_created;
 
-    // Step 2.5: Track blob size before modification for tag total_size_
-    // accounting (no lock needed - blob_info_ptr is already obtained)
+    // Stage-in never replaces a blob that already exists
+    if (!blob_created && (flags & kPutBlobIfAbsent)) {
+      task->return_code_.store(0);
+      return;
+    }
+
+    // Step 2.5: Hold off block-list swaps until the write lands, and track
+    // blob size before modification for tag total_size_ accounting
+    BlobWriteGuard write_guard(this, blob_key, blob_info_ptr);
     chi::u64 old_blob_size = blob_info_ptr->GetTotalSize();
 
     // Step 3: Allocate additional space if needed for blob extension
     // (no lock held during expensive bdev allocation)
+    timer.Switch(StatPhase::kAllocation);
     chi::u32 allocation_result =
         AllocateNewData(*blob_info_ptr, offset, size, blob_score);
 
@@ -584,8 +758,9 @@ void Runtime::PutBlob(hipc::FullPtr<PutBlobTask> task, chi::RunContext &ctx) {
 
     // Step 4: Write data to blob blocks
     // (no lock held during expensive I/O operations)
-    chi::u32 write_result =
-        ModifyExistingData(blob_info_ptr->blocks_, blob_data, size, offset);
+    chi::u32 write_result = ModifyExistingData(blob_info_ptr->blocks_,
+                                               blob_data, size, offset, &timer);
+    timer.Switch(StatPhase::kMetadata);
 
     if (write_result != 0) {
       task->return_code_.store(
@@ -632,6 +807,10 @@ void Runtime::PutBlob(hipc::FullPtr<PutBlobTask> task, chi::RunContext &ctx) {
     // Log telemetry and success messages
     LogTelemetry(CteOp::kPutBlob, offset, size, tag_id, now,
                  blob_info_ptr->last_read_);
+    if (!(flags & kPutBlobIfAbsent)) {
+      MarkPageDirty(tag_id, blob_name, offset, size);
+    }
+    RaiseAppendCursor(tag_id, blob_name, offset, size);
 
     task->return_code_.store(0);
 
@@ -645,14 +824,16 @@ void Runtime::GetBlob(hipc::FullPtr<GetBlobTask> task, chi::RunContext &ctx) {
   // Dynamic scheduling phase - determine routing
   if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
     task->pool_query_ =
-        HashBlobToContainer(task->tag_id_, task->blob_name_.str());
+        HashBlobToContainer(task->tag_id_, NameView(task->blob_name_));
     return;
   }
 
+  OpTimer timer(runtime_stats_, StatOp::kGetBlob);
   try {
     // Extract input parameters
     TagId tag_id = task->tag_id_;
-    std::string blob_name = task->blob_name_.str();
+    BlobKey blob_key = BlobKey::View(tag_id, NameView(task->blob_name_));
+    std::string_view blob_name = blob_key.GetName();
     chi::u64 offset = task->offset_;
     chi::u64 size = task->size_;
     chi::u32 flags = task->flags_;
@@ -673,20 +854,23 @@ void Runtime::GetBlob(hipc::FullPtr<GetBlobTask> task, chi::RunContext &ctx) {
     }
 
     // Step 1: Check if blob exists
-    BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
+    BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
 
     // If blob doesn't exist, error
     if (blob_info_ptr == nullptr) {
-      task->return_code_.store(1);
+      task->return_code_.store(kBlobNotFound);
       return;
     }
 
     // Use the pre-provided data pointer from the task
     hipc::Pointer blob_data_ptr = task->blob_data_;
 
-    // Step 2: Read data from blob blocks (no lock held during I/O)
-    chi::u32 read_result =
-        ReadData(blob_info_ptr->blocks_, blob_data_ptr, size, offset);
+    // Step 2: Read data from blob blocks (no lock held during I/O); the guard
+    // keeps the blocks allocated if a migration swaps them out meanwhile
+    BlobReadGuard read_guard(this, blob_key, blob_info_ptr);
+    chi::u32 read_result = ReadData(read_guard.GetBlocks(), blob_data_ptr,
+                                    size, offset, &timer);
+    timer.Switch(StatPhase::kMetadata);
     if (read_result != 0) {
       task->return_code_.store(read_result);
       return;
@@ -699,7 +883,8 @@ void Runtime::GetBlob(hipc::FullPtr<GetBlobTask> task, chi::RunContext &ctx) {
     (void)tag_lock_index; // Suppress unused variable warning
     size_t num_blocks = 0;
     blob_info_ptr->last_read_ = now;
-    num_blocks = blob_info_ptr->blocks_.size();
+    num_blocks = read_guard.GetBlocks().size();
+    read_guard.Release();
 
     // Log telemetry and success messages after releasing lock
     LogTelemetry(CteOp::kGetBlob, offset, size, tag_id,
@@ -714,19 +899,371 @@ void Runtime::GetBlob(hipc::FullPtr<GetBlobTask> task, chi::RunContext &ctx) {
   }
 }
 
+void Runtime::GroupBlobBatch(const TagId &tag_id, std::string_view blob_names,
+                             const hipc::vector<BlobBatchEntry> &entries,
+                             std::vector<std::vector<size_t>> &groups,
+                             std::vector<chi::u32> &group_owners) {
+  groups.clear();
+  group_owners.clear();
+  if (entries.empty()) {
+    return;
+  }
+
+  // The pool has one container per node, so DirectHash(id) lands on
+  // container id
+  chi::u32 num_containers = std::max<chi::u32>(CHI_IPC->GetNumHosts(), 1);
+  if (num_containers == 1) {
+    groups.emplace_back(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+      groups[0][i] = i;
+    }
+    group_owners.push_back(0);
+    return;
+  }
+  std::unordered_map<chi::u32, size_t> group_of_container;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const BlobBatchEntry &entry = entries[i];
+    chi::u32 container = GetOwnerContainer(HashBlob(
+        tag_id, blob_names.substr(entry.name_off_, entry.name_len_)));
+    auto it = group_of_container.find(container);
+    if (it == group_of_container.end()) {
+      it = group_of_container.emplace(container, groups.size()).first;
+      groups.emplace_back();
+      group_owners.push_back(container);
+    }
+    groups[it->second].push_back(i);
+  }
+}
+
+chi::PoolQuery
+Runtime::RouteBlobBatch(const TagId &tag_id, std::string_view blob_names,
+                        const hipc::vector<BlobBatchEntry> &entries) {
+  std::vector<std::vector<size_t>> groups;
+  std::vector<chi::u32> group_owners;
+  GroupBlobBatch(tag_id, blob_names, entries, groups, group_owners);
+  if (groups.size() == 1) {
+    return chi::PoolQuery::DirectHash(group_owners[0]);
+  }
+  return chi::PoolQuery::Local();
+}
+
+template <typename BatchTaskT, typename SubmitFn>
+void Runtime::ForwardBlobBatch(hipc::FullPtr<BatchTaskT> task,
+                               const std::vector<std::vector<size_t>> &groups,
+                               const std::vector<chi::u32> &group_owners,
+                               SubmitFn submit) {
+  // Step 1: Submit one sub-batch per container; each lands on a single
+  // container and is executed there without further splitting
+  std::string_view blob_names = NameView(task->blob_names_);
+  std::vector<hipc::FullPtr<BatchTaskT>> sub_tasks;
+  sub_tasks.reserve(groups.size());
+  for (size_t group = 0; group < groups.size(); ++group) {
+    std::vector<BlobIoRequest> requests;
+    requests.reserve(groups[group].size());
+    for (size_t entry_idx : groups[group]) {
+      const BlobBatchEntry &entry = task->entries_[entry_idx];
+      requests.emplace_back(
+          std::string(blob_names.substr(entry.name_off_, entry.name_len_)),
+          entry.offset_, entry.size_, entry.data_, entry.score_);
+    }
+    sub_tasks.push_back(
+        submit(requests, chi::PoolQuery::DirectHash(group_owners[group])));
+  }
+
+  // Step 2: Wait for all of them and copy per-entry results back
+  task->failed_count_ = 0;
+  for (size_t group = 0; group < groups.size(); ++group) {
+    auto &sub_task = sub_tasks[group];
+    sub_task->Wait();
+    for (size_t k = 0; k < groups[group].size(); ++k) {
+      BlobBatchEntry &entry = task->entries_[groups[group][k]];
+      entry.return_code_ =
+          (k < sub_task->entries_.size()) ? sub_task->entries_[k].return_code_
+                                          : 1;
+      if (entry.return_code_ != 0) {
+        ++task->failed_count_;
+      }
+    }
+    CHI_IPC->DelTask(sub_task);
+  }
+}
+
+void Runtime::PutBlobs(hipc::FullPtr<PutBlobsTask> task, chi::RunContext &ctx) {
+  // Dynamic scheduling phase - determine routing
+  if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
+    task->pool_query_ =
+        RouteBlobBatch(task->tag_id_, NameView(task->blob_names_),
+                       task->entries_);
+    return;
+  }
+
+  OpTimer timer(runtime_stats_, StatOp::kPutBlobs);
+  try {
+    TagId tag_id = task->tag_id_;
+    std::string_view blob_names = NameView(task->blob_names_);
+    size_t num_entries = task->entries_.size();
+    task->failed_count_ = 0;
+
+    // Step 1: A batch spanning several containers is split and forwarded
+    std::vector<std::vector<size_t>> groups;
+    std::vector<chi::u32> group_owners;
+    GroupBlobBatch(tag_id, blob_names, task->entries_, groups, group_owners);
+    if (groups.size() > 1) {
+      timer.Switch(StatPhase::kWait);
+      ForwardBlobBatch(task, groups, group_owners,
+                       [this, &task](const std::vector<BlobIoRequest> &requests,
+                                     const chi::PoolQuery &pool_query) {
+                         return client_.AsyncPutBlobs(
+                             hipc::MemContext(), task->tag_id_, requests,
+                             task->flags_, pool_query);
+                       });
+      task->return_code_.store(task->failed_count_ == 0 ? 0 : 1);
+      return;
+    }
+
+    // Step 2: Find or create each blob and allocate space for it. The size
+    // change is taken here because only allocation grows a blob, and entries
+    // naming the same blob must each count only their own growth
+    std::vector<BlobInfo *> blob_infos(num_entries, nullptr);
+    std::vector<chi::u64> size_changes(num_entries, 0);
+    std::vector<BlobWriteGuard> write_guards(num_entries);
+    for (size_t i = 0; i < num_entries; ++i) {
+      BlobBatchEntry &entry = task->entries_[i];
+      entry.return_code_ = 0;
+      if (entry.size_ == 0) {
+        entry.return_code_ = 2; // Error: Invalid size (zero)
+        continue;
+      }
+      if (entry.data_.IsNull()) {
+        entry.return_code_ = 3; // Error: Null data pointer
+        continue;
+      }
+      if (entry.name_len_ == 0) {
+        entry.return_code_ = 4; // Error: No blob name provided
+        continue;
+      }
+
+      timer.Switch(StatPhase::kMetadata);
+      BlobKey blob_key = BlobKey::View(
+          tag_id, blob_names.substr(entry.name_off_, entry.name_len_));
+      BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
+      bool blob_created = false;
+      if (blob_info_ptr == nullptr) {
+        blob_info_ptr = CreateNewBlob(blob_key, entry.score_, blob_created);
+        if (blob_info_ptr == nullptr) {
+          entry.return_code_ = 5; // Error: Failed to create blob
+          continue;
+        }
+      }
+      if (!blob_created && (task->flags_ & kPutBlobIfAbsent)) {
+        continue; // Already present; left untouched
+      }
+      write_guards[i] = BlobWriteGuard(this, blob_key, blob_info_ptr);
+      chi::u64 old_blob_size = blob_info_ptr->GetTotalSize();
+
+      timer.Switch(StatPhase::kAllocation);
+      chi::u32 allocation_result = AllocateNewData(
+          *blob_info_ptr, entry.offset_, entry.size_, entry.score_);
+      if (allocation_result != 0) {
+        HELOG(kError, "Allocation failure: {}", allocation_result);
+        entry.return_code_ =
+            10 + allocation_result; // Error: Allocation failure (10-19 range)
+        continue;
+      }
+      blob_infos[i] = blob_info_ptr;
+      size_changes[i] = blob_info_ptr->GetTotalSize() - old_blob_size;
+    }
+
+    // Step 3: Issue the writes of every entry before waiting on any
+    timer.Switch(StatPhase::kIo);
+    std::vector<PendingBdevIo<chimaera::bdev::WriteTask>> writes;
+    for (size_t i = 0; i < num_entries; ++i) {
+      if (blob_infos[i] == nullptr) {
+        continue;
+      }
+      const BlobBatchEntry &entry = task->entries_[i];
+      IssueWrites(blob_infos[i]->blocks_, entry.data_, entry.size_,
+                  entry.offset_, i, writes);
+    }
+
+    // Step 4: Wait for all writes
+    timer.Switch(StatPhase::kWait);
+    std::vector<bool> write_failed(num_entries, false);
+    WaitWrites(writes, &write_failed);
+
+    // Step 5: Update blob and tag metadata for the entries that landed
+    timer.Switch(StatPhase::kMetadata);
+    auto now = std::chrono::steady_clock::now();
+    chi::u64 tag_size_change = 0;
+    for (size_t i = 0; i < num_entries; ++i) {
+      BlobBatchEntry &entry = task->entries_[i];
+      if (blob_infos[i] == nullptr) {
+        continue;
+      }
+      if (write_failed[i]) {
+        entry.return_code_ = 21; // Error: Write failure (20-29 range)
+        continue;
+      }
+      blob_infos[i]->last_modified_ = now;
+      blob_infos[i]->score_ = entry.score_;
+      tag_size_change += size_changes[i];
+      LogTelemetry(CteOp::kPutBlob, entry.offset_, entry.size_, tag_id, now,
+                   blob_infos[i]->last_read_);
+      std::string_view entry_name =
+          blob_names.substr(entry.name_off_, entry.name_len_);
+      if (!(task->flags_ & kPutBlobIfAbsent)) {
+        MarkPageDirty(tag_id, entry_name, entry.offset_, entry.size_);
+      }
+      RaiseAppendCursor(tag_id, entry_name, entry.offset_, entry.size_);
+    }
+    {
+      size_t tag_lock_index = GetTagLockIndex(tag_id);
+      chi::ScopedCoRwReadLock tag_lock(*tag_locks_[tag_lock_index]);
+      TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
+      if (tag_info_ptr != nullptr) {
+        tag_info_ptr->last_modified_ = now;
+        tag_info_ptr->total_size_.fetch_add(
+            static_cast<size_t>(tag_size_change));
+      }
+    }
+
+    for (size_t i = 0; i < num_entries; ++i) {
+      if (task->entries_[i].return_code_ != 0) {
+        ++task->failed_count_;
+      }
+    }
+    task->return_code_.store(task->failed_count_ == 0 ? 0 : 1);
+
+  } catch (const std::exception &e) {
+    HILOG(kError, "PutBlobs failed with exception: {}", e.what());
+    for (auto &entry : task->entries_) {
+      if (entry.return_code_ == 0) {
+        entry.return_code_ = 1; // Outcome unknown; report as failed
+      }
+    }
+    task->failed_count_ = static_cast<chi::u32>(task->entries_.size());
+    task->return_code_.store(1); // Error: General exception
+  }
+}
+
+void Runtime::GetBlobs(hipc::FullPtr<GetBlobsTask> task, chi::RunContext &ctx) {
+  // Dynamic scheduling phase - determine routing
+  if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
+    task->pool_query_ =
+        RouteBlobBatch(task->tag_id_, NameView(task->blob_names_),
+                       task->entries_);
+    return;
+  }
+
+  OpTimer timer(runtime_stats_, StatOp::kGetBlobs);
+  try {
+    TagId tag_id = task->tag_id_;
+    std::string_view blob_names = NameView(task->blob_names_);
+    size_t num_entries = task->entries_.size();
+    task->failed_count_ = 0;
+
+    // Step 1: A batch spanning several containers is split and forwarded
+    std::vector<std::vector<size_t>> groups;
+    std::vector<chi::u32> group_owners;
+    GroupBlobBatch(tag_id, blob_names, task->entries_, groups, group_owners);
+    if (groups.size() > 1) {
+      timer.Switch(StatPhase::kWait);
+      ForwardBlobBatch(task, groups, group_owners,
+                       [this, &task](const std::vector<BlobIoRequest> &requests,
+                                     const chi::PoolQuery &pool_query) {
+                         return client_.AsyncGetBlobs(
+                             hipc::MemContext(), task->tag_id_, requests,
+                             task->flags_, pool_query);
+                       });
+      task->return_code_.store(task->failed_count_ == 0 ? 0 : 1);
+      return;
+    }
+
+    // Step 2: Look up every blob and issue its reads before waiting on any
+    std::vector<BlobInfo *> blob_infos(num_entries, nullptr);
+    std::vector<BlobReadGuard> read_guards(num_entries);
+    std::vector<PendingBdevIo<chimaera::bdev::ReadTask>> reads;
+    for (size_t i = 0; i < num_entries; ++i) {
+      BlobBatchEntry &entry = task->entries_[i];
+      entry.return_code_ = 0;
+      if (entry.size_ == 0 || entry.name_len_ == 0) {
+        entry.return_code_ = 1;
+        continue;
+      }
+
+      timer.Switch(StatPhase::kMetadata);
+      BlobKey blob_key = BlobKey::View(
+          tag_id, blob_names.substr(entry.name_off_, entry.name_len_));
+      BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
+      if (blob_info_ptr == nullptr) {
+        entry.return_code_ = kBlobNotFound;
+        continue;
+      }
+      blob_infos[i] = blob_info_ptr;
+      read_guards[i] = BlobReadGuard(this, blob_key, blob_info_ptr);
+
+      timer.Switch(StatPhase::kIo);
+      IssueReads(read_guards[i].GetBlocks(), entry.data_, entry.size_,
+                 entry.offset_, i, reads);
+    }
+
+    // Step 3: Wait for all reads
+    timer.Switch(StatPhase::kWait);
+    std::vector<bool> read_failed(num_entries, false);
+    WaitReads(reads, &read_failed);
+    read_guards.clear();
+
+    // Step 4: Update read timestamps for the entries that were served
+    timer.Switch(StatPhase::kMetadata);
+    auto now = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_entries; ++i) {
+      BlobBatchEntry &entry = task->entries_[i];
+      if (blob_infos[i] == nullptr) {
+        continue;
+      }
+      if (read_failed[i]) {
+        entry.return_code_ = 1;
+        continue;
+      }
+      blob_infos[i]->last_read_ = now;
+      LogTelemetry(CteOp::kGetBlob, entry.offset_, entry.size_, tag_id,
+                   blob_infos[i]->last_modified_, now);
+    }
+
+    for (size_t i = 0; i < num_entries; ++i) {
+      if (task->entries_[i].return_code_ != 0) {
+        ++task->failed_count_;
+      }
+    }
+    task->return_code_.store(task->failed_count_ == 0 ? 0 : 1);
+
+  } catch (const std::exception &e) {
+    HILOG(kError, "GetBlobs failed with exception: {}", e.what());
+    for (auto &entry : task->entries_) {
+      if (entry.return_code_ == 0) {
+        entry.return_code_ = 1; // Outcome unknown; report as failed
+      }
+    }
+    task->failed_count_ = static_cast<chi::u32>(task->entries_.size());
+    task->return_code_.store(1);
+  }
+}
+
 void Runtime::ReorganizeBlob(hipc::FullPtr<ReorganizeBlobTask> task,
                              chi::RunContext &ctx) {
   // Dynamic scheduling phase - determine routing
   if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
     task->pool_query_ =
-        HashBlobToContainer(task->tag_id_, task->blob_name_.str());
+        HashBlobToContainer(task->tag_id_, NameView(task->blob_name_));
     return;
   }
 
+  OpTimer timer(runtime_stats_, StatOp::kReorganizeBlob);
   try {
     // Extract input parameters
     TagId tag_id = task->tag_id_;
-    std::string blob_name = task->blob_name_.str();
+    BlobKey blob_key = BlobKey::View(tag_id, NameView(task->blob_name_));
+    std::string_view blob_name = blob_key.GetName();
     float new_score = task->new_score_;
 
     // Validate inputs
@@ -746,7 +1283,7 @@ void Runtime::ReorganizeBlob(hipc::FullPtr<ReorganizeBlobTask> task,
         config.performance_.score_difference_threshold_;
 
     // Step 1: Get blob info directly from table
-    BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
+    BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
     if (blob_info_ptr == nullptr) {
       task->return_code_.store(3); // Blob not found
       return;
@@ -784,46 +1321,37 @@ void Runtime::ReorganizeBlob(hipc::FullPtr<ReorganizeBlobTask> task,
       return;
     }
 
-    // Step 5: Allocate buffer for blob data
-    auto *ipc_manager = CHI_IPC;
-    hipc::FullPtr<char> blob_data_buffer =
-        ipc_manager->AllocateBuffer(blob_size);
-    if (blob_data_buffer.IsNull()) {
-      HILOG(kError, "Failed to allocate buffer for blob during reorganization");
-      task->return_code_.store(5); // Buffer allocation failed
+    // Step 5: Only move data if the DPE's choice for the new score is closer
+    // to it than the blob's current targets
+    float placement_score = GetPlacementScore(blob_info.blocks_);
+    float preferred_score = 0.0f;
+    if (!GetPreferredTargetScore(new_score, blob_size, preferred_score)) {
+      // No target can hold the whole blob; keep it where it is
+      task->return_code_.store(0);
       return;
     }
-
-    // Step 6: Get blob data
-    auto get_task =
-        client_.AsyncGetBlob(hipc::MemContext(), tag_id, blob_name, 0,
-                             blob_size, 0, blob_data_buffer.shm_);
-    get_task->Wait();
-
-    if (get_task->return_code_.load() != 0) {
-      HILOG(kWarning, "Failed to get blob data during reorganization");
-      CHI_IPC->DelTask(get_task);
-      task->return_code_.store(6); // Get blob failed
+    float gain = std::abs(placement_score - new_score) -
+                 std::abs(preferred_score - new_score);
+    if (gain < score_difference_threshold) {
+      task->return_code_.store(0);
+      HILOG(kDebug,
+            "ReorganizeBlob: blob={} already placed for score (placement={}, "
+            "preferred={})",
+            blob_name, placement_score, preferred_score);
       return;
     }
-    CHI_IPC->DelTask(get_task);
 
-    // Step 7: Put blob with new score (data reorganization)
-    HILOG(kDebug,
-          "ReorganizeBlob calling AsyncPutBlob for blob={}, new_score={}",
-          blob_name, new_score);
-    auto put_task =
-        client_.AsyncPutBlob(hipc::MemContext(), tag_id, blob_name, 0,
-                             blob_size, blob_data_buffer.shm_, new_score, 0);
-    put_task->Wait();
-
-    if (put_task->return_code_.load() != 0) {
-      HILOG(kWarning, "Failed to put blob during reorganization");
-      CHI_IPC->DelTask(put_task);
-      task->return_code_.store(7); // Put blob failed
+    // Step 6: Migrate the data between targets inside the runtime
+    chi::u64 bytes_moved = 0;
+    chi::u32 migrate_result =
+        MigrateBlob(blob_key, blob_info, new_score, bytes_moved, {}, &timer);
+    if (migrate_result != 0) {
+      HILOG(kWarning, "ReorganizeBlob: migration of blob={} failed: {}",
+            blob_name, migrate_result);
+      task->return_code_.store(
+          10 + migrate_result); // Error: Migration failure (10-19 range)
       return;
     }
-    CHI_IPC->DelTask(put_task);
 
     // Success
     task->return_code_.store(0);
@@ -842,14 +1370,16 @@ void Runtime::DelBlob(hipc::FullPtr<DelBlobTask> task, chi::RunContext &ctx) {
   // Dynamic scheduling phase - determine routing
   if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
     task->pool_query_ =
-        HashBlobToContainer(task->tag_id_, task->blob_name_.str());
+        HashBlobToContainer(task->tag_id_, NameView(task->blob_name_));
     return;
   }
 
+  OpTimer timer(runtime_stats_, StatOp::kDelBlob);
   try {
     // Extract input parameters
     TagId tag_id = task->tag_id_;
-    std::string blob_name = task->blob_name_.str();
+    BlobKey blob_key = BlobKey::View(tag_id, NameView(task->blob_name_));
+    std::string_view blob_name = blob_key.GetName();
 
     // Validate that blob_name is provided
     if (blob_name.empty()) {
@@ -858,7 +1388,7 @@ void Runtime::DelBlob(hipc::FullPtr<DelBlobTask> task, chi::RunContext &ctx) {
     }
 
     // Step 1: Check if blob exists
-    BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
+    BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
 
     if (blob_info_ptr == nullptr) {
       task->return_code_.store(1); // Blob not found
@@ -869,7 +1399,9 @@ void Runtime::DelBlob(hipc::FullPtr<DelBlobTask> task, chi::RunContext &ctx) {
     chi::u64 blob_size = blob_info_ptr->GetTotalSize();
 
     // Step 2.5: Free all blocks back to their targets before removing blob
+    timer.Switch(StatPhase::kAllocation);
     chi::u32 free_result = FreeAllBlobBlocks(*blob_info_ptr);
+    timer.Switch(StatPhase::kMetadata);
     if (free_result != 0) {
       HILOG(kWarning,
             "Failed to free some blocks for blob={}, continuing with deletion",
@@ -889,10 +1421,24 @@ void Runtime::DelBlob(hipc::FullPtr<DelBlobTask> task, chi::RunContext &ctx) {
       }
     }
 
-    // Step 5: Remove blob from tag_blob_name_to_info_ map
-    std::string compound_key = std::to_string(tag_id.major_) + "." +
-                               std::to_string(tag_id.minor_) + "." + blob_name;
-    tag_blob_name_to_info_.erase(compound_key);
+    // Step 5: Remove blob from tag_blob_name_to_info_ map and the per-tag
+    // index
+    {
+      size_t blob_lock_index = GetBlobLockIndex(blob_key);
+      chi::ScopedCoRwWriteLock blob_lock(*blob_locks_[blob_lock_index]);
+      tag_blob_name_to_info_.erase(blob_key);
+    }
+    {
+      size_t tag_lock_index = GetTagLockIndex(tag_id);
+      chi::ScopedCoRwWriteLock tag_lock(*tag_locks_[tag_lock_index]);
+      auto *blob_names = tag_blob_index_.find(tag_id);
+      if (blob_names != nullptr) {
+        blob_names->erase(std::string(blob_name));
+        if (blob_names->empty()) {
+          tag_blob_index_.erase(tag_id);
+        }
+      }
+    }
 
     // Step 6: Log telemetry for DelBlob operation
     auto now = std::chrono::steady_clock::now();
@@ -937,17 +1483,8 @@ void Runtime::DelTag(hipc::FullPtr<DelTagTask> task, chi::RunContext &ctx) {
 
     // Step 3: Delete all blobs in this tag using client AsyncDelBlob to
     // properly clean up blocks
-    // Collect all blob names first by scanning tag_blob_name_to_info_
-    std::string tag_prefix = std::to_string(tag_id.major_) + "." +
-                             std::to_string(tag_id.minor_) + ".";
-    std::vector<std::string> blob_names_to_delete;
-    tag_blob_name_to_info_.for_each(
-        [&tag_prefix, &blob_names_to_delete](const std::string &compound_key,
-                                             const BlobInfo &blob_info) {
-          if (compound_key.compare(0, tag_prefix.length(), tag_prefix) == 0) {
-            blob_names_to_delete.push_back(blob_info.blob_name_);
-          }
-        });
+    // Collect all blob names first from the per-tag index
+    std::vector<std::string> blob_names_to_delete = GetTagBlobNames(tag_id);
 
     // Process blobs in batches to limit concurrent async tasks
     constexpr size_t kMaxConcurrentDelBlobTasks = 32;
@@ -988,22 +1525,29 @@ void Runtime::DelTag(hipc::FullPtr<DelTagTask> task, chi::RunContext &ctx) {
     }
 
     // Step 4: Remove all blob name mappings for this tag (DelBlob should have
-    // removed them, but ensure cleanup)
-    std::vector<std::string> keys_to_erase;
-    tag_blob_name_to_info_.for_each(
-        [&tag_prefix, &keys_to_erase](const std::string &compound_key,
-                                      const BlobInfo &blob_info) {
-          if (compound_key.compare(0, tag_prefix.length(), tag_prefix) == 0) {
-            keys_to_erase.push_back(compound_key);
-          }
-        });
-    for (const auto &key : keys_to_erase) {
-      tag_blob_name_to_info_.erase(key);
+    // removed them, but ensure cleanup). The tag and blob locks are taken one
+    // after the other, never nested.
+    std::set<std::string> leftover_blobs;
+    {
+      size_t tag_lock_index = GetTagLockIndex(tag_id);
+      chi::ScopedCoRwWriteLock tag_lock(*tag_locks_[tag_lock_index]);
+      auto *blob_names = tag_blob_index_.find(tag_id);
+      if (blob_names != nullptr) {
+        leftover_blobs.swap(*blob_names);
+        tag_blob_index_.erase(tag_id);
+      }
+    }
+    for (const auto &blob_name : leftover_blobs) {
+      BlobKey blob_key(tag_id, blob_name);
+      size_t blob_lock_index = GetBlobLockIndex(blob_key);
+      chi::ScopedCoRwWriteLock blob_lock(*blob_locks_[blob_lock_index]);
+      tag_blob_name_to_info_.erase(blob_key);
     }
 
     // Step 5: Remove tag name mapping if it exists
     if (!tag_info_ptr->tag_name_.empty()) {
       tag_name_to_id_.erase(tag_info_ptr->tag_name_);
+      UnindexTagName(tag_info_ptr->tag_name_);
     }
 
     // Step 6: Log telemetry and remove tag from tag_id_to_info_ map
@@ -1015,6 +1559,14 @@ void Runtime::DelTag(hipc::FullPtr<DelTagTask> task, chi::RunContext &ctx) {
     LogTelemetry(CteOp::kDelTag, 0, total_size, tag_id, now, now);
 
     tag_id_to_info_.erase(tag_id);
+    {
+      std::lock_guard<std::mutex> lock(dirty_mutex_);
+      dirty_files_.erase(tag_id);
+    }
+    {
+      std::lock_guard<std::mutex> lock(append_mutex_);
+      append_cursors_.erase(tag_id);
+    }
 
     // Success
     task->return_code_.store(0);
@@ -1069,63 +1621,89 @@ void Runtime::GetTagSize(hipc::FullPtr<GetTagSizeTask> task,
 // Private helper methods
 const Config &Runtime::GetConfig() const { return config_; }
 
-void Runtime::UpdateTargetStats(const chi::PoolId &target_id,
-                                TargetInfo &target_info) {
-  // Get actual statistics from bdev using the GetStats method
-  chi::u64 remaining_size;
-  chimaera::bdev::PerfMetrics perf_metrics =
-      target_info.bdev_client_.GetStats(hipc::MemContext(), remaining_size);
-
-  // Update target info with real performance metrics from bdev
-  target_info.perf_metrics_ = perf_metrics;
-  target_info.remaining_space_ = remaining_size;
-
-  // Check if this target has a manually configured score - if so, don't
-  // overwrite it
-  float manual_score = GetManualScoreForTarget(target_info.target_name_);
-  if (manual_score >= 0.0f) {
-    // Keep the manually configured score, don't auto-calculate
-    target_info.target_score_ = manual_score;
-  } else {
-    // Auto-calculate target score using normalized log bandwidth
-    double max_bandwidth =
-        std::max(target_info.perf_metrics_.read_bandwidth_mbps_,
-                 target_info.perf_metrics_.write_bandwidth_mbps_);
-    if (max_bandwidth > 0.0) {
-      // Find the maximum bandwidth across all targets for normalization
-      double global_max_bandwidth =
-          1000.0; // TODO: Calculate actual max from all targets
-
-      // Use logarithmic scaling for target score: log(bandwidth_i) /
-      // log(bandwidth_MAX)
-      target_info.target_score_ = static_cast<float>(
-          std::log(max_bandwidth + 1.0) / std::log(global_max_bandwidth + 1.0));
-
-      // Clamp to [0, 1] range
-      target_info.target_score_ =
-          std::max(0.0f, std::min(1.0f, target_info.target_score_));
-    } else {
-      target_info.target_score_ = 0.0f; // No bandwidth, lowest score
-    }
-  }
+void Runtime::UpdateTargetStats(TargetInfo &target_info,
+                                const chimaera::bdev::PerfMetrics &sample,
+                                chi::u64 remaining_space) {
+  target_info.remaining_space_ = remaining_space;
+
+  // Smooth the metrics so one noisy sample does not reorder the tiers. The
+  // sample taken at registration seeds the average.
+  auto ewma = [](double average, double value) {
+    return kTargetStatEwmaWeight * value +
+           (1.0 - kTargetStatEwmaWeight) * average;
+  };
+  const chimaera::bdev::PerfMetrics &previous = target_info.perf_metrics_;
+  chimaera::bdev::PerfMetrics smoothed = sample;
+  smoothed.read_bandwidth_mbps_ =
+      ewma(previous.read_bandwidth_mbps_, sample.read_bandwidth_mbps_);
+  smoothed.write_bandwidth_mbps_ =
+      ewma(previous.write_bandwidth_mbps_, sample.write_bandwidth_mbps_);
+  smoothed.read_latency_us_ =
+      ewma(previous.read_latency_us_, sample.read_latency_us_);
+  smoothed.write_latency_us_ =
+      ewma(previous.write_latency_us_, sample.write_latency_us_);
+  smoothed.iops_ = ewma(previous.iops_, sample.iops_);
+  target_info.perf_metrics_ = smoothed;
+}
+
+void Runtime::NormalizeTargetScores() {
+  auto bandwidth_of = [](const TargetInfo &target_info) {
+    return std::max(target_info.perf_metrics_.read_bandwidth_mbps_,
+                    target_info.perf_metrics_.write_bandwidth_mbps_);
+  };
+
+  // Pass 1: the fastest target sets the scale, whether or not its own score
+  // is configured manually
+  double global_max_bandwidth = 0.0;
+  registered_targets_.for_each(
+      [&](const chi::PoolId &target_id, const TargetInfo &target_info) {
+        (void)target_id;
+        global_max_bandwidth =
+            std::max(global_max_bandwidth, bandwidth_of(target_info));
+      });
+
+  // Pass 2: normalized log bandwidth, so the fastest target scores 1.0
+  registered_targets_.for_each(
+      [&](const chi::PoolId &target_id, TargetInfo &target_info) {
+        (void)target_id;
+        // Check if this target has a manually configured score - if so, don't
+        // overwrite it
+        float manual_score = GetManualScoreForTarget(target_info.target_name_);
+        if (manual_score >= 0.0f) {
+          target_info.target_score_ = manual_score;
+          return;
+        }
+        target_info.target_score_ = ScoreTargetBandwidth(
+            bandwidth_of(target_info), global_max_bandwidth);
+      });
 }
 
 float Runtime::GetManualScoreForTarget(const std::string &target_name) {
-  // Check if the target name matches a configured storage device with manual
-  // score
+  const StorageDeviceConfig *device = FindDeviceForTarget(target_name);
+  if (device != nullptr) {
+    return device->score_; // Return configured score (-1.0f if not set)
+  }
+
+  return -1.0f; // No manual score configured for this target
+}
+
+const StorageDeviceConfig *
+Runtime::FindDeviceForTarget(const std::string &target_name) const {
   for (size_t i = 0; i < storage_devices_.size(); ++i) {
     const auto &device = storage_devices_[i];
 
     // Create the expected target name based on how targets are registered
     std::string expected_target_name = "storage_device_" + std::to_string(i);
 
-    // Also check if target name matches the device path directly
-    if (target_name == expected_target_name || target_name == device.path_) {
-      return device.score_; // Return configured score (-1.0f if not set)
+    // Also check if target name matches the device path directly, or the
+    // per-node names Create registers (<path>_node<N>)
+    if (target_name == expected_target_name || target_name == device.path_ ||
+        target_name.rfind(device.path_ + "_node", 0) == 0) {
+      return &device;
     }
   }
 
-  return -1.0f; // No manual score configured for this target
+  return nullptr;
 }
 
 TagId Runtime::GetOrAssignTagId(const std::string &tag_name,
@@ -1158,6 +1736,7 @@ TagId Runtime::GetOrAssignTagId(const std::string &tag_name,
   // Store mappings
   tag_name_to_id_.insert_or_assign(tag_name, tag_id);
   tag_id_to_info_.insert_or_assign(tag_id, tag_info);
+  IndexTagName(tag_name);
 
   return tag_id;
 }
@@ -1176,6 +1755,10 @@ size_t Runtime::GetTargetLockIndex(const chi::PoolId &target_id) const {
   return hasher(target_id) % target_locks_.size();
 }
 
+size_t Runtime::GetTargetStatsLockIndex() const {
+  return std::hash<std::string>{}("stat_targets") % target_locks_.size();
+}
+
 size_t Runtime::GetTagLockIndex(const std::string &tag_name) const {
   // Use same hash function as chi::unordered_map_ll to ensure lock maps to same
   // bucket
@@ -1190,6 +1773,11 @@ size_t Runtime::GetTagLockIndex(const TagId &tag_id) const {
   return hasher(tag_id) % tag_locks_.size();
 }
 
+size_t Runtime::GetBlobLockIndex(const BlobKey &blob_key) const {
+  // BlobKey hashes to its precomputed value, so this matches the map bucket
+  return blob_key.hash_ % blob_locks_.size();
+}
+
 TagId Runtime::GenerateNewTagId() {
   // Get node_id from IPC manager as the major component
   auto *ipc_manager = CHI_IPC;
@@ -1206,30 +1794,30 @@ template void Runtime::GetOrCreateTag<CreateParams>(
     hipc::FullPtr<GetOrCreateTagTask<CreateParams>> task, chi::RunContext &ctx);
 
 // Blob management helper functions
-BlobInfo *Runtime::CheckBlobExists(const std::string &blob_name,
-                                   const TagId &tag_id) {
+BlobInfo *Runtime::CheckBlobExists(const BlobKey &blob_key) {
   // Validate that blob name is provided
-  if (blob_name.empty()) {
+  if (blob_key.GetName().empty()) {
     return nullptr;
   }
 
-  // Construct composite key for lookup
-  std::string composite_key = std::to_string(tag_id.major_) + "." +
-                              std::to_string(tag_id.minor_) + "." + blob_name;
-
-  // Acquire read lock ONLY for map lookup
-  size_t tag_lock_index = GetTagLockIndex(tag_id);
-  chi::ScopedCoRwReadLock tag_lock(*tag_locks_[tag_lock_index]);
+  // Acquire read lock ONLY for map lookup (lock and bucket both come from the
+  // key's precomputed hash)
+  size_t blob_lock_index = GetBlobLockIndex(blob_key);
+  chi::ScopedCoRwReadLock blob_lock(*blob_locks_[blob_lock_index]);
 
   // Search by composite key in tag_blob_name_to_info_
-  BlobInfo *blob_info_ptr = tag_blob_name_to_info_.find(composite_key);
+  BlobInfo *blob_info_ptr = tag_blob_name_to_info_.find(blob_key);
 
   // Return result (lock released automatically at scope exit)
   return blob_info_ptr;
 }
 
-BlobInfo *Runtime::CreateNewBlob(const std::string &blob_name,
-                                 const TagId &tag_id, float blob_score) {
+BlobInfo *Runtime::CreateNewBlob(const BlobKey &blob_key, float blob_score,
+                                 bool &created) {
+  const TagId &tag_id = blob_key.tag_id_;
+  std::string_view blob_name = blob_key.GetName();
+  created = false;
+
   // Validate that blob name is provided
   if (blob_name.empty()) {
     return nullptr;
@@ -1242,76 +1830,495 @@ BlobInfo *Runtime::CreateNewBlob(const std::string &blob_name,
   new_blob_info.blob_name_ = blob_name;
   new_blob_info.score_ = blob_score;
 
-  // Construct composite key for blob storage
-  std::string composite_key = std::to_string(tag_id.major_) + "." +
-                              std::to_string(tag_id.minor_) + "." + blob_name;
-
-  // Acquire write lock ONLY for map insertion
-  size_t tag_lock_index = GetTagLockIndex(tag_id);
+  // Acquire write lock ONLY for map insertion. The lookup is repeated under
+  // the lock so that concurrent creators agree on a single blob.
+  size_t blob_lock_index = GetBlobLockIndex(blob_key);
   BlobInfo *blob_info_ptr = nullptr;
   {
-    chi::ScopedCoRwWriteLock tag_lock(*tag_locks_[tag_lock_index]);
+    chi::ScopedCoRwWriteLock blob_lock(*blob_locks_[blob_lock_index]);
+    blob_info_ptr = tag_blob_name_to_info_.find(blob_key);
+    if (blob_info_ptr != nullptr) {
+      return blob_info_ptr;
+    }
 
     // Store blob info directly in tag_blob_name_to_info_
     auto insert_result =
-        tag_blob_name_to_info_.insert_or_assign(composite_key, new_blob_info);
+        tag_blob_name_to_info_.insert_or_assign(blob_key, new_blob_info);
     blob_info_ptr = insert_result.second;
+    created = true;
   } // Release lock immediately after insertion
 
+  // Record the blob in the per-tag index
+  size_t tag_lock_index = GetTagLockIndex(tag_id);
+  {
+    chi::ScopedCoRwWriteLock tag_lock(*tag_locks_[tag_lock_index]);
+    auto *blob_names = tag_blob_index_.find(tag_id);
+    if (blob_names == nullptr) {
+      blob_names = tag_blob_index_
+                       .insert_or_assign(tag_id, std::set<std::string>())
+                       .second;
+    }
+    blob_names->insert(std::string(blob_name));
+  }
+
   return blob_info_ptr;
 }
 
-chi::u32 Runtime::AllocateNewData(BlobInfo &blob_info, chi::u64 offset,
-                                  chi::u64 size, float blob_score) {
-  HILOG(kDebug, "AllocateNewData");
-  // Calculate required additional space
-  chi::u64 current_blob_size = blob_info.GetTotalSize();
-  chi::u64 required_size = offset + size;
+Runtime::BlobWriteGuard::BlobWriteGuard(Runtime *runtime,
+                                        const BlobKey &blob_key,
+                                        BlobInfo *blob_info)
+    : runtime_(runtime), lock_index_(runtime->GetBlobLockIndex(blob_key)),
+      blob_info_(blob_info) {
+  chi::ScopedCoRwWriteLock blob_lock(*runtime_->blob_locks_[lock_index_]);
+  ++blob_info_->writers_;
+  ++blob_info_->write_gen_;
+}
 
-  if (required_size <= current_blob_size) {
-    // No additional allocation needed
-    return 0;
-  }
+Runtime::BlobWriteGuard::BlobWriteGuard(BlobWriteGuard &&other) noexcept
+    : runtime_(other.runtime_), lock_index_(other.lock_index_),
+      blob_info_(other.blob_info_) {
+  other.blob_info_ = nullptr;
+}
 
-  chi::u64 additional_size = required_size - current_blob_size;
+Runtime::BlobWriteGuard &
+Runtime::BlobWriteGuard::operator=(BlobWriteGuard &&other) noexcept {
+  if (this != &other) {
+    Release();
+    runtime_ = other.runtime_;
+    lock_index_ = other.lock_index_;
+    blob_info_ = other.blob_info_;
+    other.blob_info_ = nullptr;
+  }
+  return *this;
+}
 
-  // Get all available targets for data placement
-  std::vector<TargetInfo> available_targets;
-  available_targets.reserve(registered_targets_.size());
-  registered_targets_.for_each(
-      [&available_targets](const chi::PoolId &target_id,
-                           const TargetInfo &target_info) {
-        available_targets.push_back(target_info);
-      });
-  HILOG(kDebug, "AllocateNewData: Ordered targets: {}",
-        available_targets.size());
-  if (available_targets.empty()) {
-    return 1;
+void Runtime::BlobWriteGuard::Release() {
+  if (blob_info_ == nullptr) {
+    return;
   }
+  chi::ScopedCoRwWriteLock blob_lock(*runtime_->blob_locks_[lock_index_]);
+  --blob_info_->writers_;
+  ++blob_info_->write_gen_;
+  blob_info_ = nullptr;
+}
 
-  // Create Data Placement Engine based on configuration
-  const Config &config = GetConfig();
-  std::unique_ptr<DataPlacementEngine> dpe =
-      DpeFactory::CreateDpe(config.dpe_.dpe_type_);
+Runtime::BlobReadGuard::BlobReadGuard(Runtime *runtime,
+                                      const BlobKey &blob_key,
+                                      BlobInfo *blob_info)
+    : runtime_(runtime), lock_index_(runtime->GetBlobLockIndex(blob_key)),
+      blob_info_(blob_info) {
+  chi::ScopedCoRwWriteLock blob_lock(*runtime_->blob_locks_[lock_index_]);
+  ++blob_info_->readers_;
+  blocks_ = blob_info_->blocks_;
+}
 
-  // Select targets using DPE algorithm before allocation loop
-  std::vector<TargetInfo> ordered_targets =
-      dpe->SelectTargets(available_targets, blob_score, additional_size);
+Runtime::BlobReadGuard::BlobReadGuard(BlobReadGuard &&other) noexcept
+    : runtime_(other.runtime_), lock_index_(other.lock_index_),
+      blob_info_(other.blob_info_), blocks_(std::move(other.blocks_)) {
+  other.blob_info_ = nullptr;
+}
 
-  if (ordered_targets.empty()) {
-    return 2;
+Runtime::BlobReadGuard &
+Runtime::BlobReadGuard::operator=(BlobReadGuard &&other) noexcept {
+  if (this != &other) {
+    Release();
+    runtime_ = other.runtime_;
+    lock_index_ = other.lock_index_;
+    blob_info_ = other.blob_info_;
+    blocks_ = std::move(other.blocks_);
+    other.blob_info_ = nullptr;
   }
+  return *this;
+}
 
-  // Use for loop to iterate over pre-selected targets in order
+void Runtime::BlobReadGuard::Release() {
+  if (blob_info_ == nullptr) {
+    return;
+  }
+  // The last read out frees the blocks swapped out while it was in flight
+  BlobInfo retired;
+  {
+    chi::ScopedCoRwWriteLock blob_lock(*runtime_->blob_locks_[lock_index_]);
+    if (--blob_info_->readers_ == 0) {
+      retired.blocks_.swap(blob_info_->retired_blocks_);
+    }
+  }
+  blob_info_ = nullptr;
+  blocks_.clear();
+  if (!retired.blocks_.empty()) {
+    runtime_->FreeAllBlobBlocks(retired);
+  }
+}
+
+void Runtime::IndexTagName(const std::string &tag_name) {
+  chi::ScopedCoRwWriteLock index_lock(tag_name_index_lock_);
+  tag_name_index_.insert(tag_name);
+}
+
+void Runtime::UnindexTagName(const std::string &tag_name) {
+  chi::ScopedCoRwWriteLock index_lock(tag_name_index_lock_);
+  tag_name_index_.erase(tag_name);
+}
+
+std::vector<std::string>
+Runtime::FindTagNames(const CompiledPattern &pattern, const std::string &after,
+                      size_t limit) {
+  std::vector<std::string> tag_names;
+  const std::string &prefix = pattern.GetLiteralPrefix();
+  chi::ScopedCoRwReadLock index_lock(tag_name_index_lock_);
+  auto it = prefix.empty() ? tag_name_index_.begin()
+                           : tag_name_index_.lower_bound(prefix);
+  if (!after.empty() && (it == tag_name_index_.end() || *it <= after)) {
+    it = tag_name_index_.upper_bound(after);
+  }
+  for (; it != tag_name_index_.end(); ++it) {
+    // Names sharing the prefix are contiguous; the first one without it
+    // ends the range
+    if (!prefix.empty() && it->compare(0, prefix.size(), prefix) != 0) {
+      break;
+    }
+    if (pattern.Match(*it)) {
+      tag_names.push_back(*it);
+      if (limit != 0 && tag_names.size() >= limit) {
+        break;
+      }
+    }
+  }
+  return tag_names;
+}
+
+std::vector<std::string> Runtime::GetTagBlobNames(const TagId &tag_id) {
+  std::vector<std::string> blob_names;
+  size_t tag_lock_index = GetTagLockIndex(tag_id);
+  chi::ScopedCoRwReadLock tag_lock(*tag_locks_[tag_lock_index]);
+  auto *indexed_names = tag_blob_index_.find(tag_id);
+  if (indexed_names != nullptr) {
+    blob_names.assign(indexed_names->begin(), indexed_names->end());
+  }
+  return blob_names;
+}
+
+std::vector<TagId> Runtime::GetIndexedTagIds() {
+  // Each tag lock guards the index buckets with its index; writers take a
+  // single lock, so taking all of them in order cannot deadlock
+  std::vector<std::unique_ptr<chi::ScopedCoRwReadLock>> tag_lock_guards;
+  tag_lock_guards.reserve(tag_locks_.size());
+  for (auto &tag_lock : tag_locks_) {
+    tag_lock_guards.push_back(
+        std::make_unique<chi::ScopedCoRwReadLock>(*tag_lock));
+  }
+  std::vector<TagId> tag_ids;
+  tag_blob_index_.for_each(
+      [&tag_ids](const TagId &tag_id,
+                 const std::set<std::string> &blob_names) {
+        (void)blob_names;
+        tag_ids.push_back(tag_id);
+      });
+  return tag_ids;
+}
+
+chi::u32 Runtime::HandOverTags(chi::u32 container_id) {
+  // Step 1: Find the canonical tags here whose name moved on the ring
+  std::vector<std::string> tag_names;
+  {
+    chi::ScopedCoRwReadLock index_lock(tag_name_index_lock_);
+    tag_names.assign(tag_name_index_.begin(), tag_name_index_.end());
+  }
+  std::vector<std::pair<std::string, TagId>> hand_overs;
+  for (auto &tag_name : tag_names) {
+    if (GetTagOwnerContainer(tag_name) == container_id) {
+      continue;
+    }
+    size_t tag_lock_index = GetTagLockIndex(tag_name);
+    chi::ScopedCoRwReadLock tag_lock(*tag_locks_[tag_lock_index]);
+    TagId *tag_id_ptr = tag_name_to_id_.find(tag_name);
+    if (tag_id_ptr != nullptr && tag_id_to_info_.contains(*tag_id_ptr)) {
+      hand_overs.emplace_back(std::move(tag_name), *tag_id_ptr);
+    }
+  }
+
+  // Step 2: Create each tag on its owner under its existing ID. The TagInfo
+  // here stays, since it accounts for the tag's blobs still held here.
+  std::vector<hipc::FullPtr<GetOrCreateTagTask<CreateParams>>> tasks;
+  tasks.reserve(hand_overs.size());
+  for (const auto &hand_over : hand_overs) {
+    tasks.push_back(client_.AsyncGetOrCreateTag(
+        hipc::MemContext(), hand_over.first, hand_over.second,
+        chi::PoolQuery::DirectHash(GetTagOwnerContainer(hand_over.first))));
+  }
+  chi::u32 handed_over = 0;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    tasks[i]->Wait();
+    if (tasks[i]->return_code_.load() != 0) {
+      HELOG(kError, "RebalanceBlobs: handing over tag {} failed",
+            hand_overs[i].first);
+    } else if (tasks[i]->tag_id_ != hand_overs[i].second) {
+      // Created on the new owner before the hand-over
+      HELOG(kWarning, "RebalanceBlobs: tag {} has another ID on its owner",
+            hand_overs[i].first);
+    } else {
+      ++handed_over;
+    }
+    CHI_IPC->DelTask(tasks[i]);
+  }
+  return handed_over;
+}
+
+std::vector<std::string> Runtime::GetTagBlobNames(const TagId &tag_id,
+                                                  const std::string &after,
+                                                  size_t limit) {
+  std::vector<std::string> blob_names;
+  size_t tag_lock_index = GetTagLockIndex(tag_id);
+  chi::ScopedCoRwReadLock tag_lock(*tag_locks_[tag_lock_index]);
+  auto *indexed_names = tag_blob_index_.find(tag_id);
+  if (indexed_names == nullptr) {
+    return blob_names;
+  }
+  auto it = after.empty() ? indexed_names->begin()
+                          : indexed_names->upper_bound(after);
+  for (; it != indexed_names->end(); ++it) {
+    if (limit != 0 && blob_names.size() >= limit) {
+      break;
+    }
+    blob_names.push_back(*it);
+  }
+  return blob_names;
+}
+
+bool Runtime::EvalBlobPredicate(const BlobKey &blob_key,
+                                const BlobQueryPredicate &predicate,
+                                const Timestamp &now, BlobQueryStat &stat) {
+  BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
+  if (blob_info_ptr == nullptr) {
+    return false;
+  }
+  auto age_ms = [&now](const Timestamp &then) -> chi::u64 {
+    auto age = std::chrono::duration_cast<std::chrono::milliseconds>(now - then);
+    return age.count() > 0 ? static_cast<chi::u64>(age.count()) : 0;
+  };
+
+  bool any_target = (predicate.target_id_ == chi::PoolId::GetNull());
+  bool on_target = any_target;
+  std::vector<std::pair<chi::PoolId, chi::u64>> target_bytes;
+  stat = BlobQueryStat();
+  stat.tag_id_ = blob_key.tag_id_;
+  {
+    // Writes append blocks and migrations swap them under the blob lock
+    chi::ScopedCoRwReadLock blob_lock(
+        *blob_locks_[GetBlobLockIndex(blob_key)]);
+
+    // One pass over the blocks gives the size, the target holding the most
+    // bytes, and whether the blob has data on the requested target
+    for (const auto &block : blob_info_ptr->blocks_) {
+      const chi::PoolId &target_id = block.bdev_client_.pool_id_;
+      stat.size_ += block.size_;
+      on_target = on_target || (target_id == predicate.target_id_);
+      auto it = std::find_if(
+          target_bytes.begin(), target_bytes.end(),
+          [&target_id](const std::pair<chi::PoolId, chi::u64> &entry) {
+            return entry.first == target_id;
+          });
+      if (it == target_bytes.end()) {
+        target_bytes.emplace_back(target_id, block.size_);
+      } else {
+        it->second += block.size_;
+      }
+    }
+    chi::u64 most_bytes = 0;
+    for (const auto &entry : target_bytes) {
+      if (most_bytes == 0 || entry.second > most_bytes) {
+        stat.target_id_ = entry.first;
+        most_bytes = entry.second;
+      }
+    }
+    stat.num_blocks_ = static_cast<chi::u32>(blob_info_ptr->blocks_.size());
+    stat.score_ = blob_info_ptr->score_;
+    stat.modified_age_ms_ = age_ms(blob_info_ptr->last_modified_);
+    stat.read_age_ms_ = age_ms(blob_info_ptr->last_read_);
+  }
+
+  return on_target && stat.size_ >= predicate.min_size_ &&
+         stat.size_ <= predicate.max_size_ &&
+         stat.score_ >= predicate.min_score_ &&
+         stat.score_ <= predicate.max_score_ &&
+         stat.read_age_ms_ >= predicate.min_read_age_ms_;
+}
+
+std::string Runtime::EncodeBlobQueryCursor(const std::string &tag_name,
+                                           const std::string &blob_name) {
+  // Tag names may contain any character, so the tag name is length-prefixed
+  return std::to_string(tag_name.size()) + ":" + tag_name + blob_name;
+}
+
+bool Runtime::DecodeBlobQueryCursor(const std::string &cursor,
+                                    std::string &tag_name,
+                                    std::string &blob_name) {
+  size_t colon = cursor.find(':');
+  if (colon == 0 || colon == std::string::npos ||
+      cursor.find_first_not_of("0123456789") != colon) {
+    return false;
+  }
+  size_t tag_name_size = std::stoull(cursor.substr(0, colon));
+  if (tag_name_size > cursor.size() - colon - 1) {
+    return false;
+  }
+  tag_name = cursor.substr(colon + 1, tag_name_size);
+  blob_name = cursor.substr(colon + 1 + tag_name_size);
+  return true;
+}
+
+void Runtime::InvalidateTargetSnapshot() {
+  target_version_.fetch_add(1);
+}
+
+void Runtime::RefreshTargetSnapshot() {
+  RequestTargetStatsIfStale();
+  chi::u64 version = target_version_.load();
+  {
+    chi::ScopedCoRwReadLock snapshot_lock(target_snapshot_lock_);
+    if (target_snapshot_.version_ == version) {
+      return;
+    }
+  }
+
+  chi::ScopedCoRwWriteLock snapshot_lock(target_snapshot_lock_);
+  if (target_snapshot_.version_ == version) {
+    return; // Another task rebuilt it first
+  }
+  // clear() keeps capacity, so rebuilds only allocate when targets are added
+  target_snapshot_.targets_.clear();
+  chi::ScopedCoRwReadLock stats_lock(*target_locks_[GetTargetStatsLockIndex()]);
+  registered_targets_.for_each(
+      [this](const chi::PoolId &target_id, const TargetInfo &target_info) {
+        (void)target_id;
+        target_snapshot_.targets_.emplace_back(target_info);
+      });
+  target_snapshot_.version_ = version;
+}
+
+void Runtime::PublishTargetSnapshot() {
+  chi::u64 version = target_version_.fetch_add(1) + 1;
+  std::vector<TargetDesc> targets;
+  {
+    // Keeps StatTargets and RegisterTarget from rewriting metrics mid-copy
+    chi::ScopedCoRwReadLock stats_lock(
+        *target_locks_[GetTargetStatsLockIndex()]);
+    registered_targets_.for_each(
+        [&targets](const chi::PoolId &target_id,
+                   const TargetInfo &target_info) {
+          (void)target_id;
+          targets.emplace_back(target_info);
+        });
+  }
+
+  {
+    chi::ScopedCoRwWriteLock snapshot_lock(target_snapshot_lock_);
+    if (target_snapshot_.version_ < version) {
+      target_snapshot_.targets_.swap(targets);
+      target_snapshot_.version_ = version;
+    }
+  }
+  target_stats_time_ns_.store(SteadyNowNs());
+  target_stats_requested_.store(false);
+}
+
+void Runtime::RequestTargetStatsIfStale() {
+  chi::u64 max_age_ns =
+      static_cast<chi::u64>(config_.performance_.target_stat_interval_ms_) *
+      1000000ULL;
+  chi::u64 published_ns = target_stats_time_ns_.load();
+  if (SteadyNowNs() - published_ns <= max_age_ns) {
+    return;
+  }
+  // One request per stale period; cleared when new stats are published
+  if (!target_stats_requested_.exchange(true)) {
+    RequestMaintenance(kStatTargetsJob);
+  }
+}
+
+chi::u64 Runtime::SteadyNowNs() {
+  return static_cast<chi::u64>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+chi::u32 Runtime::AllocateNewData(
+    BlobInfo &blob_info, chi::u64 offset, chi::u64 size, float blob_score,
+    const std::vector<chi::PoolId> &excluded_targets) {
+  HILOG(kDebug, "AllocateNewData");
+  // Calculate required additional space
+  chi::u64 current_blob_size = blob_info.GetTotalSize();
+  chi::u64 required_size = offset + size;
+
+  if (required_size <= current_blob_size) {
+    // No additional allocation needed
+    return 0;
+  }
+
+  chi::u64 additional_size = required_size - current_blob_size;
+
+  // A striped allocation only needs each target to hold one stripe unit, so
+  // the DPE must not drop targets that are too small for the whole blob
+  bool striped = config_.dpe_.stripe_width_ > 1 &&
+                 additional_size >= 2 * config_.dpe_.stripe_unit_;
+  chi::u64 select_size =
+      striped ? config_.dpe_.stripe_unit_ : additional_size;
+
+  // Select targets from the compact snapshot using this worker's cached DPE.
+  // SelectTargets does not yield, so the snapshot read lock is held only for
+  // the selection itself.
+  PlacementBuffer placement;
+  std::vector<chi::PoolId> &ordered_targets = *placement;
+  RefreshTargetSnapshot();
+  {
+    chi::ScopedCoRwReadLock snapshot_lock(target_snapshot_lock_);
+    if (target_snapshot_.targets_.empty()) {
+      return 1;
+    }
+    DpeFactory::GetWorkerDpe(dpe_type_, config_.dpe_).SelectTargets(
+        target_snapshot_.targets_, blob_score, select_size, ordered_targets);
+
+    if (!excluded_targets.empty()) {
+      auto is_excluded = [&excluded_targets](const chi::PoolId &target_id) {
+        return std::find(excluded_targets.begin(), excluded_targets.end(),
+                         target_id) != excluded_targets.end();
+      };
+      ordered_targets.erase(std::remove_if(ordered_targets.begin(),
+                                           ordered_targets.end(), is_excluded),
+                            ordered_targets.end());
+      // The DPE may only have offered excluded targets (e.g. MaxBW falls back
+      // to the fastest one); any other target with room will do
+      if (ordered_targets.empty()) {
+        for (const auto &target : target_snapshot_.targets_) {
+          if (target.remaining_space_ >= select_size &&
+              !is_excluded(target.target_id_)) {
+            ordered_targets.push_back(target.target_id_);
+          }
+        }
+      }
+    }
+  }
+
+  if (ordered_targets.empty()) {
+    return 2;
+  }
+
+  // Large allocations are striped first; whatever the stripe targets cannot
+  // hold fills the selected targets in order
   chi::u64 remaining_to_allocate = additional_size;
-  for (const auto &selected_target_info : ordered_targets) {
+  if (striped) {
+    remaining_to_allocate =
+        AllocateStriped(blob_info, ordered_targets, additional_size);
+  }
+
+  // Use for loop to iterate over pre-selected targets in order
+  for (const chi::PoolId &selected_target_id : ordered_targets) {
     // Termination condition: exit when no more space to allocate
     if (remaining_to_allocate == 0) {
       break;
     }
 
-    chi::PoolId selected_target_id = selected_target_info.bdev_client_.pool_id_;
-
     // Find the selected target info for allocation using TargetId
     TargetInfo *target_info = registered_targets_.find(selected_target_id);
     if (target_info == nullptr) {
@@ -1329,23 +2336,19 @@ chi::u32 Runtime::AllocateNewData(BlobInfo &blob_info, chi::u64 offset,
           allocate_size, remaining_to_allocate);
 
     if (allocate_size == 0) {
-      // No space available, try next target
+      // No space available, try next target; the snapshot still advertised
+      // space here, so refresh it before the next placement
       HILOG(kDebug, "No space available, trying next target?");
+      InvalidateTargetSnapshot();
       continue;
     }
 
-    // Allocate space using bdev client
-    chi::u64 allocated_offset;
-    if (!AllocateFromTarget(*target_info, allocate_size, allocated_offset)) {
+    if (!AppendBlock(blob_info, *target_info, allocate_size)) {
       // Allocation failed, try next target
+      InvalidateTargetSnapshot();
       continue;
     }
 
-    // Create new block for the allocated space
-    BlobBlock new_block(target_info->bdev_client_, target_info->target_query_,
-                        allocated_offset, allocate_size);
-    blob_info.blocks_.emplace_back(new_block);
-
     remaining_to_allocate -= allocate_size;
   }
 
@@ -1358,20 +2361,104 @@ chi::u32 Runtime::AllocateNewData(BlobInfo &blob_info, chi::u64 offset,
   return 0; // Success
 }
 
+chi::u64 Runtime::AllocateStriped(
+    BlobInfo &blob_info, const std::vector<chi::PoolId> &ordered_targets,
+    chi::u64 size) {
+  const chi::u64 stripe_unit = config_.dpe_.stripe_unit_;
+  std::vector<TargetInfo *> stripe;
+  for (const chi::PoolId &target_id : ordered_targets) {
+    if (stripe.size() >= config_.dpe_.stripe_width_) {
+      break;
+    }
+    TargetInfo *target_info = registered_targets_.find(target_id);
+    if (target_info != nullptr &&
+        target_info->remaining_space_ >= stripe_unit) {
+      stripe.push_back(target_info);
+    }
+  }
+  if (stripe.size() < 2) {
+    return size;
+  }
+
+  // Each unit is its own bdev block, so blocks stay freeable one by one.
+  // A target that runs out of room leaves the stripe; the rest continue.
+  size_t next = 0;
+  while (size > 0 && !stripe.empty()) {
+    next %= stripe.size();
+    chi::u64 unit_size = std::min(size, stripe_unit);
+    if (!AppendBlock(blob_info, *stripe[next], unit_size)) {
+      InvalidateTargetSnapshot();
+      stripe.erase(stripe.begin() + next);
+      continue;
+    }
+    size -= unit_size;
+    ++next;
+  }
+  HILOG(kDebug, "AllocateStriped: {} bytes left for sequential placement",
+        size);
+  return size;
+}
+
+bool Runtime::AppendBlock(BlobInfo &blob_info, TargetInfo &target_info,
+                          chi::u64 size) {
+  // Allocate space using bdev client
+  chi::u64 allocated_offset;
+  if (!AllocateFromTarget(target_info, size, allocated_offset)) {
+    return false;
+  }
+
+  // Create new block for the allocated space
+  blob_info.blocks_.emplace_back(target_info.bdev_client_,
+                                 target_info.target_query_, allocated_offset,
+                                 size);
+  if (target_info.io_counters_) {
+    target_info.io_counters_->RecordAllocation();
+  }
+
+  // Wake the demotion job as soon as this allocation crosses the target's
+  // high watermark rather than waiting for its next period
+  chi::u64 high_mark = static_cast<chi::u64>(
+      static_cast<double>(target_info.total_space_) *
+      target_info.high_watermark_);
+  chi::u64 used = target_info.total_space_ - target_info.remaining_space_;
+  if (target_info.high_watermark_ < 1.0f && used > high_mark &&
+      used - size <= high_mark) {
+    RequestMaintenance(kEnforceWatermarksJob);
+  }
+  return true;
+}
+
 chi::u32 Runtime::ModifyExistingData(const std::vector<BlobBlock> &blocks,
                                      hipc::Pointer data, size_t data_size,
-                                     size_t data_offset_in_blob) {
+                                     size_t data_offset_in_blob,
+                                     OpTimer *timer) {
   HILOG(kDebug,
         "ModifyExistingData: blocks={}, data_size={}, data_offset_in_blob={}",
         blocks.size(), data_size, data_offset_in_blob);
 
+  std::vector<PendingBdevIo<chimaera::bdev::WriteTask>> writes;
+  if (timer != nullptr) {
+    timer->Switch(StatPhase::kIo);
+  }
+  IssueWrites(blocks, data, data_size, data_offset_in_blob, 0, writes);
+  if (timer != nullptr) {
+    timer->Switch(StatPhase::kWait);
+  }
+  if (WaitWrites(writes, nullptr) != 0) {
+    return 1;
+  }
+
+  HILOG(kDebug, "ModifyExistingData: All write tasks completed successfully");
+  return 0; // Success
+}
+
+void Runtime::IssueWrites(
+    const std::vector<BlobBlock> &blocks, hipc::Pointer data, size_t data_size,
+    size_t data_offset_in_blob, size_t owner,
+    std::vector<PendingBdevIo<chimaera::bdev::WriteTask>> &writes) {
   // Step 1: Initially store the remaining_size equal to data_size
   size_t remaining_size = data_size;
 
-  // Vector to store async write tasks for later waiting
-  std::vector<hipc::FullPtr<chimaera::bdev::WriteTask>> write_tasks;
-  std::vector<size_t> expected_write_sizes;
-
   // Step 2: Store the offset of the block in the blob. The first block is
   // offset 0
   size_t block_offset_in_blob = 0;
@@ -1379,11 +2466,6 @@ chi::u32 Runtime::ModifyExistingData(const std::vector<BlobBlock> &blocks,
   // Iterate over every block in the blob
   for (size_t block_idx = 0; block_idx < blocks.size(); ++block_idx) {
     const BlobBlock &block = blocks[block_idx];
-    HILOG(
-        kDebug,
-        "ModifyExistingData: block[{}] - target_offset={}, size={}, pool_id={}",
-        block_idx, block.target_offset_, block.size_,
-        block.bdev_client_.pool_id_.ToU64());
 
     // Step 7: If remaining size is 0, quit the for loop
     if (remaining_size == 0) {
@@ -1412,7 +2494,7 @@ chi::u32 Runtime::ModifyExistingData(const std::vector<BlobBlock> &blocks,
       size_t data_buffer_offset = write_start_in_blob - data_offset_in_blob;
 
       HILOG(kDebug,
-            "ModifyExistingData: block[{}] - writing write_size={}, "
+            "IssueWrites: block[{}] - writing write_size={}, "
             "write_start_in_block={}, data_buffer_offset={}",
             block_idx, write_size, write_start_in_block, data_buffer_offset);
 
@@ -1422,12 +2504,14 @@ chi::u32 Runtime::ModifyExistingData(const std::vector<BlobBlock> &blocks,
       hipc::Pointer data_ptr = data + data_buffer_offset;
 
       chimaera::bdev::Client cte_clientcopy = block.bdev_client_;
-      auto write_task =
+      PendingBdevIo<chimaera::bdev::WriteTask> pending;
+      pending.task_ =
           cte_clientcopy.AsyncWrite(hipc::MemContext(), block.target_query_,
                                     bdev_block, data_ptr, write_size);
-
-      write_tasks.push_back(write_task);
-      expected_write_sizes.push_back(write_size);
+      pending.expected_size_ = write_size;
+      pending.target_id_ = block.bdev_client_.pool_id_;
+      pending.owner_ = owner;
+      writes.push_back(pending);
 
       // Step 6: Subtract the amount of data we have written from the
       // remaining_size
@@ -1437,52 +2521,64 @@ chi::u32 Runtime::ModifyExistingData(const std::vector<BlobBlock> &blocks,
     // Update block offset for next iteration
     block_offset_in_blob += block.size_;
   }
+}
 
-  // Step 7: Wait for all Async write operations to complete
-  HILOG(kDebug,
-        "ModifyExistingData: Waiting for {} async write tasks to complete",
-        write_tasks.size());
-  for (size_t task_idx = 0; task_idx < write_tasks.size(); ++task_idx) {
-    auto task = write_tasks[task_idx];
-    size_t expected_size = expected_write_sizes[task_idx];
-
-    task->Wait();
-
-    HILOG(kDebug,
-          "ModifyExistingData: task[{}] completed - bytes_written={}, "
-          "expected={}, status={}",
-          task_idx, task->bytes_written_, expected_size,
-          (task->bytes_written_ == expected_size ? "SUCCESS" : "FAILED"));
-
-    if (task->bytes_written_ != expected_size) {
-      CHI_IPC->DelTask(task);
+chi::u32 Runtime::WaitWrites(
+    std::vector<PendingBdevIo<chimaera::bdev::WriteTask>> &writes,
+    std::vector<bool> *owner_failed) {
+  // Wait for every write, even after a failure, so no task is leaked
+  HILOG(kDebug, "WaitWrites: Waiting for {} async write tasks to complete",
+        writes.size());
+  chi::u32 num_failed = 0;
+  for (auto &pending : writes) {
+    pending.task_->Wait();
+    chi::u64 bytes_written = pending.task_->bytes_written_;
+    if (bytes_written != pending.expected_size_) {
       HILOG(kError,
-            "ModifyExistingData: WRITE FAILED - task[{}] wrote {} bytes, "
-            "expected {}",
-            task_idx, task->bytes_written_, expected_size);
-      return 1;
+            "WaitWrites: WRITE FAILED - wrote {} bytes, expected {}",
+            bytes_written, pending.expected_size_);
+      ++num_failed;
+      if (owner_failed != nullptr) {
+        (*owner_failed)[pending.owner_] = true;
+      }
+    } else {
+      RecordTargetIo(pending.target_id_, pending.expected_size_, true);
     }
-
-    CHI_IPC->DelTask(task);
+    CHI_IPC->DelTask(pending.task_);
   }
-
-  HILOG(kDebug, "ModifyExistingData: All write tasks completed successfully");
-  return 0; // Success
+  writes.clear();
+  return num_failed;
 }
 
 chi::u32 Runtime::ReadData(const std::vector<BlobBlock> &blocks,
                            hipc::Pointer data, size_t data_size,
-                           size_t data_offset_in_blob) {
+                           size_t data_offset_in_blob, OpTimer *timer) {
   HILOG(kDebug, "ReadData: blocks={}, data_size={}, data_offset_in_blob={}",
         blocks.size(), data_size, data_offset_in_blob);
 
+  std::vector<PendingBdevIo<chimaera::bdev::ReadTask>> reads;
+  if (timer != nullptr) {
+    timer->Switch(StatPhase::kIo);
+  }
+  IssueReads(blocks, data, data_size, data_offset_in_blob, 0, reads);
+  if (timer != nullptr) {
+    timer->Switch(StatPhase::kWait);
+  }
+  if (WaitReads(reads, nullptr) != 0) {
+    return 1;
+  }
+
+  HILOG(kDebug, "ReadData: All read tasks completed successfully");
+  return 0; // Success
+}
+
+void Runtime::IssueReads(
+    const std::vector<BlobBlock> &blocks, hipc::Pointer data, size_t data_size,
+    size_t data_offset_in_blob, size_t owner,
+    std::vector<PendingBdevIo<chimaera::bdev::ReadTask>> &reads) {
   // Step 1: Initially store the remaining_size equal to data_size
   size_t remaining_size = data_size;
 
-  // Vector to store async read tasks for later waiting
-  std::vector<hipc::FullPtr<chimaera::bdev::ReadTask>> read_tasks;
-  std::vector<size_t> expected_read_sizes;
-
   // Step 2: Store the offset of the block in the blob. The first block is
   // offset 0
   size_t block_offset_in_blob = 0;
@@ -1490,9 +2586,6 @@ chi::u32 Runtime::ReadData(const std::vector<BlobBlock> &blocks,
   // Iterate over every block in the blob
   for (size_t block_idx = 0; block_idx < blocks.size(); ++block_idx) {
     const BlobBlock &block = blocks[block_idx];
-    HILOG(kDebug, "ReadData: block[{}] - target_offset={}, size={}, pool_id={}",
-          block_idx, block.target_offset_, block.size_,
-          block.bdev_client_.pool_id_.ToU64());
 
     // Step 7: If remaining size is 0, quit the for loop
     if (remaining_size == 0) {
@@ -1521,7 +2614,7 @@ chi::u32 Runtime::ReadData(const std::vector<BlobBlock> &blocks,
       size_t data_buffer_offset = read_start_in_blob - data_offset_in_blob;
 
       HILOG(kDebug,
-            "ReadData: block[{}] - reading read_size={}, "
+            "IssueReads: block[{}] - reading read_size={}, "
             "read_start_in_block={}, data_buffer_offset={}",
             block_idx, read_size, read_start_in_block, data_buffer_offset);
 
@@ -1531,12 +2624,14 @@ chi::u32 Runtime::ReadData(const std::vector<BlobBlock> &blocks,
       hipc::Pointer data_ptr = data + data_buffer_offset;
 
       chimaera::bdev::Client cte_clientcopy = block.bdev_client_;
-      auto read_task =
+      PendingBdevIo<chimaera::bdev::ReadTask> pending;
+      pending.task_ =
           cte_clientcopy.AsyncRead(hipc::MemContext(), block.target_query_,
                                    bdev_block, data_ptr, read_size);
-
-      read_tasks.push_back(read_task);
-      expected_read_sizes.push_back(read_size);
+      pending.expected_size_ = read_size;
+      pending.target_id_ = block.bdev_client_.pool_id_;
+      pending.owner_ = owner;
+      reads.push_back(pending);
 
       // Step 6: Subtract the amount of data we have read from the
       // remaining_size
@@ -1546,97 +2641,340 @@ chi::u32 Runtime::ReadData(const std::vector<BlobBlock> &blocks,
     // Update block offset for next iteration
     block_offset_in_blob += block.size_;
   }
+}
 
-  // Step 7: Wait for all Async read operations to complete
-  HILOG(kDebug, "ReadData: Waiting for {} async read tasks to complete",
-        read_tasks.size());
-  for (size_t task_idx = 0; task_idx < read_tasks.size(); ++task_idx) {
-    auto task = read_tasks[task_idx];
-    size_t expected_size = expected_read_sizes[task_idx];
-
-    task->Wait();
-
-    HILOG(
-        kDebug,
-        "ReadData: task[{}] completed - bytes_read={}, expected={}, status={}",
-        task_idx, task->bytes_read_, expected_size,
-        (task->bytes_read_ == expected_size ? "SUCCESS" : "FAILED"));
-
-    // Log first few bytes of data that was read for debugging
-    if (task->bytes_read_ > 0) {
-      hipc::Pointer read_data_ptr =
-          data + (task_idx > 0 ? expected_read_sizes[task_idx - 1] : 0);
-      char *read_data =
-          CHI_IPC->GetMainAllocator()->Convert<char>(read_data_ptr);
-      std::string data_preview = "data=[";
-      for (size_t i = 0; i < std::min(static_cast<size_t>(task->bytes_read_),
-                                      static_cast<size_t>(16));
-           ++i) {
-        if (i > 0)
-          data_preview += ",";
-        data_preview +=
-            std::to_string(static_cast<unsigned char>(read_data[i]));
-      }
-      if (task->bytes_read_ > 16)
-        data_preview += ",...";
-      data_preview += "]";
-      HILOG(kDebug, "ReadData: task[{}] - {}", task_idx, data_preview);
-    }
-
-    if (task->bytes_read_ != expected_size) {
-      CHI_IPC->DelTask(task);
-      HILOG(kError,
-            "ReadData: READ FAILED - task[{}] read {} bytes, expected {}",
-            task_idx, task->bytes_read_, expected_size);
-      return 1;
+chi::u32 Runtime::WaitReads(
+    std::vector<PendingBdevIo<chimaera::bdev::ReadTask>> &reads,
+    std::vector<bool> *owner_failed) {
+  // Wait for every read, even after a failure, so no task is leaked
+  HILOG(kDebug, "WaitReads: Waiting for {} async read tasks to complete",
+        reads.size());
+  chi::u32 num_failed = 0;
+  for (auto &pending : reads) {
+    pending.task_->Wait();
+    chi::u64 bytes_read = pending.task_->bytes_read_;
+    if (bytes_read != pending.expected_size_) {
+      HILOG(kError, "WaitReads: READ FAILED - read {} bytes, expected {}",
+            bytes_read, pending.expected_size_);
+      ++num_failed;
+      if (owner_failed != nullptr) {
+        (*owner_failed)[pending.owner_] = true;
+      }
+    } else {
+      RecordTargetIo(pending.target_id_, pending.expected_size_, false);
     }
+    CHI_IPC->DelTask(pending.task_);
+  }
+  reads.clear();
+  return num_failed;
+}
 
-    CHI_IPC->DelTask(task);
+void Runtime::RecordTargetIo(const chi::PoolId &target_id, chi::u64 bytes,
+                             bool is_write) {
+  size_t lock_index = GetTargetLockIndex(target_id);
+  chi::ScopedCoRwReadLock target_lock(*target_locks_[lock_index]);
+  TargetInfo *target_info = registered_targets_.find(target_id);
+  if (target_info == nullptr || !target_info->io_counters_) {
+    return; // Target was unregistered while the I/O was in flight
+  }
+  if (is_write) {
+    target_info->io_counters_->RecordWrite(bytes);
+  } else {
+    target_info->io_counters_->RecordRead(bytes);
   }
+}
 
-  HILOG(kDebug, "ReadData: All read tasks completed successfully");
-  return 0; // Success
+float Runtime::GetPlacementScore(const std::vector<BlobBlock> &blocks) {
+  double weighted_score = 0.0;
+  chi::u64 total_size = 0;
+  for (const auto &block : blocks) {
+    TargetInfo *target_info =
+        registered_targets_.find(block.bdev_client_.pool_id_);
+    if (target_info == nullptr) {
+      continue;
+    }
+    weighted_score += static_cast<double>(target_info->target_score_) *
+                      static_cast<double>(block.size_);
+    total_size += block.size_;
+  }
+  if (total_size == 0) {
+    return 0.0f;
+  }
+  return static_cast<float>(weighted_score / static_cast<double>(total_size));
 }
 
-// Block management helper functions
+bool Runtime::GetPreferredTargetScore(float blob_score, chi::u64 blob_size,
+                                      float &target_score) {
+  PlacementBuffer placement;
+  std::vector<chi::PoolId> &ordered_targets = *placement;
+  RefreshTargetSnapshot();
 
-bool Runtime::AllocateFromTarget(TargetInfo &target_info, chi::u64 size,
-                                 chi::u64 &allocated_offset) {
-  // Check if target has sufficient space
-  if (target_info.remaining_space_ < size) {
+  chi::ScopedCoRwReadLock snapshot_lock(target_snapshot_lock_);
+  DpeFactory::GetWorkerDpe(dpe_type_, config_.dpe_).SelectTargets(
+      target_snapshot_.targets_, blob_score, blob_size, ordered_targets);
+  if (ordered_targets.empty()) {
     return false;
   }
-
-  try {
-    // Use bdev client AllocateBlocks method to get actual offset
-    std::vector<chimaera::bdev::Block> allocated_blocks =
-        target_info.bdev_client_.AllocateBlocks(
-            hipc::MemContext(), target_info.target_query_, size);
-
-    // Check if we got any blocks
-    if (allocated_blocks.empty()) {
-      return false;
+  for (const auto &target : target_snapshot_.targets_) {
+    if (target.target_id_ == ordered_targets.front()) {
+      target_score = target.target_score_;
+      return true;
     }
+  }
+  return false;
+}
 
-    // Use the first block (for single allocation case)
-    chimaera::bdev::Block allocated_block = allocated_blocks[0];
-    allocated_offset = allocated_block.offset_;
-
-    // Update remaining space
-    target_info.remaining_space_ -= size;
-    // HILOG(kInfo,
-    //       "Allocated from target {}: offset={}, size={} remaining_space={}",
-    //       target_info.target_name_, allocated_offset, size,
-    //       target_info.remaining_space_);
+chi::u32 Runtime::MigrateBlob(const BlobKey &blob_key, BlobInfo &blob_info,
+                              float blob_score, chi::u64 &bytes_moved,
+                              const std::vector<chi::PoolId> &excluded_targets,
+                              OpTimer *timer) {
+  bytes_moved = 0;
+
+  // Step 1: Snapshot the block list; a blob being written is left for a
+  // later pass
+  size_t blob_lock_index = GetBlobLockIndex(blob_key);
+  chi::u64 gen_before;
+  std::vector<BlobBlock> source_blocks;
+  {
+    chi::ScopedCoRwReadLock blob_lock(*blob_locks_[blob_lock_index]);
+    if (blob_info.writers_ > 0) {
+      return 4;
+    }
+    gen_before = blob_info.write_gen_;
+    source_blocks = blob_info.blocks_;
+  }
+  chi::u64 blob_size = 0;
+  for (const auto &block : source_blocks) {
+    blob_size += block.size_;
+  }
+  if (blob_size == 0) {
+    return 0;
+  }
 
-    return true;
-  } catch (const std::exception &e) {
-    // Allocation failed
-    return false;
+  // Step 2: Allocate the destination blocks into a staging BlobInfo so the
+  // live blob keeps serving reads from its old blocks during the copy
+  BlobInfo staging;
+  if (timer != nullptr) {
+    timer->Switch(StatPhase::kAllocation);
+  }
+  if (AllocateNewData(staging, 0, blob_size, blob_score, excluded_targets) !=
+      0) {
+    FreeAllBlobBlocks(staging);
+    return 2;
   }
-}
+
+  // Step 3: Copy window by window; each window reads from the old blocks and
+  // writes to the new ones, so at most kMigrationWindowSize bytes are in
+  // flight regardless of blob size
+  chi::u64 window_size = std::min(blob_size, kMigrationWindowSize);
+  hipc::FullPtr<char> window = CHI_IPC->AllocateBuffer(window_size);
+  if (window.IsNull()) {
+    FreeAllBlobBlocks(staging);
+    return 1;
+  }
+  for (chi::u64 off = 0; off < blob_size; off += window_size) {
+    chi::u64 len = std::min(window_size, blob_size - off);
+    if (ReadData(source_blocks, window.shm_, len, off, timer) != 0 ||
+        ModifyExistingData(staging.blocks_, window.shm_, len, off, timer) !=
+            0) {
+      CHI_IPC->FreeBuffer(window);
+      FreeAllBlobBlocks(staging);
+      return 3;
+    }
+  }
+  CHI_IPC->FreeBuffer(window);
+
+  // Step 4: Swap the block lists unless a write was in flight or started or
+  // finished during the copy; a write can land in the old blocks or append
+  // to the list before it updates any timestamp
+  if (timer != nullptr) {
+    timer->Switch(StatPhase::kMetadata);
+  }
+  bool swapped = false;
+  {
+    chi::ScopedCoRwWriteLock blob_lock(*blob_locks_[blob_lock_index]);
+    if (blob_info.writers_ == 0 && blob_info.write_gen_ == gen_before) {
+      blob_info.blocks_.swap(staging.blocks_);
+      blob_info.score_ = blob_score;
+      ++blob_info.write_gen_;
+      swapped = true;
+      RetireBlocks(blob_info, staging);
+    }
+  }
+
+  // Step 5: staging now holds the blocks nobody references: the old blocks
+  // after a swap no read is using, or the discarded copy after a conflict
+  if (timer != nullptr) {
+    timer->Switch(StatPhase::kAllocation);
+  }
+  FreeAllBlobBlocks(staging);
+  if (!swapped) {
+    return 4;
+  }
+  bytes_moved = blob_size;
+  return 0;
+}
+
+chi::u32 Runtime::ShrinkBlob(const BlobKey &blob_key, BlobInfo &blob_info,
+                             chi::u64 new_size, chi::u64 &bytes_freed) {
+  bytes_freed = 0;
+
+  // Step 1: Snapshot the block list and split it at new_size; a blob being
+  // written is not shrunk
+  size_t blob_lock_index = GetBlobLockIndex(blob_key);
+  chi::u64 gen_before;
+  std::vector<BlobBlock> source_blocks;
+  {
+    chi::ScopedCoRwReadLock blob_lock(*blob_locks_[blob_lock_index]);
+    if (blob_info.writers_ > 0) {
+      return 4;
+    }
+    gen_before = blob_info.write_gen_;
+    source_blocks = blob_info.blocks_;
+  }
+  std::vector<BlobBlock> kept_blocks;
+  BlobInfo released; // Blocks nobody references once the new list is in
+  std::vector<BlobBlock> boundary; // Block straddling new_size, if any
+  chi::u64 boundary_keep = 0;
+  chi::u64 block_start = 0;
+  for (const auto &block : source_blocks) {
+    if (block_start + block.size_ <= new_size) {
+      kept_blocks.push_back(block);
+    } else if (block_start < new_size) {
+      boundary.push_back(block);
+      boundary_keep = new_size - block_start;
+    } else {
+      released.blocks_.push_back(block);
+    }
+    block_start += block.size_;
+  }
+  chi::u64 blob_size = block_start;
+  if (new_size >= blob_size) {
+    return 0;
+  }
+
+  // Step 2: bdev blocks are freed whole, so the kept head of the block
+  // straddling new_size is copied into a new block, preferably on the same
+  // target
+  size_t copy_begin = kept_blocks.size();
+  if (!boundary.empty()) {
+    BlobInfo trimmed;
+    TargetInfo *target_info =
+        registered_targets_.find(boundary[0].bdev_client_.pool_id_);
+    chi::u64 allocated_offset;
+    if (target_info != nullptr &&
+        AllocateFromTarget(*target_info, boundary_keep, allocated_offset)) {
+      trimmed.blocks_.emplace_back(target_info->bdev_client_,
+                                   target_info->target_query_,
+                                   allocated_offset, boundary_keep);
+    } else if (AllocateNewData(trimmed, 0, boundary_keep, blob_info.score_) !=
+               0) {
+      FreeAllBlobBlocks(trimmed);
+      return 2;
+    }
+
+    hipc::FullPtr<char> buffer = CHI_IPC->AllocateBuffer(boundary_keep);
+    if (buffer.IsNull()) {
+      FreeAllBlobBlocks(trimmed);
+      return 1;
+    }
+    bool copied =
+        ReadData(boundary, buffer.shm_, boundary_keep, 0) == 0 &&
+        ModifyExistingData(trimmed.blocks_, buffer.shm_, boundary_keep, 0) ==
+            0;
+    CHI_IPC->FreeBuffer(buffer);
+    if (!copied) {
+      FreeAllBlobBlocks(trimmed);
+      return 3;
+    }
+    kept_blocks.insert(kept_blocks.end(), trimmed.blocks_.begin(),
+                       trimmed.blocks_.end());
+    released.blocks_.push_back(boundary[0]);
+  }
+
+  // Step 3: Swap the block lists unless a write was in flight or started or
+  // finished during the copy, as in MigrateBlob; a write extending past
+  // new_size would otherwise have its blocks freed
+  bool swapped = false;
+  {
+    chi::ScopedCoRwWriteLock blob_lock(*blob_locks_[blob_lock_index]);
+    if (blob_info.writers_ == 0 && blob_info.write_gen_ == gen_before) {
+      blob_info.blocks_.swap(kept_blocks);
+      blob_info.last_modified_ = std::chrono::steady_clock::now();
+      ++blob_info.write_gen_;
+      swapped = true;
+      // Reads in flight may still be reading the tail; the last one frees it
+      RetireBlocks(blob_info, released);
+    }
+  }
+  if (!swapped) {
+    // The live list is untouched; only the copy made in step 2 is unused
+    released.blocks_.assign(kept_blocks.begin() + copy_begin,
+                            kept_blocks.end());
+  }
+  FreeAllBlobBlocks(released);
+  if (!swapped) {
+    return 4;
+  }
+  bytes_freed = blob_size - new_size;
+  return 0;
+}
+
+// Block management helper functions
+
+bool Runtime::AllocateFromTarget(TargetInfo &target_info, chi::u64 size,
+                                 chi::u64 &allocated_offset) {
+  // Check if target has sufficient space
+  if (target_info.remaining_space_ < size) {
+    return false;
+  }
+
+  try {
+    // Use bdev client AllocateBlocks method to get actual offset
+    std::vector<chimaera::bdev::Block> allocated_blocks =
+        target_info.bdev_client_.AllocateBlocks(
+            hipc::MemContext(), target_info.target_query_, size);
+
+    // Check if we got any blocks
+    if (allocated_blocks.empty()) {
+      return false;
+    }
+
+    // Use the first block (for single allocation case)
+    chimaera::bdev::Block allocated_block = allocated_blocks[0];
+    allocated_offset = allocated_block.offset_;
+
+    // Update remaining space
+    target_info.remaining_space_ -= size;
+    // HILOG(kInfo,
+    //       "Allocated from target {}: offset={}, size={} remaining_space={}",
+    //       target_info.target_name_, allocated_offset, size,
+    //       target_info.remaining_space_);
+
+    return true;
+  } catch (const std::exception &e) {
+    // Allocation failed
+    return false;
+  }
+}
+
+void Runtime::RetireBlocks(BlobInfo &blob_info, BlobInfo &released) {
+  if (blob_info.readers_ == 0) {
+    return;
+  }
+  blob_info.retired_blocks_.insert(blob_info.retired_blocks_.end(),
+                                   released.blocks_.begin(),
+                                   released.blocks_.end());
+  released.blocks_.clear();
+}
 
 chi::u32 Runtime::FreeAllBlobBlocks(BlobInfo &blob_info) {
+  // Blocks still retired when the blob goes away are freed with the rest
+  blob_info.blocks_.insert(blob_info.blocks_.end(),
+                           blob_info.retired_blocks_.begin(),
+                           blob_info.retired_blocks_.end());
+  blob_info.retired_blocks_.clear();
+
   // Map: PoolId -> (target_query, vector<Block>)
   std::unordered_map<chi::PoolId, std::pair<chi::PoolQuery,
                                             std::vector<chimaera::bdev::Block>>>
@@ -1672,6 +3010,23 @@ chi::u32 Runtime::FreeAllBlobBlocks(BlobInfo &blob_info) {
     }
   }
 
+  // Return the freed space to the owning targets
+  for (const auto &pool_entry : blocks_by_pool) {
+    chi::u64 freed_size = 0;
+    for (const auto &block : pool_entry.second.second) {
+      freed_size += block.size_;
+    }
+    size_t lock_index = GetTargetLockIndex(pool_entry.first);
+    chi::ScopedCoRwReadLock target_lock(*target_locks_[lock_index]);
+    TargetInfo *target_info = registered_targets_.find(pool_entry.first);
+    if (target_info != nullptr) {
+      target_info->remaining_space_ += freed_size;
+    }
+  }
+  if (!blocks_by_pool.empty()) {
+    InvalidateTargetSnapshot();
+  }
+
   // Clear all blocks
   blob_info.blocks_.clear();
   return 0;
@@ -1680,79 +3035,45 @@ chi::u32 Runtime::FreeAllBlobBlocks(BlobInfo &blob_info) {
 void Runtime::LogTelemetry(CteOp op, size_t off, size_t size,
                            const TagId &tag_id, const Timestamp &mod_time,
                            const Timestamp &read_time) {
-  // Increment atomic counter and get current logical time
-  std::uint64_t logical_time = telemetry_counter_.fetch_add(1) + 1;
-
-  // Create telemetry entry with logical time and enqueue it
-  CteTelemetry telemetry_entry(op, off, size, tag_id, mod_time, read_time,
-                               logical_time);
-
-  // Circular queue automatically overwrites oldest entries when full
-  telemetry_log_.push(telemetry_entry);
+  // The ring assigns the logical time and overwrites the oldest entry when
+  // full; pollers never remove entries, so producers never contend with them
+  telemetry_log_.Push(
+      CteTelemetry(op, off, size, tag_id, mod_time, read_time));
 }
 
 size_t Runtime::GetTelemetryQueueSize() { return telemetry_log_.GetSize(); }
 
-size_t Runtime::GetTelemetryEntries(std::vector<CteTelemetry> &entries,
-                                    size_t max_entries) {
+std::uint64_t Runtime::GetTelemetryEntries(std::vector<CteTelemetry> &entries,
+                                           std::uint64_t cursor,
+                                           size_t max_entries,
+                                           std::uint64_t &dropped) {
   entries.clear();
-  size_t queue_size = telemetry_log_.GetSize();
-  size_t entries_to_read = std::min(max_entries, queue_size);
-
-  entries.reserve(entries_to_read);
-
-  // Read entries by popping and re-pushing them (since peek may not be
-  // available)
-  std::vector<CteTelemetry> temp_entries;
-  temp_entries.reserve(entries_to_read);
-
-  // Pop entries temporarily
-  for (size_t i = 0; i < entries_to_read; ++i) {
-    CteTelemetry entry;
-    auto token = telemetry_log_.pop(entry);
-    if (!token.IsNull()) {
-      temp_entries.push_back(entry);
-    } else {
-      break; // Queue is empty
-    }
-  }
-
-  // Re-push entries back to queue (in reverse order to maintain order)
-  for (auto it = temp_entries.rbegin(); it != temp_entries.rend(); ++it) {
-    telemetry_log_.push(*it);
-  }
-
-  // Copy to output vector
-  entries = temp_entries;
-  return entries.size();
+  return telemetry_log_.Read(cursor, max_entries, entries, dropped);
 }
 
 void Runtime::PollTelemetryLog(hipc::FullPtr<PollTelemetryLogTask> task,
                                chi::RunContext &ctx) {
   try {
-    std::uint64_t minimum_logical_time = task->minimum_logical_time_;
+    std::uint64_t cursor = task->minimum_logical_time_;
 
-    // Get telemetry entries with logical time filtering
-    std::vector<CteTelemetry> all_entries;
-    size_t retrieved_count = GetTelemetryEntries(all_entries, 1000);
+    // Copy only entries logged after the caller's cursor
+    std::vector<CteTelemetry> new_entries;
+    std::uint64_t dropped = 0;
+    std::uint64_t next_cursor = GetTelemetryEntries(
+        new_entries, cursor, task->max_entries_, dropped);
 
-    // Filter entries by minimum logical time
     task->entries_.clear();
-    std::uint64_t max_logical_time = minimum_logical_time;
-
-    for (const auto &entry : all_entries) {
-      if (entry.logical_time_ >= minimum_logical_time) {
-        task->entries_.emplace_back(entry);
-        max_logical_time = std::max(max_logical_time, entry.logical_time_);
-      }
+    for (const auto &entry : new_entries) {
+      task->entries_.emplace_back(entry);
     }
 
-    task->last_logical_time_ = max_logical_time;
+    task->last_logical_time_ = next_cursor;
+    task->dropped_entries_ = dropped;
     task->return_code_.store(0);
 
   } catch (const std::exception &e) {
     task->return_code_.store(1);
-    task->last_logical_time_ = 0;
+    task->last_logical_time_ = task->minimum_logical_time_;
   }
   (void)ctx;
 }
@@ -1762,14 +3083,15 @@ void Runtime::GetBlobScore(hipc::FullPtr<GetBlobScoreTask> task,
   // Dynamic scheduling phase - determine routing
   if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
     task->pool_query_ =
-        HashBlobToContainer(task->tag_id_, task->blob_name_.str());
+        HashBlobToContainer(task->tag_id_, NameView(task->blob_name_));
     return;
   }
 
   try {
     // Extract input parameters
     TagId tag_id = task->tag_id_;
-    std::string blob_name = task->blob_name_.str();
+    BlobKey blob_key = BlobKey::View(tag_id, NameView(task->blob_name_));
+    std::string_view blob_name = blob_key.GetName();
 
     // Validate that blob_name is provided
     if (blob_name.empty()) {
@@ -1778,7 +3100,7 @@ void Runtime::GetBlobScore(hipc::FullPtr<GetBlobScoreTask> task,
     }
 
     // Step 1: Check if blob exists
-    BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
+    BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
 
     if (blob_info_ptr == nullptr) {
       task->return_code_.store(1); // Blob not found
@@ -1812,14 +3134,15 @@ void Runtime::GetBlobSize(hipc::FullPtr<GetBlobSizeTask> task,
   // Dynamic scheduling phase - determine routing
   if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
     task->pool_query_ =
-        HashBlobToContainer(task->tag_id_, task->blob_name_.str());
+        HashBlobToContainer(task->tag_id_, NameView(task->blob_name_));
     return;
   }
 
   try {
     // Extract input parameters
     TagId tag_id = task->tag_id_;
-    std::string blob_name = task->blob_name_.str();
+    BlobKey blob_key = BlobKey::View(tag_id, NameView(task->blob_name_));
+    std::string_view blob_name = blob_key.GetName();
 
     // Validate that blob_name is provided
     if (blob_name.empty()) {
@@ -1828,7 +3151,7 @@ void Runtime::GetBlobSize(hipc::FullPtr<GetBlobSizeTask> task,
     }
 
     // Step 1: Check if blob exists
-    BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
+    BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
     if (blob_info_ptr == nullptr) {
       task->return_code_.store(1); // Blob not found
       return;
@@ -1878,21 +3201,19 @@ void Runtime::GetContainedBlobs(hipc::FullPtr<GetContainedBlobsTask> task,
     // Clear output vector
     task->blob_names_.clear();
 
-    // Construct prefix for this tag's blobs
-    std::string prefix = std::to_string(tag_id.major_) + "." +
-                         std::to_string(tag_id.minor_) + ".";
-
-    // Iterate through tag_blob_name_to_info_ and filter by prefix
-    tag_blob_name_to_info_.for_each(
-        [&prefix, &task](const std::string &composite_key,
-                         const BlobInfo &blob_info) {
-          // Check if composite key starts with the tag prefix
-          if (composite_key.rfind(prefix, 0) == 0) {
-            // Extract blob name (everything after the prefix)
-            std::string blob_name = composite_key.substr(prefix.length());
-            task->blob_names_.emplace_back(blob_name.c_str());
-          }
-        });
+    // Copy one page of this tag's blob names from the per-tag index. A full
+    // page leaves the cursor on its last name; the cursor is the name itself.
+    size_t max_results = task->max_results_;
+    std::vector<std::string> blob_names =
+        GetTagBlobNames(tag_id, task->cursor_.str(), max_results);
+    for (const auto &blob_name : blob_names) {
+      task->blob_names_.emplace_back(blob_name.c_str());
+    }
+    std::string next_cursor;
+    if (max_results != 0 && blob_names.size() == max_results) {
+      next_cursor = blob_names.back();
+    }
+    task->next_cursor_ = hipc::string(task->GetCtxAllocator(), next_cursor);
 
     // Success
     task->return_code_.store(0);
@@ -1918,28 +3239,30 @@ void Runtime::TagQuery(hipc::FullPtr<TagQueryTask> task, chi::RunContext &ctx) {
     return;
   }
 
+  OpTimer timer(runtime_stats_, StatOp::kTagQuery);
   try {
     std::string tag_regex = task->tag_regex_.str();
-    std::vector<std::string> matching_tags;
-
-    // Create regex pattern
-    std::regex pattern(tag_regex);
-
-    // Iterate over tag table and find matching tags
-    tag_name_to_id_.for_each(
-        [&pattern, &matching_tags](const std::string &tag_name,
-                                   const TagId &tag_id) {
-          (void)tag_id; // Suppress unused parameter warning
-          if (std::regex_match(tag_name, pattern)) {
-            matching_tags.push_back(tag_name);
-          }
-        });
+
+    // Compiled once per distinct pattern
+    std::shared_ptr<const CompiledPattern> pattern =
+        query_patterns_.Get(tag_regex);
+
+    // Scan only the index range sharing the pattern's literal prefix,
+    // resuming after the cursor (the last name of the previous page)
+    size_t max_results = task->max_results_;
+    std::vector<std::string> matching_tags =
+        FindTagNames(*pattern, task->cursor_.str(), max_results);
 
     // Copy results to task output
     task->tag_names_.clear();
     for (const auto &tag_name : matching_tags) {
       task->tag_names_.emplace_back(tag_name.c_str());
     }
+    std::string next_cursor;
+    if (max_results != 0 && matching_tags.size() == max_results) {
+      next_cursor = matching_tags.back();
+    }
+    task->next_cursor_ = hipc::string(task->GetCtxAllocator(), next_cursor);
 
     // Success
     task->return_code_.store(0);
@@ -1960,47 +3283,90 @@ void Runtime::BlobQuery(hipc::FullPtr<BlobQueryTask> task,
     return;
   }
 
+  OpTimer timer(runtime_stats_, StatOp::kBlobQuery);
   try {
     std::string tag_regex = task->tag_regex_.str();
     std::string blob_regex = task->blob_regex_.str();
 
-    // Create regex patterns
-    std::regex tag_pattern(tag_regex);
-    std::regex blob_pattern(blob_regex);
-
-    // Find matching tag IDs
-    std::vector<TagId> matching_tag_ids;
-    tag_name_to_id_.for_each(
-        [&tag_pattern, &matching_tag_ids](const std::string &tag_name,
-                                          const TagId &tag_id) {
-          if (std::regex_match(tag_name, tag_pattern)) {
-            matching_tag_ids.push_back(tag_id);
-          }
-        });
+    // Compiled once per distinct pattern
+    std::shared_ptr<const CompiledPattern> tag_pattern =
+        query_patterns_.Get(tag_regex);
+    std::shared_ptr<const CompiledPattern> blob_pattern =
+        query_patterns_.Get(blob_regex);
+
+    // The cursor names the tag and blob the previous page ended on
+    std::string cursor_tag;
+    std::string cursor_blob;
+    if (!task->cursor_.str().empty() &&
+        !DecodeBlobQueryCursor(task->cursor_.str(), cursor_tag, cursor_blob)) {
+      task->return_code_.store(2); // Malformed cursor
+      return;
+    }
+
+    // Tags in name order: the cursor's tag (if it still matches), then the
+    // matching tags after it from the index range sharing the literal prefix
+    std::vector<std::string> tag_names;
+    if (!cursor_tag.empty() && tag_pattern->Match(cursor_tag)) {
+      tag_names.push_back(cursor_tag);
+    }
+    for (auto &tag_name : FindTagNames(*tag_pattern, cursor_tag)) {
+      tag_names.push_back(std::move(tag_name));
+    }
 
-    // Find blobs in matching tags
+    // Find blobs in matching tags, stopping once the page is full. A paged
+    // query reads each tag's blob index in batches so a page costs about
+    // as much as the names it scans.
+    size_t max_results = task->max_results_;
+    size_t scan_batch = max_results == 0 ? 0 : kQueryScanBatch;
     std::vector<std::string> matching_blobs;
-    for (const auto &tag_id : matching_tag_ids) {
-      // Construct prefix for this tag's blobs
-      std::string prefix = std::to_string(tag_id.major_) + "." +
-                           std::to_string(tag_id.minor_) + ".";
-
-      // Iterate through tag_blob_name_to_info_ and filter by prefix
-      tag_blob_name_to_info_.for_each(
-          [&prefix, &blob_pattern, &matching_blobs](
-              const std::string &composite_key, const BlobInfo &blob_info) {
-            (void)blob_info; // Suppress unused parameter warning
-            // Check if composite key starts with the tag prefix
-            if (composite_key.rfind(prefix, 0) == 0) {
-              // Extract blob name (everything after the prefix)
-              std::string blob_name = composite_key.substr(prefix.length());
-
-              // Check if blob name matches regex
-              if (std::regex_match(blob_name, blob_pattern)) {
-                matching_blobs.push_back(blob_name);
-              }
+    std::string next_cursor;
+
+    // Metadata predicates and stats are read from the blob table in the same
+    // pass; plain name queries never touch it
+    const BlobQueryPredicate &predicate = task->predicate_;
+    bool with_stats = task->with_stats_;
+    bool read_metadata = with_stats || predicate.IsSet();
+    auto now = std::chrono::steady_clock::now();
+    std::vector<BlobQueryStat> matching_stats;
+    for (const auto &tag_name : tag_names) {
+      TagId *tag_id_ptr = tag_name_to_id_.find(tag_name);
+      if (tag_id_ptr == nullptr) {
+        continue;
+      }
+      TagId tag_id = *tag_id_ptr;
+      std::string after = (tag_name == cursor_tag) ? cursor_blob : "";
+      while (next_cursor.empty()) {
+        // Only visit the blobs indexed under this tag
+        std::vector<std::string> blob_names =
+            GetTagBlobNames(tag_id, after, scan_batch);
+        for (auto &blob_name : blob_names) {
+          if (!blob_pattern->Match(blob_name)) {
+            continue;
+          }
+          if (read_metadata) {
+            BlobQueryStat stat;
+            if (!EvalBlobPredicate(BlobKey(tag_id, blob_name), predicate, now,
+                                   stat)) {
+              continue;
             }
-          });
+            if (with_stats) {
+              matching_stats.push_back(stat);
+            }
+          }
+          matching_blobs.push_back(blob_name);
+          if (max_results != 0 && matching_blobs.size() == max_results) {
+            next_cursor = EncodeBlobQueryCursor(tag_name, blob_name);
+            break;
+          }
+        }
+        if (scan_batch == 0 || blob_names.size() < scan_batch) {
+          break;
+        }
+        after = blob_names.back();
+      }
+      if (!next_cursor.empty()) {
+        break;
+      }
     }
 
     // Copy results to task output
@@ -2008,6 +3374,11 @@ void Runtime::BlobQuery(hipc::FullPtr<BlobQueryTask> task,
     for (const auto &blob_name : matching_blobs) {
       task->blob_names_.emplace_back(blob_name.c_str());
     }
+    task->blob_stats_.clear();
+    for (const auto &stat : matching_stats) {
+      task->blob_stats_.emplace_back(stat);
+    }
+    task->next_cursor_ = hipc::string(task->GetCtxAllocator(), next_cursor);
 
     // Success
     task->return_code_.store(0);
@@ -2022,24 +3393,1304 @@ void Runtime::BlobQuery(hipc::FullPtr<BlobQueryTask> task,
   }
 }
 
-// ==============================================================================
-// Helper Functions for Dynamic Scheduling
-// ==============================================================================
+void Runtime::ReorganizeTiers(hipc::FullPtr<ReorganizeTiersTask> task,
+                              chi::RunContext &ctx) {
+  // Dynamic scheduling phase - determine routing
+  if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
+    task->pool_query_ = chi::PoolQuery::Broadcast();
+    return;
+  }
 
-chi::PoolQuery Runtime::HashBlobToContainer(const TagId &tag_id,
-                                            const std::string &blob_name) {
-  // Compute hash from tag_id and blob_name
-  std::hash<std::string> string_hasher;
-  std::hash<chi::u32> u32_hasher;
+  try {
+    const Config &config = GetConfig();
+    float score_threshold = config.performance_.score_threshold_;
+    float score_difference_threshold =
+        config.performance_.score_difference_threshold_;
+    task->blobs_promoted_ = 0;
+    task->blobs_demoted_ = 0;
+    task->bytes_moved_ = 0;
+
+    // Step 1: Snapshot the tags that have blobs on this container
+    std::vector<TagId> tag_ids = GetIndexedTagIds();
+
+    // Step 2: Collect blobs whose placement disagrees with their score.
+    // Blobs at or above score_threshold may only move up, blobs below it may
+    // only move down, and either must get closer by score_difference_threshold
+    struct Candidate {
+      BlobKey blob_key_;
+      float gain_;
+      bool promote_;
+    };
+    std::vector<Candidate> candidates;
+    for (const auto &tag_id : tag_ids) {
+      for (auto &blob_name : GetTagBlobNames(tag_id)) {
+        BlobKey blob_key(tag_id, std::move(blob_name));
+        BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
+        if (blob_info_ptr == nullptr) {
+          continue;
+        }
+        chi::u64 blob_size = blob_info_ptr->GetTotalSize();
+        if (blob_size == 0) {
+          continue;
+        }
+        float blob_score = blob_info_ptr->score_;
+        float placement_score = GetPlacementScore(blob_info_ptr->blocks_);
+        float preferred_score = 0.0f;
+        if (!GetPreferredTargetScore(blob_score, blob_size, preferred_score)) {
+          continue;
+        }
+        bool promote = blob_score >= score_threshold;
+        if (promote ? preferred_score <= placement_score
+                    : preferred_score >= placement_score) {
+          continue;
+        }
+        float gain = std::abs(placement_score - blob_score) -
+                     std::abs(preferred_score - blob_score);
+        if (gain < score_difference_threshold) {
+          continue;
+        }
+        candidates.push_back(Candidate{std::move(blob_key), gain, promote});
+      }
+    }
 
-  // Combine tag_id major, minor, and blob_name into a single hash
-  chi::u32 hash_value = u32_hasher(tag_id.major_);
-  hash_value ^= u32_hasher(tag_id.minor_) + 0x9e3779b9 + (hash_value << 6) +
-                (hash_value >> 2);
-  hash_value ^= static_cast<chi::u32>(string_hasher(blob_name)) + 0x9e3779b9 +
-                (hash_value << 6) + (hash_value >> 2);
+    // Step 3: Migrate the most misplaced blobs first, up to max_blobs_
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate &a, const Candidate &b) {
+                return a.gain_ > b.gain_;
+              });
+    if (task->max_blobs_ > 0 && candidates.size() > task->max_blobs_) {
+      candidates.resize(task->max_blobs_);
+    }
+
+    for (const auto &candidate : candidates) {
+      BlobInfo *blob_info_ptr = CheckBlobExists(candidate.blob_key_);
+      if (blob_info_ptr == nullptr) {
+        continue; // Deleted since the scan
+      }
+      chi::u64 bytes_moved = 0;
+      chi::u32 migrate_result =
+          MigrateBlob(candidate.blob_key_, *blob_info_ptr,
+                      blob_info_ptr->score_, bytes_moved);
+      if (migrate_result != 0) {
+        HILOG(kDebug, "ReorganizeTiers: skipped blob={} (code {})",
+              candidate.blob_key_.blob_name_, migrate_result);
+        continue;
+      }
+      if (candidate.promote_) {
+        ++task->blobs_promoted_;
+      } else {
+        ++task->blobs_demoted_;
+      }
+      task->bytes_moved_ += bytes_moved;
+    }
+
+    task->return_code_.store(0);
+    HILOG(kDebug,
+          "ReorganizeTiers: candidates={}, promoted={}, demoted={}, bytes={}",
+          candidates.size(), task->blobs_promoted_, task->blobs_demoted_,
+          task->bytes_moved_);
+
+  } catch (const std::exception &e) {
+    task->return_code_.store(1);
+    HILOG(kError, "ReorganizeTiers failed: {}", e.what());
+  }
+}
+
+void Runtime::EnforceWatermarks(hipc::FullPtr<EnforceWatermarksTask> task,
+                                chi::RunContext &ctx) {
+  // Dynamic scheduling phase - determine routing
+  if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
+    task->pool_query_ = chi::PoolQuery::Broadcast();
+    return;
+  }
+
+  try {
+    task->targets_over_ = 0;
+    task->blobs_demoted_ = 0;
+    task->bytes_moved_ = 0;
+
+    // Step 1: Find targets above their high watermark and how many bytes each
+    // must shed to get back under its low watermark
+    struct Pressure {
+      chi::PoolId target_id_;
+      float target_score_;
+      chi::u64 to_free_;
+    };
+    std::vector<Pressure> pressured;
+    registered_targets_.for_each(
+        [&pressured](const chi::PoolId &target_id,
+                     const TargetInfo &target_info) {
+          double total = static_cast<double>(target_info.total_space_);
+          chi::u64 used =
+              target_info.total_space_ - target_info.remaining_space_;
+          if (target_info.total_space_ == 0 ||
+              static_cast<double>(used) <=
+                  total * target_info.high_watermark_) {
+            return;
+          }
+          auto low_mark =
+              static_cast<chi::u64>(total * target_info.low_watermark_);
+          pressured.push_back(
+              Pressure{target_id, target_info.target_score_, used - low_mark});
+        });
+    task->targets_over_ = static_cast<chi::u32>(pressured.size());
+    if (pressured.empty()) {
+      task->return_code_.store(0);
+      return;
+    }
+
+    auto find_pressure = [&pressured](const chi::PoolId &target_id) {
+      for (auto &pressure : pressured) {
+        if (pressure.target_id_ == target_id) {
+          return &pressure;
+        }
+      }
+      return static_cast<Pressure *>(nullptr);
+    };
+
+    // Step 2: Collect blobs holding data on those targets, coldest first:
+    // lowest score, then least recently read
+    struct Candidate {
+      BlobKey blob_key_;
+      float score_;
+      Timestamp last_read_;
+    };
+    std::vector<Candidate> candidates;
+    std::vector<TagId> tag_ids = GetIndexedTagIds();
+    for (const auto &tag_id : tag_ids) {
+      for (auto &blob_name : GetTagBlobNames(tag_id)) {
+        BlobKey blob_key(tag_id, std::move(blob_name));
+        BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
+        if (blob_info_ptr == nullptr) {
+          continue;
+        }
+        // A blob being written is neither cold nor movable (MigrateBlob
+        // refuses it); its block list is read under the blob lock
+        bool on_pressured = false;
+        {
+          chi::ScopedCoRwReadLock blob_lock(
+              *blob_locks_[GetBlobLockIndex(blob_key)]);
+          if (blob_info_ptr->writers_ > 0) {
+            continue;
+          }
+          for (const auto &block : blob_info_ptr->blocks_) {
+            if (find_pressure(block.bdev_client_.pool_id_) != nullptr) {
+              on_pressured = true;
+              break;
+            }
+          }
+        }
+        if (on_pressured) {
+          candidates.push_back(Candidate{std::move(blob_key),
+                                         blob_info_ptr->score_,
+                                         blob_info_ptr->last_read_});
+        }
+      }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate &a, const Candidate &b) {
+                if (a.score_ != b.score_) {
+                  return a.score_ < b.score_;
+                }
+                return a.last_read_ < b.last_read_;
+              });
+
+    // Step 3: Demote until every pressured target is under its low watermark.
+    // A blob may not land on a pressured target or on anything faster than
+    // the target it is being drained from
+    std::vector<chi::PoolId> excluded;
+    for (const auto &candidate : candidates) {
+      if (task->max_blobs_ > 0 && task->blobs_demoted_ >= task->max_blobs_) {
+        break;
+      }
+      bool pending = false;
+      for (const auto &pressure : pressured) {
+        pending = pending || pressure.to_free_ > 0;
+      }
+      if (!pending) {
+        break;
+      }
+
+      BlobInfo *blob_info_ptr = CheckBlobExists(candidate.blob_key_);
+      if (blob_info_ptr == nullptr) {
+        continue; // Deleted since the scan
+      }
+
+      // Bytes this blob frees on each pressured target if it moves
+      std::vector<std::pair<Pressure *, chi::u64>> freed;
+      float source_score = 0.0f;
+      bool helps = false;
+      {
+        chi::ScopedCoRwReadLock blob_lock(
+            *blob_locks_[GetBlobLockIndex(candidate.blob_key_)]);
+        for (const auto &block : blob_info_ptr->blocks_) {
+          Pressure *pressure = find_pressure(block.bdev_client_.pool_id_);
+          if (pressure == nullptr) {
+            continue;
+          }
+          freed.emplace_back(pressure, block.size_);
+          if (pressure->to_free_ > 0) {
+            helps = true;
+            source_score = std::max(source_score, pressure->target_score_);
+          }
+        }
+      }
+      if (!helps) {
+        continue;
+      }
+
+      excluded.clear();
+      for (const auto &pressure : pressured) {
+        excluded.push_back(pressure.target_id_);
+      }
+      registered_targets_.for_each(
+          [&excluded, source_score](const chi::PoolId &target_id,
+                                    const TargetInfo &target_info) {
+            if (target_info.target_score_ > source_score) {
+              excluded.push_back(target_id);
+            }
+          });
+
+      chi::u64 bytes_moved = 0;
+      chi::u32 migrate_result =
+          MigrateBlob(candidate.blob_key_, *blob_info_ptr,
+                      blob_info_ptr->score_, bytes_moved, excluded);
+      if (migrate_result != 0) {
+        HILOG(kDebug, "EnforceWatermarks: could not demote blob={} (code {})",
+              candidate.blob_key_.blob_name_, migrate_result);
+        continue;
+      }
+      for (auto &entry : freed) {
+        entry.first->to_free_ -= std::min(entry.first->to_free_, entry.second);
+      }
+      ++task->blobs_demoted_;
+      task->bytes_moved_ += bytes_moved;
+    }
+
+    task->return_code_.store(0);
+    HILOG(kDebug,
+          "EnforceWatermarks: targets_over={}, demoted={}, bytes={}",
+          task->targets_over_, task->blobs_demoted_, task->bytes_moved_);
+
+  } catch (const std::exception &e) {
+    task->return_code_.store(1);
+    HILOG(kError, "EnforceWatermarks failed: {}", e.what());
+  }
+}
+
+void Runtime::GetRuntimeStats(hipc::FullPtr<GetRuntimeStatsTask> task,
+                              chi::RunContext &ctx) {
+  // Dynamic scheduling phase - determine routing
+  if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
+    task->pool_query_ = chi::PoolQuery::Broadcast();
+    return;
+  }
+
+  try {
+    // Step 1: Summarize every latency series that has samples
+    std::vector<LatencySummary> summaries;
+    runtime_stats_.Summarize(summaries);
+    if (task->reset_) {
+      runtime_stats_.Reset();
+    }
+    task->latencies_.clear();
+    for (const auto &summary : summaries) {
+      task->latencies_.push_back(summary);
+    }
+
+    // Step 2: Snapshot the I/O counters of each registered target
+    task->targets_.clear();
+    registered_targets_.for_each(
+        [&task](const chi::PoolId &target_id, const TargetInfo &target_info) {
+          TargetIoStats stats;
+          stats.target_id_ = target_id;
+          stats.remaining_space_ = target_info.remaining_space_;
+          if (target_info.io_counters_) {
+            const TargetIoCounters &counters = *target_info.io_counters_;
+            stats.bytes_read_ = counters.bytes_read_.load();
+            stats.bytes_written_ = counters.bytes_written_.load();
+            stats.ops_read_ = counters.ops_read_.load();
+            stats.ops_written_ = counters.ops_written_.load();
+            stats.blocks_allocated_ = counters.blocks_allocated_.load();
+          }
+          stats.is_local_ = target_info.is_local_;
+          task->targets_.push_back(stats);
+        });
+
+    task->return_code_.store(0);
+  } catch (const std::exception &e) {
+    HELOG(kError, "GetRuntimeStats failed: {}", e.what());
+    task->return_code_.store(1);
+  }
+}
+
+void Runtime::StageIn(hipc::FullPtr<StageInTask> task, chi::RunContext &ctx) {
+  // Dynamic scheduling phase - determine routing
+  if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
+    task->pool_query_ = chi::PoolQuery::Local();
+    return;
+  }
+
+  // Bytes read from the file per PutBlobs batch, and batches in flight
+  static constexpr chi::u64 kStageInWindow = 16ULL * 1024 * 1024;
+  static constexpr size_t kStageInDepth = 4;
+
+  struct StagedWindow {
+    hipc::FullPtr<PutBlobsTask> task_;
+    hipc::FullPtr<char> buffer_;
+  };
+  std::deque<StagedWindow> in_flight;
+  bool failed = false;
+  auto retire = [&](StagedWindow &window) {
+    window.task_->Wait();
+    for (const auto &entry : window.task_->entries_) {
+      if (entry.return_code_ == 0) {
+        ++task->pages_staged_;
+        task->bytes_staged_ += entry.size_;
+      } else {
+        failed = true;
+      }
+    }
+    CHI_IPC->DelTask(window.task_);
+    CHI_IPC->FreeBuffer(window.buffer_);
+  };
+
+  int fd = -1;
+  try {
+    std::string path = task->path_.str();
+    chi::u64 page_size = task->page_size_;
+    task->pages_staged_ = 0;
+    task->bytes_staged_ = 0;
+    if (path.empty() || page_size == 0) {
+      task->return_code_.store(2); // Error: Invalid path or page size
+      return;
+    }
+
+    // Step 1: Open the backing file and clamp the range to its size
+    fd = open(path.c_str(), O_RDONLY);
+    struct stat file_stat;
+    if (fd < 0 || fstat(fd, &file_stat) != 0) {
+      HELOG(kError, "StageIn: cannot open {}", path);
+      if (fd >= 0) {
+        close(fd);
+      }
+      task->return_code_.store(3); // Error: Backing file unavailable
+      return;
+    }
+    chi::u64 file_size = static_cast<chi::u64>(file_stat.st_size);
+    chi::u64 begin = (task->offset_ / page_size) * page_size;
+    chi::u64 end = (task->size_ == 0)
+                       ? file_size
+                       : std::min(file_size, task->offset_ + task->size_);
+    chi::u64 window_size =
+        std::max(page_size, (kStageInWindow / page_size) * page_size);
+
+    // Step 2: Read the range a window at a time and store each window's
+    // pages with one PutBlobs, keeping a few windows in flight
+    TagId tag_id = client_.GetOrCreateTag(hipc::MemContext(), path);
+    for (chi::u64 off = begin; off < end && !failed; off += window_size) {
+      chi::u64 len = std::min(window_size, end - off);
+      hipc::FullPtr<char> buffer = CHI_IPC->AllocateBuffer(len);
+      if (buffer.IsNull()) {
+        failed = true;
+        break;
+      }
+      chi::u64 got = 0;
+      while (got < len) {
+        ssize_t ret = pread(fd, buffer.ptr_ + got, len - got, off + got);
+        if (ret <= 0) {
+          break;
+        }
+        got += static_cast<chi::u64>(ret);
+      }
+      if (got == 0) {
+        CHI_IPC->FreeBuffer(buffer);
+        break;
+      }
+
+      std::vector<BlobIoRequest> requests;
+      for (chi::u64 page_off = 0; page_off < got; page_off += page_size) {
+        chi::u64 page_len = std::min(page_size, got - page_off);
+        requests.emplace_back(std::to_string((off + page_off) / page_size), 0,
+                              page_len, buffer.shm_ + page_off, task->score_);
+      }
+      in_flight.push_back({client_.AsyncPutBlobs(hipc::MemContext(), tag_id,
+                                                 requests, kPutBlobIfAbsent),
+                           buffer});
+      if (in_flight.size() > kStageInDepth) {
+        retire(in_flight.front());
+        in_flight.pop_front();
+      }
+      if (got < len) {
+        break; // File shrank while staging
+      }
+    }
+  } catch (const std::exception &e) {
+    HELOG(kError, "StageIn failed: {}", e.what());
+    failed = true;
+  }
+
+  // Step 3: Wait for the remaining windows
+  for (auto &window : in_flight) {
+    retire(window);
+  }
+  if (fd >= 0) {
+    close(fd);
+  }
+  task->return_code_.store(failed ? 1 : 0);
+}
+
+void Runtime::FlushTag(hipc::FullPtr<FlushTagTask> task, chi::RunContext &ctx) {
+  // Dynamic scheduling phase - determine routing
+  if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
+    task->pool_query_ = chi::PoolQuery::Broadcast();
+    return;
+  }
+
+  OpTimer timer(runtime_stats_, StatOp::kFlushTag);
+  auto start = std::chrono::steady_clock::now();
+  chi::u32 result = 0;
+  try {
+    TagId tag_id = task->tag_id_;
+    bool flush_all = tag_id.IsNull();
+    task->pages_flushed_ = 0;
+    task->bytes_flushed_ = 0;
+    task->failed_pages_ = 0;
+    if (!flush_all) {
+      std::string path = task->path_.str();
+      if (path.empty() || task->page_size_ == 0) {
+        task->return_code_.store(2); // Error: Invalid path or page size
+        return;
+      }
+      RegisterDirtyFile(tag_id, path, task->page_size_);
+    }
+
+    // Step 1: Take the dirty ranges of registered files; ranges written from
+    // here on are marked dirty again and go out with the next flush
+    std::vector<std::pair<TagId, DirtyFile>> work;
+    {
+      std::lock_guard<std::mutex> lock(dirty_mutex_);
+      for (auto &kv : dirty_files_) {
+        if ((flush_all || kv.first == tag_id) && !kv.second.path_.empty() &&
+            !kv.second.pages_.empty()) {
+          DirtyFile file;
+          file.path_ = kv.second.path_;
+          file.page_size_ = kv.second.page_size_;
+          file.pages_.swap(kv.second.pages_);
+          work.emplace_back(kv.first, std::move(file));
+        }
+      }
+    }
+
+    // Step 2: Write each file back
+    timer.Switch(StatPhase::kIo);
+    bool durable = (task->flags_ & kFlushDurable) != 0;
+    for (const auto &item : work) {
+      result |= FlushDirtyFile(item.first, item.second, durable,
+                               task->pages_flushed_, task->bytes_flushed_,
+                               task->failed_pages_);
+    }
+  } catch (const std::exception &e) {
+    HELOG(kError, "FlushTag failed: {}", e.what());
+    result = 1;
+  }
+
+  task->elapsed_ns_ = static_cast<chi::u64>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count());
+  if (task->bytes_flushed_ > 0) {
+    double seconds = static_cast<double>(task->elapsed_ns_) / 1e9;
+    HILOG(kDebug, "Flushed {} pages ({} bytes) in {} ms ({} MB/s)",
+          task->pages_flushed_, task->bytes_flushed_, seconds * 1e3,
+          (static_cast<double>(task->bytes_flushed_) / (1024.0 * 1024.0)) /
+              seconds);
+  }
+  task->return_code_.store(result == 0 ? 0 : 1);
+}
+
+void Runtime::MarkPageDirty(const TagId &tag_id, std::string_view blob_name,
+                            chi::u64 offset, chi::u64 size) {
+  chi::u64 page_index;
+  if (size == 0 || !ParsePageIndex(blob_name, page_index)) {
+    return;
+  }
+  // Only tags with a registered backing file are ever flushed; tracking any
+  // other tag with numeric blob names would grow without bound
+  std::lock_guard<std::mutex> lock(dirty_mutex_);
+  auto it = dirty_files_.find(tag_id);
+  if (it == dirty_files_.end()) {
+    return;
+  }
+  AddDirtyRange(it->second.pages_[page_index], offset, offset + size);
+}
+
+void Runtime::RegisterDirtyFile(const TagId &tag_id, const std::string &path,
+                                chi::u64 page_size) {
+  std::lock_guard<std::mutex> lock(dirty_mutex_);
+  DirtyFile &file = dirty_files_[tag_id];
+  file.path_ = path;
+  file.page_size_ = page_size;
+}
+
+chi::u32 Runtime::FlushDirtyFile(const TagId &tag_id, const DirtyFile &file,
+                                 bool durable, chi::u64 &pages_flushed,
+                                 chi::u64 &bytes_flushed,
+                                 chi::u64 &failed_pages) {
+  // One dirty range of a page, clamped to the page's current size
+  struct DirtySpan {
+    chi::u64 page_index_;
+    chi::u64 begin_;
+    chi::u64 end_;
+  };
+
+  // A run of spans contiguous in the file, read with one GetBlobs and written
+  // with one pwrite
+  struct FlushRun {
+    chi::u64 file_offset_ = 0;
+    chi::u64 size_ = 0;
+    std::vector<DirtySpan> spans_;
+    std::vector<BlobIoRequest> requests_;
+    hipc::FullPtr<GetBlobsTask> task_;
+    hipc::FullPtr<char> buffer_;
+  };
+
+  std::set<chi::u64> flushed;
+  std::vector<DirtySpan> failed;
+  auto redirty = [&](const std::vector<DirtySpan> &spans) {
+    failed.insert(failed.end(), spans.begin(), spans.end());
+  };
+
+  // The file is not created here: a file removed since its pages were
+  // written has nothing left to flush to
+  int fd = open(file.path_.c_str(), O_WRONLY);
+  if (fd < 0) {
+    HILOG(kDebug, "Flush: {} is gone; dropping its dirty pages", file.path_);
+    std::lock_guard<std::mutex> lock(dirty_mutex_);
+    dirty_files_.erase(tag_id);
+    return 0;
+  }
+
+  // Step 1: Group the dirty ranges, in file order, into runs of ranges that
+  // are contiguous in the file. Only written bytes are read back, so a
+  // partial write never replaces file data around it.
+  chi::u64 page_size = file.page_size_;
+  std::vector<FlushRun> runs;
+  for (const auto &page : file.pages_) {
+    chi::u64 page_index = page.first;
+    BlobKey blob_key(tag_id, std::to_string(page_index));
+    BlobInfo *blob_info = CheckBlobExists(blob_key);
+    if (blob_info == nullptr) {
+      continue; // Deleted since it was written
+    }
+    chi::u64 blob_size;
+    {
+      // The block list may be swapped or appended to concurrently
+      chi::ScopedCoRwReadLock blob_lock(
+          *blob_locks_[GetBlobLockIndex(blob_key)]);
+      blob_size = std::min(blob_info->GetTotalSize(), page_size);
+    }
+    for (const auto &range : page.second) {
+      chi::u64 begin = range.first;
+      chi::u64 end = std::min(range.second, blob_size);
+      if (begin >= end) {
+        continue; // Truncated away since it was written
+      }
+      chi::u64 file_offset = page_index * page_size + begin;
+      bool extends = !runs.empty() &&
+                     runs.back().file_offset_ + runs.back().size_ ==
+                         file_offset &&
+                     runs.back().size_ + (end - begin) <= kFlushRunSize;
+      if (!extends) {
+        runs.emplace_back();
+        runs.back().file_offset_ = file_offset;
+      }
+      FlushRun &run = runs.back();
+      run.requests_.emplace_back(std::to_string(page_index), begin,
+                                 end - begin);
+      run.spans_.push_back(DirtySpan{page_index, begin, end});
+      run.size_ += end - begin;
+    }
+  }
+
+  // Step 2: Read runs from CTE with a few in flight and write each back as
+  // soon as it arrives, so tier reads overlap file writes
+  auto retire = [&](FlushRun &run) {
+    if (run.task_.IsNull()) {
+      redirty(run.spans_);
+      return;
+    }
+    run.task_->Wait();
+    bool read_ok = (run.task_->return_code_.load() == 0);
+    CHI_IPC->DelTask(run.task_);
+    chi::u64 written = 0;
+    while (read_ok && written < run.size_) {
+      ssize_t ret = pwrite(fd, run.buffer_.ptr_ + written,
+                           run.size_ - written, run.file_offset_ + written);
+      if (ret <= 0) {
+        break;
+      }
+      written += static_cast<chi::u64>(ret);
+    }
+    CHI_IPC->FreeBuffer(run.buffer_);
+    if (written == run.size_) {
+      for (const auto &span : run.spans_) {
+        flushed.insert(span.page_index_);
+      }
+      bytes_flushed += run.size_;
+    } else {
+      redirty(run.spans_);
+    }
+  };
+
+  size_t next_retire = 0;
+  for (size_t i = 0; i < runs.size(); ++i) {
+    FlushRun &run = runs[i];
+    run.buffer_ = CHI_IPC->AllocateBuffer(run.size_);
+    if (!run.buffer_.IsNull()) {
+      chi::u64 buffer_off = 0;
+      for (auto &request : run.requests_) {
+        request.data_ = run.buffer_.shm_ + buffer_off;
+        buffer_off += request.size_;
+      }
+      run.task_ =
+          client_.AsyncGetBlobs(hipc::MemContext(), tag_id, run.requests_);
+    }
+    if (i + 1 - next_retire > kFlushDepth) {
+      retire(runs[next_retire++]);
+    }
+  }
+  while (next_retire < runs.size()) {
+    retire(runs[next_retire++]);
+  }
+
+  if (durable && fdatasync(fd) != 0) {
+    HELOG(kError, "Flush: fdatasync of {} failed", file.path_);
+    failed.clear();
+    flushed.clear();
+    for (const auto &run : runs) {
+      redirty(run.spans_);
+    }
+  }
+  close(fd);
+
+  // Ranges that did not make it stay dirty for the next flush
+  std::set<chi::u64> failed_set;
+  for (const auto &span : failed) {
+    failed_set.insert(span.page_index_);
+    flushed.erase(span.page_index_);
+  }
+  pages_flushed += flushed.size();
+  if (!failed.empty()) {
+    failed_pages += failed_set.size();
+    std::lock_guard<std::mutex> lock(dirty_mutex_);
+    auto it = dirty_files_.find(tag_id);
+    if (it != dirty_files_.end()) {
+      for (const auto &span : failed) {
+        AddDirtyRange(it->second.pages_[span.page_index_], span.begin_,
+                      span.end_);
+      }
+    }
+    return 1;
+  }
+  return 0;
+}
+
+void Runtime::TruncateBlob(hipc::FullPtr<TruncateBlobTask> task,
+                           chi::RunContext &ctx) {
+  // Dynamic scheduling phase - determine routing
+  if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
+    task->pool_query_ =
+        HashBlobToContainer(task->tag_id_, NameView(task->blob_name_));
+    return;
+  }
+
+  try {
+    TagId tag_id = task->tag_id_;
+    BlobKey blob_key = BlobKey::View(tag_id, NameView(task->blob_name_));
+    task->bytes_freed_ = 0;
+    if (blob_key.GetName().empty()) {
+      task->return_code_.store(1); // Error: Blob name required
+      return;
+    }
+
+    BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
+    if (blob_info_ptr == nullptr) {
+      task->return_code_.store(kBlobNotFound);
+      return;
+    }
+
+    chi::u64 bytes_freed = 0;
+    chi::u32 result =
+        ShrinkBlob(blob_key, *blob_info_ptr, task->new_size_, bytes_freed);
+    if (result != 0) {
+      HILOG(kWarning, "TruncateBlob of {} failed with code {}",
+            blob_key.GetName(), result);
+      task->return_code_.store(result);
+      return;
+    }
+
+    // Update tag's total_size_
+    TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
+    if (tag_info_ptr != nullptr && bytes_freed > 0) {
+      if (bytes_freed <= tag_info_ptr->total_size_) {
+        tag_info_ptr->total_size_ -= bytes_freed;
+      } else {
+        tag_info_ptr->total_size_ = 0; // Clamp to 0 if we would underflow
+      }
+      tag_info_ptr->last_modified_ = std::chrono::steady_clock::now();
+    }
+
+    task->bytes_freed_ = bytes_freed;
+    task->return_code_.store(0);
+  } catch (const std::exception &e) {
+    task->return_code_.store(1);
+  }
+}
+
+void Runtime::TruncateTag(hipc::FullPtr<TruncateTagTask> task,
+                          chi::RunContext &ctx) {
+  // Dynamic scheduling phase - determine routing
+  if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
+    task->pool_query_ = chi::PoolQuery::Broadcast();
+    return;
+  }
+
+  try {
+    TagId tag_id = task->tag_id_;
+    chi::u64 new_size = task->new_size_;
+    chi::u64 page_size = task->page_size_;
+    task->pages_deleted_ = 0;
+    task->bytes_freed_ = 0;
+    if (tag_id.IsNull() || page_size == 0) {
+      task->return_code_.store(1); // Error: Invalid tag or page size
+      return;
+    }
+
+    // Step 1: Sort this container's page blobs of the tag into pages that lie
+    // wholly past the new size and the one page the new size falls inside
+    chi::u64 boundary_page = new_size / page_size;
+    bool has_boundary = (new_size % page_size) != 0;
+    std::vector<std::string> doomed_pages;
+    std::string boundary_name;
+    for (const auto &blob_name : GetTagBlobNames(tag_id)) {
+      chi::u64 page_index;
+      if (!ParsePageIndex(blob_name, page_index)) {
+        continue;
+      }
+      if (page_index > boundary_page ||
+          (page_index == boundary_page && !has_boundary)) {
+        doomed_pages.push_back(blob_name);
+      } else if (page_index == boundary_page) {
+        boundary_name = blob_name;
+      }
+    }
+
+    // Step 2: Delete the pages past the new size in batches to limit
+    // concurrent async tasks
+    constexpr size_t kMaxConcurrentDelBlobTasks = 32;
+    std::vector<hipc::FullPtr<DelBlobTask>> async_tasks;
+    bool failed = false;
+    for (size_t i = 0; i < doomed_pages.size();
+         i += kMaxConcurrentDelBlobTasks) {
+      async_tasks.clear();
+      size_t batch_end =
+          std::min(i + kMaxConcurrentDelBlobTasks, doomed_pages.size());
+      for (size_t j = i; j < batch_end; ++j) {
+        BlobInfo *blob_info = CheckBlobExists(BlobKey(tag_id, doomed_pages[j]));
+        if (blob_info != nullptr) {
+          task->bytes_freed_ += blob_info->GetTotalSize();
+        }
+        async_tasks.push_back(
+            client_.AsyncDelBlob(hipc::MemContext(), tag_id, doomed_pages[j]));
+      }
+      for (auto del_task : async_tasks) {
+        del_task->Wait();
+        if (del_task->return_code_.load() == 0) {
+          ++task->pages_deleted_;
+        } else {
+          failed = true;
+        }
+        CHI_IPC->DelTask(del_task);
+      }
+    }
+
+    // Step 3: Shrink the page the new size falls inside
+    if (!boundary_name.empty()) {
+      auto trunc_task = client_.AsyncTruncateBlob(
+          hipc::MemContext(), tag_id, boundary_name, new_size % page_size);
+      trunc_task->Wait();
+      if (trunc_task->return_code_.load() == 0) {
+        task->bytes_freed_ += trunc_task->bytes_freed_;
+      } else {
+        failed = true;
+      }
+      CHI_IPC->DelTask(trunc_task);
+    }
+
+    // Appends continue at the new end
+    {
+      std::lock_guard<std::mutex> lock(append_mutex_);
+      auto it = append_cursors_.find(tag_id);
+      if (it != append_cursors_.end()) {
+        it->second.next_ = new_size;
+      }
+    }
+
+    HILOG(kDebug, "TruncateTag: tag_id={},{} to {} bytes, {} pages deleted",
+          tag_id.major_, tag_id.minor_, new_size, task->pages_deleted_);
+    task->return_code_.store(failed ? 2 : 0);
+  } catch (const std::exception &e) {
+    task->return_code_.store(1);
+  }
+}
+
+void Runtime::AppendToTag(hipc::FullPtr<AppendToTagTask> task,
+                          chi::RunContext &ctx) {
+  // Dynamic scheduling phase - all appends of a tag go to the container
+  // holding its cursor
+  if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
+    task->pool_query_ = HashBlobToContainer(task->tag_id_, "");
+    return;
+  }
+
+  try {
+    TagId tag_id = task->tag_id_;
+    chi::u64 size = task->size_;
+    chi::u64 page_size = task->page_size_;
+    if (tag_id.IsNull() || page_size == 0 || size == 0 ||
+        task->data_.IsNull()) {
+      task->return_code_.store(1); // Error: Invalid tag, size or data
+      return;
+    }
+
+    // Step 1: Reserve the range; no other append can be handed any of it
+    chi::u64 offset =
+        ReserveAppend(tag_id, size, task->min_offset_, page_size);
+    task->offset_ = offset;
+
+    // Step 2: Split the range into page blob writes sent as one PutBlobs,
+    // which fans out to the containers holding the pages
+    std::vector<BlobIoRequest> requests;
+    for (chi::u64 done = 0; done < size;) {
+      chi::u64 page_index = (offset + done) / page_size;
+      chi::u64 page_off = (offset + done) % page_size;
+      chi::u64 len = std::min(page_size - page_off, size - done);
+      requests.emplace_back(std::to_string(page_index), page_off, len,
+                            task->data_ + done, task->score_);
+      done += len;
+    }
+    auto put_task = client_.AsyncPutBlobs(hipc::MemContext(), tag_id, requests);
+    put_task->Wait();
+    chi::u32 result = put_task->return_code_.load();
+    CHI_IPC->DelTask(put_task);
+    if (result != 0) {
+      // The range stays reserved; the caller sees the hole it left
+      HELOG(kError, "AppendToTag: writing {} bytes at {} failed", size,
+            offset);
+      task->return_code_.store(2);
+      return;
+    }
+
+    HILOG(kDebug, "AppendToTag: tag_id={},{} appended {} bytes at {}",
+          tag_id.major_, tag_id.minor_, size, offset);
+    task->return_code_.store(0);
+  } catch (const std::exception &e) {
+    task->return_code_.store(1);
+  }
+}
+
+void Runtime::RebalanceBlobs(hipc::FullPtr<RebalanceBlobsTask> task,
+                             chi::RunContext &ctx) {
+  // Dynamic scheduling phase - determine routing
+  if (ctx.exec_mode == chi::ExecMode::kDynamicSchedule) {
+    task->pool_query_ = chi::PoolQuery::DirectHash(task->container_id_);
+    return;
+  }
+
+  try {
+    chi::u32 container_id = task->container_id_;
+    chi::u32 max_blobs = task->max_blobs_;
+    task->blobs_moved_ = 0;
+    task->blobs_deferred_ = 0;
+    task->bytes_moved_ = 0;
+
+    // Step 1: Hand tags over first, so their new owner resolves the name to
+    // the ID the moved blobs are stored under
+    task->tags_moved_ = HandOverTags(container_id);
+
+    // Step 2: Find the blobs held here that the ring assigns elsewhere.
+    // Dirty file pages stay until they are written back, since their new
+    // owner would not know they still have to be flushed.
+    struct Move {
+      BlobKey blob_key_;
+      chi::u32 owner_;
+      chi::u64 size_;
+      float score_;
+    };
+    std::vector<Move> moves;
+    std::vector<TagId> tag_ids = GetIndexedTagIds();
+    auto is_dirty = [this](const TagId &tag_id, const std::string &blob_name) {
+      chi::u64 page_index;
+      if (!ParsePageIndex(blob_name, page_index)) {
+        return false;
+      }
+      std::lock_guard<std::mutex> lock(dirty_mutex_);
+      auto it = dirty_files_.find(tag_id);
+      return it != dirty_files_.end() && it->second.pages_.count(page_index);
+    };
+    for (const auto &tag_id : tag_ids) {
+      if (max_blobs != 0 && moves.size() >= max_blobs) {
+        break;
+      }
+      for (auto &blob_name : GetTagBlobNames(tag_id)) {
+        if (max_blobs != 0 && moves.size() >= max_blobs) {
+          break;
+        }
+        chi::u32 owner = GetOwnerContainer(HashBlob(tag_id, blob_name));
+        if (owner == container_id) {
+          continue;
+        }
+        if (is_dirty(tag_id, blob_name)) {
+          ++task->blobs_deferred_;
+          continue;
+        }
+        BlobKey blob_key(tag_id, std::move(blob_name));
+        BlobInfo *blob_info_ptr = CheckBlobExists(blob_key);
+        if (blob_info_ptr == nullptr) {
+          continue;
+        }
+        chi::u64 size = blob_info_ptr->GetTotalSize();
+        float score = blob_info_ptr->score_;
+        moves.push_back(Move{std::move(blob_key), owner, size, score});
+      }
+    }
+
+    // Step 3: Copy each blob to its owner, then delete it here, in batches
+    // to bound concurrent tasks and staging memory. The copy never replaces
+    // a blob the owner already holds: that one was written after routing
+    // changed and may hold only the bytes written since, so the local copy is
+    // kept and the blob is retried on the next pass.
+    for (size_t i = 0; i < moves.size(); i += kRebalanceBatch) {
+      size_t batch_end = std::min(i + kRebalanceBatch, moves.size());
+      std::vector<hipc::FullPtr<char>> buffers(batch_end - i);
+      std::vector<hipc::FullPtr<GetBlobTask>> reads(batch_end - i);
+      for (size_t j = i; j < batch_end; ++j) {
+        const Move &move = moves[j];
+        buffers[j - i] = CHI_IPC->AllocateBuffer(move.size_);
+        if (buffers[j - i].IsNull()) {
+          continue;
+        }
+        reads[j - i] = client_.AsyncGetBlob(
+            hipc::MemContext(), move.blob_key_.tag_id_,
+            move.blob_key_.blob_name_, 0, move.size_, 0, buffers[j - i].shm_,
+            chi::PoolQuery::Local());
+      }
+
+      std::vector<hipc::FullPtr<PutBlobTask>> puts(batch_end - i);
+      for (size_t j = i; j < batch_end; ++j) {
+        auto &read = reads[j - i];
+        if (read.IsNull()) {
+          continue;
+        }
+        read->Wait();
+        bool read_ok = (read->return_code_.load() == 0);
+        CHI_IPC->DelTask(read);
+        if (!read_ok) {
+          continue;
+        }
+        const Move &move = moves[j];
+        puts[j - i] = client_.AsyncPutBlob(
+            hipc::MemContext(), move.blob_key_.tag_id_,
+            move.blob_key_.blob_name_, 0, move.size_, buffers[j - i].shm_,
+            move.score_, kPutBlobIfAbsent,
+            chi::PoolQuery::DirectHash(move.owner_));
+      }
+
+      std::vector<hipc::FullPtr<DelBlobTask>> dels(batch_end - i);
+      for (size_t j = i; j < batch_end; ++j) {
+        auto &put = puts[j - i];
+        if (put.IsNull()) {
+          continue;
+        }
+        put->Wait();
+        bool put_ok = (put->return_code_.load() == 0);
+        bool created = put->blob_created_;
+        CHI_IPC->DelTask(put);
+        if (!put_ok) {
+          continue;
+        }
+        const Move &move = moves[j];
+        if (!created) {
+          HILOG(kWarning,
+                "RebalanceBlobs: container {} already holds blob {}; keeping "
+                "the local copy",
+                move.owner_, move.blob_key_.blob_name_);
+          continue;
+        }
+        dels[j - i] = client_.AsyncDelBlob(
+            hipc::MemContext(), move.blob_key_.tag_id_,
+            move.blob_key_.blob_name_, chi::PoolQuery::Local());
+      }
+
+      for (size_t j = i; j < batch_end; ++j) {
+        auto &del = dels[j - i];
+        bool moved = false;
+        if (!del.IsNull()) {
+          del->Wait();
+          moved = (del->return_code_.load() == 0);
+          CHI_IPC->DelTask(del);
+        }
+        if (moved) {
+          ++task->blobs_moved_;
+          task->bytes_moved_ += moves[j].size_;
+        } else {
+          ++task->blobs_deferred_;
+        }
+        if (!buffers[j - i].IsNull()) {
+          CHI_IPC->FreeBuffer(buffers[j - i]);
+        }
+      }
+    }
+
+    HILOG(kDebug,
+          "RebalanceBlobs: container {} moved {} blobs ({} bytes), {} deferred",
+          container_id, task->blobs_moved_, task->bytes_moved_,
+          task->blobs_deferred_);
+    task->return_code_.store(0);
+  } catch (const std::exception &e) {
+    task->return_code_.store(1);
+    HILOG(kError, "RebalanceBlobs failed: {}", e.what());
+  }
+}
+
+chi::u64 Runtime::ReserveAppend(const TagId &tag_id, chi::u64 size,
+                                chi::u64 min_offset, chi::u64 page_size) {
+  // The tag size is queried once, on the tag's first append; from then on
+  // positional writes reach the cursor through RaiseAppendCursor or the
+  // caller's floor. The query yields; racing first appends stay disjoint
+  // since the cursor only moves forward under the lock.
+  bool seeded;
+  {
+    std::lock_guard<std::mutex> lock(append_mutex_);
+    seeded = append_cursors_.find(tag_id) != append_cursors_.end();
+  }
+  chi::u64 tag_size = 0;
+  if (!seeded) {
+    auto size_task = client_.AsyncGetTagSize(hipc::MemContext(), tag_id);
+    size_task->Wait();
+    tag_size = size_task->tag_size_;
+    CHI_IPC->DelTask(size_task);
+  }
+
+  std::lock_guard<std::mutex> lock(append_mutex_);
+  AppendCursor &cursor = append_cursors_[tag_id];
+  cursor.page_size_ = page_size;
+  cursor.next_ = std::max({cursor.next_, min_offset, tag_size});
+  chi::u64 offset = cursor.next_;
+  cursor.next_ += size;
+  return offset;
+}
+
+void Runtime::RaiseAppendCursor(const TagId &tag_id,
+                                std::string_view blob_name, chi::u64 offset,
+                                chi::u64 size) {
+  chi::u64 page_index;
+  if (size == 0 || !ParsePageIndex(blob_name, page_index)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(append_mutex_);
+  auto it = append_cursors_.find(tag_id);
+  if (it == append_cursors_.end() || it->second.page_size_ == 0) {
+    return; // Appends of this tag are not routed here
+  }
+  AppendCursor &cursor = it->second;
+  cursor.next_ =
+      std::max(cursor.next_, page_index * cursor.page_size_ + offset + size);
+}
+
+// ==============================================================================
+// Background Maintenance
+// ==============================================================================
+
+void Runtime::StartMaintenanceThread() {
+  if (maintenance_thread_.joinable()) {
+    return;
+  }
+  const PerformanceConfig &perf = config_.performance_;
+  maintenance_jobs_[kReorganizeTiersJob].period_ =
+      std::chrono::milliseconds(perf.reorganize_interval_ms_);
+  maintenance_jobs_[kEnforceWatermarksJob].period_ =
+      std::chrono::milliseconds(perf.watermark_check_interval_ms_);
+  maintenance_jobs_[kFlushDirtyJob].period_ =
+      std::chrono::milliseconds(perf.flush_interval_ms_);
+  maintenance_jobs_[kStatTargetsJob].period_ =
+      std::chrono::milliseconds(config_.targets_.poll_period_ms_);
+
+  bool any_enabled = false;
+  auto now = std::chrono::steady_clock::now();
+  for (auto &job : maintenance_jobs_) {
+    job.next_run_ = now + job.period_;
+    any_enabled = any_enabled || job.period_.count() > 0;
+  }
+  if (!any_enabled) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(maintenance_mutex_);
+    maintenance_stop_ = false;
+  }
+  maintenance_thread_ = std::thread(&Runtime::MaintenanceLoop, this);
+  HILOG(kInfo,
+        "Background maintenance enabled: reorganize every {} ms, watermark "
+        "checks every {} ms, flush every {} ms, target stats every {} ms",
+        perf.reorganize_interval_ms_, perf.watermark_check_interval_ms_,
+        perf.flush_interval_ms_, config_.targets_.poll_period_ms_);
+}
+
+void Runtime::StopMaintenanceThread() {
+  if (!maintenance_thread_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(maintenance_mutex_);
+    maintenance_stop_ = true;
+  }
+  maintenance_cv_.notify_all();
+  maintenance_thread_.join();
+}
+
+void Runtime::RequestMaintenance(MaintenanceJob job) {
+  if (maintenance_jobs_[job].period_.count() == 0) {
+    return;
+  }
+  // Workers must not block on the maintenance mutex; a notify that races the
+  // thread's predicate check only delays the job to its next period
+  maintenance_requests_.fetch_or(1u << job);
+  maintenance_cv_.notify_one();
+}
+
+void Runtime::RunMaintenanceJob(MaintenanceJob job) {
+  // Only this container: every runtime runs its own maintenance thread
+  chi::PoolQuery local = chi::PoolQuery::Local();
+  switch (job) {
+  case kReorganizeTiersJob: {
+    auto task = client_.AsyncReorganizeTiers(
+        hipc::MemContext(), config_.performance_.reorganize_max_blobs_, local);
+    task->Wait();
+    CHI_IPC->DelTask(task);
+    break;
+  }
+  case kEnforceWatermarksJob: {
+    auto task = client_.AsyncEnforceWatermarks(hipc::MemContext(), 0, local);
+    task->Wait();
+    CHI_IPC->DelTask(task);
+    break;
+  }
+  case kFlushDirtyJob: {
+    auto task = client_.AsyncFlushTag(hipc::MemContext(), TagId::GetNull(),
+                                      "", 0, 0, local);
+    task->Wait();
+    CHI_IPC->DelTask(task);
+    break;
+  }
+  case kStatTargetsJob: {
+    auto task = client_.AsyncStatTargets(hipc::MemContext(), local);
+    task->Wait();
+    CHI_IPC->DelTask(task);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+void Runtime::MaintenanceLoop() {
+  std::unique_lock<std::mutex> lock(maintenance_mutex_);
+  while (!maintenance_stop_) {
+    auto next_run = std::chrono::steady_clock::time_point::max();
+    for (const auto &job : maintenance_jobs_) {
+      if (job.period_.count() > 0) {
+        next_run = std::min(next_run, job.next_run_);
+      }
+    }
+    maintenance_cv_.wait_until(lock, next_run, [this] {
+      return maintenance_stop_ || maintenance_requests_.load() != 0;
+    });
+    if (maintenance_stop_) {
+      break;
+    }
+
+    chi::u32 requests = maintenance_requests_.exchange(0);
+    lock.unlock();
+    for (chi::u32 job = 0; job < kMaintenanceJobCount; ++job) {
+      MaintenanceSchedule &schedule = maintenance_jobs_[job];
+      if (schedule.period_.count() == 0) {
+        continue;
+      }
+      auto now = std::chrono::steady_clock::now();
+      if (now < schedule.next_run_ && (requests & (1u << job)) == 0) {
+        continue;
+      }
+      RunMaintenanceJob(static_cast<MaintenanceJob>(job));
+      schedule.next_run_ = std::chrono::steady_clock::now() + schedule.period_;
+    }
+    lock.lock();
+  }
+}
+
+// ==============================================================================
+// Helper Functions for Dynamic Scheduling
+// ==============================================================================
+
+chi::u32 Runtime::HashBlob(const TagId &tag_id, std::string_view blob_name) {
+  // Compute hash from tag_id and blob_name
+  std::hash<std::string_view> string_hasher;
+  std::hash<chi::u32> u32_hasher;
+
+  // Combine tag_id major, minor, and blob_name into a single hash
+  chi::u32 hash_value = u32_hasher(tag_id.major_);
+  hash_value ^= u32_hasher(tag_id.minor_) + 0x9e3779b9 + (hash_value << 6) +
+                (hash_value >> 2);
+  hash_value ^= static_cast<chi::u32>(string_hasher(blob_name)) + 0x9e3779b9 +
+                (hash_value << 6) + (hash_value >> 2);
+  return hash_value;
+}
+
+chi::u32 Runtime::GetTagOwnerContainer(const std::string &tag_name) {
+  std::hash<std::string> string_hasher;
+  return GetOwnerContainer(static_cast<chi::u32>(string_hasher(tag_name)));
+}
+
+chi::PoolQuery Runtime::HashBlobToContainer(const TagId &tag_id,
+                                            std::string_view blob_name) {
+  return chi::PoolQuery::DirectHash(
+      GetOwnerContainer(HashBlob(tag_id, blob_name)));
+}
+
+chi::u32 Runtime::GetOwnerContainer(chi::u64 hash) {
+  // The pool has one container per node, so DirectHash(id) lands on
+  // container id
+  chi::u32 num_containers = std::max<chi::u32>(CHI_IPC->GetNumHosts(), 1);
+  {
+    chi::ScopedCoRwReadLock ring_lock(hash_ring_lock_);
+    if (hash_ring_.GetNumContainers() == num_containers) {
+      return hash_ring_.GetOwner(hash);
+    }
+  }
+  chi::ScopedCoRwWriteLock ring_lock(hash_ring_lock_);
+  if (hash_ring_.GetNumContainers() != num_containers) {
+    HILOG(kInfo, "Building hash ring: {} containers, {} virtual nodes each",
+          num_containers, config_.targets_.virtual_nodes_);
+    hash_ring_.Build(num_containers, config_.targets_.virtual_nodes_);
+  }
+  return hash_ring_.GetOwner(hash);
+}
 
-  return chi::PoolQuery::DirectHash(hash_value);
+chi::u32 Runtime::GetLocalContainerId() const {
+  // Ring indices are container IDs within the pool, not node IDs
+  return container_id_;
 }
 
 } // namespace wrp_cte::core
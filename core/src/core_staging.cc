@@ -0,0 +1,70 @@
+#include <wrp_cte/core/core_staging.h>
+
+namespace wrp_cte::core {
+
+StagingPool::~StagingPool() { Trim(); }
+
+StagingPool &StagingPool::Get() {
+  thread_local StagingPool pool;
+  return pool;
+}
+
+size_t StagingPool::GetClass(size_t size) {
+  if (size > (1ULL << kMaxClassBits)) {
+    return kNumClasses;
+  }
+  if (size <= (1ULL << kMinClassBits)) {
+    return 0;
+  }
+  chi::u32 bits = 64 - static_cast<chi::u32>(__builtin_clzll(size - 1));
+  return static_cast<size_t>(bits - kMinClassBits);
+}
+
+size_t StagingPool::GetCapacity(size_t size) {
+  size_t size_class = GetClass(size);
+  if (size_class == kNumClasses) {
+    return size;
+  }
+  return 1ULL << (kMinClassBits + size_class);
+}
+
+hipc::FullPtr<char> StagingPool::Acquire(size_t size) {
+  size_t size_class = GetClass(size);
+  if (size_class < kNumClasses && !free_lists_[size_class].empty()) {
+    hipc::FullPtr<char> buffer = free_lists_[size_class].back();
+    free_lists_[size_class].pop_back();
+    cached_bytes_ -= GetCapacity(size);
+    return buffer;
+  }
+  return CHI_IPC->AllocateBuffer(GetCapacity(size));
+}
+
+void StagingPool::Release(const hipc::FullPtr<char> &buffer, size_t size) {
+  if (buffer.IsNull()) {
+    return;
+  }
+  size_t size_class = GetClass(size);
+  size_t capacity = GetCapacity(size);
+  if (size_class < kNumClasses &&
+      free_lists_[size_class].size() < kMaxBuffersPerClass &&
+      cached_bytes_ + capacity <= kMaxCachedBytes) {
+    free_lists_[size_class].push_back(buffer);
+    cached_bytes_ += capacity;
+    return;
+  }
+  hipc::FullPtr<char> owned = buffer;
+  CHI_IPC->FreeBuffer(owned);
+}
+
+void StagingPool::Trim() {
+  auto *ipc_manager = CHI_IPC;
+  for (auto &free_list : free_lists_) {
+    for (auto &buffer : free_list) {
+      ipc_manager->FreeBuffer(buffer);
+    }
+    free_list.clear();
+  }
+  cached_bytes_ = 0;
+}
+
+} // namespace wrp_cte::core
@@ -0,0 +1,114 @@
+#include <limits>
+#include <wrp_cte/core/core_stats.h>
+
+namespace wrp_cte::core {
+
+size_t LatencyHistogram::BucketIndex(chi::u64 value_ns) {
+  if (value_ns < kSubBuckets) {
+    return static_cast<size_t>(value_ns);
+  }
+  chi::u32 exponent = 63 - static_cast<chi::u32>(__builtin_clzll(value_ns));
+  if (exponent > kMaxExponent) {
+    return kBucketCount - 1;
+  }
+  chi::u64 sub = (value_ns >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+  return static_cast<size_t>(kSubBuckets +
+                             (exponent - kSubBucketBits) * kSubBuckets + sub);
+}
+
+chi::u64 LatencyHistogram::BucketUpperBound(size_t index) {
+  if (index < kSubBuckets) {
+    return static_cast<chi::u64>(index);
+  }
+  chi::u64 exponent = (index - kSubBuckets) / kSubBuckets + kSubBucketBits;
+  chi::u64 sub = (index - kSubBuckets) % kSubBuckets;
+  chi::u64 shift = exponent - kSubBucketBits;
+  return ((kSubBuckets + sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(chi::u64 value_ns) {
+  buckets_[BucketIndex(value_ns)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_ns_.fetch_add(value_ns, std::memory_order_relaxed);
+
+  chi::u64 current = min_ns_.load(std::memory_order_relaxed);
+  while (value_ns < current &&
+         !min_ns_.compare_exchange_weak(current, value_ns,
+                                        std::memory_order_relaxed)) {
+  }
+  current = max_ns_.load(std::memory_order_relaxed);
+  while (value_ns > current &&
+         !max_ns_.compare_exchange_weak(current, value_ns,
+                                        std::memory_order_relaxed)) {
+  }
+}
+
+void LatencyHistogram::Reset() {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_ns_.store(0, std::memory_order_relaxed);
+  min_ns_.store(std::numeric_limits<chi::u64>::max(),
+                std::memory_order_relaxed);
+  max_ns_.store(0, std::memory_order_relaxed);
+}
+
+LatencySummary LatencyHistogram::Summarize(StatOp op, StatPhase phase) const {
+  LatencySummary summary;
+  summary.op_ = static_cast<chi::u32>(op);
+  summary.phase_ = static_cast<chi::u32>(phase);
+
+  // Bucket counts are read without a snapshot, so derive the total from the
+  // buckets themselves to keep the percentile ranks consistent
+  chi::u64 counts[kBucketCount];
+  chi::u64 total = 0;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0) {
+    return summary;
+  }
+  summary.count_ = total;
+  summary.sum_ns_ = sum_ns_.load(std::memory_order_relaxed);
+  summary.min_ns_ = min_ns_.load(std::memory_order_relaxed);
+  summary.max_ns_ = max_ns_.load(std::memory_order_relaxed);
+
+  const double quantiles[] = {0.50, 0.90, 0.99, 0.999};
+  chi::u64 *outputs[] = {&summary.p50_ns_, &summary.p90_ns_, &summary.p99_ns_,
+                         &summary.p999_ns_};
+  size_t q = 0;
+  chi::u64 seen = 0;
+  for (size_t i = 0; i < kBucketCount && q < 4; ++i) {
+    seen += counts[i];
+    while (q < 4 && static_cast<double>(seen) >=
+                        quantiles[q] * static_cast<double>(total)) {
+      *outputs[q] = std::min(BucketUpperBound(i), summary.max_ns_);
+      ++q;
+    }
+  }
+  return summary;
+}
+
+void RuntimeStats::Summarize(std::vector<LatencySummary> &summaries) const {
+  for (size_t op = 0; op < kStatOpCount; ++op) {
+    for (size_t phase = 0; phase < kStatPhaseCount; ++phase) {
+      LatencySummary summary = histograms_[op][phase].Summarize(
+          static_cast<StatOp>(op), static_cast<StatPhase>(phase));
+      if (summary.count_ > 0) {
+        summaries.push_back(summary);
+      }
+    }
+  }
+}
+
+void RuntimeStats::Reset() {
+  for (auto &op_histograms : histograms_) {
+    for (auto &histogram : op_histograms) {
+      histogram.Reset();
+    }
+  }
+}
+
+} // namespace wrp_cte::core
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <wrp_cte/core/core_telemetry.h>
+
+namespace wrp_cte::core {
+
+TelemetryRing::TelemetryRing(size_t capacity) : capacity_(0), head_(0) {
+  Reset(capacity);
+}
+
+void TelemetryRing::Reset(size_t capacity) {
+  capacity_ = std::max<size_t>(capacity, 1);
+  slots_ = std::make_unique<Slot[]>(capacity_);
+  head_.store(0, std::memory_order_release);
+}
+
+std::uint64_t TelemetryRing::Push(CteTelemetry entry) {
+  std::uint64_t logical_time =
+      head_.fetch_add(1, std::memory_order_acq_rel) + 1;
+  Slot &slot = slots_[(logical_time - 1) % capacity_];
+
+  // Odd sequence marks the slot as being written; readers that see it, or see
+  // it change while copying, discard what they copied
+  slot.seq_.store(Published(logical_time) | 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  entry.logical_time_ = logical_time;
+  slot.entry_ = entry;
+  slot.seq_.store(Published(logical_time), std::memory_order_release);
+  return logical_time;
+}
+
+std::uint64_t TelemetryRing::Read(std::uint64_t cursor, size_t max_entries,
+                                  std::vector<CteTelemetry> &entries,
+                                  std::uint64_t &dropped) const {
+  dropped = 0;
+  if (max_entries == 0) {
+    max_entries = capacity_;
+  }
+
+  std::uint64_t head = head_.load(std::memory_order_acquire);
+  if (cursor >= head) {
+    return cursor;
+  }
+
+  // Entries older than one ring length have been overwritten already
+  std::uint64_t next = cursor + 1;
+  std::uint64_t oldest = (head > capacity_) ? head - capacity_ + 1 : 1;
+  if (next < oldest) {
+    dropped += oldest - next;
+    next = oldest;
+  }
+
+  size_t copied = 0;
+  for (; next <= head && copied < max_entries; ++next) {
+    const Slot &slot = slots_[(next - 1) % capacity_];
+    std::uint64_t before = slot.seq_.load(std::memory_order_acquire);
+    if (before < Published(next)) {
+      break; // Claimed but not yet published; resume here on the next poll
+    }
+    if (before != Published(next)) {
+      ++dropped; // Lapped by a newer entry
+      continue;
+    }
+    CteTelemetry entry = slot.entry_;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq_.load(std::memory_order_relaxed) != before) {
+      ++dropped; // Overwritten while copying
+      continue;
+    }
+    entries.push_back(entry);
+    ++copied;
+  }
+  return next - 1;
+}
+
+size_t TelemetryRing::GetSize() const {
+  return static_cast<size_t>(
+      std::min<std::uint64_t>(GetHead(), static_cast<std::uint64_t>(capacity_)));
+}
+
+} // namespace wrp_cte::core
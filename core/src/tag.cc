@@ -13,25 +13,27 @@ Tag::Tag(const std::string &tag_name) : tag_name_(tag_name) {
 Tag::Tag(const TagId &tag_id) : tag_id_(tag_id), tag_name_("") {}
 
 void Tag::PutBlob(const std::string &blob_name, const char *data, size_t data_size, size_t off) {
-  // Allocate shared memory for the data
-  auto *ipc_manager = CHI_IPC;
-  hipc::FullPtr<char> shm_fullptr = ipc_manager->AllocateBuffer(data_size);
+  // Stage the data in a pooled shared memory buffer
+  IoBuffer staging(data_size);
 
-  if (shm_fullptr.IsNull()) {
+  if (staging.IsNull()) {
     throw std::runtime_error("Failed to allocate shared memory for PutBlob");
   }
 
   // Copy data to shared memory
-  memcpy(shm_fullptr.ptr_, data, data_size);
+  memcpy(staging.data(), data, data_size);
 
-  // Convert to hipc::Pointer for API call
-  hipc::Pointer shm_ptr = shm_fullptr.shm_;
-
-  // Call SHM version with default score of 1.0
-  PutBlob(blob_name, shm_ptr, data_size, off, 1.0f);
+  // Call SHM version with default score of 1.0; the buffer returns to the
+  // pool when staging goes out of scope
+  PutBlob(blob_name, staging.shm(), data_size, off, 1.0f);
+}
 
-  // Explicitly free shared memory buffer
-  ipc_manager->FreeBuffer(shm_fullptr);
+void Tag::PutBlob(const std::string &blob_name, const IoBuffer &data, size_t off,
+                  float score) {
+  if (data.IsNull()) {
+    throw std::invalid_argument("PutBlob requires a non-null IoBuffer");
+  }
+  PutBlob(blob_name, data.shm(), data.size(), off, score);
 }
 
 void Tag::PutBlob(const std::string &blob_name, const hipc::Pointer &data, size_t data_size,
@@ -46,10 +48,10 @@ void Tag::PutBlob(const std::string &blob_name, const hipc::Pointer &data, size_
 
 // NOTE: AsyncPutBlob(const char*) overload removed due to memory management issues.
 // For async operations, the caller must manage shared memory lifecycle by:
-// 1. Allocating: hipc::FullPtr<char> shm_ptr = CHI_IPC->AllocateBuffer(data_size);
-// 2. Copying data: memcpy(shm_ptr.ptr_, data, data_size);
-// 3. Calling: AsyncPutBlob(blob_name, shm_ptr.shm_, data_size, off, score);
-// 4. Keeping shm_ptr alive until task completes
+// 1. Allocating: IoBuffer buf = Tag::AllocateIoBuffer(data_size);
+// 2. Filling buf.data() directly (or copying data into it)
+// 3. Calling: AsyncPutBlob(blob_name, buf.shm(), data_size, off, score);
+// 4. Keeping buf alive until task completes
 
 hipc::FullPtr<PutBlobTask> Tag::AsyncPutBlob(const std::string &blob_name, const hipc::Pointer &data,
                                              size_t data_size, size_t off, float score) {
@@ -68,25 +70,25 @@ void Tag::GetBlob(const std::string &blob_name, char *data, size_t data_size, si
     throw std::invalid_argument("data buffer must be pre-allocated by caller");
   }
 
-  // Allocate shared memory for the data
-  auto *ipc_manager = CHI_IPC;
-  hipc::FullPtr<char> shm_fullptr = ipc_manager->AllocateBuffer(data_size);
+  // Stage the data in a pooled shared memory buffer
+  IoBuffer staging(data_size);
 
-  if (shm_fullptr.IsNull()) {
+  if (staging.IsNull()) {
     throw std::runtime_error("Failed to allocate shared memory for GetBlob");
   }
 
-  // Convert to hipc::Pointer for API call
-  hipc::Pointer shm_ptr = shm_fullptr.shm_;
-
   // Call SHM version
-  GetBlob(blob_name, shm_ptr, data_size, off);
+  GetBlob(blob_name, staging.shm(), data_size, off);
 
   // Copy data from shared memory to output buffer
-  memcpy(data, shm_fullptr.ptr_, data_size);
+  memcpy(data, staging.data(), data_size);
+}
 
-  // Explicitly free shared memory buffer
-  ipc_manager->FreeBuffer(shm_fullptr);
+void Tag::GetBlob(const std::string &blob_name, IoBuffer &data, size_t off) {
+  if (data.IsNull()) {
+    throw std::invalid_argument("GetBlob requires a non-null IoBuffer");
+  }
+  GetBlob(blob_name, data.shm(), data.size(), off);
 }
 
 void Tag::GetBlob(const std::string &blob_name, hipc::Pointer data, size_t data_size, size_t off) {
@@ -97,7 +99,7 @@ void Tag::GetBlob(const std::string &blob_name, hipc::Pointer data, size_t data_
   
   if (data.IsNull()) {
     throw std::invalid_argument("data pointer must be pre-allocated by caller. "
-                               "Use CHI_IPC->AllocateBuffer(data_size) to allocate shared memory.");
+                               "Use Tag::AllocateIoBuffer(data_size) to allocate shared memory.");
   }
   
   auto *cte_client = WRP_CTE_CLIENT;
@@ -108,6 +110,125 @@ void Tag::GetBlob(const std::string &blob_name, hipc::Pointer data, size_t data_
   }
 }
 
+hipc::FullPtr<GetBlobTask> Tag::AsyncGetBlob(const std::string &blob_name, const hipc::Pointer &data,
+                                             size_t data_size, size_t off) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  return cte_client->AsyncGetBlob(hipc::MemContext(), tag_id_, blob_name,
+                                  off, data_size, 0, data);
+}
+
+void Tag::PutBlobs(std::vector<BlobIoRequest> &requests, const char *data) {
+  size_t total_size = 0;
+  for (const auto &request : requests) {
+    total_size += request.size_;
+  }
+  if (total_size == 0) {
+    throw std::invalid_argument("PutBlobs requires a non-empty batch");
+  }
+
+  // Report every blob as failed unless the runtime says otherwise
+  for (auto &request : requests) {
+    request.return_code_ = 1;
+  }
+
+  // Stage the whole batch in one pooled shared memory buffer
+  IoBuffer staging(total_size);
+
+  if (staging.IsNull()) {
+    throw std::runtime_error("Failed to allocate shared memory for PutBlobs");
+  }
+
+  // Copy data to shared memory and point each request at its slice
+  memcpy(staging.data(), data, total_size);
+  size_t buffer_off = 0;
+  for (auto &request : requests) {
+    request.data_ = staging.shm() + buffer_off;
+    buffer_off += request.size_;
+  }
+
+  auto *cte_client = WRP_CTE_CLIENT;
+  bool result = cte_client->PutBlobs(hipc::MemContext(), tag_id_, requests);
+  if (!result) {
+    throw std::runtime_error("PutBlobs operation failed");
+  }
+}
+
+void Tag::PutBlobs(std::vector<BlobIoRequest> &requests) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  bool result = cte_client->PutBlobs(hipc::MemContext(), tag_id_, requests);
+  if (!result) {
+    throw std::runtime_error("PutBlobs operation failed");
+  }
+}
+
+hipc::FullPtr<PutBlobsTask>
+Tag::AsyncPutBlobs(const std::vector<BlobIoRequest> &requests) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  return cte_client->AsyncPutBlobs(hipc::MemContext(), tag_id_, requests);
+}
+
+void Tag::GetBlobs(std::vector<BlobIoRequest> &requests, char *data) {
+  if (data == nullptr) {
+    throw std::invalid_argument("data buffer must be pre-allocated by caller");
+  }
+  size_t total_size = 0;
+  for (const auto &request : requests) {
+    total_size += request.size_;
+  }
+  if (total_size == 0) {
+    throw std::invalid_argument("GetBlobs requires a non-empty batch");
+  }
+
+  // Report every blob as failed unless the runtime says otherwise
+  for (auto &request : requests) {
+    request.return_code_ = 1;
+  }
+
+  // Stage the whole batch in one pooled shared memory buffer
+  IoBuffer staging(total_size);
+
+  if (staging.IsNull()) {
+    throw std::runtime_error("Failed to allocate shared memory for GetBlobs");
+  }
+
+  size_t buffer_off = 0;
+  for (auto &request : requests) {
+    request.data_ = staging.shm() + buffer_off;
+    buffer_off += request.size_;
+  }
+
+  auto *cte_client = WRP_CTE_CLIENT;
+  bool result = cte_client->GetBlobs(hipc::MemContext(), tag_id_, requests);
+
+  // Copy data from shared memory to output buffer
+  memcpy(data, staging.data(), total_size);
+  if (!result) {
+    throw std::runtime_error("GetBlobs operation failed");
+  }
+}
+
+void Tag::GetBlobs(std::vector<BlobIoRequest> &requests) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  bool result = cte_client->GetBlobs(hipc::MemContext(), tag_id_, requests);
+  if (!result) {
+    throw std::runtime_error("GetBlobs operation failed");
+  }
+}
+
+hipc::FullPtr<GetBlobsTask>
+Tag::AsyncGetBlobs(const std::vector<BlobIoRequest> &requests) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  return cte_client->AsyncGetBlobs(hipc::MemContext(), tag_id_, requests);
+}
+
+IoBuffer Tag::AllocateIoBuffer(size_t size) {
+  IoBuffer buffer(size);
+  if (buffer.IsNull()) {
+    throw std::runtime_error("Failed to allocate shared memory for IoBuffer");
+  }
+  return buffer;
+}
+
 float Tag::GetBlobScore(const std::string &blob_name) {
   auto *cte_client = WRP_CTE_CLIENT;
   return cte_client->GetBlobScore(hipc::MemContext(), tag_id_, blob_name);
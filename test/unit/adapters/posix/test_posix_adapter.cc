@@ -18,13 +18,18 @@
  *
  * Test Cases:
  * 1. Open-Write-Read-Close: Basic file I/O operations with data verification
+ * 2. File Size Verification: Size on disk after a small write
+ * 3. Write-Back Cache: Buffered small writes are visible after fsync/close
+ * 4. Read-Ahead: Sequential and strided reads return correct data
  */
 
 #include <catch2/catch_all.hpp>
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
 #include <filesystem>
+#include <sys/stat.h>
 #include <thread>
 #include <unistd.h>
 #include <vector>
@@ -228,4 +233,351 @@ TEST_CASE("POSIX Adapter: File Size Verification", "[posix][adapter]") {
     // Clean up
     stdfs::remove(kTestFile);
   }
-}
\ No newline at end of file
+}
+/**
+ * POSIX Adapter Test: Write-Back Cache
+ *
+ * Many small sequential writes are buffered by the client-side write-back
+ * cache and must be readable after fsync and after reopening the file.
+ */
+TEST_CASE("POSIX Adapter: Write-Back Cache Small Writes", "[posix][adapter]") {
+  REQUIRE(initializeRuntime());
+
+  if (stdfs::exists(kTestFile)) {
+    stdfs::remove(kTestFile);
+  }
+
+  auto *cae_config = WRP_CAE_CONF;
+  REQUIRE(cae_config != nullptr);
+  cae_config->SetWriteBackCacheSize(1024 * 1024);
+
+  SECTION("Small writes are visible after fsync and close") {
+    int fd = open(kTestFile.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    REQUIRE(fd >= 0);
+
+    // 100-byte records straddle page boundaries
+    const size_t record_size = 100;
+    const size_t num_records = 2000;
+    std::vector<char> expected(record_size * num_records);
+    for (size_t i = 0; i < num_records; ++i) {
+      char *record = expected.data() + i * record_size;
+      std::memset(record, static_cast<int>('a' + i % 26), record_size);
+      ssize_t bytes_written = write(fd, record, record_size);
+      REQUIRE(bytes_written == static_cast<ssize_t>(record_size));
+    }
+    REQUIRE(fsync(fd) == 0);
+
+    // Reads see buffered data even without a flush
+    const char tail[] = "tail";
+    REQUIRE(write(fd, tail, sizeof(tail)) == static_cast<ssize_t>(sizeof(tail)));
+    std::vector<char> read_tail(sizeof(tail));
+    REQUIRE(pread(fd, read_tail.data(), sizeof(tail), expected.size()) ==
+            static_cast<ssize_t>(sizeof(tail)));
+    REQUIRE(std::memcmp(read_tail.data(), tail, sizeof(tail)) == 0);
+    REQUIRE(close(fd) == 0);
+
+    fd = open(kTestFile.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    std::vector<char> read_data(expected.size());
+    REQUIRE(read(fd, read_data.data(), read_data.size()) ==
+            static_cast<ssize_t>(read_data.size()));
+    REQUIRE(read_data == expected);
+    REQUIRE(close(fd) == 0);
+
+    stdfs::remove(kTestFile);
+  }
+
+  cae_config->SetWriteBackCacheSize(0);
+}
+
+/**
+ * POSIX Adapter Test: Read-Ahead
+ *
+ * Sequential and strided readers must get the same data with read-ahead
+ * enabled as without it.
+ */
+TEST_CASE("POSIX Adapter: Read-Ahead Streams", "[posix][adapter]") {
+  REQUIRE(initializeRuntime());
+
+  if (stdfs::exists(kTestFile)) {
+    stdfs::remove(kTestFile);
+  }
+
+  auto *cae_config = WRP_CAE_CONF;
+  REQUIRE(cae_config != nullptr);
+  const size_t page_size = cae_config->GetAdapterPageSize();
+  const size_t num_pages = 64;
+  std::vector<char> expected(page_size * num_pages);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    expected[i] = static_cast<char>((i / page_size + i) % 251);
+  }
+
+  int fd = open(kTestFile.c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+  REQUIRE(fd >= 0);
+  REQUIRE(write(fd, expected.data(), expected.size()) ==
+          static_cast<ssize_t>(expected.size()));
+  REQUIRE(close(fd) == 0);
+
+  cae_config->SetReadAheadMaxPages(8);
+
+  SECTION("Sequential half-page reads") {
+    fd = open(kTestFile.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    std::vector<char> read_data(expected.size());
+    const size_t chunk = page_size / 2;
+    for (size_t off = 0; off < read_data.size(); off += chunk) {
+      REQUIRE(read(fd, read_data.data() + off, chunk) ==
+              static_cast<ssize_t>(chunk));
+    }
+    REQUIRE(read_data == expected);
+    REQUIRE(close(fd) == 0);
+  }
+
+  SECTION("Strided page reads") {
+    fd = open(kTestFile.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    std::vector<char> page(page_size);
+    for (size_t p = 0; p < num_pages; p += 3) {
+      REQUIRE(pread(fd, page.data(), page_size, p * page_size) ==
+              static_cast<ssize_t>(page_size));
+      REQUIRE(std::memcmp(page.data(), expected.data() + p * page_size,
+                          page_size) == 0);
+    }
+    REQUIRE(close(fd) == 0);
+  }
+
+  cae_config->SetReadAheadMaxPages(0);
+  stdfs::remove(kTestFile);
+}
+
+/**
+ * POSIX Adapter Test: Stage-In on Read Miss
+ *
+ * A file written while interception is off exists only on disk; reading it
+ * through the adapter must return the file contents and stage them into CTE.
+ */
+TEST_CASE("POSIX Adapter: Stage-In on Read Miss", "[posix][adapter]") {
+  REQUIRE(initializeRuntime());
+
+  if (stdfs::exists(kTestFile)) {
+    stdfs::remove(kTestFile);
+  }
+
+  auto *cae_config = WRP_CAE_CONF;
+  REQUIRE(cae_config != nullptr);
+  const size_t page_size = cae_config->GetAdapterPageSize();
+  std::vector<char> expected(page_size * 4 + page_size / 3);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    expected[i] = static_cast<char>((i * 7) % 253);
+  }
+
+  cae_config->DisableInterception();
+  int fd = open(kTestFile.c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+  REQUIRE(fd >= 0);
+  REQUIRE(write(fd, expected.data(), expected.size()) ==
+          static_cast<ssize_t>(expected.size()));
+  REQUIRE(close(fd) == 0);
+  cae_config->EnableInterception();
+
+  SECTION("Missing pages are read from the file and staged in") {
+    for (int pass = 0; pass < 2; ++pass) {
+      fd = open(kTestFile.c_str(), O_RDONLY);
+      REQUIRE(fd >= 0);
+      std::vector<char> read_data(expected.size());
+      REQUIRE(read(fd, read_data.data(), read_data.size()) ==
+              static_cast<ssize_t>(read_data.size()));
+      REQUIRE(read_data == expected);
+      REQUIRE(close(fd) == 0);
+    }
+
+    // The first pass inserted every page into the file's tag
+    wrp_cte::core::Tag tag(stdfs::absolute(kTestFile).string());
+    REQUIRE(tag.GetBlobSize("0") == page_size);
+    REQUIRE(tag.GetBlobSize("4") == expected.size() % page_size);
+  }
+
+  stdfs::remove(kTestFile);
+}
+
+/**
+ * POSIX Adapter Test: Write-Back on Close
+ *
+ * Data written through the adapter lives in CTE until it is flushed; after
+ * fsync and close the backing file itself must hold it.
+ */
+TEST_CASE("POSIX Adapter: Write-Back to the Backing File", "[posix][adapter]") {
+  REQUIRE(initializeRuntime());
+
+  if (stdfs::exists(kTestFile)) {
+    stdfs::remove(kTestFile);
+  }
+
+  auto *cae_config = WRP_CAE_CONF;
+  REQUIRE(cae_config != nullptr);
+  const size_t page_size = cae_config->GetAdapterPageSize();
+  std::vector<char> expected(page_size * 8 + page_size / 2);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    expected[i] = static_cast<char>((i * 13) % 241);
+  }
+
+  SECTION("fsync and close write pages back") {
+    int fd = open(kTestFile.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    REQUIRE(fd >= 0);
+    REQUIRE(write(fd, expected.data(), expected.size()) ==
+            static_cast<ssize_t>(expected.size()));
+    REQUIRE(fsync(fd) == 0);
+
+    // Rewrite one page after the sync; close must write it back too
+    std::vector<char> page(page_size, 'W');
+    REQUIRE(pwrite(fd, page.data(), page_size, 3 * page_size) ==
+            static_cast<ssize_t>(page_size));
+    std::memcpy(expected.data() + 3 * page_size, page.data(), page_size);
+    REQUIRE(close(fd) == 0);
+
+    // Read the real file, bypassing CTE
+    cae_config->DisableInterception();
+    fd = open(kTestFile.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    std::vector<char> on_disk(expected.size());
+    REQUIRE(read(fd, on_disk.data(), on_disk.size()) ==
+            static_cast<ssize_t>(on_disk.size()));
+    REQUIRE(close(fd) == 0);
+    cae_config->EnableInterception();
+    REQUIRE(on_disk == expected);
+  }
+
+  SECTION("A mid-page write to an existing file keeps the bytes around it") {
+    // The file exists before it is opened through the adapter and none of
+    // its pages are in CTE
+    cae_config->DisableInterception();
+    int fd = open(kTestFile.c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    REQUIRE(fd >= 0);
+    REQUIRE(write(fd, expected.data(), expected.size()) ==
+            static_cast<ssize_t>(expected.size()));
+    REQUIRE(close(fd) == 0);
+    cae_config->EnableInterception();
+
+    fd = open(kTestFile.c_str(), O_RDWR);
+    REQUIRE(fd >= 0);
+    std::vector<char> patch(100, 'M');
+    REQUIRE(pwrite(fd, patch.data(), patch.size(), page_size + 1000) ==
+            static_cast<ssize_t>(patch.size()));
+    std::memcpy(expected.data() + page_size + 1000, patch.data(),
+                patch.size());
+    REQUIRE(close(fd) == 0);
+
+    cae_config->DisableInterception();
+    fd = open(kTestFile.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    std::vector<char> on_disk(expected.size());
+    REQUIRE(read(fd, on_disk.data(), on_disk.size()) ==
+            static_cast<ssize_t>(on_disk.size()));
+    REQUIRE(close(fd) == 0);
+    cae_config->EnableInterception();
+    REQUIRE(on_disk == expected);
+  }
+
+  stdfs::remove(kTestFile);
+}
+
+/**
+ * POSIX Adapter Test: ftruncate
+ *
+ * Shrinking a file through the adapter must drop the pages past the new size
+ * from CTE and from the backing file, and keep the bytes before it.
+ */
+TEST_CASE("POSIX Adapter: ftruncate", "[posix][adapter]") {
+  REQUIRE(initializeRuntime());
+
+  if (stdfs::exists(kTestFile)) {
+    stdfs::remove(kTestFile);
+  }
+
+  auto *cae_config = WRP_CAE_CONF;
+  REQUIRE(cae_config != nullptr);
+  const size_t page_size = cae_config->GetAdapterPageSize();
+  std::vector<char> contents(page_size * 4);
+  for (size_t i = 0; i < contents.size(); ++i) {
+    contents[i] = static_cast<char>((i * 7) % 251);
+  }
+
+  SECTION("Shrinking into the middle of a page") {
+    int fd = open(kTestFile.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    REQUIRE(fd >= 0);
+    REQUIRE(write(fd, contents.data(), contents.size()) ==
+            static_cast<ssize_t>(contents.size()));
+
+    size_t new_size = page_size + page_size / 3;
+    REQUIRE(ftruncate(fd, new_size) == 0);
+    struct stat st;
+    REQUIRE(fstat(fd, &st) == 0);
+    REQUIRE(static_cast<size_t>(st.st_size) == new_size);
+
+    // Everything before the new size survives
+    std::vector<char> out(new_size, 0);
+    REQUIRE(pread(fd, out.data(), out.size(), 0) ==
+            static_cast<ssize_t>(new_size));
+    REQUIRE(std::equal(out.begin(), out.end(), contents.begin()));
+    REQUIRE(close(fd) == 0);
+
+    // The backing file was cut as well
+    cae_config->DisableInterception();
+    REQUIRE(stdfs::file_size(kTestFile) == new_size);
+    cae_config->EnableInterception();
+  }
+
+  stdfs::remove(kTestFile);
+}
+
+/**
+ * POSIX Adapter Test: O_APPEND
+ *
+ * Appends through two descriptors of one file must land back to back after
+ * the existing contents rather than overwrite each other.
+ */
+TEST_CASE("POSIX Adapter: O_APPEND Writes", "[posix][adapter]") {
+  REQUIRE(initializeRuntime());
+
+  if (stdfs::exists(kTestFile)) {
+    stdfs::remove(kTestFile);
+  }
+
+  auto *cae_config = WRP_CAE_CONF;
+  REQUIRE(cae_config != nullptr);
+  const size_t page_size = cae_config->GetAdapterPageSize();
+
+  SECTION("Interleaved appends from two descriptors") {
+    std::vector<char> head(page_size / 2, 'h');
+    int fd = open(kTestFile.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    REQUIRE(fd >= 0);
+    REQUIRE(write(fd, head.data(), head.size()) ==
+            static_cast<ssize_t>(head.size()));
+    REQUIRE(close(fd) == 0);
+
+    int fd1 = open(kTestFile.c_str(), O_WRONLY | O_APPEND);
+    int fd2 = open(kTestFile.c_str(), O_WRONLY | O_APPEND);
+    REQUIRE(fd1 >= 0);
+    REQUIRE(fd2 >= 0);
+    const size_t record_size = page_size / 3;
+    std::vector<char> expected = head;
+    for (size_t i = 0; i < 6; ++i) {
+      std::vector<char> record(record_size, static_cast<char>('a' + i));
+      int target = (i % 2 == 0) ? fd1 : fd2;
+      REQUIRE(write(target, record.data(), record.size()) ==
+              static_cast<ssize_t>(record.size()));
+      expected.insert(expected.end(), record.begin(), record.end());
+    }
+    REQUIRE(close(fd1) == 0);
+    REQUIRE(close(fd2) == 0);
+
+    fd = open(kTestFile.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    std::vector<char> out(expected.size(), 0);
+    REQUIRE(pread(fd, out.data(), out.size(), 0) ==
+            static_cast<ssize_t>(out.size()));
+    REQUIRE(close(fd) == 0);
+    REQUIRE(out == expected);
+  }
+
+  stdfs::remove(kTestFile);
+}
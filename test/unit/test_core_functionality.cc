@@ -36,9 +36,13 @@
  */
 
 #include <catch2/catch_all.hpp>
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <thread>
 
@@ -2129,6 +2133,896 @@ TEST_CASE_METHOD(CTECoreFunctionalTestFixture,
   INFO("=== ReorganizeBlob FUNCTIONAL Test Completed Successfully ===");
 }
 
+/**
+ * FUNCTIONAL Test: ReorganizeTiers and EnforceWatermarks migration passes
+ *
+ * Stores hot and cold blobs across two targets, runs a migration pass,
+ * and verifies that any migration kept blob data and scores intact.
+ */
+TEST_CASE_METHOD(CTECoreFunctionalTestFixture,
+                 "FUNCTIONAL - ReorganizeTiers Operations",
+                 "[cte][core][blob][reorganize][functional]") {
+  chi::PoolQuery pool_query = chi::PoolQuery::Dynamic();
+  wrp_cte::core::CreateParams params;
+  REQUIRE_NOTHROW(core_client_->Create(mctx_, pool_query, kCTECorePoolName,
+                                       kCTECorePoolId, params));
+
+  const std::vector<std::string> target_suffixes = {"tier_fast", "tier_slow"};
+  for (size_t i = 0; i < target_suffixes.size(); ++i) {
+    std::string target_name = test_storage_path_ + "_" + target_suffixes[i];
+    chi::u32 result = core_client_->RegisterTarget(
+        mctx_, target_name, chimaera::bdev::BdevType::kFile, kTestTargetSize,
+        chi::PoolQuery::Local(),
+        chi::PoolId(608 + static_cast<chi::u32>(i), 0));
+    REQUIRE(result == 0);
+  }
+
+  wrp_cte::core::TagId tag_id =
+      core_client_->GetOrCreateTag(mctx_, "reorganize_tiers_tag");
+  REQUIRE((tag_id.major_ != 0 || tag_id.minor_ != 0));
+
+  const size_t num_blobs = 8;
+  const chi::u64 blob_size = 64 * 1024;
+  std::vector<std::string> blob_names;
+  std::vector<float> blob_scores;
+  for (size_t i = 0; i < num_blobs; ++i) {
+    std::string blob_name = "tier_blob_" + std::to_string(i);
+    float score = (i % 2 == 0) ? 0.9f : 0.1f;
+    auto data = CreateTestData(blob_size, static_cast<char>('a' + i));
+    hipc::FullPtr<char> put_buffer = CHI_IPC->AllocateBuffer(blob_size);
+    REQUIRE(!put_buffer.IsNull());
+    REQUIRE(CopyToSharedMemory(put_buffer, data));
+    REQUIRE(core_client_->PutBlob(mctx_, tag_id, blob_name, 0, blob_size,
+                                  put_buffer.shm_, score, 0));
+    blob_names.push_back(blob_name);
+    blob_scores.push_back(score);
+  }
+
+  SECTION("Reorganization pass preserves data and scores") {
+    auto task = core_client_->AsyncReorganizeTiers(mctx_, 0);
+    REQUIRE(!task.IsNull());
+    REQUIRE(WaitForTaskCompletion(task, 30000));
+    REQUIRE(task->return_code_.load() == 0);
+    INFO("Promoted " << task->blobs_promoted_ << ", demoted "
+                     << task->blobs_demoted_ << ", bytes "
+                     << task->bytes_moved_);
+    REQUIRE(task->bytes_moved_ ==
+            (task->blobs_promoted_ + task->blobs_demoted_) * blob_size);
+    CHI_IPC->DelTask(task);
+
+    for (size_t i = 0; i < num_blobs; ++i) {
+      float score = core_client_->GetBlobScore(mctx_, tag_id, blob_names[i]);
+      REQUIRE(std::abs(score - blob_scores[i]) < 0.01f);
+
+      hipc::FullPtr<char> get_buffer = CHI_IPC->AllocateBuffer(blob_size);
+      REQUIRE(!get_buffer.IsNull());
+      REQUIRE(core_client_->GetBlob(mctx_, tag_id, blob_names[i], 0, blob_size,
+                                    0, get_buffer.shm_));
+      auto retrieved = CopyFromSharedMemory(get_buffer.shm_, blob_size);
+      REQUIRE(VerifyTestData(retrieved, static_cast<char>('a' + i)));
+    }
+  }
+
+  SECTION("A limited pass migrates at most max_blobs per container") {
+    chi::u32 moved = core_client_->ReorganizeTiers(mctx_, 1);
+    REQUIRE(moved <= 1);
+  }
+
+  SECTION("Watermark pass only demotes and preserves data") {
+    auto task = core_client_->AsyncEnforceWatermarks(mctx_, 0);
+    REQUIRE(!task.IsNull());
+    REQUIRE(WaitForTaskCompletion(task, 30000));
+    REQUIRE(task->return_code_.load() == 0);
+    if (task->targets_over_ == 0) {
+      REQUIRE(task->blobs_demoted_ == 0);
+    }
+    REQUIRE(task->bytes_moved_ == task->blobs_demoted_ * blob_size);
+    CHI_IPC->DelTask(task);
+
+    for (size_t i = 0; i < num_blobs; ++i) {
+      hipc::FullPtr<char> get_buffer = CHI_IPC->AllocateBuffer(blob_size);
+      REQUIRE(!get_buffer.IsNull());
+      REQUIRE(core_client_->GetBlob(mctx_, tag_id, blob_names[i], 0, blob_size,
+                                    0, get_buffer.shm_));
+      auto retrieved = CopyFromSharedMemory(get_buffer.shm_, blob_size);
+      REQUIRE(VerifyTestData(retrieved, static_cast<char>('a' + i)));
+    }
+  }
+}
+
+TEST_CASE_METHOD(CTECoreFunctionalTestFixture,
+                 "FUNCTIONAL - GetRuntimeStats Operations",
+                 "[cte][core][stats][functional]") {
+  chi::PoolQuery pool_query = chi::PoolQuery::Dynamic();
+  wrp_cte::core::CreateParams params;
+  REQUIRE_NOTHROW(core_client_->Create(mctx_, pool_query, kCTECorePoolName,
+                                       kCTECorePoolId, params));
+
+  std::string target_name = test_storage_path_ + "_stats";
+  chi::PoolId target_id(610, 0);
+  REQUIRE(core_client_->RegisterTarget(
+              mctx_, target_name, chimaera::bdev::BdevType::kFile,
+              kTestTargetSize, chi::PoolQuery::Local(), target_id) == 0);
+
+  wrp_cte::core::TagId tag_id =
+      core_client_->GetOrCreateTag(mctx_, "runtime_stats_tag");
+  REQUIRE((tag_id.major_ != 0 || tag_id.minor_ != 0));
+
+  // Start from empty histograms; target counters are cumulative, so keep a
+  // baseline (blobs may land on targets registered by earlier tests)
+  auto sum_target_bytes = [](const wrp_cte::core::RuntimeStatsReport &r,
+                             bool written) {
+    chi::u64 total = 0;
+    for (const auto &stats : r.targets_) {
+      total += written ? stats.bytes_written_ : stats.bytes_read_;
+    }
+    return total;
+  };
+  wrp_cte::core::RuntimeStatsReport baseline =
+      core_client_->GetRuntimeStats(mctx_, true);
+  REQUIRE(!baseline.targets_.empty());
+
+  const size_t num_blobs = 4;
+  const chi::u64 blob_size = 16 * 1024;
+  for (size_t i = 0; i < num_blobs; ++i) {
+    std::string blob_name = "stats_blob_" + std::to_string(i);
+    auto data = CreateTestData(blob_size, static_cast<char>('s' + i));
+    hipc::FullPtr<char> buffer = CHI_IPC->AllocateBuffer(blob_size);
+    REQUIRE(!buffer.IsNull());
+    REQUIRE(CopyToSharedMemory(buffer, data));
+    REQUIRE(core_client_->PutBlob(mctx_, tag_id, blob_name, 0, blob_size,
+                                  buffer.shm_, 0.5f, 0));
+    REQUIRE(core_client_->GetBlob(mctx_, tag_id, blob_name, 0, blob_size, 0,
+                                  buffer.shm_));
+  }
+
+  wrp_cte::core::RuntimeStatsReport report =
+      core_client_->GetRuntimeStats(mctx_);
+
+  auto find_series = [&report](wrp_cte::core::StatOp op,
+                               wrp_cte::core::StatPhase phase)
+      -> const wrp_cte::core::LatencySummary * {
+    for (const auto &summary : report.latencies_) {
+      if (summary.op_ == static_cast<chi::u32>(op) &&
+          summary.phase_ == static_cast<chi::u32>(phase)) {
+        return &summary;
+      }
+    }
+    return nullptr;
+  };
+
+  SECTION("Latency histograms count every operation") {
+    for (auto op : {wrp_cte::core::StatOp::kPutBlob,
+                    wrp_cte::core::StatOp::kGetBlob}) {
+      const auto *total = find_series(op, wrp_cte::core::StatPhase::kTotal);
+      REQUIRE(total != nullptr);
+      REQUIRE(total->count_ == num_blobs);
+      REQUIRE(total->min_ns_ <= total->p50_ns_);
+      REQUIRE(total->p50_ns_ <= total->p99_ns_);
+      REQUIRE(total->p99_ns_ <= total->max_ns_);
+
+      const auto *wait = find_series(op, wrp_cte::core::StatPhase::kWait);
+      REQUIRE(wait != nullptr);
+      REQUIRE(wait->sum_ns_ <= total->sum_ns_);
+    }
+  }
+
+  SECTION("Target counters track completed I/O") {
+    bool found = false;
+    for (const auto &stats : report.targets_) {
+      found = found || (stats.target_id_ == target_id);
+    }
+    REQUIRE(found);
+    REQUIRE(sum_target_bytes(report, true) -
+                sum_target_bytes(baseline, true) ==
+            num_blobs * blob_size);
+    REQUIRE(sum_target_bytes(report, false) -
+                sum_target_bytes(baseline, false) ==
+            num_blobs * blob_size);
+  }
+
+  SECTION("Reset clears the histograms") {
+    core_client_->GetRuntimeStats(mctx_, true);
+    report = core_client_->GetRuntimeStats(mctx_);
+    REQUIRE(find_series(wrp_cte::core::StatOp::kPutBlob,
+                        wrp_cte::core::StatPhase::kTotal) == nullptr);
+  }
+}
+
+TEST_CASE_METHOD(CTECoreFunctionalTestFixture,
+                 "FUNCTIONAL - Batched PutBlobs/GetBlobs Operations",
+                 "[cte][core][blob][batch][functional]") {
+  chi::PoolQuery pool_query = chi::PoolQuery::Dynamic();
+  wrp_cte::core::CreateParams params;
+  REQUIRE_NOTHROW(core_client_->Create(mctx_, pool_query, kCTECorePoolName,
+                                       kCTECorePoolId, params));
+
+  std::string target_name = test_storage_path_ + "_batch";
+  REQUIRE(core_client_->RegisterTarget(
+              mctx_, target_name, chimaera::bdev::BdevType::kFile,
+              kTestTargetSize, chi::PoolQuery::Local(),
+              chi::PoolId(611, 0)) == 0);
+
+  wrp_cte::core::TagId tag_id =
+      core_client_->GetOrCreateTag(mctx_, "batch_blob_tag");
+  REQUIRE((tag_id.major_ != 0 || tag_id.minor_ != 0));
+
+  const size_t num_blobs = 16;
+  const chi::u64 blob_size = 4096;
+  hipc::FullPtr<char> put_buffer =
+      CHI_IPC->AllocateBuffer(num_blobs * blob_size);
+  REQUIRE(!put_buffer.IsNull());
+  std::vector<wrp_cte::core::BlobIoRequest> puts;
+  for (size_t i = 0; i < num_blobs; ++i) {
+    std::memset(put_buffer.ptr_ + i * blob_size, static_cast<int>('A' + i),
+                blob_size);
+    puts.emplace_back("batch_blob_" + std::to_string(i), 0, blob_size,
+                      put_buffer.shm_ + i * blob_size, 0.5f);
+  }
+  REQUIRE(core_client_->PutBlobs(mctx_, tag_id, puts));
+  for (const auto &request : puts) {
+    REQUIRE(request.return_code_ == 0);
+  }
+  REQUIRE(core_client_->GetTagSize(mctx_, tag_id) == num_blobs * blob_size);
+
+  SECTION("GetBlobs returns every blob's data") {
+    hipc::FullPtr<char> get_buffer =
+        CHI_IPC->AllocateBuffer(num_blobs * blob_size);
+    REQUIRE(!get_buffer.IsNull());
+    std::vector<wrp_cte::core::BlobIoRequest> gets;
+    for (size_t i = 0; i < num_blobs; ++i) {
+      gets.emplace_back("batch_blob_" + std::to_string(i), 0, blob_size,
+                        get_buffer.shm_ + i * blob_size);
+    }
+    REQUIRE(core_client_->GetBlobs(mctx_, tag_id, gets));
+    for (size_t i = 0; i < num_blobs; ++i) {
+      REQUIRE(gets[i].return_code_ == 0);
+      REQUIRE(get_buffer.ptr_[i * blob_size] == static_cast<char>('A' + i));
+      REQUIRE(get_buffer.ptr_[(i + 1) * blob_size - 1] ==
+              static_cast<char>('A' + i));
+    }
+  }
+
+  SECTION("Per-blob failures do not fail the rest of the batch") {
+    hipc::FullPtr<char> get_buffer = CHI_IPC->AllocateBuffer(2 * blob_size);
+    REQUIRE(!get_buffer.IsNull());
+    std::vector<wrp_cte::core::BlobIoRequest> gets;
+    gets.emplace_back("batch_blob_3", 0, blob_size, get_buffer.shm_);
+    gets.emplace_back("missing_blob", 0, blob_size,
+                      get_buffer.shm_ + blob_size);
+    REQUIRE_FALSE(core_client_->GetBlobs(mctx_, tag_id, gets));
+    REQUIRE(gets[0].return_code_ == 0);
+    REQUIRE(gets[1].return_code_ != 0);
+    REQUIRE(get_buffer.ptr_[0] == 'D');
+  }
+}
+
+TEST_CASE_METHOD(CTECoreFunctionalTestFixture,
+                 "FUNCTIONAL - Tag IoBuffer Staging Pool",
+                 "[cte][core][blob][staging][functional]") {
+  chi::PoolQuery pool_query = chi::PoolQuery::Dynamic();
+  wrp_cte::core::CreateParams params;
+  REQUIRE_NOTHROW(core_client_->Create(mctx_, pool_query, kCTECorePoolName,
+                                       kCTECorePoolId, params));
+
+  std::string target_name = test_storage_path_ + "_staging";
+  REQUIRE(core_client_->RegisterTarget(
+              mctx_, target_name, chimaera::bdev::BdevType::kFile,
+              kTestTargetSize, chi::PoolQuery::Local(),
+              chi::PoolId(612, 0)) == 0);
+
+  wrp_cte::core::Tag tag("staging_pool_tag");
+  const size_t blob_size = 8192;
+
+  SECTION("IoBuffer round trip without staging copies") {
+    wrp_cte::core::IoBuffer put_buffer =
+        wrp_cte::core::Tag::AllocateIoBuffer(blob_size);
+    REQUIRE(!put_buffer.IsNull());
+    REQUIRE(put_buffer.size() == blob_size);
+    std::memset(put_buffer.data(), 'Z', blob_size);
+    REQUIRE_NOTHROW(tag.PutBlob("iobuf_blob", put_buffer));
+
+    wrp_cte::core::IoBuffer get_buffer =
+        wrp_cte::core::Tag::AllocateIoBuffer(blob_size);
+    REQUIRE_NOTHROW(tag.GetBlob("iobuf_blob", get_buffer));
+    REQUIRE(get_buffer.data()[0] == 'Z');
+    REQUIRE(get_buffer.data()[blob_size - 1] == 'Z');
+  }
+
+  SECTION("Released buffers are reused by the same thread") {
+    auto &pool = wrp_cte::core::StagingPool::Get();
+    pool.Trim();
+    hipc::Pointer first_shm;
+    {
+      wrp_cte::core::IoBuffer buffer(blob_size);
+      REQUIRE(!buffer.IsNull());
+      first_shm = buffer.shm();
+    }
+    REQUIRE(pool.GetCachedBytes() ==
+            wrp_cte::core::StagingPool::GetCapacity(blob_size));
+    wrp_cte::core::IoBuffer reused(blob_size - 1);
+    REQUIRE(reused.shm() == first_shm);
+    REQUIRE(pool.GetCachedBytes() == 0);
+  }
+
+  SECTION("Raw PutBlob/GetBlob go through the pool") {
+    std::vector<char> data(blob_size, 'Q');
+    REQUIRE_NOTHROW(tag.PutBlob("raw_blob", data.data(), blob_size));
+    std::vector<char> out(blob_size, 0);
+    REQUIRE_NOTHROW(tag.GetBlob("raw_blob", out.data(), blob_size));
+    REQUIRE(out == data);
+    REQUIRE(wrp_cte::core::StagingPool::Get().GetCachedBytes() > 0);
+  }
+}
+
+TEST_CASE_METHOD(CTECoreFunctionalTestFixture,
+                 "FUNCTIONAL - StageIn Operations",
+                 "[cte][core][blob][stage_in][functional]") {
+  chi::PoolQuery pool_query = chi::PoolQuery::Dynamic();
+  wrp_cte::core::CreateParams params;
+  REQUIRE_NOTHROW(core_client_->Create(mctx_, pool_query, kCTECorePoolName,
+                                       kCTECorePoolId, params));
+
+  std::string target_name = test_storage_path_ + "_stage_in";
+  REQUIRE(core_client_->RegisterTarget(
+              mctx_, target_name, chimaera::bdev::BdevType::kFile,
+              kTestTargetSize, chi::PoolQuery::Local(),
+              chi::PoolId(613, 0)) == 0);
+
+  // Backing file of 3.5 pages; page i is filled with 'a' + i
+  const size_t page_size = 4096;
+  const size_t file_size = 3 * page_size + page_size / 2;
+  std::string file_path = test_storage_path_ + "_stage_in_file.bin";
+  {
+    std::ofstream out(file_path, std::ios::binary | std::ios::trunc);
+    for (size_t i = 0; i < file_size; ++i) {
+      out.put(static_cast<char>('a' + i / page_size));
+    }
+  }
+
+  SECTION("Whole file is staged one blob per page") {
+    REQUIRE(core_client_->StageIn(mctx_, file_path, page_size) == file_size);
+
+    wrp_cte::core::Tag tag(file_path);
+    REQUIRE(tag.GetBlobSize("3") == page_size / 2);
+    std::vector<char> out(page_size, 0);
+    REQUIRE_NOTHROW(tag.GetBlob("2", out.data(), page_size));
+    REQUIRE(out[0] == 'c');
+    REQUIRE(out[page_size - 1] == 'c');
+  }
+
+  SECTION("Staging never replaces existing blobs") {
+    wrp_cte::core::Tag tag(file_path);
+    std::vector<char> newer(page_size, 'Z');
+    REQUIRE_NOTHROW(tag.PutBlob("1", newer.data(), page_size));
+
+    REQUIRE(core_client_->StageIn(mctx_, file_path, page_size, page_size,
+                                  2 * page_size) == 2 * page_size);
+    std::vector<char> out(page_size, 0);
+    REQUIRE_NOTHROW(tag.GetBlob("1", out.data(), page_size));
+    REQUIRE(out[0] == 'Z');
+    REQUIRE_NOTHROW(tag.GetBlob("2", out.data(), page_size));
+    REQUIRE(out[0] == 'c');
+  }
+
+  SECTION("Missing blobs report kBlobNotFound") {
+    wrp_cte::core::Tag tag(file_path);
+    std::vector<wrp_cte::core::BlobIoRequest> requests;
+    requests.emplace_back("0", 0, page_size);
+    std::vector<char> out(page_size, 0);
+    REQUIRE_THROWS(tag.GetBlobs(requests, out.data()));
+    REQUIRE(requests[0].return_code_ == wrp_cte::core::kBlobNotFound);
+  }
+
+  SECTION("Missing files fail") {
+    REQUIRE(core_client_->StageIn(mctx_, file_path + ".missing", page_size) ==
+            0);
+  }
+
+  std::filesystem::remove(file_path);
+}
+
+TEST_CASE_METHOD(CTECoreFunctionalTestFixture,
+                 "FUNCTIONAL - FlushTag Operations",
+                 "[cte][core][blob][flush][functional]") {
+  chi::PoolQuery pool_query = chi::PoolQuery::Dynamic();
+  wrp_cte::core::CreateParams params;
+  REQUIRE_NOTHROW(core_client_->Create(mctx_, pool_query, kCTECorePoolName,
+                                       kCTECorePoolId, params));
+
+  std::string target_name = test_storage_path_ + "_flush";
+  REQUIRE(core_client_->RegisterTarget(
+              mctx_, target_name, chimaera::bdev::BdevType::kFile,
+              kTestTargetSize, chi::PoolQuery::Local(),
+              chi::PoolId(614, 0)) == 0);
+
+  // Write-back never creates the backing file
+  const size_t page_size = 4096;
+  std::string file_path = test_storage_path_ + "_flush_file.bin";
+  { std::ofstream out(file_path, std::ios::binary | std::ios::trunc); }
+
+  wrp_cte::core::Tag tag(file_path);
+  auto read_file = [](const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in),
+                             std::istreambuf_iterator<char>());
+  };
+
+  SECTION("Dirty pages are coalesced and written back once") {
+    // Register the file before writing, as the adapter does on open
+    REQUIRE(core_client_->FlushTag(mctx_, tag.GetTagId(), file_path, page_size)
+                .success_);
+
+    // Pages 0-1 are full, page 2 is the partial last page
+    std::vector<char> expected(2 * page_size + page_size / 4);
+    for (size_t p = 0; p < 3; ++p) {
+      size_t len = std::min(page_size, expected.size() - p * page_size);
+      std::memset(expected.data() + p * page_size, 'a' + p, len);
+      REQUIRE_NOTHROW(tag.PutBlob(std::to_string(p),
+                                  expected.data() + p * page_size, len));
+    }
+
+    wrp_cte::core::FlushReport report =
+        core_client_->FlushTag(mctx_, tag.GetTagId(), file_path, page_size,
+                               wrp_cte::core::kFlushDurable);
+    REQUIRE(report.success_);
+    REQUIRE(report.pages_ == 3);
+    REQUIRE(report.bytes_ == expected.size());
+    REQUIRE(read_file(file_path) == expected);
+
+    // Nothing changed since
+    report = core_client_->FlushTag(mctx_, tag.GetTagId(), file_path,
+                                    page_size);
+    REQUIRE(report.success_);
+    REQUIRE(report.bytes_ == 0);
+
+    // Only the rewritten page goes out
+    std::vector<char> page(page_size, 'Z');
+    REQUIRE_NOTHROW(tag.PutBlob("1", page.data(), page_size));
+    std::memcpy(expected.data() + page_size, page.data(), page_size);
+    report = core_client_->FlushTag(mctx_, tag.GetTagId(), file_path,
+                                    page_size);
+    REQUIRE(report.success_);
+    REQUIRE(report.pages_ == 1);
+    REQUIRE(read_file(file_path) == expected);
+  }
+
+  SECTION("Partial writes leave the rest of an existing file alone") {
+    // An existing file whose pages were never staged into CTE
+    std::string existing_path = file_path + ".existing";
+    std::vector<char> expected(2 * page_size, 'x');
+    {
+      std::ofstream out(existing_path, std::ios::binary | std::ios::trunc);
+      out.write(expected.data(), expected.size());
+    }
+    wrp_cte::core::Tag existing(existing_path);
+    REQUIRE(core_client_
+                ->FlushTag(mctx_, existing.GetTagId(), existing_path, page_size)
+                .success_);
+
+    // One mid-page write to page 0, two disjoint ones to page 1
+    std::vector<char> patch(100, 'P');
+    REQUIRE_NOTHROW(existing.PutBlob("0", patch.data(), 100, 1000));
+    REQUIRE_NOTHROW(existing.PutBlob("1", patch.data(), 10, 50));
+    REQUIRE_NOTHROW(existing.PutBlob("1", patch.data(), 10, 70));
+    std::memset(expected.data() + 1000, 'P', 100);
+    std::memset(expected.data() + page_size + 50, 'P', 10);
+    std::memset(expected.data() + page_size + 70, 'P', 10);
+
+    wrp_cte::core::FlushReport report = core_client_->FlushTag(
+        mctx_, existing.GetTagId(), existing_path, page_size);
+    REQUIRE(report.success_);
+    REQUIRE(report.pages_ == 2);
+    REQUIRE(report.bytes_ == 120);
+    REQUIRE(read_file(existing_path) == expected);
+    std::filesystem::remove(existing_path);
+  }
+
+  SECTION("Writes to an unregistered tag are not tracked") {
+    std::string unregistered_path = file_path + ".unregistered";
+    { std::ofstream out(unregistered_path, std::ios::binary | std::ios::trunc); }
+    wrp_cte::core::Tag unregistered(unregistered_path);
+    std::vector<char> page(page_size, 'u');
+    REQUIRE_NOTHROW(unregistered.PutBlob("0", page.data(), page_size));
+
+    // Registering afterwards finds nothing dirty
+    wrp_cte::core::FlushReport report = core_client_->FlushTag(
+        mctx_, unregistered.GetTagId(), unregistered_path, page_size);
+    REQUIRE(report.success_);
+    REQUIRE(report.bytes_ == 0);
+    REQUIRE(read_file(unregistered_path).empty());
+    std::filesystem::remove(unregistered_path);
+  }
+
+  SECTION("Staged-in pages are not written back") {
+    std::string staged_path = file_path + ".staged";
+    std::vector<char> expected(2 * page_size, 's');
+    {
+      std::ofstream out(staged_path, std::ios::binary | std::ios::trunc);
+      out.write(expected.data(), expected.size());
+    }
+    REQUIRE(core_client_->StageIn(mctx_, staged_path, page_size) ==
+            expected.size());
+    wrp_cte::core::Tag staged(staged_path);
+    wrp_cte::core::FlushReport report = core_client_->FlushTag(
+        mctx_, staged.GetTagId(), staged_path, page_size);
+    REQUIRE(report.success_);
+    REQUIRE(report.bytes_ == 0);
+    REQUIRE(read_file(staged_path) == expected);
+    std::filesystem::remove(staged_path);
+  }
+
+  SECTION("Invalid requests fail") {
+    REQUIRE_FALSE(core_client_->FlushTag(mctx_, tag.GetTagId(), "", page_size)
+                      .success_);
+    REQUIRE_FALSE(
+        core_client_->FlushTag(mctx_, tag.GetTagId(), file_path, 0).success_);
+  }
+
+  std::filesystem::remove(file_path);
+}
+
+TEST_CASE_METHOD(CTECoreFunctionalTestFixture,
+                 "FUNCTIONAL - Truncate Operations",
+                 "[cte][core][blob][truncate][functional]") {
+  chi::PoolQuery pool_query = chi::PoolQuery::Dynamic();
+  wrp_cte::core::CreateParams params;
+  REQUIRE_NOTHROW(core_client_->Create(mctx_, pool_query, kCTECorePoolName,
+                                       kCTECorePoolId, params));
+
+  std::string target_name = test_storage_path_ + "_truncate";
+  REQUIRE(core_client_->RegisterTarget(
+              mctx_, target_name, chimaera::bdev::BdevType::kFile,
+              kTestTargetSize, chi::PoolQuery::Local(),
+              chi::PoolId(615, 0)) == 0);
+
+  const size_t page_size = 4096;
+  wrp_cte::core::Tag tag("truncate_test_file");
+
+  // Four full pages holding 'a', 'b', 'c', 'd'
+  std::vector<char> contents(4 * page_size);
+  for (size_t p = 0; p < 4; ++p) {
+    std::memset(contents.data() + p * page_size, 'a' + p, page_size);
+    REQUIRE_NOTHROW(tag.PutBlob(std::to_string(p),
+                                contents.data() + p * page_size, page_size));
+  }
+  REQUIRE(core_client_->GetTagSize(mctx_, tag.GetTagId()) == contents.size());
+
+  SECTION("Pages past the new size are deleted and the last one shrunk") {
+    size_t new_size = page_size + page_size / 2;
+    REQUIRE(core_client_->TruncateTag(mctx_, tag.GetTagId(), new_size,
+                                      page_size));
+    REQUIRE(core_client_->GetTagSize(mctx_, tag.GetTagId()) == new_size);
+    REQUIRE(tag.GetBlobSize("0") == page_size);
+    REQUIRE(tag.GetBlobSize("1") == page_size / 2);
+    REQUIRE(tag.GetBlobSize("2") == 0);
+    REQUIRE(tag.GetBlobSize("3") == 0);
+
+    // The kept head of the boundary page is intact
+    std::vector<char> out(page_size / 2, 0);
+    REQUIRE_NOTHROW(tag.GetBlob("1", out.data(), out.size()));
+    REQUIRE(std::all_of(out.begin(), out.end(),
+                        [](char c) { return c == 'b'; }));
+
+    // The freed space can be written again
+    REQUIRE_NOTHROW(tag.PutBlob("2", contents.data(), page_size));
+    REQUIRE(tag.GetBlobSize("2") == page_size);
+  }
+
+  SECTION("A page-aligned size deletes whole pages only") {
+    REQUIRE(core_client_->TruncateTag(mctx_, tag.GetTagId(), 2 * page_size,
+                                      page_size));
+    REQUIRE(core_client_->GetTagSize(mctx_, tag.GetTagId()) == 2 * page_size);
+    REQUIRE(tag.GetBlobSize("1") == page_size);
+    REQUIRE(tag.GetBlobSize("2") == 0);
+  }
+
+  SECTION("Truncating to zero empties the tag") {
+    REQUIRE(core_client_->TruncateTag(mctx_, tag.GetTagId(), 0, page_size));
+    REQUIRE(core_client_->GetTagSize(mctx_, tag.GetTagId()) == 0);
+    REQUIRE(tag.GetContainedBlobs().empty());
+  }
+
+  SECTION("TruncateBlob leaves smaller blobs alone") {
+    REQUIRE(core_client_->TruncateBlob(mctx_, tag.GetTagId(), "0",
+                                       2 * page_size));
+    REQUIRE(tag.GetBlobSize("0") == page_size);
+    REQUIRE(core_client_->TruncateBlob(mctx_, tag.GetTagId(), "0", 100));
+    REQUIRE(tag.GetBlobSize("0") == 100);
+    REQUIRE_FALSE(
+        core_client_->TruncateBlob(mctx_, tag.GetTagId(), "missing", 0));
+  }
+
+  SECTION("Invalid requests fail") {
+    REQUIRE_FALSE(
+        core_client_->TruncateTag(mctx_, tag.GetTagId(), page_size, 0));
+  }
+}
+
+TEST_CASE_METHOD(CTECoreFunctionalTestFixture,
+                 "FUNCTIONAL - AppendToTag Operations",
+                 "[cte][core][blob][append][functional]") {
+  chi::PoolQuery pool_query = chi::PoolQuery::Dynamic();
+  wrp_cte::core::CreateParams params;
+  REQUIRE_NOTHROW(core_client_->Create(mctx_, pool_query, kCTECorePoolName,
+                                       kCTECorePoolId, params));
+
+  std::string target_name = test_storage_path_ + "_append";
+  REQUIRE(core_client_->RegisterTarget(
+              mctx_, target_name, chimaera::bdev::BdevType::kFile,
+              kTestTargetSize, chi::PoolQuery::Local(),
+              chi::PoolId(616, 0)) == 0);
+
+  const size_t page_size = 4096;
+  wrp_cte::core::Tag tag("append_test_file");
+
+  SECTION("Appends land back to back across page boundaries") {
+    // One full page already in the file
+    std::vector<char> head(page_size, 'h');
+    REQUIRE_NOTHROW(tag.PutBlob("0", head.data(), head.size()));
+
+    const size_t record_size = page_size / 2 + 100;
+    for (size_t i = 0; i < 3; ++i) {
+      auto buffer = wrp_cte::core::Tag::AllocateIoBuffer(record_size);
+      REQUIRE_FALSE(buffer.IsNull());
+      std::memset(buffer.data(), 'a' + i, record_size);
+      chi::u64 offset = 0;
+      REQUIRE(core_client_->AppendToTag(mctx_, tag.GetTagId(), buffer.shm(),
+                                        record_size, page_size, offset));
+      REQUIRE(offset == page_size + i * record_size);
+    }
+    REQUIRE(core_client_->GetTagSize(mctx_, tag.GetTagId()) ==
+            page_size + 3 * record_size);
+
+    // The second record starts inside page 1 and ends inside page 2
+    chi::u64 second = page_size + record_size;
+    std::vector<char> out(page_size - second % page_size, 0);
+    REQUIRE_NOTHROW(tag.GetBlob("1", out.data(), out.size(),
+                                second % page_size));
+    REQUIRE(std::all_of(out.begin(), out.end(),
+                        [](char c) { return c == 'b'; }));
+  }
+
+  SECTION("Concurrent appends get disjoint ranges") {
+    const size_t kThreads = 4;
+    const size_t kAppendsPerThread = 8;
+    const size_t record_size = 1000;
+    std::vector<std::vector<chi::u64>> offsets(kThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        for (size_t i = 0; i < kAppendsPerThread; ++i) {
+          auto buffer = wrp_cte::core::Tag::AllocateIoBuffer(record_size);
+          std::memset(buffer.data(), 'A' + t, record_size);
+          chi::u64 offset = 0;
+          if (core_client_->AppendToTag(mctx_, tag.GetTagId(), buffer.shm(),
+                                        record_size, page_size, offset)) {
+            offsets[t].push_back(offset);
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    std::vector<chi::u64> all;
+    for (const auto &thread_offsets : offsets) {
+      REQUIRE(thread_offsets.size() == kAppendsPerThread);
+      all.insert(all.end(), thread_offsets.begin(), thread_offsets.end());
+    }
+    std::sort(all.begin(), all.end());
+    for (size_t i = 0; i < all.size(); ++i) {
+      REQUIRE(all[i] == i * record_size);
+    }
+    REQUIRE(core_client_->GetTagSize(mctx_, tag.GetTagId()) ==
+            all.size() * record_size);
+  }
+
+  SECTION("Appends start at or past the caller's floor") {
+    // An existing file of 10000 bytes none of whose pages are in CTE
+    auto buffer = wrp_cte::core::Tag::AllocateIoBuffer(100);
+    std::memset(buffer.data(), 'f', 100);
+    chi::u64 offset = 0;
+    REQUIRE(core_client_->AppendToTag(mctx_, tag.GetTagId(), buffer.shm(),
+                                      100, page_size, offset, 1.0f, 10000));
+    REQUIRE(offset == 10000);
+    REQUIRE(core_client_->AppendToTag(mctx_, tag.GetTagId(), buffer.shm(),
+                                      100, page_size, offset, 1.0f, 10000));
+    REQUIRE(offset == 10100);
+  }
+
+  SECTION("Appends see positional writes that extended the tag") {
+    auto buffer = wrp_cte::core::Tag::AllocateIoBuffer(page_size);
+    std::memset(buffer.data(), 'p', page_size);
+
+    // Data written before the first append seeds the cursor
+    std::vector<char> head(100, 'w');
+    REQUIRE_NOTHROW(tag.PutBlob("0", head.data(), head.size()));
+    chi::u64 offset = 0;
+    REQUIRE(core_client_->AppendToTag(mctx_, tag.GetTagId(), buffer.shm(),
+                                      100, page_size, offset));
+    REQUIRE(offset == 100);
+
+    // A later write through another descriptor fills the rest of page 0; it
+    // runs on the tag's append owner (the only container here) and raises
+    // the cursor without a tag size query
+    std::vector<char> rest(page_size - 200, 'w');
+    REQUIRE_NOTHROW(tag.PutBlob("0", rest.data(), rest.size(), 200));
+    REQUIRE(core_client_->AppendToTag(mctx_, tag.GetTagId(), buffer.shm(),
+                                      100, page_size, offset));
+    REQUIRE(offset == page_size);
+
+    // Writes the owner never sees are covered by the caller's floor
+    REQUIRE(core_client_->AppendToTag(mctx_, tag.GetTagId(), buffer.shm(),
+                                      100, page_size, offset, 1.0f,
+                                      3 * page_size));
+    REQUIRE(offset == 3 * page_size);
+  }
+
+  SECTION("Appends continue at the end after a truncate") {
+    auto buffer = wrp_cte::core::Tag::AllocateIoBuffer(page_size);
+    std::memset(buffer.data(), 'x', page_size);
+    chi::u64 offset = 0;
+    REQUIRE(core_client_->AppendToTag(mctx_, tag.GetTagId(), buffer.shm(),
+                                      page_size, page_size, offset));
+    REQUIRE(core_client_->TruncateTag(mctx_, tag.GetTagId(), 100, page_size));
+    REQUIRE(core_client_->AppendToTag(mctx_, tag.GetTagId(), buffer.shm(),
+                                      page_size, page_size, offset));
+    REQUIRE(offset == 100);
+  }
+
+  SECTION("Invalid requests fail") {
+    auto buffer = wrp_cte::core::Tag::AllocateIoBuffer(page_size);
+    chi::u64 offset = 0;
+    REQUIRE_FALSE(core_client_->AppendToTag(mctx_, tag.GetTagId(),
+                                            buffer.shm(), page_size, 0,
+                                            offset));
+    REQUIRE_FALSE(core_client_->AppendToTag(mctx_, tag.GetTagId(),
+                                            buffer.shm(), 0, page_size,
+                                            offset));
+  }
+}
+
+TEST_CASE_METHOD(CTECoreFunctionalTestFixture,
+                 "FUNCTIONAL - Rebalance Blobs",
+                 "[cte][core][blob][rebalance][functional]") {
+  chi::PoolQuery pool_query = chi::PoolQuery::Dynamic();
+  wrp_cte::core::CreateParams params;
+  REQUIRE_NOTHROW(core_client_->Create(mctx_, pool_query, kCTECorePoolName,
+                                       kCTECorePoolId, params));
+
+  std::string target_name = test_storage_path_ + "_rebalance";
+  REQUIRE(core_client_->RegisterTarget(
+              mctx_, target_name, chimaera::bdev::BdevType::kFile,
+              kTestTargetSize, chi::PoolQuery::Local(),
+              chi::PoolId(617, 0)) == 0);
+
+  wrp_cte::core::Tag tag("rebalance_test_tag");
+  const size_t blob_size = 4096;
+  const size_t kNumBlobs = 16;
+  for (size_t i = 0; i < kNumBlobs; ++i) {
+    std::vector<char> data(blob_size, static_cast<char>('a' + i));
+    REQUIRE_NOTHROW(tag.PutBlob("blob_" + std::to_string(i), data.data(),
+                                data.size()));
+  }
+
+  // Every blob already lives on the container the ring assigns it to
+  REQUIRE(core_client_->RebalanceBlobs(mctx_) == 0);
+
+  for (size_t i = 0; i < kNumBlobs; ++i) {
+    std::vector<char> out(blob_size, 0);
+    REQUIRE_NOTHROW(tag.GetBlob("blob_" + std::to_string(i), out.data(),
+                                out.size()));
+    REQUIRE(std::all_of(out.begin(), out.end(), [i](char c) {
+      return c == static_cast<char>('a' + i);
+    }));
+  }
+  REQUIRE(core_client_->GetTagSize(mctx_, tag.GetTagId()) ==
+          kNumBlobs * blob_size);
+}
+
+/**
+ * FUNCTIONAL Test: Striped Allocation
+ *
+ * This test verifies:
+ * 1. A pool created with stripe_width 2 stripes a multi-unit blob even when
+ *    neither target could hold the whole blob on its own
+ * 2. Consecutive stripe units land on alternating targets
+ * 3. The striped blob reads back intact
+ */
+TEST_CASE_METHOD(CTECoreFunctionalTestFixture,
+                 "FUNCTIONAL - Striped Allocation",
+                 "[cte][core][blob][stripe][functional]") {
+  const chi::u64 kStripeUnit = 64 * 1024;
+  const chi::u64 kNumUnits = 8;
+  const chi::u64 kBlobSize = kStripeUnit * kNumUnits;
+  // Each target holds six units: more than its half, less than the blob
+  const chi::u64 kStripeTargetSize = kStripeUnit * 6;
+
+  // A dedicated pool, so the stripe config applies and only these two
+  // targets are candidates
+  wrp_cte::core::CreateParams params;
+  params.config_.dpe_.stripe_unit_ = kStripeUnit;
+  params.config_.dpe_.stripe_width_ = 2;
+  REQUIRE_NOTHROW(core_client_->Create(mctx_, chi::PoolQuery::Dynamic(),
+                                       "cte_stripe_test_pool", core_pool_id_,
+                                       params));
+
+  const chi::PoolId target_ids[2] = {chi::PoolId(618, 0),
+                                     chi::PoolId(619, 0)};
+  for (size_t i = 0; i < 2; ++i) {
+    std::string target_name =
+        test_storage_path_ + "_stripe_" + std::to_string(i);
+    REQUIRE(core_client_->RegisterTarget(
+                mctx_, target_name, chimaera::bdev::BdevType::kFile,
+                kStripeTargetSize, chi::PoolQuery::Local(),
+                target_ids[i]) == 0);
+  }
+
+  wrp_cte::core::TagId tag_id =
+      core_client_->GetOrCreateTag(mctx_, "stripe_test_tag");
+  REQUIRE((tag_id.major_ != 0 || tag_id.minor_ != 0));
+
+  // Every unit gets its own pattern so a misplaced block shows up on read
+  std::vector<char> data(kBlobSize);
+  for (chi::u64 i = 0; i < kBlobSize; ++i) {
+    data[i] = static_cast<char>('a' + (i / kStripeUnit) + (i % 7));
+  }
+  hipc::FullPtr<char> buffer = CHI_IPC->AllocateBuffer(kBlobSize);
+  REQUIRE(!buffer.IsNull());
+  REQUIRE(CopyToSharedMemory(buffer, data));
+  REQUIRE(core_client_->PutBlob(mctx_, tag_id, "striped_blob", 0, kBlobSize,
+                                buffer.shm_, 0.5f, 0));
+
+  auto target_stats = [this](const chi::PoolId &target_id) {
+    wrp_cte::core::RuntimeStatsReport report =
+        core_client_->GetRuntimeStats(mctx_);
+    for (const auto &stats : report.targets_) {
+      if (stats.target_id_ == target_id) {
+        return stats;
+      }
+    }
+    return wrp_cte::core::TargetIoStats();
+  };
+
+  SECTION("Units alternate across the stripe targets") {
+    for (const chi::PoolId &target_id : target_ids) {
+      wrp_cte::core::TargetIoStats stats = target_stats(target_id);
+      REQUIRE(stats.blocks_allocated_ == kNumUnits / 2);
+      REQUIRE(stats.bytes_written_ == kBlobSize / 2);
+    }
+
+    // Reading one unit at a time shows which target serves each unit
+    hipc::FullPtr<char> unit_buffer = CHI_IPC->AllocateBuffer(kStripeUnit);
+    REQUIRE(!unit_buffer.IsNull());
+    int prev_owner = -1;
+    for (chi::u64 unit = 0; unit < kNumUnits; ++unit) {
+      chi::u64 before[2] = {target_stats(target_ids[0]).bytes_read_,
+                            target_stats(target_ids[1]).bytes_read_};
+      REQUIRE(core_client_->GetBlob(mctx_, tag_id, "striped_blob",
+                                    unit * kStripeUnit, kStripeUnit, 0,
+                                    unit_buffer.shm_));
+      chi::u64 read[2] = {target_stats(target_ids[0]).bytes_read_ - before[0],
+                          target_stats(target_ids[1]).bytes_read_ - before[1]};
+      INFO("unit " << unit);
+      REQUIRE(read[0] + read[1] == kStripeUnit);
+      int owner = read[0] == kStripeUnit ? 0 : 1;
+      REQUIRE(read[owner] == kStripeUnit);
+      REQUIRE(owner != prev_owner);
+      prev_owner = owner;
+    }
+  }
+
+  SECTION("The striped blob reads back intact") {
+    hipc::FullPtr<char> out_buffer = CHI_IPC->AllocateBuffer(kBlobSize);
+    REQUIRE(!out_buffer.IsNull());
+    REQUIRE(core_client_->GetBlob(mctx_, tag_id, "striped_blob", 0, kBlobSize,
+                                  0, out_buffer.shm_));
+    REQUIRE(CopyFromSharedMemory(out_buffer, kBlobSize) == data);
+  }
+}
+
 /**
  * Integration Test: End-to-End CTE Core Workflow
  *
@@ -11,17 +11,23 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include <catch2/catch_all.hpp>
+#include <algorithm>
 #include <filesystem>
 #include <cstdlib>
 #include <memory>
 #include <thread>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 
 using namespace std::chrono_literals;
 
 #include <chimaera/chimaera.h>
 #include <wrp_cte/core/core_client.h>
 #include <wrp_cte/core/core_tasks.h>
+#include <wrp_cte/core/core_dpe.h>
+#include <wrp_cte/core/core_hash_ring.h>
+#include <wrp_cte/core/core_telemetry.h>
 #include <chimaera/bdev/bdev_client.h>
 #include <chimaera/bdev/bdev_tasks.h>
 #include <chimaera/admin/admin_tasks.h>
@@ -378,6 +384,448 @@ TEST_CASE("Blob Information Structure", "[cte][core][blob][info]") {
   }
 }
 
+/**
+ * Test Case: Blob Key
+ *
+ * This test verifies:
+ * 1. A borrowed key matches the owning key for the same name
+ * 2. Copying a borrowed key makes it own its name
+ */
+TEST_CASE("Blob Key", "[cte][core][blob][key]") {
+  using wrp_cte::core::BlobKey;
+  wrp_cte::core::TagId tag_id{1, 2};
+  // Longer than any small-string buffer, so an owning copy must allocate
+  std::string name(64, 'b');
+
+  SECTION("Borrowed and owning keys are interchangeable for lookup") {
+    BlobKey owned(tag_id, name);
+    BlobKey borrowed = BlobKey::View(tag_id, name);
+    REQUIRE(borrowed.GetName().data() == name.data());
+    REQUIRE(borrowed.hash_ == owned.hash_);
+    REQUIRE(borrowed == owned);
+    REQUIRE(borrowed != BlobKey::View(wrp_cte::core::TagId{1, 3}, name));
+  }
+
+  SECTION("Copies own their name") {
+    BlobKey borrowed = BlobKey::View(tag_id, name);
+    BlobKey copy(borrowed);
+    name[0] = 'c';
+    REQUIRE(copy.GetName() == std::string(64, 'b'));
+    REQUIRE(copy.GetName().data() != name.data());
+
+    BlobKey moved(std::move(copy));
+    REQUIRE(moved.GetName() == std::string(64, 'b'));
+  }
+}
+
+/**
+ * Test Case: Target Score Normalization
+ *
+ * This test verifies:
+ * 1. With two targets of different bandwidth the faster scores 1.0 and the
+ *    slower log(bw + 1) / log(max_bw + 1)
+ * 2. Registering a faster target lowers the scores of the others
+ * 3. Targets without bandwidth score 0.0
+ */
+TEST_CASE("Target Score Normalization", "[cte][core][dpe][score]") {
+  using wrp_cte::core::ScoreTargetBandwidth;
+
+  SECTION("Two targets of different bandwidth") {
+    double fast = 2000.0;
+    double slow = 100.0;
+    double max_bandwidth = std::max(fast, slow);
+    float fast_score = ScoreTargetBandwidth(fast, max_bandwidth);
+    float slow_score = ScoreTargetBandwidth(slow, max_bandwidth);
+    REQUIRE(fast_score == Catch::Approx(1.0f));
+    REQUIRE(slow_score ==
+            Catch::Approx(std::log(slow + 1.0) / std::log(fast + 1.0)));
+    REQUIRE(slow_score > 0.0f);
+    REQUIRE(slow_score < fast_score);
+  }
+
+  SECTION("A faster target rescales the others") {
+    float before = ScoreTargetBandwidth(100.0, 2000.0);
+    float after = ScoreTargetBandwidth(100.0, 8000.0);
+    REQUIRE(after < before);
+    REQUIRE(ScoreTargetBandwidth(2000.0, 8000.0) < 1.0f);
+  }
+
+  SECTION("Targets without bandwidth score zero") {
+    REQUIRE(ScoreTargetBandwidth(0.0, 2000.0) == 0.0f);
+    REQUIRE(ScoreTargetBandwidth(100.0, 0.0) == 0.0f);
+    REQUIRE(ScoreTargetBandwidth(5000.0, 2000.0) == 1.0f); // Stale maximum
+  }
+}
+
+/**
+ * Test Case: Hash Ring
+ *
+ * This test verifies:
+ * 1. Growing the ring from N to N+1 containers moves about 1/(N+1) of the
+ *    keys, all of them to the new container
+ * 2. Virtual nodes even out the share of keys each container owns
+ */
+TEST_CASE("Hash Ring", "[cte][core][hash][ring]") {
+  using wrp_cte::core::HashRing;
+  constexpr chi::u64 kNumKeys = 100000;
+
+  // Fraction of keys owned by each container
+  auto shares = [](const HashRing &ring) {
+    std::vector<double> share(ring.GetNumContainers(), 0.0);
+    for (chi::u64 key = 0; key < kNumKeys; ++key) {
+      share[ring.GetOwner(key)] += 1.0 / kNumKeys;
+    }
+    return share;
+  };
+
+  SECTION("Growing the ring moves few keys, all to the new container") {
+    constexpr chi::u32 kContainers = 8;
+    HashRing before;
+    before.Build(kContainers, 64);
+    HashRing after;
+    after.Build(kContainers + 1, 64);
+
+    chi::u64 moved = 0;
+    bool moved_to_new = true;
+    for (chi::u64 key = 0; key < kNumKeys; ++key) {
+      chi::u32 old_owner = before.GetOwner(key);
+      chi::u32 new_owner = after.GetOwner(key);
+      if (old_owner != new_owner) {
+        ++moved;
+        moved_to_new = moved_to_new && new_owner == kContainers;
+      }
+    }
+    double fraction = static_cast<double>(moved) / kNumKeys;
+    double expected = 1.0 / (kContainers + 1);
+    INFO("moved fraction " << fraction << ", expected " << expected);
+    REQUIRE(moved_to_new);
+    REQUIRE(fraction > expected * 0.5);
+    REQUIRE(fraction < expected * 1.5);
+  }
+
+  SECTION("Virtual nodes spread keys evenly") {
+    constexpr chi::u32 kContainers = 8;
+    auto spread = [&](chi::u32 virtual_nodes) {
+      HashRing ring;
+      ring.Build(kContainers, virtual_nodes);
+      REQUIRE(ring.GetVirtualNodes() == virtual_nodes);
+      auto share = shares(ring);
+      auto minmax = std::minmax_element(share.begin(), share.end());
+      return std::make_pair(*minmax.first, *minmax.second);
+    };
+
+    // Every container owns within half of its fair share
+    auto even = spread(256);
+    double fair = 1.0 / kContainers;
+    INFO("shares in [" << even.first << ", " << even.second << "]");
+    REQUIRE(even.first > fair * 0.5);
+    REQUIRE(even.second < fair * 1.5);
+
+    // One point per container is far less even
+    auto single = spread(1);
+    REQUIRE(single.second - single.first > even.second - even.first);
+  }
+
+  SECTION("An unbuilt ring maps every key to container 0") {
+    HashRing ring;
+    REQUIRE(ring.GetNumContainers() == 0);
+    REQUIRE(ring.GetOwner(12345) == 0);
+  }
+}
+
+/**
+ * Test Case: Telemetry Ring
+ *
+ * This test verifies:
+ * 1. Reads resume after the caller's cursor and never consume entries
+ * 2. Entries overwritten before they are read are counted as dropped
+ * 3. max_entries bounds one read and the cursor resumes after it
+ * 4. Concurrent producers and a reader see each entry at most once, in order
+ */
+TEST_CASE("Telemetry Ring", "[cte][core][telemetry][ring]") {
+  using wrp_cte::core::CteOp;
+  using wrp_cte::core::CteTelemetry;
+  using wrp_cte::core::TelemetryRing;
+
+  auto make_entry = [](size_t off) {
+    CteTelemetry entry;
+    entry.op_ = CteOp::kPutBlob;
+    entry.off_ = off;
+    entry.size_ = 1;
+    return entry;
+  };
+
+  SECTION("Cursor reads") {
+    TelemetryRing ring(8);
+    std::vector<CteTelemetry> entries;
+    std::uint64_t dropped = 0;
+    REQUIRE(ring.Read(0, 0, entries, dropped) == 0);
+    REQUIRE(entries.empty());
+
+    for (size_t i = 0; i < 3; ++i) {
+      REQUIRE(ring.Push(make_entry(i)) == i + 1);
+    }
+    std::uint64_t cursor = ring.Read(0, 0, entries, dropped);
+    REQUIRE(cursor == 3);
+    REQUIRE(dropped == 0);
+    REQUIRE(entries.size() == 3);
+    for (size_t i = 0; i < 3; ++i) {
+      REQUIRE(entries[i].off_ == i);
+      REQUIRE(entries[i].logical_time_ == i + 1);
+    }
+
+    // Nothing new after the cursor; an older cursor sees the same entries
+    entries.clear();
+    REQUIRE(ring.Read(cursor, 0, entries, dropped) == cursor);
+    REQUIRE(entries.empty());
+    REQUIRE(ring.Read(1, 0, entries, dropped) == 3);
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[0].off_ == 1);
+    REQUIRE(ring.GetSize() == 3);
+  }
+
+  SECTION("Lapped entries are counted as dropped") {
+    TelemetryRing ring(4);
+    for (size_t i = 0; i < 10; ++i) {
+      ring.Push(make_entry(i));
+    }
+    REQUIRE(ring.GetHead() == 10);
+    REQUIRE(ring.GetSize() == 4);
+
+    std::vector<CteTelemetry> entries;
+    std::uint64_t dropped = 0;
+    std::uint64_t cursor = ring.Read(0, 0, entries, dropped);
+    REQUIRE(cursor == 10);
+    REQUIRE(dropped == 6);
+    REQUIRE(entries.size() == 4);
+    REQUIRE(entries.front().logical_time_ == 7);
+    REQUIRE(entries.back().logical_time_ == 10);
+
+    // A cursor inside the retained window loses nothing
+    entries.clear();
+    REQUIRE(ring.Read(8, 0, entries, dropped) == 10);
+    REQUIRE(dropped == 0);
+    REQUIRE(entries.size() == 2);
+  }
+
+  SECTION("max_entries bounds one read") {
+    TelemetryRing ring(16);
+    for (size_t i = 0; i < 10; ++i) {
+      ring.Push(make_entry(i));
+    }
+    std::vector<CteTelemetry> entries;
+    std::uint64_t dropped = 0;
+    std::uint64_t cursor = ring.Read(0, 4, entries, dropped);
+    REQUIRE(cursor == 4);
+    REQUIRE(entries.size() == 4);
+    cursor = ring.Read(cursor, 4, entries, dropped);
+    REQUIRE(cursor == 8);
+    cursor = ring.Read(cursor, 4, entries, dropped);
+    REQUIRE(cursor == 10);
+    REQUIRE(entries.size() == 10);
+    for (size_t i = 0; i < entries.size(); ++i) {
+      REQUIRE(entries[i].logical_time_ == i + 1);
+    }
+  }
+
+  SECTION("Concurrent Push and Read") {
+    constexpr size_t kProducers = 4;
+    constexpr size_t kPerProducer = 20000;
+    TelemetryRing ring(256);
+    std::atomic<bool> done{false};
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < kProducers; ++p) {
+      producers.emplace_back([&ring, &make_entry, p]() {
+        for (size_t i = 0; i < kPerProducer; ++i) {
+          ring.Push(make_entry(p * kPerProducer + i));
+        }
+      });
+    }
+
+    // Every logical time is either read once or counted as dropped
+    std::uint64_t cursor = 0;
+    std::uint64_t seen = 0;
+    std::uint64_t total_dropped = 0;
+    std::uint64_t last_time = 0;
+    bool ordered = true;
+    std::vector<CteTelemetry> entries;
+    auto poll = [&]() {
+      entries.clear();
+      std::uint64_t dropped = 0;
+      cursor = ring.Read(cursor, 0, entries, dropped);
+      total_dropped += dropped;
+      for (const auto &entry : entries) {
+        ordered = ordered && entry.logical_time_ > last_time;
+        last_time = entry.logical_time_;
+      }
+      seen += entries.size();
+    };
+    std::thread reader([&]() {
+      while (!done.load()) {
+        poll();
+      }
+    });
+    for (auto &producer : producers) {
+      producer.join();
+    }
+    done.store(true);
+    reader.join();
+    poll(); // Drain what was published after the reader's last poll
+
+    REQUIRE(ordered);
+    REQUIRE(cursor == kProducers * kPerProducer);
+    REQUIRE(seen + total_dropped == kProducers * kPerProducer);
+  }
+}
+
+/**
+ * Test Case: Data Placement Locality
+ *
+ * This test verifies:
+ * 1. Every DPE offers targets on the local node before remote ones
+ * 2. Remote targets are used only when no local target has room
+ * 3. MaxBW keeps a local target of the wrong tier ahead of remote targets
+ * 4. Weighted ranks by the configured blend and spreads large blobs
+ */
+TEST_CASE("Data Placement Locality", "[cte][core][dpe][locality]") {
+  using wrp_cte::core::DpeFactory;
+  using wrp_cte::core::DpeType;
+  using wrp_cte::core::TargetDesc;
+
+  auto make_target = [](chi::u32 major, bool is_local, float score,
+                        double bandwidth, chi::u64 remaining) {
+    TargetDesc desc;
+    desc.target_id_ = chi::PoolId(major, 0);
+    desc.is_local_ = is_local;
+    desc.target_score_ = score;
+    desc.write_bandwidth_mbps_ = bandwidth;
+    desc.avg_latency_us_ = 1000.0 / bandwidth;
+    desc.remaining_space_ = remaining;
+    desc.total_space_ = 1ULL << 30;
+    return desc;
+  };
+
+  const chi::u64 kSize = 1024 * 1024;
+  // Remote targets are faster, so only locality can put the local ones first
+  std::vector<TargetDesc> targets = {
+      make_target(1, false, 0.5f, 8000.0, 1ULL << 30),
+      make_target(2, true, 0.5f, 1000.0, 1ULL << 30),
+      make_target(3, false, 0.5f, 6000.0, 1ULL << 30),
+      make_target(4, true, 0.5f, 2000.0, 1ULL << 30),
+  };
+
+  SECTION("Local targets come first") {
+    for (DpeType type :
+         {DpeType::kRandom, DpeType::kRoundRobin, DpeType::kMaxBW,
+          DpeType::kWeighted}) {
+      auto dpe = DpeFactory::CreateDpe(type);
+      std::vector<chi::PoolId> ordered;
+      dpe->SelectTargets(targets, 1.0f, kSize, ordered);
+      REQUIRE(ordered.size() == 4);
+      for (size_t i = 0; i < 2; ++i) {
+        INFO("DPE " << wrp_cte::core::DpeTypeToString(type));
+        REQUIRE((ordered[i] == chi::PoolId(2, 0) ||
+                 ordered[i] == chi::PoolId(4, 0)));
+      }
+    }
+
+    // MaxBW orders each group by bandwidth
+    auto dpe = DpeFactory::CreateDpe(DpeType::kMaxBW);
+    std::vector<chi::PoolId> ordered;
+    dpe->SelectTargets(targets, 1.0f, kSize, ordered);
+    REQUIRE(ordered[0] == chi::PoolId(4, 0));
+    REQUIRE(ordered[1] == chi::PoolId(2, 0));
+    REQUIRE(ordered[2] == chi::PoolId(1, 0));
+    REQUIRE(ordered[3] == chi::PoolId(3, 0));
+  }
+
+  SECTION("Full local targets spill to remote ones") {
+    targets[1].remaining_space_ = 0;
+    targets[3].remaining_space_ = kSize / 2;
+    auto dpe = DpeFactory::CreateDpe(DpeType::kMaxBW);
+    std::vector<chi::PoolId> ordered;
+    dpe->SelectTargets(targets, 1.0f, kSize, ordered);
+    REQUIRE(ordered.size() == 2);
+    REQUIRE(ordered[0] == chi::PoolId(1, 0));
+    REQUIRE(ordered[1] == chi::PoolId(3, 0));
+  }
+
+  SECTION("MaxBW prefers a local target over a remote one of the right tier") {
+    targets[1].target_score_ = 1.0f;
+    targets[3].target_score_ = 1.0f;
+    auto dpe = DpeFactory::CreateDpe(DpeType::kMaxBW);
+    std::vector<chi::PoolId> ordered;
+    dpe->SelectTargets(targets, 0.5f, kSize, ordered);
+    REQUIRE(ordered.size() == 3);
+    REQUIRE(ordered[0] == chi::PoolId(4, 0));
+    REQUIRE(ordered[1] == chi::PoolId(1, 0));
+    REQUIRE(ordered[2] == chi::PoolId(3, 0));
+  }
+
+  SECTION("Weighted ranks by bandwidth and free capacity") {
+    wrp_cte::core::DpeConfig config;
+    config.bandwidth_weight_ = 1.0;
+    config.latency_weight_ = 0.0;
+    config.capacity_weight_ = 0.0;
+    config.score_fit_weight_ = 0.0;
+    // Keep the blob below the spread threshold so ranking is deterministic
+    config.large_blob_size_ = 2 * kSize;
+    auto dpe = DpeFactory::CreateDpe(DpeType::kWeighted, config);
+    std::vector<chi::PoolId> ordered;
+    dpe->SelectTargets(targets, 0.5f, kSize, ordered);
+    REQUIRE(ordered.size() == 4);
+    REQUIRE(ordered[0] == chi::PoolId(4, 0));
+
+    // With only capacity weighted, the emptier local target wins
+    config.bandwidth_weight_ = 0.0;
+    config.capacity_weight_ = 1.0;
+    targets[3].remaining_space_ = 1ULL << 28;
+    dpe = DpeFactory::CreateDpe(DpeType::kWeighted, config);
+    dpe->SelectTargets(targets, 0.5f, kSize, ordered);
+    REQUIRE(ordered[0] == chi::PoolId(2, 0));
+  }
+
+  SECTION("Worker DPE follows the config it is called with") {
+    wrp_cte::core::DpeConfig config;
+    config.bandwidth_weight_ = 1.0;
+    config.latency_weight_ = 0.0;
+    config.capacity_weight_ = 0.0;
+    config.score_fit_weight_ = 0.0;
+    config.large_blob_size_ = 2 * kSize;
+    targets[3].remaining_space_ = 1ULL << 28;
+    std::vector<chi::PoolId> ordered;
+    DpeFactory::GetWorkerDpe(DpeType::kWeighted, config)
+        .SelectTargets(targets, 0.5f, kSize, ordered);
+    REQUIRE(ordered[0] == chi::PoolId(4, 0));
+
+    // Same thread, new tuning: the cached engine must not keep the old one
+    config.bandwidth_weight_ = 0.0;
+    config.capacity_weight_ = 1.0;
+    DpeFactory::GetWorkerDpe(DpeType::kWeighted, config)
+        .SelectTargets(targets, 0.5f, kSize, ordered);
+    REQUIRE(ordered[0] == chi::PoolId(2, 0));
+  }
+
+  SECTION("Weighted spreads large blobs over the best targets") {
+    wrp_cte::core::DpeConfig config;
+    config.large_blob_size_ = kSize;
+    config.spread_width_ = 2;
+    auto dpe = DpeFactory::CreateDpe(DpeType::kWeighted, config);
+    std::vector<chi::PoolId> ordered;
+    size_t first_counts[5] = {0, 0, 0, 0, 0};
+    for (int i = 0; i < 200; ++i) {
+      dpe->SelectTargets(targets, 0.5f, kSize, ordered);
+      REQUIRE(ordered.size() == 4);
+      ++first_counts[ordered[0].major_];
+    }
+    // Both local targets lead some of the time; remote ones never do
+    REQUIRE(first_counts[2] > 0);
+    REQUIRE(first_counts[4] > 0);
+    REQUIRE(first_counts[1] == 0);
+    REQUIRE(first_counts[3] == 0);
+  }
+}
+
 /**
  * Test Case: Task Structure Validation
  * 
@@ -32,6 +32,7 @@
  * - Follow Google C++ style guide
  */
 
+#include <algorithm>
 #include <catch2/catch_all.hpp>
 #include <cstdlib>
 #include <filesystem>
@@ -515,6 +516,201 @@ TEST_CASE_METHOD(CTEQueryTestFixture, "BlobQuery - File Extension Filter",
   }
 }
 
+/**
+ * Test TagQuery with path-prefix patterns answered from the tag name index
+ */
+TEST_CASE_METHOD(CTEQueryTestFixture, "TagQuery - Path Prefix",
+                 "[query][tagquery][prefix]") {
+  INFO("Testing TagQuery with path-prefix patterns");
+
+  // Sibling directories share a textual prefix but not a path prefix
+  for (const char* path : {"/scratch/job1/out.dat", "/scratch/job1/log.txt",
+                           "/scratch/job10/out.dat", "/scratch/job2/out.dat"}) {
+    REQUIRE(!core_client_->GetOrCreateTag(mctx_, path).IsNull());
+  }
+
+  std::vector<std::string> results = core_client_->TagQuery(
+      mctx_, "/scratch/job1/.*", chi::PoolQuery::Broadcast());
+  std::sort(results.begin(), results.end());
+  REQUIRE(results == std::vector<std::string>{"/scratch/job1/log.txt",
+                                              "/scratch/job1/out.dat"});
+
+  // The part after the literal prefix is still matched by the regex
+  results = core_client_->TagQuery(mctx_, "/scratch/job1.*\\.dat",
+                                   chi::PoolQuery::Broadcast());
+  std::sort(results.begin(), results.end());
+  REQUIRE(results == std::vector<std::string>{"/scratch/job1/out.dat",
+                                              "/scratch/job10/out.dat"});
+
+  // Without a literal prefix every tag is scanned
+  results = core_client_->TagQuery(mctx_, ".*/out\\.dat",
+                                   chi::PoolQuery::Broadcast());
+  CHECK(results.size() >= 3);
+
+  // Deleted tags leave the index
+  REQUIRE(core_client_->DelTag(mctx_, "/scratch/job1/log.txt"));
+  results = core_client_->TagQuery(mctx_, "/scratch/job1/.*",
+                                   chi::PoolQuery::Broadcast());
+  REQUIRE(results == std::vector<std::string>{"/scratch/job1/out.dat"});
+}
+
+/**
+ * Test cursor-based pagination and the lazy query iterators
+ */
+TEST_CASE_METHOD(CTEQueryTestFixture, "Query - Paginated Results",
+                 "[query][pagination]") {
+  INFO("Testing paged TagQuery/BlobQuery/GetContainedBlobs");
+
+  auto sorted = [](std::vector<std::string> names) {
+    std::sort(names.begin(), names.end());
+    return names;
+  };
+  auto drain = [](wrp_cte::core::QueryResultIterator it) {
+    std::vector<std::string> names;
+    std::string name;
+    while (it.Next(name)) {
+      names.push_back(name);
+    }
+    REQUIRE(it.GetFailedPages() == 0);
+    return names;
+  };
+
+  std::vector<std::string> all_blobs = sorted(core_client_->BlobQuery(
+      mctx_, ".*", ".*", chi::PoolQuery::Broadcast()));
+  REQUIRE(!all_blobs.empty());
+
+  SECTION("BlobQuery pages never exceed max_results") {
+    // Pages of one name walk across tag boundaries through the cursor
+    std::string cursor;
+    std::vector<std::string> paged;
+    std::vector<std::string> page;
+    size_t pages = 0;
+    do {
+      REQUIRE(core_client_->BlobQueryPage(mctx_, "user_.*", "blob_.*",
+                                          chi::PoolQuery::DirectHash(0), 1,
+                                          cursor, page));
+      REQUIRE(page.size() <= 1);
+      paged.insert(paged.end(), page.begin(), page.end());
+      ++pages;
+    } while (!cursor.empty());
+    REQUIRE(sorted(paged) == sorted(core_client_->BlobQuery(
+                                 mctx_, "user_.*", "blob_.*",
+                                 chi::PoolQuery::Broadcast())));
+    REQUIRE(pages >= paged.size());
+  }
+
+  SECTION("Iterators return the same results as unpaged queries") {
+    REQUIRE(sorted(drain(core_client_->IterateBlobQuery(mctx_, ".*", ".*",
+                                                        3))) == all_blobs);
+    REQUIRE(sorted(drain(core_client_->IterateTagQuery(mctx_, ".*", 2))) ==
+            sorted(core_client_->TagQuery(mctx_, ".*",
+                                          chi::PoolQuery::Broadcast())));
+
+    wrp_cte::core::TagId tag_id =
+        core_client_->GetOrCreateTag(mctx_, "user_data");
+    REQUIRE(sorted(drain(core_client_->IterateContainedBlobs(
+                mctx_, tag_id, 1))) ==
+            sorted(core_client_->GetContainedBlobs(mctx_, tag_id)));
+  }
+
+  SECTION("A malformed cursor is rejected") {
+    std::string cursor = "not-a-cursor";
+    std::vector<std::string> page;
+    REQUIRE_FALSE(core_client_->BlobQueryPage(mctx_, ".*", ".*",
+                                              chi::PoolQuery::DirectHash(0),
+                                              10, cursor, page));
+    REQUIRE(page.empty());
+  }
+}
+
+/**
+ * Test BlobQuery metadata predicates and returned blob stats
+ */
+TEST_CASE_METHOD(CTEQueryTestFixture, "BlobQuery - Metadata Predicates",
+                 "[query][blobquery][predicate]") {
+  INFO("Testing BlobQuery size/score/age/target predicates");
+
+  // One blob that differs from the fixture's 4KB, score 0.5 blobs
+  const size_t big_size = 2 * kTestBlobSize;
+  wrp_cte::core::TagId tag_id =
+      core_client_->GetOrCreateTag(mctx_, "user_data");
+  hipc::FullPtr<char> buffer = CHI_IPC->AllocateBuffer(big_size);
+  REQUIRE(!buffer.IsNull());
+  std::memset(buffer.ptr_, 'B', big_size);
+  REQUIRE(core_client_->PutBlob(mctx_, tag_id, "big.bin", 0, big_size,
+                                buffer.shm_, 0.9f, 0));
+  CHI_IPC->FreeBuffer(buffer);
+
+  auto names = [](const std::vector<wrp_cte::core::BlobQueryResult> &results) {
+    std::vector<std::string> blob_names;
+    for (const auto &result : results) {
+      blob_names.push_back(result.blob_name_);
+    }
+    return blob_names;
+  };
+
+  // Stats come back with the names in one round trip
+  std::vector<wrp_cte::core::BlobQueryResult> results =
+      core_client_->BlobQueryWithStats(mctx_, "user_data", "big\\.bin");
+  REQUIRE(results.size() == 1);
+  const wrp_cte::core::BlobQueryStat &stat = results[0].stat_;
+  REQUIRE(stat.tag_id_ == tag_id);
+  REQUIRE(stat.size_ == big_size);
+  REQUIRE(stat.score_ == Catch::Approx(0.9f));
+  REQUIRE(stat.num_blocks_ >= 1);
+  REQUIRE(!(stat.target_id_ == chi::PoolId::GetNull()));
+
+  // Without predicates every name match is returned
+  REQUIRE(core_client_->BlobQueryWithStats(mctx_, "user_data", ".*").size() ==
+          core_client_->BlobQuery(mctx_, "user_data", ".*").size());
+
+  wrp_cte::core::BlobQueryPredicate predicate;
+  predicate.min_size_ = kTestBlobSize + 1;
+  REQUIRE(names(core_client_->BlobQueryWithStats(mctx_, "user_data", ".*",
+                                                 predicate)) ==
+          std::vector<std::string>{"big.bin"});
+
+  predicate = wrp_cte::core::BlobQueryPredicate();
+  predicate.min_score_ = 0.8f;
+  REQUIRE(names(core_client_->BlobQueryWithStats(mctx_, "user_data", ".*",
+                                                 predicate)) ==
+          std::vector<std::string>{"big.bin"});
+
+  predicate = wrp_cte::core::BlobQueryPredicate();
+  predicate.max_score_ = 0.6f;
+  for (const auto &result :
+       core_client_->BlobQueryWithStats(mctx_, "user_data", ".*", predicate)) {
+    REQUIRE(result.blob_name_ != "big.bin");
+  }
+
+  // Nothing has gone unread for an hour
+  predicate = wrp_cte::core::BlobQueryPredicate();
+  predicate.min_read_age_ms_ = 3600 * 1000;
+  REQUIRE(core_client_->BlobQueryWithStats(mctx_, ".*", ".*", predicate)
+              .empty());
+
+  // Residency on the blob's own target matches, on an unknown one does not
+  predicate = wrp_cte::core::BlobQueryPredicate();
+  predicate.target_id_ = stat.target_id_;
+  std::vector<std::string> resident = names(
+      core_client_->BlobQueryWithStats(mctx_, "user_data", ".*", predicate));
+  REQUIRE(std::find(resident.begin(), resident.end(), "big.bin") !=
+          resident.end());
+  predicate.target_id_ = chi::PoolId(999, 0);
+  REQUIRE(core_client_->BlobQueryWithStats(mctx_, ".*", ".*", predicate)
+              .empty());
+
+  // Predicates also apply to plain name queries
+  predicate = wrp_cte::core::BlobQueryPredicate();
+  predicate.min_size_ = kTestBlobSize + 1;
+  std::string cursor;
+  std::vector<std::string> page;
+  REQUIRE(core_client_->BlobQueryPage(mctx_, "user_data", ".*",
+                                      chi::PoolQuery::DirectHash(0), 10,
+                                      cursor, page, predicate));
+  REQUIRE(page == std::vector<std::string>{"big.bin"});
+}
+
 /**
  * Test Query API with Local pool query
  */
@@ -537,3 +733,59 @@ TEST_CASE_METHOD(CTEQueryTestFixture, "Query - Local Pool Query",
   INFO("BlobQuery with Local returned " << blob_results.size() << " results");
   REQUIRE(!blob_results.empty());
 }
+
+/**
+ * Test compiled patterns: the literal pre-filter must never reject a string
+ * the regex would match
+ */
+TEST_CASE("Query - Compiled Pattern Prefilter", "[query][pattern]") {
+  using wrp_cte::core::CompiledPattern;
+
+  CompiledPattern plain("user_.*");
+  CHECK(plain.GetLiteralPrefix() == "user_");
+  CHECK(plain.Match("user_alice"));
+  CHECK_FALSE(plain.Match("admin_user_alice"));
+  CHECK(plain.Search("admin_user_alice"));
+
+  CompiledPattern anchored("^/tmp/.*\\.dat$");
+  CHECK(anchored.GetLiteralPrefix() == "/tmp/");
+  CHECK(anchored.Search("/tmp/a.dat"));
+  CHECK_FALSE(anchored.Search("/home/tmp/a.dat"));
+
+  // An optional character is not part of the required literal
+  CompiledPattern optional("files?_.*");
+  CHECK(optional.GetLiteralPrefix() == "file");
+  CHECK(optional.Match("file_1"));
+  CHECK(optional.Match("files_1"));
+
+  // Escaped punctuation is literal; classes end the literal
+  CompiledPattern escaped("a\\.b\\d+");
+  CHECK(escaped.GetLiteralPrefix() == "a.b");
+  CHECK(escaped.Match("a.b42"));
+  CHECK_FALSE(escaped.Match("axb42"));
+
+  // Alternation disables the pre-filter
+  CompiledPattern alternation("user_alice|admin_.*");
+  CHECK(alternation.GetLiteralPrefix().empty());
+  CHECK(alternation.Match("admin_root"));
+
+  CHECK_THROWS(CompiledPattern("user_[unclosed"));
+}
+
+/**
+ * Test the bounded LRU of compiled query patterns
+ */
+TEST_CASE("Query - Pattern Cache", "[query][pattern]") {
+  wrp_cte::core::PatternCache cache(2);
+
+  auto first = cache.Get("a.*");
+  CHECK(cache.Get("a.*") == first); // Hit: same compiled object
+  cache.Get("b.*");
+  cache.Get("a.*");                 // a.* is now the most recent
+  cache.Get("c.*");                 // Evicts b.*
+  CHECK(cache.GetSize() == 2);
+  CHECK(cache.Get("a.*") == first);
+
+  CHECK_THROWS(cache.Get("("));
+  CHECK(cache.GetSize() == 2);
+}
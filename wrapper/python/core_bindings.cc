@@ -68,8 +68,8 @@ NB_MODULE(wrp_cte_core_ext, m) {
       .def(nb::init<>())
       .def(nb::init<const chi::PoolId &>())
       .def("PollTelemetryLog", &wrp_cte::core::Client::PollTelemetryLog,
-           "mctx"_a, "minimum_logical_time"_a,
-           "Poll telemetry log with minimum logical time filter")
+           "mctx"_a, "minimum_logical_time"_a, "max_entries"_a = 0,
+           "Poll telemetry entries logged after the minimum_logical_time cursor")
       .def("ReorganizeBlob", &wrp_cte::core::Client::ReorganizeBlob,
            "mctx"_a, "tag_id"_a, "blob_name"_a, "new_score"_a,
            "Reorganize single blob with new score for data placement optimization")